@@ -19,11 +19,14 @@ namespace am {
 	Configuration defines:
 
 	- %AM_CONFIG_IMPLICIT_LINEAR_INTERFACE
+	- %AM_CONFIG_ALIGN_SIMD
+	- %AM_CONFIG_TRIVIAL_DEFAULT_CONSTRUCT
 	- %AM_CONFIG_FLOAT_PRECISION
 	- %AM_CONFIG_INT_PRECISION
 	- %AM_CONFIG_UINT_PRECISION
 	- %AM_CONFIG_VECTOR_TYPES
 	- %AM_CONFIG_MATRIX_TYPES
+	- %AM_CONFIG_NO_INTRINSICS
 	@{
 */
 
@@ -53,6 +56,57 @@ namespace am {
 	#define AM_CONFIG_IMPLICIT_LINEAR_INTERFACE
 #endif
 
+#ifdef DOXYGEN_CONSISTS_SOLELY_OF_UNICORNS_AND_CONFETTI
+	/**
+		Whether 4-dimensional vectors should be aligned to their
+		size (e.g., 16 bytes for @c vec4 with single-precision
+		components), so they can be loaded with aligned SIMD
+		instructions and never straddle a cache line. Matrices with
+		4-component columns (@c mat2x4, @c mat3x4, @c mat4x4) are
+		aligned the same way through their columns.
+
+		@warning This changes the layout of these types, so it must be
+		defined the same way in every translation unit. Before C++17,
+		@c new does not honor alignments greater than that of
+		@c std::max_align_t; use am::aligned_allocator for dynamic
+		storage.
+
+		This is not defined by default.
+	*/
+	#define AM_CONFIG_ALIGN_SIMD
+#endif
+
+#ifdef DOXYGEN_CONSISTS_SOLELY_OF_UNICORNS_AND_CONFETTI
+	/**
+		Whether vector and matrix types should be trivially
+		default-constructible.
+
+		By default, vectors are zeroed and matrices are set to
+		identity when default-constructed. With this defined, the
+		default constructors leave components uninitialized, so
+		default-initialized storage (e.g., <code>new mat4x4[n]</code>)
+		costs only the allocation; use the @c zero() and @c identity()
+		factories for initialized values.
+
+		@note Value-initialization (e.g., @c mat4x4{}) zeroes
+		components in this mode; it does @em not produce an identity
+		matrix. Standard containers value-initialize, so
+		<code>std::vector<mat4x4>(n)</code> and @c resize() still write
+		every element; use am::default_init_allocator to skip that.
+
+		This is not defined by default.
+	*/
+	#define AM_CONFIG_TRIVIAL_DEFAULT_CONSTRUCT
+#endif
+
+/** @cond INTERNAL */
+#ifdef AM_CONFIG_ALIGN_SIMD
+	#define AM_DETAIL_ALIGN_SIMD(size_) alignas(size_)
+#else
+	#define AM_DETAIL_ALIGN_SIMD(size_)
+#endif
+/** @endcond */
+
 #ifdef DOXYGEN_CONSISTS_SOLELY_OF_UNICORNS_AND_CONFETTI
 
 /**
@@ -186,6 +240,45 @@ namespace am {
 #endif // DOXYGEN_CONSISTS_SOLELY_OF_UNICORNS_AND_CONFETTI
 
 /** @} */ // end of name-group Linear configuration
+
+/**
+	@name Instruction set configuration
+	@{
+*/
+
+#ifdef DOXYGEN_CONSISTS_SOLELY_OF_UNICORNS_AND_CONFETTI
+	/**
+		Whether to avoid instruction set intrinsics.
+
+		By default, some functions use intrinsics for instruction
+		sets the compiler targets (e.g., BMI2 with
+		<code>-mbmi2</code> or <code>-march=haswell</code>). With
+		this defined, the portable implementations are always used.
+		Results are the same either way.
+
+		This is not defined by default.
+	*/
+	#define AM_CONFIG_NO_INTRINSICS
+#endif
+
+/** @cond INTERNAL */
+#if !defined(AM_CONFIG_NO_INTRINSICS) && defined(__BMI2__)
+	#define AM_DETAIL_BMI2
+#endif
+#if !defined(AM_CONFIG_NO_INTRINSICS) && defined(__SSE2__)
+	#define AM_DETAIL_SSE2
+#endif
+#if !defined(AM_CONFIG_NO_INTRINSICS) && defined(__AVX2__)
+	#define AM_DETAIL_AVX2
+#endif
+#if \
+	!defined(AM_CONFIG_NO_INTRINSICS) && \
+	defined(__SSE4_2__) && defined(__x86_64__)
+	#define AM_DETAIL_SSE42
+#endif
+/** @endcond */
+
+/** @} */ // end of name-group Instruction set configuration
 /** @} */ // end of doc-group config
 
 } // namespace am
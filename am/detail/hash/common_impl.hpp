@@ -0,0 +1,99 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Word loads and wide multiplication shared by the hash
+implementations.
+*/
+
+#pragma once
+
+#include "../../config.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+namespace am {
+namespace detail {
+namespace hash {
+
+/** @cond INTERNAL */
+
+inline std::uint32_t
+hash_swap32(
+	std::uint32_t const x
+) noexcept {
+	return
+		(x << 24) | ((x << 8) & 0x00ff0000u) |
+		((x >> 8) & 0x0000ff00u) | (x >> 24)
+	;
+}
+
+inline std::uint64_t
+hash_swap64(
+	std::uint64_t const x
+) noexcept {
+	return
+		(static_cast<std::uint64_t>(hash_swap32(static_cast<std::uint32_t>(x))) << 32) |
+		hash_swap32(static_cast<std::uint32_t>(x >> 32))
+	;
+}
+
+// Unaligned little-endian loads; a single mov on little-endian targets
+inline std::uint32_t
+hash_read32(
+	uint8_t const* const p
+) noexcept {
+	std::uint32_t x;
+	std::memcpy(&x, p, sizeof(x));
+#if defined(__BYTE_ORDER__)
+	#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	x = hash_swap32(x);
+	#endif
+#endif
+	return x;
+}
+
+inline std::uint64_t
+hash_read64(
+	uint8_t const* const p
+) noexcept {
+	std::uint64_t x;
+	std::memcpy(&x, p, sizeof(x));
+#if defined(__BYTE_ORDER__)
+	#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	x = hash_swap64(x);
+	#endif
+#endif
+	return x;
+}
+
+// Full 64x64->128 multiply
+inline void
+hash_mul128(
+	std::uint64_t const a,
+	std::uint64_t const b,
+	std::uint64_t& lo,
+	std::uint64_t& hi
+) noexcept {
+#if defined(__SIZEOF_INT128__)
+	__extension__ typedef unsigned __int128 uint128;
+	uint128 const p = static_cast<uint128>(a) * b;
+	lo = static_cast<std::uint64_t>(p);
+	hi = static_cast<std::uint64_t>(p >> 64);
+#else
+	std::uint64_t const lo_lo = (a & 0xffffffffu) * (b & 0xffffffffu);
+	std::uint64_t const hi_lo = (a >> 32) * (b & 0xffffffffu);
+	std::uint64_t const lo_hi = (a & 0xffffffffu) * (b >> 32);
+	std::uint64_t const hi_hi = (a >> 32) * (b >> 32);
+	std::uint64_t const cross = (lo_lo >> 32) + (hi_lo & 0xffffffffu) + lo_hi;
+	lo = (cross << 32) | (lo_lo & 0xffffffffu);
+	hi = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+#endif
+}
+
+/** @endcond */ // INTERNAL
+
+} // namespace hash
+} // namespace detail
+} // namespace am
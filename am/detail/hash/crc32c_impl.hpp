@@ -0,0 +1,297 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief CRC-32C (implementation).
+*/
+
+#pragma once
+
+#include "../../config.hpp"
+#include "../../hash/common.hpp"
+#include "./common_impl.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(AM_DETAIL_SSE42)
+	#include <nmmintrin.h>
+#endif
+
+namespace am {
+namespace detail {
+namespace hash {
+
+/** @cond INTERNAL */
+
+#define AM_HASH_CRC32C_RESTRICT_LENGTH(hash_length)		\
+	AM_STATIC_ASSERT(									\
+		::am::hash::HashLength::HL32 == hash_length,	\
+		"CRC-32C only has a 32-bit implementation"		\
+	)
+
+// Castagnoli polynomial, reflected
+constexpr std::uint32_t const crc32c_poly = 0x82f63b78u;
+
+// Polynomials are reflected: x^0 is the top bit
+inline std::uint32_t
+crc32c_multiply(
+	std::uint32_t a,
+	std::uint32_t b
+) noexcept {
+	std::uint32_t p = 0u;
+	for (std::uint32_t m = 1u << 31; m != 0u; m >>= 1) {
+		if (a & m) {
+			p ^= b;
+		}
+		b = (b >> 1) ^ (crc32c_poly & (0u - (b & 1u)));
+	}
+	return p;
+}
+
+// x^(8 * size) mod P
+inline std::uint32_t
+crc32c_power(
+	std::uint64_t size
+) noexcept {
+	std::uint32_t p = 1u << 31;
+	// x^8
+	std::uint32_t square = 1u << 23;
+	for (; size != 0u; size >>= 1) {
+		if (size & 1u) {
+			p = crc32c_multiply(square, p);
+		}
+		square = crc32c_multiply(square, square);
+	}
+	return p;
+}
+
+// Table for the linear map crc -> crc * x^(8 * size) mod P
+struct crc32c_shift_table {
+	std::uint32_t table[4][256];
+
+	explicit
+	crc32c_shift_table(
+		std::uint64_t const size
+	) noexcept {
+		std::uint32_t const power = crc32c_power(size);
+		for (unsigned k = 0; k < 4u; ++k) {
+			for (std::uint32_t n = 0; n < 256u; ++n) {
+				table[k][n] = crc32c_multiply(power, n << (8u * k));
+			}
+		}
+	}
+
+	std::uint32_t
+	operator()(
+		std::uint32_t const crc
+	) const noexcept {
+		return
+			table[0][crc & 0xffu] ^
+			table[1][(crc >> 8) & 0xffu] ^
+			table[2][(crc >> 16) & 0xffu] ^
+			table[3][crc >> 24]
+		;
+	}
+};
+
+#if defined(AM_DETAIL_SSE42)
+
+// Three-way interleave: the crc32 instruction has a latency of 3 and a
+// throughput of 1, so three independent streams are run over adjacent
+// thirds of a block and then joined by shifting
+enum : unsigned {
+	crc32c_long = 8192u,
+	crc32c_short = 256u,
+};
+
+struct crc32c_tables {
+	crc32c_shift_table shift_long{crc32c_long};
+	crc32c_shift_table shift_short{crc32c_short};
+};
+
+inline crc32c_tables const&
+crc32c_table_data() noexcept {
+	static crc32c_tables const tables{};
+	return tables;
+}
+
+template<
+	unsigned Stream
+>
+inline uint8_t const*
+crc32c_interleave(
+	std::uint64_t& crc,
+	uint8_t const* p,
+	crc32c_shift_table const& shift
+) noexcept {
+	std::uint64_t crc0 = crc, crc1 = 0u, crc2 = 0u;
+	uint8_t const* const end = p + Stream;
+	for (; p != end; p += 8) {
+		crc0 = _mm_crc32_u64(crc0, hash_read64(p));
+		crc1 = _mm_crc32_u64(crc1, hash_read64(p + Stream));
+		crc2 = _mm_crc32_u64(crc2, hash_read64(p + 2u * Stream));
+	}
+	crc0 = shift(static_cast<std::uint32_t>(crc0)) ^ crc1;
+	crc = shift(static_cast<std::uint32_t>(crc0)) ^ crc2;
+	return p + 2u * Stream;
+}
+
+// Update a raw (non-inverted) CRC register
+inline std::uint32_t
+crc32c_update(
+	std::uint32_t const crc,
+	uint8_t const* p,
+	std::size_t size
+) noexcept {
+	std::uint64_t c = crc;
+	if (size >= 3u * crc32c_short) {
+		auto const& tables = crc32c_table_data();
+		for (; size >= 3u * crc32c_long; size -= 3u * crc32c_long) {
+			p = crc32c_interleave<crc32c_long>(c, p, tables.shift_long);
+		}
+		for (; size >= 3u * crc32c_short; size -= 3u * crc32c_short) {
+			p = crc32c_interleave<crc32c_short>(c, p, tables.shift_short);
+		}
+	}
+	for (; size >= 8u; size -= 8u, p += 8) {
+		c = _mm_crc32_u64(c, hash_read64(p));
+	}
+	std::uint32_t c32 = static_cast<std::uint32_t>(c);
+	for (; size > 0u; --size, ++p) {
+		c32 = _mm_crc32_u8(c32, *p);
+	}
+	return c32;
+}
+
+#else
+
+// Slicing-by-8
+struct crc32c_tables {
+	std::uint32_t slice[8][256];
+
+	crc32c_tables() noexcept {
+		for (std::uint32_t n = 0; n < 256u; ++n) {
+			std::uint32_t c = n;
+			for (unsigned k = 0; k < 8u; ++k) {
+				c = (c >> 1) ^ (crc32c_poly & (0u - (c & 1u)));
+			}
+			slice[0][n] = c;
+		}
+		for (std::uint32_t n = 0; n < 256u; ++n) {
+			for (unsigned k = 1; k < 8u; ++k) {
+				std::uint32_t const c = slice[k - 1u][n];
+				slice[k][n] = (c >> 8) ^ slice[0][c & 0xffu];
+			}
+		}
+	}
+};
+
+inline crc32c_tables const&
+crc32c_table_data() noexcept {
+	static crc32c_tables const tables{};
+	return tables;
+}
+
+// Update a raw (non-inverted) CRC register
+inline std::uint32_t
+crc32c_update(
+	std::uint32_t crc,
+	uint8_t const* p,
+	std::size_t size
+) noexcept {
+	auto const& t = crc32c_table_data().slice;
+	for (; size >= 8u; size -= 8u, p += 8) {
+		std::uint64_t const w = hash_read64(p) ^ crc;
+		crc
+			= t[7][w & 0xffu]
+			^ t[6][(w >> 8) & 0xffu]
+			^ t[5][(w >> 16) & 0xffu]
+			^ t[4][(w >> 24) & 0xffu]
+			^ t[3][(w >> 32) & 0xffu]
+			^ t[2][(w >> 40) & 0xffu]
+			^ t[1][(w >> 48) & 0xffu]
+			^ t[0][w >> 56]
+		;
+	}
+	for (; size > 0u; --size, ++p) {
+		crc = t[0][(crc ^ *p) & 0xffu] ^ (crc >> 8);
+	}
+	return crc;
+}
+
+#endif
+
+struct crc32c_state {
+	std::uint32_t value;
+	unsigned size;
+};
+
+template<
+	::am::hash::HashLength L
+>
+struct crc32c_impl {
+	AM_HASH_CRC32C_RESTRICT_LENGTH(L);
+
+	static constexpr auto const hash_length = L;
+	using hash_type = ::am::hash::common_hash_type<L>;
+	using state_type = crc32c_state;
+
+	static hash_type
+	calc(
+		uint8_t const* const data,
+		unsigned const size
+	) noexcept {
+		return ~crc32c_update(~0u, data, size);
+	}
+
+	static void
+	state_init(
+		state_type& s
+	) noexcept {
+		s.value = 0u;
+		s.size = 0u;
+	}
+
+	static void
+	state_add(
+		state_type& s,
+		uint8_t const* const data,
+		unsigned const size
+	) noexcept {
+		s.value = ~crc32c_update(~s.value, data, size);
+		s.size += size;
+	}
+
+	static hash_type
+	state_value(
+		state_type const& s
+	) noexcept {
+		return s.value;
+	}
+
+	static unsigned
+	state_size(
+		state_type const& s
+	) noexcept {
+		return s.size;
+	}
+};
+
+/** @endcond */ // INTERNAL
+
+} // namespace hash
+} // namespace detail
+
+/** @cond INTERNAL */
+namespace hash {
+
+template<HashLength L>
+struct impl_is_stateful<detail::hash::crc32c_impl<L>> {
+	static constexpr bool const value = true;
+};
+
+} // namespace hash
+/** @endcond */ // INTERNAL
+
+} // namespace am
@@ -0,0 +1,1366 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Flat hash tables (implementation).
+*/
+
+#pragma once
+
+#include "../../config.hpp"
+#include "../../memory.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(AM_DETAIL_SSE2)
+	#include <emmintrin.h>
+#endif
+
+namespace am {
+namespace detail {
+namespace hash {
+
+/** @cond INTERNAL */
+
+// Control bytes: one per slot, plus a sentinel and a copy of the first
+// (width - 1) bytes after the last slot, so a group can be loaded at
+// any slot without wrapping. Full slots hold the low 7 bits of the
+// hash (h2); the other states have the top bit set.
+using flat_ctrl = std::int8_t;
+
+enum : flat_ctrl {
+	flat_empty = -128,
+	flat_deleted = -2,
+	flat_sentinel = -1,
+};
+
+constexpr std::uint8_t const
+flat_debruijn_table[64]{
+	 0,  1, 56,  2, 57, 49, 28,  3, 61, 58, 42, 50, 38, 29, 17,  4,
+	62, 47, 59, 36, 45, 43, 51, 22, 53, 39, 33, 30, 24, 18, 12,  5,
+	63, 55, 48, 27, 60, 41, 37, 16, 46, 35, 44, 21, 52, 32, 23, 11,
+	54, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19,  9, 13,  8,  7,  6
+};
+
+// Index of the lowest set bit; x must be non-zero
+inline unsigned
+flat_ctz(
+	std::uint64_t const x
+) noexcept {
+	return flat_debruijn_table[
+		((x & (0u - x)) * 0x03f79d71b4ca8b09ULL) >> 58
+	];
+}
+
+// Index of the highest set bit; x must be non-zero
+inline unsigned
+flat_msb(
+	std::uint64_t x
+) noexcept {
+	unsigned n = 0u;
+	while (x >>= 1) {
+		++n;
+	}
+	return n;
+}
+
+#if defined(AM_DETAIL_SSE2)
+
+// Masks have bit i set for slot i
+struct flat_group {
+	static constexpr unsigned const width = 16u;
+	static constexpr unsigned const shift = 0u;
+	using mask_type = std::uint32_t;
+
+	__m128i ctrl;
+
+	explicit
+	flat_group(
+		flat_ctrl const* const p
+	) noexcept
+		: ctrl(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p)))
+	{}
+
+	mask_type
+	match(
+		flat_ctrl const h2
+	) const noexcept {
+		return static_cast<mask_type>(
+			_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl))
+		);
+	}
+
+	mask_type
+	match_empty() const noexcept {
+		return match(flat_empty);
+	}
+
+	mask_type
+	match_empty_or_deleted() const noexcept {
+		return static_cast<mask_type>(_mm_movemask_epi8(
+			_mm_cmpgt_epi8(_mm_set1_epi8(flat_sentinel), ctrl)
+		));
+	}
+
+	unsigned
+	count_leading_empty_or_deleted() const noexcept {
+		return flat_ctz(~match_empty_or_deleted());
+	}
+};
+
+#else
+
+// Masks have bit (8 * i + 7) set for slot i. match() can report a
+// false positive in the slot after a true match; callers compare keys
+// anyway.
+struct flat_group {
+	static constexpr unsigned const width = 8u;
+	static constexpr unsigned const shift = 3u;
+	using mask_type = std::uint64_t;
+
+	static constexpr std::uint64_t const lsbs = 0x0101010101010101ULL;
+	static constexpr std::uint64_t const msbs = 0x8080808080808080ULL;
+
+	std::uint64_t ctrl;
+
+	explicit
+	flat_group(
+		flat_ctrl const* const p
+	) noexcept
+		: ctrl(0u)
+	{
+		for (unsigned i = 0; i < width; ++i) {
+			ctrl |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(p[i])) << (8u * i);
+		}
+	}
+
+	mask_type
+	match(
+		flat_ctrl const h2
+	) const noexcept {
+		std::uint64_t const x = ctrl ^ (lsbs * static_cast<std::uint8_t>(h2));
+		return (x - lsbs) & ~x & msbs;
+	}
+
+	mask_type
+	match_empty() const noexcept {
+		return ctrl & ~(ctrl << 6) & msbs;
+	}
+
+	mask_type
+	match_empty_or_deleted() const noexcept {
+		return ctrl & ~(ctrl << 7) & msbs;
+	}
+
+	unsigned
+	count_leading_empty_or_deleted() const noexcept {
+		std::uint64_t const x = ~match_empty_or_deleted() & msbs;
+		return (0u != x) ? flat_ctz(x) >> shift : width;
+	}
+};
+
+#endif
+
+constexpr unsigned const flat_width = flat_group::width;
+
+// Slots before the first match, or width if none
+inline unsigned
+flat_trailing(
+	flat_group::mask_type const mask
+) noexcept {
+	return (0u != mask) ? flat_ctz(mask) >> flat_group::shift : flat_width;
+}
+
+// Slots after the last match, or width if none
+inline unsigned
+flat_leading(
+	flat_group::mask_type const mask
+) noexcept {
+	return (0u != mask)
+		? ((flat_width << flat_group::shift) - 1u - flat_msb(mask)) >> flat_group::shift
+		: flat_width
+	;
+}
+
+// Control bytes for tables with no slots: a sentinel (so iteration
+// stops at once) followed by empties (so lookups stop at once)
+template<
+	class = void
+>
+struct flat_empty_group {
+	static flat_ctrl value[16];
+};
+
+template<class T>
+flat_ctrl flat_empty_group<T>::value[16]{
+	flat_sentinel,
+	flat_empty, flat_empty, flat_empty, flat_empty, flat_empty,
+	flat_empty, flat_empty, flat_empty, flat_empty, flat_empty,
+	flat_empty, flat_empty, flat_empty, flat_empty, flat_empty
+};
+
+// The table takes h1 (the probe start) and h2 from opposite ends of
+// the hash, so it is mixed first: 32-bit or weak hashes (e.g., FNV,
+// whose low bits depend only on the low bits of the input) would
+// otherwise cluster
+inline std::uint64_t
+flat_mix(
+	std::uint64_t h
+) noexcept {
+	h *= 0x9e3779b97f4a7c15ULL;
+	return h ^ (h >> 32);
+}
+
+// Triangular probing over groups; visits every group once when the
+// number of groups is a power of two
+struct flat_probe {
+	std::size_t mask;
+	std::size_t offset;
+	std::size_t index;
+
+	flat_probe(
+		std::uint64_t const h1,
+		std::size_t const mask
+	) noexcept
+		: mask(mask)
+		, offset(static_cast<std::size_t>(h1) & mask)
+		, index(0u)
+	{}
+
+	std::size_t
+	at(
+		unsigned const i
+	) const noexcept {
+		return (offset + i) & mask;
+	}
+
+	void
+	next() noexcept {
+		index += flat_width;
+		offset = (offset + index) & mask;
+	}
+};
+
+template<class T, class = void>
+struct flat_is_transparent
+	: std::false_type
+{};
+
+template<class T>
+struct flat_is_transparent<T, typename std::conditional<
+	true, void, typename T::is_transparent
+>::type>
+	: std::true_type
+{};
+
+// Lookup key type: any type for transparent Hash and Eq, otherwise
+// the key type. Written so that K is deducible when transparent.
+template<
+	bool Transparent
+>
+struct flat_key_arg {
+	template<class K, class /*Key*/>
+	using type = K;
+};
+
+template<>
+struct flat_key_arg<false> {
+	template<class /*K*/, class Key>
+	using type = Key;
+};
+
+// Map slots are constructed and destroyed as std::pair<K, V> so that
+// resizing can move keys, and are handed out as std::pair<K const, V>
+// through the other member of the union (as Abseil's flat_hash_map
+// does)
+template<
+	class K,
+	class V
+>
+union flat_map_slot {
+	std::pair<K const, V> value;
+	std::pair<K, V> mutable_value;
+
+	flat_map_slot() = delete;
+	~flat_map_slot() = delete;
+};
+
+template<
+	class K,
+	class V
+>
+struct flat_map_policy {
+	using key_type = K;
+	using value_type = std::pair<K const, V>;
+	using mutable_value_type = std::pair<K, V>;
+	using slot_type = flat_map_slot<K, V>;
+	static constexpr bool const constant_iterators = false;
+
+	static K const&
+	key(
+		value_type const& value
+	) noexcept {
+		return value.first;
+	}
+
+	static value_type&
+	element(
+		slot_type& slot
+	) noexcept {
+		return slot.value;
+	}
+
+	static value_type const&
+	element(
+		slot_type const& slot
+	) noexcept {
+		return slot.value;
+	}
+
+	static mutable_value_type&
+	mutable_element(
+		slot_type& slot
+	) noexcept {
+		return slot.mutable_value;
+	}
+
+	template<
+		class... Args
+	>
+	static void
+	construct(
+		slot_type* const slot,
+		Args&&... args
+	) {
+		::new (static_cast<void*>(&slot->mutable_value)) mutable_value_type(std::forward<Args>(args)...);
+	}
+
+	static void
+	destroy(
+		slot_type& slot
+	) noexcept {
+		slot.mutable_value.~mutable_value_type();
+	}
+};
+
+template<
+	class K
+>
+struct flat_set_policy {
+	using key_type = K;
+	using value_type = K;
+	using slot_type = K;
+	static constexpr bool const constant_iterators = true;
+
+	static K const&
+	key(
+		value_type const& value
+	) noexcept {
+		return value;
+	}
+
+	static K&
+	element(
+		slot_type& slot
+	) noexcept {
+		return slot;
+	}
+
+	static K const&
+	element(
+		slot_type const& slot
+	) noexcept {
+		return slot;
+	}
+
+	static K&
+	mutable_element(
+		slot_type& slot
+	) noexcept {
+		return slot;
+	}
+
+	template<
+		class... Args
+	>
+	static void
+	construct(
+		slot_type* const slot,
+		Args&&... args
+	) {
+		::new (static_cast<void*>(slot)) K(std::forward<Args>(args)...);
+	}
+
+	static void
+	destroy(
+		slot_type& slot
+	) noexcept {
+		slot.~K();
+	}
+};
+
+template<
+	class Policy,
+	bool Const
+>
+class flat_iterator {
+	template<class, class, class>
+	friend class flat_table;
+	template<class, bool>
+	friend class flat_iterator;
+
+private:
+	using slot_type = typename Policy::slot_type;
+
+	flat_ctrl const* m_ctrl;
+	slot_type* m_slot;
+
+	flat_iterator(
+		flat_ctrl const* const ctrl,
+		slot_type* const slot
+	) noexcept
+		: m_ctrl(ctrl)
+		, m_slot(slot)
+	{}
+
+	void
+	skip_free() noexcept {
+		while (*m_ctrl < flat_sentinel) {
+			unsigned const n = flat_group{m_ctrl}.count_leading_empty_or_deleted();
+			m_ctrl += n;
+			m_slot += n;
+		}
+	}
+
+public:
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = typename Policy::value_type;
+	using difference_type = std::ptrdiff_t;
+	using reference = typename std::conditional<
+		Const || Policy::constant_iterators,
+		value_type const&,
+		value_type&
+	>::type;
+	using pointer = typename std::remove_reference<reference>::type*;
+
+	flat_iterator() noexcept
+		: m_ctrl(nullptr)
+		, m_slot(nullptr)
+	{}
+
+	// iterator -> const_iterator
+	template<
+		bool C,
+		class = typename std::enable_if<Const && !C>::type
+	>
+	flat_iterator(
+		flat_iterator<Policy, C> const& other
+	) noexcept
+		: m_ctrl(other.m_ctrl)
+		, m_slot(other.m_slot)
+	{}
+
+	reference
+	operator*() const noexcept {
+		return Policy::element(*m_slot);
+	}
+
+	pointer
+	operator->() const noexcept {
+		return &Policy::element(*m_slot);
+	}
+
+	flat_iterator&
+	operator++() noexcept {
+		++m_ctrl;
+		++m_slot;
+		skip_free();
+		return *this;
+	}
+
+	flat_iterator
+	operator++(int) noexcept {
+		flat_iterator const it = *this;
+		++*this;
+		return it;
+	}
+
+	friend bool
+	operator==(
+		flat_iterator const& x,
+		flat_iterator const& y
+	) noexcept {
+		return x.m_ctrl == y.m_ctrl;
+	}
+
+	friend bool
+	operator!=(
+		flat_iterator const& x,
+		flat_iterator const& y
+	) noexcept {
+		return x.m_ctrl != y.m_ctrl;
+	}
+};
+
+/** @endcond */ // INTERNAL
+
+/**
+	Flat (open-addressing) hash table.
+
+	The common base of @c am::hash::flat_map and
+	@c am::hash::flat_set.
+
+	@tparam Policy Slot policy.
+	@tparam Hash Hash functor.
+	@tparam Eq Key equality functor.
+*/
+template<
+	class Policy,
+	class Hash,
+	class Eq
+>
+class flat_table {
+public:
+	/** Key type. */
+	using key_type = typename Policy::key_type;
+	/** Value type. */
+	using value_type = typename Policy::value_type;
+	/** Size/length type. */
+	using size_type = std::size_t;
+	/** Difference type. */
+	using difference_type = std::ptrdiff_t;
+	/** Hash functor type. */
+	using hasher = Hash;
+	/** Key equality functor type. */
+	using key_equal = Eq;
+	/** Reference type. */
+	using reference = value_type&;
+	/** Const reference type. */
+	using const_reference = value_type const&;
+	/** Iterator type. */
+	using iterator = flat_iterator<Policy, false>;
+	/** Const iterator type. */
+	using const_iterator = flat_iterator<Policy, true>;
+
+protected:
+	/** @cond INTERNAL */
+	using slot_type = typename Policy::slot_type;
+
+	template<class K>
+	using key_arg = typename flat_key_arg<
+		flat_is_transparent<Hash>::value &&
+		flat_is_transparent<Eq>::value
+	>::template type<K, key_type>;
+
+	static constexpr std::size_t const alignment
+		= alignof(slot_type) > 16u ? alignof(slot_type) : 16u
+	;
+	/** @endcond */
+
+private:
+	flat_ctrl* m_ctrl;
+	slot_type* m_slots;
+	size_type m_capacity;
+	size_type m_size;
+	size_type m_growth_left;
+	Hash m_hash;
+	Eq m_eq;
+
+	// Capacities are (2^n - 1), and at least (width - 1) so that the
+	// cloned control bytes never wrap
+	static size_type
+	growth(
+		size_type const capacity
+	) noexcept {
+		return (flat_width == 8u && capacity == 7u)
+			? 6u
+			: capacity - capacity / 8u
+		;
+	}
+
+	static size_type
+	capacity_for(
+		size_type const count
+	) noexcept {
+		size_type capacity = flat_width - 1u;
+		while (growth(capacity) < count) {
+			capacity = capacity * 2u + 1u;
+		}
+		return capacity;
+	}
+
+	static size_type
+	slot_offset(
+		size_type const capacity
+	) noexcept {
+		return
+			(capacity + flat_width + alignof(slot_type) - 1u)
+			& ~(alignof(slot_type) - 1u)
+		;
+	}
+
+	static flat_ctrl
+	h2(
+		std::uint64_t const mixed
+	) noexcept {
+		return static_cast<flat_ctrl>(mixed & 0x7fu);
+	}
+
+	std::uint64_t
+	hash_key(
+		key_type const& key
+	) const {
+		return static_cast<std::uint64_t>(m_hash(key));
+	}
+
+	void
+	reset_empty() noexcept {
+		m_ctrl = flat_empty_group<>::value;
+		m_slots = nullptr;
+		m_capacity = 0u;
+		m_size = 0u;
+		m_growth_left = 0u;
+	}
+
+	void
+	set_ctrl(
+		size_type const i,
+		flat_ctrl const h
+	) noexcept {
+		m_ctrl[i] = h;
+		m_ctrl[((i - (flat_width - 1u)) & m_capacity) + (flat_width - 1u)] = h;
+	}
+
+	template<
+		class K
+	>
+	size_type
+	find_index(
+		K const& key,
+		std::uint64_t const hash
+	) const {
+		std::uint64_t const mixed = flat_mix(hash);
+		flat_ctrl const h = h2(mixed);
+		flat_probe p{mixed >> 7, m_capacity};
+		for (;;) {
+			flat_group const g{m_ctrl + p.offset};
+			for (auto mask = g.match(h); 0u != mask; mask &= mask - 1u) {
+				size_type const i = p.at(flat_ctz(mask) >> flat_group::shift);
+				if (m_eq(Policy::key(Policy::element(m_slots[i])), key)) {
+					return i;
+				}
+			}
+			if (0u != g.match_empty()) {
+				return m_capacity;
+			}
+			p.next();
+		}
+	}
+
+	size_type
+	find_first_non_full(
+		std::uint64_t const mixed
+	) const noexcept {
+		flat_probe p{mixed >> 7, m_capacity};
+		for (;;) {
+			auto const mask = flat_group{m_ctrl + p.offset}.match_empty_or_deleted();
+			if (0u != mask) {
+				return p.at(flat_ctz(mask) >> flat_group::shift);
+			}
+			p.next();
+		}
+	}
+
+	// Claim a slot for a key known to be absent; the slot is marked
+	// full but not constructed
+	size_type
+	prepare_insert(
+		std::uint64_t const hash
+	) {
+		std::uint64_t const mixed = flat_mix(hash);
+		size_type i = find_first_non_full(mixed);
+		if (0u == m_growth_left && flat_deleted != m_ctrl[i]) {
+			grow();
+			i = find_first_non_full(mixed);
+		}
+		m_growth_left -= (flat_empty == m_ctrl[i]) ? 1u : 0u;
+		set_ctrl(i, h2(mixed));
+		++m_size;
+		return i;
+	}
+
+	// Mark a slot free. It can become empty (rather than deleted)
+	// only if no probe can have passed over it, i.e., if it is in a
+	// run of fewer than width non-empty slots
+	void
+	erase_meta(
+		size_type const i
+	) noexcept {
+		--m_size;
+		size_type const before = (i - flat_width) & m_capacity;
+		auto const empty_after = flat_group{m_ctrl + i}.match_empty();
+		auto const empty_before = flat_group{m_ctrl + before}.match_empty();
+		bool const was_never_full
+			= 0u != empty_before && 0u != empty_after
+			&& flat_leading(empty_before) + flat_trailing(empty_after) < flat_width
+		;
+		set_ctrl(i, was_never_full ? flat_ctrl{flat_empty} : flat_ctrl{flat_deleted});
+		m_growth_left += was_never_full ? 1u : 0u;
+	}
+
+	template<
+		class... Args
+	>
+	void
+	construct_at(
+		size_type const i,
+		Args&&... args
+	) {
+		try {
+			Policy::construct(m_slots + i, std::forward<Args>(args)...);
+		} catch (...) {
+			erase_meta(i);
+			throw;
+		}
+	}
+
+	void
+	destroy_slots() noexcept {
+		if (!std::is_trivially_destructible<value_type>::value) {
+			for (size_type i = 0; i < m_capacity; ++i) {
+				if (0 <= m_ctrl[i]) {
+					Policy::destroy(m_slots[i]);
+				}
+			}
+		}
+	}
+
+	void
+	deallocate() noexcept {
+		if (0u != m_capacity) {
+			detail::aligned_deallocate(m_ctrl);
+		}
+	}
+
+	void
+	allocate(
+		size_type const capacity
+	) {
+		size_type const offset = slot_offset(capacity);
+		if (capacity > (~size_type(0) - offset) / sizeof(slot_type)) {
+			throw std::bad_alloc{};
+		}
+		void* const p = detail::aligned_allocate(
+			offset + capacity * sizeof(slot_type), alignment
+		);
+		m_ctrl = static_cast<flat_ctrl*>(p);
+		m_slots = reinterpret_cast<slot_type*>(static_cast<unsigned char*>(p) + offset);
+		m_capacity = capacity;
+		m_size = 0u;
+		m_growth_left = growth(capacity);
+		std::memset(m_ctrl, flat_empty, capacity + flat_width);
+		m_ctrl[capacity] = flat_sentinel;
+	}
+
+	// Moves (or, if moving can throw, copies) every value into a new
+	// allocation, so a throw leaves the table unchanged. Map keys are
+	// moved through the mutable view of the slot
+	void
+	resize(
+		size_type const capacity
+	) {
+		flat_table next(m_hash, m_eq);
+		next.allocate(capacity);
+		for (size_type i = 0; i < m_capacity; ++i) {
+			if (0 <= m_ctrl[i]) {
+				size_type const j = next.prepare_insert(hash_key(Policy::key(Policy::element(m_slots[i]))));
+				next.construct_at(j, std::move_if_noexcept(Policy::mutable_element(m_slots[i])));
+			}
+		}
+		swap(next);
+	}
+
+	// Grow, or, if most of the used slots are tombstones, rebuild at
+	// the same capacity
+	void
+	grow() {
+		if (0u == m_capacity) {
+			resize(flat_width - 1u);
+		} else if (m_capacity > flat_width && m_size * 32u <= m_capacity * 25u) {
+			resize(m_capacity);
+		} else {
+			resize(m_capacity * 2u + 1u);
+		}
+	}
+
+	iterator
+	iterator_at(
+		size_type const i
+	) noexcept {
+		return {m_ctrl + i, m_slots + i};
+	}
+
+	const_iterator
+	iterator_at(
+		size_type const i
+	) const noexcept {
+		return {m_ctrl + i, m_slots + i};
+	}
+
+protected:
+	/** @cond INTERNAL */
+	// Find key, or claim a slot for it. If the second value is true,
+	// the slot must be constructed with construct_at()
+	template<
+		class K
+	>
+	std::pair<size_type, bool>
+	find_or_prepare_insert(
+		K const& key
+	) {
+		std::uint64_t const hash = static_cast<std::uint64_t>(m_hash(key));
+		size_type const i = find_index(key, hash);
+		if (i != m_capacity) {
+			return {i, false};
+		}
+		return {prepare_insert(hash), true};
+	}
+
+	template<
+		class K,
+		class... Args
+	>
+	std::pair<iterator, bool>
+	emplace_key(
+		K const& key,
+		Args&&... args
+	) {
+		auto const res = find_or_prepare_insert(key);
+		if (res.second) {
+			construct_at(res.first, std::forward<Args>(args)...);
+		}
+		return {iterator_at(res.first), res.second};
+	}
+
+	value_type&
+	slot(
+		size_type const i
+	) noexcept {
+		return Policy::element(m_slots[i]);
+	}
+	/** @endcond */
+
+public:
+/** @name Special member functions */ /// @{
+	/** Destructor. */
+	~flat_table() noexcept {
+		destroy_slots();
+		deallocate();
+	}
+
+	/**
+		Constructor with functors.
+
+		@note This does not allocate.
+
+		@param hash Hash functor.
+		@param eq Key equality functor.
+	*/
+	explicit
+	flat_table(
+		Hash const& hash = Hash(),
+		Eq const& eq = Eq()
+	)
+		: m_hash(hash)
+		, m_eq(eq)
+	{
+		reset_empty();
+	}
+
+	/**
+		Constructor with capacity.
+
+		@param count Number of values to reserve space for.
+		@param hash Hash functor.
+		@param eq Key equality functor.
+	*/
+	explicit
+	flat_table(
+		size_type const count,
+		Hash const& hash = Hash(),
+		Eq const& eq = Eq()
+	)
+		: flat_table(hash, eq)
+	{
+		reserve(count);
+	}
+
+	/**
+		Constructor with initializer list.
+
+		@param init Values.
+		@param hash Hash functor.
+		@param eq Key equality functor.
+	*/
+	flat_table(
+		std::initializer_list<value_type> const init,
+		Hash const& hash = Hash(),
+		Eq const& eq = Eq()
+	)
+		: flat_table(init.size(), hash, eq)
+	{
+		insert(init.begin(), init.end());
+	}
+
+	/** Copy constructor. */
+	flat_table(
+		flat_table const& other
+	)
+		: flat_table(other.m_hash, other.m_eq)
+	{
+		if (0u != other.m_size) {
+			allocate(capacity_for(other.m_size));
+			for (size_type i = 0; i < other.m_capacity; ++i) {
+				if (0 <= other.m_ctrl[i]) {
+					value_type const& value = Policy::element(other.m_slots[i]);
+					construct_at(prepare_insert(hash_key(Policy::key(value))), value);
+				}
+			}
+		}
+	}
+
+	/** Move constructor. */
+	flat_table(
+		flat_table&& other
+	) noexcept
+		: m_ctrl(other.m_ctrl)
+		, m_slots(other.m_slots)
+		, m_capacity(other.m_capacity)
+		, m_size(other.m_size)
+		, m_growth_left(other.m_growth_left)
+		, m_hash(other.m_hash)
+		, m_eq(other.m_eq)
+	{
+		other.reset_empty();
+	}
+
+	/** Copy assignment operator. */
+	flat_table&
+	operator=(
+		flat_table const& other
+	) {
+		if (this != &other) {
+			flat_table copy(other);
+			swap(copy);
+		}
+		return *this;
+	}
+
+	/** Move assignment operator. */
+	flat_table&
+	operator=(
+		flat_table&& other
+	) noexcept {
+		if (this != &other) {
+			flat_table moved(std::move(other));
+			swap(moved);
+		}
+		return *this;
+	}
+/// @}
+
+/** @name Properties */ /// @{
+	/**
+		Get the number of values.
+	*/
+	size_type
+	size() const noexcept {
+		return m_size;
+	}
+
+	/**
+		Check if the table is empty.
+	*/
+	bool
+	empty() const noexcept {
+		return 0u == m_size;
+	}
+
+	/**
+		Get the number of slots.
+	*/
+	size_type
+	capacity() const noexcept {
+		return m_capacity;
+	}
+
+	/**
+		Get the ratio of values to slots.
+	*/
+	float
+	load_factor() const noexcept {
+		return (0u != m_capacity)
+			? static_cast<float>(m_size) / static_cast<float>(m_capacity)
+			: 0.0f
+		;
+	}
+
+	/**
+		Get the hash functor.
+	*/
+	hasher
+	hash_function() const {
+		return m_hash;
+	}
+
+	/**
+		Get the key equality functor.
+	*/
+	key_equal
+	key_eq() const {
+		return m_eq;
+	}
+/// @}
+
+/** @name Iteration */ /// @{
+	/**
+		Get an iterator to the first value.
+	*/
+	iterator
+	begin() noexcept {
+		iterator it = iterator_at(0u);
+		it.skip_free();
+		return it;
+	}
+
+	/**
+		Get an iterator past the last value.
+	*/
+	iterator
+	end() noexcept {
+		return iterator_at(m_capacity);
+	}
+
+	/** @copydoc begin() */
+	const_iterator
+	begin() const noexcept {
+		const_iterator it = iterator_at(0u);
+		it.skip_free();
+		return it;
+	}
+
+	/** @copydoc end() */
+	const_iterator
+	end() const noexcept {
+		return iterator_at(m_capacity);
+	}
+
+	/** @copydoc begin() */
+	const_iterator
+	cbegin() const noexcept {
+		return begin();
+	}
+
+	/** @copydoc end() */
+	const_iterator
+	cend() const noexcept {
+		return end();
+	}
+/// @}
+
+/** @name Lookup */ /// @{
+	/**
+		Find a value by key.
+
+		@note With a transparent hash and key equality functor (like
+		@c am::hash::hasher and @c am::hash::equal_to), @a key can be
+		any type comparable to the key type that hashes the same.
+
+		@returns An iterator to the value, or end() if there is none.
+		@param key Key.
+	*/
+	template<
+		class K = key_type
+	>
+	iterator
+	find(
+		key_arg<K> const& key
+	) {
+		return iterator_at(find_index(key, static_cast<std::uint64_t>(m_hash(key))));
+	}
+
+	/**
+		Find a value by key with a precomputed hash.
+
+		@note The hash must be what the hash functor gives for @a key.
+		It can come from an earlier call, or from a hash combiner fed
+		the same bytes (for stateful implementations, a
+		@c generic_combiner gives the same hash as hashing the bytes
+		all at once).
+
+		@returns An iterator to the value, or end() if there is none.
+		@param key Key.
+		@param hash Hash of @a key.
+	*/
+	template<
+		class K = key_type
+	>
+	iterator
+	find(
+		key_arg<K> const& key,
+		std::uint64_t const hash
+	) {
+		return iterator_at(find_index(key, hash));
+	}
+
+	/** @copydoc find(key_arg<K> const&) */
+	template<
+		class K = key_type
+	>
+	const_iterator
+	find(
+		key_arg<K> const& key
+	) const {
+		return iterator_at(find_index(key, static_cast<std::uint64_t>(m_hash(key))));
+	}
+
+	/** @copydoc find(key_arg<K> const&, std::uint64_t const) */
+	template<
+		class K = key_type
+	>
+	const_iterator
+	find(
+		key_arg<K> const& key,
+		std::uint64_t const hash
+	) const {
+		return iterator_at(find_index(key, hash));
+	}
+
+	/**
+		Check if a key is in the table.
+
+		@param key Key.
+	*/
+	template<
+		class K = key_type
+	>
+	bool
+	contains(
+		key_arg<K> const& key
+	) const {
+		return m_capacity != find_index(key, static_cast<std::uint64_t>(m_hash(key)));
+	}
+
+	/**
+		Check if a key is in the table (precomputed hash).
+
+		@param key Key.
+		@param hash Hash of @a key.
+	*/
+	template<
+		class K = key_type
+	>
+	bool
+	contains(
+		key_arg<K> const& key,
+		std::uint64_t const hash
+	) const {
+		return m_capacity != find_index(key, hash);
+	}
+
+	/**
+		Count values with a key.
+
+		@returns 1 if @a key is in the table, 0 otherwise.
+		@param key Key.
+	*/
+	template<
+		class K = key_type
+	>
+	size_type
+	count(
+		key_arg<K> const& key
+	) const {
+		return contains(key) ? 1u : 0u;
+	}
+/// @}
+
+/** @name Modifiers */ /// @{
+	/**
+		Insert a value.
+
+		@note Invalidates iterators if the table grows.
+
+		@returns An iterator to the value with the key of @a value and
+		whether @a value was inserted.
+		@param value Value.
+	*/
+	std::pair<iterator, bool>
+	insert(
+		value_type const& value
+	) {
+		return emplace_key(Policy::key(value), value);
+	}
+
+	/** @copydoc insert(value_type const&) */
+	std::pair<iterator, bool>
+	insert(
+		value_type&& value
+	) {
+		return emplace_key(Policy::key(value), std::move(value));
+	}
+
+	/**
+		Insert a range of values.
+
+		@tparam InputIt Input iterator; inferred from @a first.
+		@param first First value.
+		@param last End of values.
+	*/
+	template<
+		class InputIt
+	>
+	void
+	insert(
+		InputIt first,
+		InputIt const last
+	) {
+		for (; first != last; ++first) {
+			insert(*first);
+		}
+	}
+
+	/**
+		Construct and insert a value.
+
+		@note The value is constructed before the lookup (as with the
+		standard unordered containers); see @c flat_map::try_emplace()
+		to avoid that.
+
+		@returns An iterator to the value with the key of the new value
+		and whether it was inserted.
+		@param args Constructor arguments.
+	*/
+	template<
+		class... Args
+	>
+	std::pair<iterator, bool>
+	emplace(
+		Args&&... args
+	) {
+		value_type value(std::forward<Args>(args)...);
+		return insert(std::move(value));
+	}
+
+	/**
+		Remove a value.
+
+		@returns An iterator to the next value.
+		@param pos Iterator to the value.
+	*/
+	iterator
+	erase(
+		const_iterator const pos
+	) noexcept {
+		size_type const i = static_cast<size_type>(pos.m_ctrl - m_ctrl);
+		Policy::destroy(m_slots[i]);
+		erase_meta(i);
+		iterator it = iterator_at(i + 1u);
+		it.skip_free();
+		return it;
+	}
+
+	/** @copydoc erase(const_iterator const) */
+	iterator
+	erase(
+		iterator const pos
+	) noexcept {
+		return erase(const_iterator{pos});
+	}
+
+	/**
+		Remove a value by key.
+
+		@returns The number of values removed (0 or 1).
+		@param key Key.
+	*/
+	template<
+		class K = key_type
+	>
+	size_type
+	erase(
+		key_arg<K> const& key
+	) {
+		size_type const i = find_index(key, static_cast<std::uint64_t>(m_hash(key)));
+		if (i == m_capacity) {
+			return 0u;
+		}
+		Policy::destroy(m_slots[i]);
+		erase_meta(i);
+		return 1u;
+	}
+
+	/**
+		Remove all values.
+
+		@note This keeps the allocation.
+	*/
+	void
+	clear() noexcept {
+		destroy_slots();
+		if (0u != m_capacity) {
+			std::memset(m_ctrl, flat_empty, m_capacity + flat_width);
+			m_ctrl[m_capacity] = flat_sentinel;
+			m_size = 0u;
+			m_growth_left = growth(m_capacity);
+		}
+	}
+
+	/**
+		Reserve space.
+
+		@note Invalidates iterators if the table grows.
+
+		@param count Number of values to make room for without
+		growing.
+	*/
+	void
+	reserve(
+		size_type const count
+	) {
+		if (count > m_size + m_growth_left) {
+			resize(capacity_for(count));
+		}
+	}
+
+	/**
+		Swap with another table.
+
+		@param other Table.
+	*/
+	void
+	swap(
+		flat_table& other
+	) noexcept {
+		using std::swap;
+		swap(m_ctrl, other.m_ctrl);
+		swap(m_slots, other.m_slots);
+		swap(m_capacity, other.m_capacity);
+		swap(m_size, other.m_size);
+		swap(m_growth_left, other.m_growth_left);
+		swap(m_hash, other.m_hash);
+		swap(m_eq, other.m_eq);
+	}
+/// @}
+};
+
+} // namespace hash
+} // namespace detail
+} // namespace am
@@ -13,6 +13,8 @@ and no copyright is claimed on them.
 #include "../../config.hpp"
 #include "../../hash/common.hpp"
 
+#include <cstdint>
+
 namespace am {
 namespace detail {
 namespace hash {
@@ -409,6 +411,19 @@ struct ce_impl final {
 	}
 };
 
+// MurmurHash3 x64 finalizer (also a good 64-bit mixer by itself)
+inline std::uint64_t
+fmix64(
+	std::uint64_t h
+) noexcept {
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return h;
+}
+
 /** @endcond */ // INTERNAL
 
 } // namespace hash
@@ -0,0 +1,392 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief SipHash (implementation).
+Although the AM implementations are under the MIT license,
+SipHash itself is by Jean-Philippe Aumasson and Daniel J. Bernstein
+and is in the public domain (CC0).
+*/
+
+#pragma once
+
+#include "../../config.hpp"
+#include "../../hash/common.hpp"
+#include "./common_impl.hpp"
+
+#include <cstdint>
+
+namespace am {
+namespace detail {
+namespace hash {
+
+/** @cond INTERNAL */
+
+struct siphash_key {
+	std::uint64_t k0;
+	std::uint64_t k1;
+};
+
+struct siphash_v {
+	std::uint64_t v0;
+	std::uint64_t v1;
+	std::uint64_t v2;
+	std::uint64_t v3;
+};
+
+struct siphash_state {
+	siphash_v v;
+	std::uint64_t tail;
+	unsigned size;
+};
+
+inline constexpr std::uint64_t
+siphash_rotl(
+	std::uint64_t const x,
+	unsigned const r
+) noexcept {
+	return (x << r) | (x >> (64u - r));
+}
+
+inline siphash_v
+siphash_init(
+	siphash_key const& key
+) noexcept {
+	return {
+		key.k0 ^ 0x736f6d6570736575ULL,
+		key.k1 ^ 0x646f72616e646f6dULL,
+		key.k0 ^ 0x6c7967656e657261ULL,
+		key.k1 ^ 0x7465646279746573ULL
+	};
+}
+
+template<
+	unsigned Rounds
+>
+inline void
+siphash_rounds(
+	siphash_v& s
+) noexcept {
+	for (unsigned i = 0; i < Rounds; ++i) {
+		s.v0 += s.v1; s.v1 = siphash_rotl(s.v1, 13); s.v1 ^= s.v0;
+		s.v0 = siphash_rotl(s.v0, 32);
+		s.v2 += s.v3; s.v3 = siphash_rotl(s.v3, 16); s.v3 ^= s.v2;
+		s.v0 += s.v3; s.v3 = siphash_rotl(s.v3, 21); s.v3 ^= s.v0;
+		s.v2 += s.v1; s.v1 = siphash_rotl(s.v1, 17); s.v1 ^= s.v2;
+		s.v2 = siphash_rotl(s.v2, 32);
+	}
+}
+
+template<
+	unsigned C
+>
+inline void
+siphash_compress(
+	siphash_v& s,
+	std::uint64_t const m
+) noexcept {
+	s.v3 ^= m;
+	siphash_rounds<C>(s);
+	s.v0 ^= m;
+}
+
+// Last word: the trailing (size % 8) bytes, with the low byte of the
+// size in the top byte. Short inputs are read with (possibly
+// overlapping) whole loads rather than byte by byte.
+inline std::uint64_t
+siphash_last_word(
+	uint8_t const* const data,
+	unsigned const size
+) noexcept {
+	unsigned const rem = size & 7u;
+	std::uint64_t b = static_cast<std::uint64_t>(size) << 56;
+	if (size >= 8u) {
+		if (rem != 0u) {
+			b |= hash_read64(data + size - 8u) >> (64u - 8u * rem);
+		}
+	} else if (rem >= 4u) {
+		b |= hash_read32(data);
+		b |= static_cast<std::uint64_t>(hash_read32(data + rem - 4u)) << (8u * (rem - 4u));
+	} else if (rem != 0u) {
+		b |= static_cast<std::uint64_t>(data[0]);
+		b |= static_cast<std::uint64_t>(data[rem >> 1]) << (8u * (rem >> 1));
+		b |= static_cast<std::uint64_t>(data[rem - 1u]) << (8u * (rem - 1u));
+	}
+	return b;
+}
+
+template<
+	unsigned C,
+	unsigned D
+>
+inline std::uint64_t
+siphash_finish(
+	siphash_v s,
+	std::uint64_t const b
+) noexcept {
+	siphash_compress<C>(s, b);
+	s.v2 ^= 0xffu;
+	siphash_rounds<D>(s);
+	return s.v0 ^ s.v1 ^ s.v2 ^ s.v3;
+}
+
+// constexpr
+template<
+	unsigned C,
+	unsigned D
+>
+struct siphash_ce_impl final {
+	static constexpr siphash_v
+	init(
+		siphash_key const& key
+	) noexcept {
+		return {
+			key.k0 ^ 0x736f6d6570736575ULL,
+			key.k1 ^ 0x646f72616e646f6dULL,
+			key.k0 ^ 0x6c7967656e657261ULL,
+			key.k1 ^ 0x7465646279746573ULL
+		};
+	}
+
+	// First and second halves of a round, from the half's sums
+	static constexpr siphash_v
+	half1(
+		std::uint64_t const a0,
+		std::uint64_t const v1,
+		std::uint64_t const a2,
+		std::uint64_t const v3
+	) noexcept {
+		return {
+			siphash_rotl(a0, 32),
+			siphash_rotl(v1, 13) ^ a0,
+			a2,
+			siphash_rotl(v3, 16) ^ a2
+		};
+	}
+
+	static constexpr siphash_v
+	half2(
+		std::uint64_t const a0,
+		std::uint64_t const v1,
+		std::uint64_t const a2,
+		std::uint64_t const v3
+	) noexcept {
+		return {
+			a0,
+			siphash_rotl(v1, 17) ^ a2,
+			siphash_rotl(a2, 32),
+			siphash_rotl(v3, 21) ^ a0
+		};
+	}
+
+	static constexpr siphash_v
+	round2(
+		siphash_v const& s
+	) noexcept {
+		return half2(s.v0 + s.v3, s.v1, s.v2 + s.v1, s.v3);
+	}
+
+	static constexpr siphash_v
+	rounds(
+		siphash_v const& s,
+		unsigned const n
+	) noexcept {
+		return (0u == n)
+			? s
+			: rounds(round2(half1(s.v0 + s.v1, s.v1, s.v2 + s.v3, s.v3)), n - 1u)
+		;
+	}
+
+	static constexpr siphash_v
+	xor_v0(
+		siphash_v const& s,
+		std::uint64_t const m
+	) noexcept {
+		return {s.v0 ^ m, s.v1, s.v2, s.v3};
+	}
+
+	static constexpr siphash_v
+	compress(
+		siphash_v const& s,
+		std::uint64_t const m
+	) noexcept {
+		return xor_v0(rounds({s.v0, s.v1, s.v2, s.v3 ^ m}, C), m);
+	}
+
+	static constexpr std::uint64_t
+	byte(
+		char const* const data,
+		unsigned const i
+	) noexcept {
+		return static_cast<std::uint64_t>(static_cast<uint8_t>(data[i]));
+	}
+
+	// Little-endian bytes [i, i + n) of data
+	static constexpr std::uint64_t
+	word(
+		char const* const data,
+		unsigned const i,
+		unsigned const n
+	) noexcept {
+		return (0u == n)
+			? 0u
+			: byte(data, i + n - 1u) << (8u * (n - 1u)) | word(data, i, n - 1u)
+		;
+	}
+
+	static constexpr siphash_v
+	body(
+		siphash_v const& s,
+		char const* const data,
+		unsigned const i,
+		unsigned const end
+	) noexcept {
+		return (i < end)
+			? body(compress(s, word(data, i, 8u)), data, i + 8u, end)
+			: s
+		;
+	}
+
+	static constexpr std::uint64_t
+	fold(
+		siphash_v const& s
+	) noexcept {
+		return s.v0 ^ s.v1 ^ s.v2 ^ s.v3;
+	}
+
+	static constexpr std::uint64_t
+	finish(
+		siphash_v const& s,
+		std::uint64_t const b
+	) noexcept {
+		return fold(rounds(xor_v2(compress(s, b)), D));
+	}
+
+	static constexpr siphash_v
+	xor_v2(
+		siphash_v const& s
+	) noexcept {
+		return {s.v0, s.v1, s.v2 ^ 0xffu, s.v3};
+	}
+
+	static constexpr std::uint64_t
+	calc(
+		char const* const data,
+		unsigned const size,
+		siphash_key const& key
+	) noexcept {
+		return finish(
+			body(init(key), data, 0u, size & ~7u),
+			static_cast<std::uint64_t>(size) << 56 |
+			word(data, size & ~7u, size & 7u)
+		);
+	}
+}; // struct siphash_ce_impl
+
+template<
+	unsigned C,
+	unsigned D
+>
+struct siphash_impl {
+	static constexpr auto const hash_length = ::am::hash::HashLength::HL64;
+	using hash_type = ::am::hash::common_hash_type<hash_length>;
+	using seed_type = siphash_key;
+	using state_type = siphash_state;
+
+	static hash_type
+	calc(
+		uint8_t const* const data,
+		unsigned const size,
+		seed_type const& key
+	) noexcept {
+		siphash_v s = siphash_init(key);
+		uint8_t const* p = data;
+		for (uint8_t const* const end = data + (size & ~7u); p != end; p += 8) {
+			siphash_compress<C>(s, hash_read64(p));
+		}
+		return siphash_finish<C, D>(s, siphash_last_word(data, size));
+	}
+
+	static void
+	state_init(
+		state_type& s,
+		seed_type const& key
+	) noexcept {
+		s.v = siphash_init(key);
+		s.tail = 0u;
+		s.size = 0u;
+	}
+
+	static void
+	state_add(
+		state_type& s,
+		uint8_t const* data,
+		unsigned size
+	) noexcept {
+		unsigned fill = s.size & 7u;
+		s.size += size;
+		if (fill != 0u) {
+			for (; fill < 8u && size > 0u; ++fill, ++data, --size) {
+				s.tail |= static_cast<std::uint64_t>(*data) << (8u * fill);
+			}
+			if (fill < 8u) {
+				return;
+			}
+			siphash_compress<C>(s.v, s.tail);
+			s.tail = 0u;
+		}
+		for (; size >= 8u; size -= 8u, data += 8) {
+			siphash_compress<C>(s.v, hash_read64(data));
+		}
+		for (unsigned i = 0; i < size; ++i) {
+			s.tail |= static_cast<std::uint64_t>(data[i]) << (8u * i);
+		}
+	}
+
+	static hash_type
+	state_value(
+		state_type const& s
+	) noexcept {
+		return siphash_finish<C, D>(
+			s.v, s.tail | static_cast<std::uint64_t>(s.size) << 56
+		);
+	}
+
+	static unsigned
+	state_size(
+		state_type const& s
+	) noexcept {
+		return s.size;
+	}
+
+	static constexpr hash_type
+	calc_ce_seq(
+		char const* const data,
+		unsigned const size,
+		seed_type const& key
+	) noexcept {
+		return siphash_ce_impl<C, D>::calc(data, size, key);
+	}
+};
+
+/** @endcond */ // INTERNAL
+
+} // namespace hash
+} // namespace detail
+
+/** @cond INTERNAL */
+namespace hash {
+
+template<unsigned C, unsigned D>
+struct impl_is_stateful<detail::hash::siphash_impl<C, D>> {
+	static constexpr bool const value = true;
+};
+template<unsigned C, unsigned D>
+struct impl_is_seeded<detail::hash::siphash_impl<C, D>> {
+	static constexpr bool const value = true;
+};
+
+} // namespace hash
+/** @endcond */ // INTERNAL
+
+} // namespace am
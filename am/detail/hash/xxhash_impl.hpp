@@ -0,0 +1,1127 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief xxHash (implementation).
+Although the AM implementations are under the MIT license,
+the xxHash algorithms themselves are Copyright (C) Yann Collet
+under the BSD 2-clause license.
+*/
+
+#pragma once
+
+#include "../../config.hpp"
+#include "../../hash/common.hpp"
+#include "./common_impl.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(AM_DETAIL_AVX2)
+	#include <immintrin.h>
+#elif defined(AM_DETAIL_SSE2)
+	#include <emmintrin.h>
+#endif
+
+namespace am {
+namespace detail {
+namespace hash {
+
+/** @cond INTERNAL */
+
+#define AM_HASH_XXH64_RESTRICT_LENGTH(hash_length)		\
+	AM_STATIC_ASSERT(									\
+		::am::hash::HashLength::HL64 == hash_length,	\
+		"XXH64 only has a 64-bit implementation"		\
+	)
+
+#define AM_HASH_XXH3_RESTRICT_LENGTH(hash_length)		\
+	AM_STATIC_ASSERT(									\
+		::am::hash::HashLength::HL64 == hash_length ||	\
+		::am::hash::HashLength::HL128 == hash_length,	\
+		"XXH3 only has 64-bit and 128-bit implementations"	\
+	)
+
+template<
+	::am::hash::HashLength L
+>
+using xxh_hash_type = ::am::hash::common_hash_type<L>;
+
+constexpr std::uint32_t const xxh_prime32_1 = 0x9e3779b1u;
+constexpr std::uint32_t const xxh_prime32_2 = 0x85ebca77u;
+constexpr std::uint32_t const xxh_prime32_3 = 0xc2b2ae3du;
+
+constexpr std::uint64_t const xxh_prime64_1 = 0x9e3779b185ebca87ULL;
+constexpr std::uint64_t const xxh_prime64_2 = 0xc2b2ae3d27d4eb4fULL;
+constexpr std::uint64_t const xxh_prime64_3 = 0x165667b19e3779f9ULL;
+constexpr std::uint64_t const xxh_prime64_4 = 0x85ebca77c2b2ae63ULL;
+constexpr std::uint64_t const xxh_prime64_5 = 0x27d4eb2f165667c5ULL;
+
+constexpr std::uint64_t const xxh_prime_mx1 = 0x165667919e3779f9ULL;
+constexpr std::uint64_t const xxh_prime_mx2 = 0x9fb21c651e98df25ULL;
+
+inline std::uint32_t
+xxh_rotl32(
+	std::uint32_t const x,
+	unsigned const r
+) noexcept {
+	return (x << r) | (x >> (32u - r));
+}
+
+inline std::uint64_t
+xxh_rotl64(
+	std::uint64_t const x,
+	unsigned const r
+) noexcept {
+	return (x << r) | (x >> (64u - r));
+}
+
+inline std::uint64_t
+xxh_mul128_fold64(
+	std::uint64_t const a,
+	std::uint64_t const b
+) noexcept {
+	std::uint64_t lo, hi;
+	hash_mul128(a, b, lo, hi);
+	return lo ^ hi;
+}
+
+// XXH64
+
+inline std::uint64_t
+xxh64_round(
+	std::uint64_t acc,
+	std::uint64_t const input
+) noexcept {
+	acc += input * xxh_prime64_2;
+	acc = xxh_rotl64(acc, 31);
+	return acc * xxh_prime64_1;
+}
+
+inline std::uint64_t
+xxh64_merge_round(
+	std::uint64_t acc,
+	std::uint64_t const v
+) noexcept {
+	acc ^= xxh64_round(0, v);
+	return acc * xxh_prime64_1 + xxh_prime64_4;
+}
+
+inline std::uint64_t
+xxh64_avalanche(
+	std::uint64_t h
+) noexcept {
+	h ^= h >> 33;
+	h *= xxh_prime64_2;
+	h ^= h >> 29;
+	h *= xxh_prime64_3;
+	h ^= h >> 32;
+	return h;
+}
+
+inline void
+xxh64_init(
+	std::uint64_t (&v)[4],
+	std::uint64_t const seed
+) noexcept {
+	v[0] = seed + xxh_prime64_1 + xxh_prime64_2;
+	v[1] = seed + xxh_prime64_2;
+	v[2] = seed;
+	v[3] = seed - xxh_prime64_1;
+}
+
+// Consume 32-byte stripes; returns the end of the last stripe
+inline uint8_t const*
+xxh64_stripes(
+	std::uint64_t (&v)[4],
+	uint8_t const* p,
+	std::size_t const count
+) noexcept {
+	std::uint64_t v0 = v[0], v1 = v[1], v2 = v[2], v3 = v[3];
+	for (std::size_t i = 0; i < count; ++i, p += 32) {
+		v0 = xxh64_round(v0, hash_read64(p +  0));
+		v1 = xxh64_round(v1, hash_read64(p +  8));
+		v2 = xxh64_round(v2, hash_read64(p + 16));
+		v3 = xxh64_round(v3, hash_read64(p + 24));
+	}
+	v[0] = v0; v[1] = v1; v[2] = v2; v[3] = v3;
+	return p;
+}
+
+inline std::uint64_t
+xxh64_converge(
+	std::uint64_t const (&v)[4]
+) noexcept {
+	std::uint64_t h
+		= xxh_rotl64(v[0], 1) + xxh_rotl64(v[1], 7)
+		+ xxh_rotl64(v[2], 12) + xxh_rotl64(v[3], 18)
+	;
+	h = xxh64_merge_round(h, v[0]);
+	h = xxh64_merge_round(h, v[1]);
+	h = xxh64_merge_round(h, v[2]);
+	h = xxh64_merge_round(h, v[3]);
+	return h;
+}
+
+// Mix in the last (< 32) bytes
+inline std::uint64_t
+xxh64_finalize(
+	std::uint64_t h,
+	uint8_t const* p,
+	std::size_t size
+) noexcept {
+	for (; size >= 8u; size -= 8u, p += 8) {
+		h ^= xxh64_round(0, hash_read64(p));
+		h = xxh_rotl64(h, 27) * xxh_prime64_1 + xxh_prime64_4;
+	}
+	if (size >= 4u) {
+		h ^= static_cast<std::uint64_t>(hash_read32(p)) * xxh_prime64_1;
+		h = xxh_rotl64(h, 23) * xxh_prime64_2 + xxh_prime64_3;
+		size -= 4u;
+		p += 4;
+	}
+	for (; size > 0u; --size, ++p) {
+		h ^= *p * xxh_prime64_5;
+		h = xxh_rotl64(h, 11) * xxh_prime64_1;
+	}
+	return xxh64_avalanche(h);
+}
+
+struct xxh64_state {
+	std::uint64_t v[4];
+	uint8_t buffer[32];
+	std::uint64_t size;
+	unsigned buffered;
+};
+
+template<
+	::am::hash::HashLength L
+>
+struct xxh64_impl {
+	AM_HASH_XXH64_RESTRICT_LENGTH(L);
+
+	static constexpr auto const hash_length = L;
+	using hash_type = xxh_hash_type<L>;
+	using seed_type = hash_type;
+	using state_type = xxh64_state;
+
+	static hash_type
+	calc(
+		uint8_t const* const data,
+		unsigned const size,
+		seed_type const seed
+	) noexcept {
+		std::uint64_t h;
+		uint8_t const* p = data;
+		if (size >= 32u) {
+			std::uint64_t v[4];
+			xxh64_init(v, seed);
+			p = xxh64_stripes(v, p, size / 32u);
+			h = xxh64_converge(v);
+		} else {
+			h = seed + xxh_prime64_5;
+		}
+		h += size;
+		return xxh64_finalize(h, p, size & 31u);
+	}
+
+	static void
+	state_init(
+		state_type& s,
+		seed_type const seed
+	) noexcept {
+		xxh64_init(s.v, seed);
+		s.size = 0u;
+		s.buffered = 0u;
+	}
+
+	static void
+	state_add(
+		state_type& s,
+		uint8_t const* data,
+		unsigned size
+	) noexcept {
+		s.size += size;
+		if (s.buffered + size < 32u) {
+			std::memcpy(s.buffer + s.buffered, data, size);
+			s.buffered += size;
+			return;
+		}
+		if (s.buffered != 0u) {
+			unsigned const fill = 32u - s.buffered;
+			std::memcpy(s.buffer + s.buffered, data, fill);
+			xxh64_stripes(s.v, s.buffer, 1u);
+			data += fill;
+			size -= fill;
+		}
+		data = xxh64_stripes(s.v, data, size / 32u);
+		s.buffered = size & 31u;
+		std::memcpy(s.buffer, data, s.buffered);
+	}
+
+	static hash_type
+	state_value(
+		state_type const& s
+	) noexcept {
+		std::uint64_t h
+			= s.size >= 32u
+			? xxh64_converge(s.v)
+			: s.v[2] + xxh_prime64_5
+		;
+		h += s.size;
+		return xxh64_finalize(h, s.buffer, s.buffered);
+	}
+
+	static unsigned
+	state_size(
+		state_type const& s
+	) noexcept {
+		return static_cast<unsigned>(s.size);
+	}
+};
+
+// XXH3
+
+enum : unsigned {
+	xxh3_secret_size = 192u,
+	xxh3_secret_size_min = 136u,
+	xxh3_stripe_size = 64u,
+	xxh3_secret_rate = 8u,
+	xxh3_block_stripes
+		= (xxh3_secret_size - xxh3_stripe_size) / xxh3_secret_rate,
+	xxh3_block_size = xxh3_stripe_size * xxh3_block_stripes,
+	xxh3_midsize_max = 240u,
+	xxh3_buffer_size = 256u,
+};
+
+// Default secret (from FARSH)
+alignas(64) constexpr uint8_t const xxh3_secret[xxh3_secret_size]{
+	0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+	0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+	0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+	0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+	0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+	0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+	0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+	0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+	0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+	0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+	0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+	0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+inline std::uint64_t
+xxh3_avalanche(
+	std::uint64_t h
+) noexcept {
+	h ^= h >> 37;
+	h *= xxh_prime_mx1;
+	h ^= h >> 32;
+	return h;
+}
+
+inline std::uint64_t
+xxh3_rrmxmx(
+	std::uint64_t h,
+	std::uint64_t const size
+) noexcept {
+	h ^= xxh_rotl64(h, 49) ^ xxh_rotl64(h, 24);
+	h *= xxh_prime_mx2;
+	h ^= (h >> 35) + size;
+	h *= xxh_prime_mx2;
+	return h ^ (h >> 28);
+}
+
+inline std::uint64_t
+xxh3_mix16(
+	uint8_t const* const p,
+	uint8_t const* const secret,
+	std::uint64_t const seed
+) noexcept {
+	return xxh_mul128_fold64(
+		hash_read64(p + 0) ^ (hash_read64(secret + 0) + seed),
+		hash_read64(p + 8) ^ (hash_read64(secret + 8) - seed)
+	);
+}
+
+// Secret for the long path: the default secret with seed added to
+// even words and subtracted from odd words
+inline void
+xxh3_derive_secret(
+	uint8_t (&secret)[xxh3_secret_size],
+	std::uint64_t const seed
+) noexcept {
+	for (unsigned i = 0; i < xxh3_secret_size; i += 16u) {
+		std::uint64_t const lo = hash_read64(xxh3_secret + i) + seed;
+		std::uint64_t const hi = hash_read64(xxh3_secret + i + 8u) - seed;
+		std::memcpy(secret + i, &lo, 8u);
+		std::memcpy(secret + i + 8u, &hi, 8u);
+	}
+}
+
+// Long-input accumulators. acc is 8 64-bit lanes; each stripe is 64
+// bytes of input against 64 bytes of secret, with the secret advancing
+// 8 bytes per stripe.
+#if defined(AM_DETAIL_AVX2)
+
+inline __m256i
+xxh3_round(
+	__m256i const acc,
+	uint8_t const* const p,
+	uint8_t const* const secret
+) noexcept {
+	__m256i const data = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p));
+	__m256i const key = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(secret));
+	__m256i const data_key = _mm256_xor_si256(data, key);
+	__m256i const data_key_lo = _mm256_srli_epi64(data_key, 32);
+	__m256i const product = _mm256_mul_epu32(data_key, data_key_lo);
+	__m256i const data_swap = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+	return _mm256_add_epi64(product, _mm256_add_epi64(acc, data_swap));
+}
+
+inline __m256i
+xxh3_scramble_round(
+	__m256i acc,
+	uint8_t const* const secret
+) noexcept {
+	__m256i const prime = _mm256_set1_epi32(static_cast<int>(xxh_prime32_1));
+	__m256i const key = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(secret));
+	acc = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 47));
+	acc = _mm256_xor_si256(acc, key);
+	__m256i const prod_lo = _mm256_mul_epu32(acc, prime);
+	__m256i const prod_hi = _mm256_mul_epu32(_mm256_srli_epi64(acc, 32), prime);
+	return _mm256_add_epi64(prod_lo, _mm256_slli_epi64(prod_hi, 32));
+}
+
+inline void
+xxh3_accumulate(
+	std::uint64_t (&acc)[8],
+	uint8_t const* p,
+	uint8_t const* secret,
+	std::size_t const stripes
+) noexcept {
+	__m256i a0 = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(acc + 0));
+	__m256i a1 = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(acc + 4));
+	for (std::size_t n = 0; n < stripes; ++n) {
+		a0 = xxh3_round(a0, p +  0, secret +  0);
+		a1 = xxh3_round(a1, p + 32, secret + 32);
+		p += xxh3_stripe_size;
+		secret += xxh3_secret_rate;
+	}
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + 0), a0);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + 4), a1);
+}
+
+inline void
+xxh3_scramble(
+	std::uint64_t (&acc)[8],
+	uint8_t const* const secret
+) noexcept {
+	__m256i* const a = reinterpret_cast<__m256i*>(acc);
+	_mm256_storeu_si256(a + 0, xxh3_scramble_round(
+		_mm256_loadu_si256(a + 0), secret +  0
+	));
+	_mm256_storeu_si256(a + 1, xxh3_scramble_round(
+		_mm256_loadu_si256(a + 1), secret + 32
+	));
+}
+
+#elif defined(AM_DETAIL_SSE2)
+
+inline __m128i
+xxh3_round(
+	__m128i const acc,
+	uint8_t const* const p,
+	uint8_t const* const secret
+) noexcept {
+	__m128i const data = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+	__m128i const key = _mm_loadu_si128(reinterpret_cast<__m128i const*>(secret));
+	__m128i const data_key = _mm_xor_si128(data, key);
+	__m128i const data_key_lo = _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1));
+	__m128i const product = _mm_mul_epu32(data_key, data_key_lo);
+	__m128i const data_swap = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+	return _mm_add_epi64(product, _mm_add_epi64(acc, data_swap));
+}
+
+inline __m128i
+xxh3_scramble_round(
+	__m128i acc,
+	uint8_t const* const secret
+) noexcept {
+	__m128i const prime = _mm_set1_epi32(static_cast<int>(xxh_prime32_1));
+	__m128i const key = _mm_loadu_si128(reinterpret_cast<__m128i const*>(secret));
+	acc = _mm_xor_si128(acc, _mm_srli_epi64(acc, 47));
+	acc = _mm_xor_si128(acc, key);
+	__m128i const prod_lo = _mm_mul_epu32(acc, prime);
+	__m128i const prod_hi = _mm_mul_epu32(
+		_mm_shuffle_epi32(acc, _MM_SHUFFLE(0, 3, 0, 1)), prime
+	);
+	return _mm_add_epi64(prod_lo, _mm_slli_epi64(prod_hi, 32));
+}
+
+inline void
+xxh3_accumulate(
+	std::uint64_t (&acc)[8],
+	uint8_t const* p,
+	uint8_t const* secret,
+	std::size_t const stripes
+) noexcept {
+	__m128i* const a = reinterpret_cast<__m128i*>(acc);
+	__m128i a0 = _mm_loadu_si128(a + 0);
+	__m128i a1 = _mm_loadu_si128(a + 1);
+	__m128i a2 = _mm_loadu_si128(a + 2);
+	__m128i a3 = _mm_loadu_si128(a + 3);
+	for (std::size_t n = 0; n < stripes; ++n) {
+		a0 = xxh3_round(a0, p +  0, secret +  0);
+		a1 = xxh3_round(a1, p + 16, secret + 16);
+		a2 = xxh3_round(a2, p + 32, secret + 32);
+		a3 = xxh3_round(a3, p + 48, secret + 48);
+		p += xxh3_stripe_size;
+		secret += xxh3_secret_rate;
+	}
+	_mm_storeu_si128(a + 0, a0);
+	_mm_storeu_si128(a + 1, a1);
+	_mm_storeu_si128(a + 2, a2);
+	_mm_storeu_si128(a + 3, a3);
+}
+
+inline void
+xxh3_scramble(
+	std::uint64_t (&acc)[8],
+	uint8_t const* const secret
+) noexcept {
+	__m128i* const a = reinterpret_cast<__m128i*>(acc);
+	for (unsigned i = 0; i < 4u; ++i) {
+		_mm_storeu_si128(a + i, xxh3_scramble_round(
+			_mm_loadu_si128(a + i), secret + 16u * i
+		));
+	}
+}
+
+#else
+
+inline void
+xxh3_accumulate(
+	std::uint64_t (&acc)[8],
+	uint8_t const* p,
+	uint8_t const* secret,
+	std::size_t const stripes
+) noexcept {
+	for (std::size_t n = 0; n < stripes; ++n) {
+		for (unsigned i = 0; i < 8u; ++i) {
+			std::uint64_t const data = hash_read64(p + 8u * i);
+			std::uint64_t const data_key = data ^ hash_read64(secret + 8u * i);
+			acc[i ^ 1u] += data;
+			acc[i] += (data_key & 0xffffffffu) * (data_key >> 32);
+		}
+		p += xxh3_stripe_size;
+		secret += xxh3_secret_rate;
+	}
+}
+
+inline void
+xxh3_scramble(
+	std::uint64_t (&acc)[8],
+	uint8_t const* const secret
+) noexcept {
+	for (unsigned i = 0; i < 8u; ++i) {
+		std::uint64_t a = acc[i];
+		a ^= a >> 47;
+		a ^= hash_read64(secret + 8u * i);
+		acc[i] = a * xxh_prime32_1;
+	}
+}
+
+#endif
+
+inline void
+xxh3_acc_init(
+	std::uint64_t (&acc)[8]
+) noexcept {
+	acc[0] = xxh_prime32_3;
+	acc[1] = xxh_prime64_1;
+	acc[2] = xxh_prime64_2;
+	acc[3] = xxh_prime64_3;
+	acc[4] = xxh_prime64_4;
+	acc[5] = xxh_prime32_2;
+	acc[6] = xxh_prime64_5;
+	acc[7] = xxh_prime32_1;
+}
+
+// All stripes but the last, then the last stripe (ending at the end of
+// the input) against an unaligned secret offset
+inline void
+xxh3_long(
+	std::uint64_t (&acc)[8],
+	uint8_t const* const p,
+	std::size_t const size,
+	uint8_t const* const secret
+) noexcept {
+	std::size_t const blocks = (size - 1u) / xxh3_block_size;
+	for (std::size_t n = 0; n < blocks; ++n) {
+		xxh3_accumulate(acc, p + n * xxh3_block_size, secret, xxh3_block_stripes);
+		xxh3_scramble(acc, secret + xxh3_secret_size - xxh3_stripe_size);
+	}
+	std::size_t const stripes
+		= ((size - 1u) - blocks * xxh3_block_size) / xxh3_stripe_size
+	;
+	xxh3_accumulate(acc, p + blocks * xxh3_block_size, secret, stripes);
+	xxh3_accumulate(
+		acc, p + size - xxh3_stripe_size,
+		secret + xxh3_secret_size - xxh3_stripe_size - 7u, 1u
+	);
+}
+
+inline std::uint64_t
+xxh3_merge(
+	std::uint64_t const (&acc)[8],
+	uint8_t const* const secret,
+	std::uint64_t h
+) noexcept {
+	for (unsigned i = 0; i < 4u; ++i) {
+		h += xxh_mul128_fold64(
+			acc[2u * i + 0u] ^ hash_read64(secret + 16u * i + 0u),
+			acc[2u * i + 1u] ^ hash_read64(secret + 16u * i + 8u)
+		);
+	}
+	return xxh3_avalanche(h);
+}
+
+// Streaming: consume whole stripes, scrambling at block boundaries
+inline uint8_t const*
+xxh3_consume(
+	std::uint64_t (&acc)[8],
+	unsigned& stripes_so_far,
+	uint8_t const* p,
+	std::size_t stripes,
+	uint8_t const* const secret
+) noexcept {
+	uint8_t const* initial_secret = secret + stripes_so_far * xxh3_secret_rate;
+	if (stripes >= xxh3_block_stripes - stripes_so_far) {
+		std::size_t count = xxh3_block_stripes - stripes_so_far;
+		do {
+			xxh3_accumulate(acc, p, initial_secret, count);
+			xxh3_scramble(acc, secret + xxh3_secret_size - xxh3_stripe_size);
+			p += count * xxh3_stripe_size;
+			stripes -= count;
+			count = xxh3_block_stripes;
+			initial_secret = secret;
+		} while (stripes >= xxh3_block_stripes);
+		stripes_so_far = 0u;
+	}
+	if (stripes > 0u) {
+		xxh3_accumulate(acc, p, initial_secret, stripes);
+		p += stripes * xxh3_stripe_size;
+		stripes_so_far += static_cast<unsigned>(stripes);
+	}
+	return p;
+}
+
+struct xxh3_state {
+	std::uint64_t acc[8];
+	uint8_t secret[xxh3_secret_size];
+	uint8_t buffer[xxh3_buffer_size];
+	std::uint64_t seed;
+	std::uint64_t size;
+	unsigned buffered;
+	unsigned stripes;
+};
+
+// 64-bit short paths
+
+inline std::uint64_t
+xxh3_64_0to16(
+	uint8_t const* const p,
+	std::size_t const size,
+	uint8_t const* const secret,
+	std::uint64_t seed
+) noexcept {
+	if (size > 8u) {
+		std::uint64_t const flip1
+			= (hash_read64(secret + 24) ^ hash_read64(secret + 32)) + seed;
+		std::uint64_t const flip2
+			= (hash_read64(secret + 40) ^ hash_read64(secret + 48)) - seed;
+		std::uint64_t const lo = hash_read64(p) ^ flip1;
+		std::uint64_t const hi = hash_read64(p + size - 8u) ^ flip2;
+		return xxh3_avalanche(
+			size + hash_swap64(lo) + hi + xxh_mul128_fold64(lo, hi)
+		);
+	} else if (size >= 4u) {
+		seed ^= static_cast<std::uint64_t>(
+			hash_swap32(static_cast<std::uint32_t>(seed))
+		) << 32;
+		std::uint64_t const flip
+			= (hash_read64(secret + 8) ^ hash_read64(secret + 16)) - seed;
+		std::uint64_t const input
+			= hash_read32(p + size - 4u)
+			+ (static_cast<std::uint64_t>(hash_read32(p)) << 32)
+		;
+		return xxh3_rrmxmx(input ^ flip, size);
+	} else if (size > 0u) {
+		std::uint32_t const combined
+			= (static_cast<std::uint32_t>(p[0]) << 16)
+			| (static_cast<std::uint32_t>(p[size >> 1]) << 24)
+			| (static_cast<std::uint32_t>(p[size - 1u]))
+			| (static_cast<std::uint32_t>(size) << 8)
+		;
+		std::uint64_t const flip
+			= (hash_read32(secret) ^ hash_read32(secret + 4)) + seed;
+		return xxh64_avalanche(combined ^ flip);
+	}
+	return xxh64_avalanche(
+		seed ^ hash_read64(secret + 56) ^ hash_read64(secret + 64)
+	);
+}
+
+inline std::uint64_t
+xxh3_64_17to128(
+	uint8_t const* const p,
+	std::size_t const size,
+	uint8_t const* const secret,
+	std::uint64_t const seed
+) noexcept {
+	std::uint64_t h = size * xxh_prime64_1;
+	if (size > 32u) {
+		if (size > 64u) {
+			if (size > 96u) {
+				h += xxh3_mix16(p + 48, secret + 96, seed);
+				h += xxh3_mix16(p + size - 64u, secret + 112, seed);
+			}
+			h += xxh3_mix16(p + 32, secret + 64, seed);
+			h += xxh3_mix16(p + size - 48u, secret + 80, seed);
+		}
+		h += xxh3_mix16(p + 16, secret + 32, seed);
+		h += xxh3_mix16(p + size - 32u, secret + 48, seed);
+	}
+	h += xxh3_mix16(p, secret, seed);
+	h += xxh3_mix16(p + size - 16u, secret + 16, seed);
+	return xxh3_avalanche(h);
+}
+
+inline std::uint64_t
+xxh3_64_129to240(
+	uint8_t const* const p,
+	std::size_t const size,
+	uint8_t const* const secret,
+	std::uint64_t const seed
+) noexcept {
+	std::uint64_t h = size * xxh_prime64_1;
+	for (unsigned i = 0; i < 8u; ++i) {
+		h += xxh3_mix16(p + 16u * i, secret + 16u * i, seed);
+	}
+	std::uint64_t h_end = xxh3_mix16(
+		p + size - 16u, secret + xxh3_secret_size_min - 17u, seed
+	);
+	h = xxh3_avalanche(h);
+	unsigned const rounds = static_cast<unsigned>(size) / 16u;
+	for (unsigned i = 8u; i < rounds; ++i) {
+		h_end += xxh3_mix16(p + 16u * i, secret + 16u * (i - 8u) + 3u, seed);
+	}
+	return xxh3_avalanche(h + h_end);
+}
+
+inline std::uint64_t
+xxh3_64_short(
+	uint8_t const* const p,
+	std::size_t const size,
+	std::uint64_t const seed
+) noexcept {
+	return
+		size <= 16u ? xxh3_64_0to16(p, size, xxh3_secret, seed)
+		: size <= 128u ? xxh3_64_17to128(p, size, xxh3_secret, seed)
+		: xxh3_64_129to240(p, size, xxh3_secret, seed)
+	;
+}
+
+// 128-bit short paths
+
+struct xxh3_128_value {
+	std::uint64_t lo;
+	std::uint64_t hi;
+};
+
+inline xxh3_128_value
+xxh3_128_0to16(
+	uint8_t const* const p,
+	std::size_t const size,
+	uint8_t const* const secret,
+	std::uint64_t seed
+) noexcept {
+	if (size > 8u) {
+		std::uint64_t const flip_lo
+			= (hash_read64(secret + 32) ^ hash_read64(secret + 40)) - seed;
+		std::uint64_t const flip_hi
+			= (hash_read64(secret + 48) ^ hash_read64(secret + 56)) + seed;
+		std::uint64_t const in_lo = hash_read64(p);
+		std::uint64_t in_hi = hash_read64(p + size - 8u);
+		xxh3_128_value m;
+		hash_mul128(in_lo ^ in_hi ^ flip_lo, xxh_prime64_1, m.lo, m.hi);
+		m.lo += static_cast<std::uint64_t>(size - 1u) << 54;
+		in_hi ^= flip_hi;
+		m.hi += in_hi + (in_hi & 0xffffffffu) * (xxh_prime32_2 - 1u);
+		m.lo ^= hash_swap64(m.hi);
+		xxh3_128_value h;
+		hash_mul128(m.lo, xxh_prime64_2, h.lo, h.hi);
+		h.hi += m.hi * xxh_prime64_2;
+		return {xxh3_avalanche(h.lo), xxh3_avalanche(h.hi)};
+	} else if (size >= 4u) {
+		seed ^= static_cast<std::uint64_t>(
+			hash_swap32(static_cast<std::uint32_t>(seed))
+		) << 32;
+		std::uint64_t const input
+			= hash_read32(p)
+			+ (static_cast<std::uint64_t>(hash_read32(p + size - 4u)) << 32)
+		;
+		std::uint64_t const flip
+			= (hash_read64(secret + 16) ^ hash_read64(secret + 24)) + seed;
+		xxh3_128_value m;
+		hash_mul128(input ^ flip, xxh_prime64_1 + (size << 2), m.lo, m.hi);
+		m.hi += m.lo << 1;
+		m.lo ^= m.hi >> 3;
+		m.lo ^= m.lo >> 35;
+		m.lo *= xxh_prime_mx2;
+		m.lo ^= m.lo >> 28;
+		m.hi = xxh3_avalanche(m.hi);
+		return m;
+	} else if (size > 0u) {
+		std::uint32_t const combined_lo
+			= (static_cast<std::uint32_t>(p[0]) << 16)
+			| (static_cast<std::uint32_t>(p[size >> 1]) << 24)
+			| (static_cast<std::uint32_t>(p[size - 1u]))
+			| (static_cast<std::uint32_t>(size) << 8)
+		;
+		std::uint32_t const combined_hi
+			= xxh_rotl32(hash_swap32(combined_lo), 13);
+		std::uint64_t const flip_lo
+			= (hash_read32(secret) ^ hash_read32(secret + 4)) + seed;
+		std::uint64_t const flip_hi
+			= (hash_read32(secret + 8) ^ hash_read32(secret + 12)) - seed;
+		return {
+			xxh64_avalanche(combined_lo ^ flip_lo),
+			xxh64_avalanche(combined_hi ^ flip_hi)
+		};
+	}
+	return {
+		xxh64_avalanche(seed ^ hash_read64(secret + 64) ^ hash_read64(secret + 72)),
+		xxh64_avalanche(seed ^ hash_read64(secret + 80) ^ hash_read64(secret + 88))
+	};
+}
+
+inline void
+xxh3_128_mix32(
+	xxh3_128_value& acc,
+	uint8_t const* const p1,
+	uint8_t const* const p2,
+	uint8_t const* const secret,
+	std::uint64_t const seed
+) noexcept {
+	acc.lo += xxh3_mix16(p1, secret, seed);
+	acc.lo ^= hash_read64(p2) + hash_read64(p2 + 8);
+	acc.hi += xxh3_mix16(p2, secret + 16, seed);
+	acc.hi ^= hash_read64(p1) + hash_read64(p1 + 8);
+}
+
+inline xxh3_128_value
+xxh3_128_finish(
+	xxh3_128_value const& acc,
+	std::size_t const size,
+	std::uint64_t const seed
+) noexcept {
+	std::uint64_t const lo = acc.lo + acc.hi;
+	std::uint64_t const hi
+		= acc.lo * xxh_prime64_1
+		+ acc.hi * xxh_prime64_4
+		+ (size - seed) * xxh_prime64_2
+	;
+	return {xxh3_avalanche(lo), 0u - xxh3_avalanche(hi)};
+}
+
+inline xxh3_128_value
+xxh3_128_17to128(
+	uint8_t const* const p,
+	std::size_t const size,
+	uint8_t const* const secret,
+	std::uint64_t const seed
+) noexcept {
+	xxh3_128_value acc{size * xxh_prime64_1, 0u};
+	if (size > 32u) {
+		if (size > 64u) {
+			if (size > 96u) {
+				xxh3_128_mix32(acc, p + 48, p + size - 64u, secret + 96, seed);
+			}
+			xxh3_128_mix32(acc, p + 32, p + size - 48u, secret + 64, seed);
+		}
+		xxh3_128_mix32(acc, p + 16, p + size - 32u, secret + 32, seed);
+	}
+	xxh3_128_mix32(acc, p, p + size - 16u, secret, seed);
+	return xxh3_128_finish(acc, size, seed);
+}
+
+inline xxh3_128_value
+xxh3_128_129to240(
+	uint8_t const* const p,
+	std::size_t const size,
+	uint8_t const* const secret,
+	std::uint64_t const seed
+) noexcept {
+	xxh3_128_value acc{size * xxh_prime64_1, 0u};
+	for (unsigned i = 32u; i < 160u; i += 32u) {
+		xxh3_128_mix32(acc, p + i - 32u, p + i - 16u, secret + i - 32u, seed);
+	}
+	acc.lo = xxh3_avalanche(acc.lo);
+	acc.hi = xxh3_avalanche(acc.hi);
+	for (unsigned i = 160u; i <= size; i += 32u) {
+		xxh3_128_mix32(
+			acc, p + i - 32u, p + i - 16u, secret + 3u + i - 160u, seed
+		);
+	}
+	xxh3_128_mix32(
+		acc, p + size - 16u, p + size - 32u,
+		secret + xxh3_secret_size_min - 17u - 16u, 0u - seed
+	);
+	return xxh3_128_finish(acc, size, seed);
+}
+
+inline xxh3_128_value
+xxh3_128_short(
+	uint8_t const* const p,
+	std::size_t const size,
+	std::uint64_t const seed
+) noexcept {
+	return
+		size <= 16u ? xxh3_128_0to16(p, size, xxh3_secret, seed)
+		: size <= 128u ? xxh3_128_17to128(p, size, xxh3_secret, seed)
+		: xxh3_128_129to240(p, size, xxh3_secret, seed)
+	;
+}
+
+// Variant-specific parts of XXH3
+template<
+	::am::hash::HashLength L
+>
+struct xxh3_variant;
+
+template<>
+struct xxh3_variant< ::am::hash::HashLength::HL64> {
+	using hash_type = xxh_hash_type< ::am::hash::HashLength::HL64>;
+
+	static hash_type
+	short_value(
+		uint8_t const* const p,
+		std::size_t const size,
+		std::uint64_t const seed
+	) noexcept {
+		return xxh3_64_short(p, size, seed);
+	}
+
+	static hash_type
+	long_value(
+		std::uint64_t const (&acc)[8],
+		std::uint64_t const size,
+		uint8_t const* const secret
+	) noexcept {
+		return xxh3_merge(acc, secret + 11u, size * xxh_prime64_1);
+	}
+};
+
+template<>
+struct xxh3_variant< ::am::hash::HashLength::HL128> {
+	using hash_type = xxh_hash_type< ::am::hash::HashLength::HL128>;
+
+	// Stored as the low then high 64-bit halves, in host byte order
+	static hash_type
+	make(
+		xxh3_128_value const& v
+	) noexcept {
+		hash_type h;
+		std::memcpy(h.data + 0, &v.lo, 8u);
+		std::memcpy(h.data + 8, &v.hi, 8u);
+		return h;
+	}
+
+	static hash_type
+	short_value(
+		uint8_t const* const p,
+		std::size_t const size,
+		std::uint64_t const seed
+	) noexcept {
+		return make(xxh3_128_short(p, size, seed));
+	}
+
+	static hash_type
+	long_value(
+		std::uint64_t const (&acc)[8],
+		std::uint64_t const size,
+		uint8_t const* const secret
+	) noexcept {
+		return make({
+			xxh3_merge(acc, secret + 11u, size * xxh_prime64_1),
+			xxh3_merge(
+				acc, secret + xxh3_secret_size - 64u - 11u,
+				~(size * xxh_prime64_2)
+			)
+		});
+	}
+};
+
+template<
+	::am::hash::HashLength L
+>
+struct xxh3_impl {
+	AM_HASH_XXH3_RESTRICT_LENGTH(L);
+
+	static constexpr auto const hash_length = L;
+	using variant = xxh3_variant<L>;
+	using hash_type = xxh_hash_type<L>;
+	using seed_type = std::uint64_t;
+	using state_type = xxh3_state;
+
+	static hash_type
+	calc(
+		uint8_t const* const data,
+		unsigned const size,
+		seed_type const seed
+	) noexcept {
+		if (size <= xxh3_midsize_max) {
+			return variant::short_value(data, size, seed);
+		}
+		std::uint64_t acc[8];
+		xxh3_acc_init(acc);
+		if (seed == 0u) {
+			xxh3_long(acc, data, size, xxh3_secret);
+			return variant::long_value(acc, size, xxh3_secret);
+		} else {
+			uint8_t secret[xxh3_secret_size];
+			xxh3_derive_secret(secret, seed);
+			xxh3_long(acc, data, size, secret);
+			return variant::long_value(acc, size, secret);
+		}
+	}
+
+	static void
+	state_init(
+		state_type& s,
+		seed_type const seed
+	) noexcept {
+		xxh3_acc_init(s.acc);
+		xxh3_derive_secret(s.secret, seed);
+		s.seed = seed;
+		s.size = 0u;
+		s.buffered = 0u;
+		s.stripes = 0u;
+	}
+
+	// The buffer always keeps the last stripe for state_value(), so
+	// input is only consumed once more than a full buffer is available
+	static void
+	state_add(
+		state_type& s,
+		uint8_t const* data,
+		unsigned const size
+	) noexcept {
+		uint8_t const* const end = data + size;
+		s.size += size;
+		if (size <= xxh3_buffer_size - s.buffered) {
+			std::memcpy(s.buffer + s.buffered, data, size);
+			s.buffered += size;
+			return;
+		}
+		if (s.buffered != 0u) {
+			unsigned const fill = xxh3_buffer_size - s.buffered;
+			std::memcpy(s.buffer + s.buffered, data, fill);
+			data += fill;
+			xxh3_consume(
+				s.acc, s.stripes, s.buffer,
+				xxh3_buffer_size / xxh3_stripe_size, s.secret
+			);
+			s.buffered = 0u;
+		}
+		if (end - data > static_cast<std::ptrdiff_t>(xxh3_buffer_size)) {
+			std::size_t const stripes
+				= static_cast<std::size_t>(end - 1 - data) / xxh3_stripe_size;
+			data = xxh3_consume(s.acc, s.stripes, data, stripes, s.secret);
+			std::memcpy(
+				s.buffer + xxh3_buffer_size - xxh3_stripe_size,
+				data - xxh3_stripe_size, xxh3_stripe_size
+			);
+		}
+		s.buffered = static_cast<unsigned>(end - data);
+		std::memcpy(s.buffer, data, s.buffered);
+	}
+
+	static hash_type
+	state_value(
+		state_type const& s
+	) noexcept {
+		if (s.size <= xxh3_midsize_max) {
+			return variant::short_value(
+				s.buffer, static_cast<std::size_t>(s.size), s.seed
+			);
+		}
+		std::uint64_t acc[8];
+		std::memcpy(acc, s.acc, sizeof(acc));
+		uint8_t const* last;
+		uint8_t last_stripe[xxh3_stripe_size];
+		if (s.buffered >= xxh3_stripe_size) {
+			unsigned stripes = s.stripes;
+			xxh3_consume(
+				acc, stripes, s.buffer,
+				(s.buffered - 1u) / xxh3_stripe_size, s.secret
+			);
+			last = s.buffer + s.buffered - xxh3_stripe_size;
+		} else {
+			// Tail of the previous buffer, then the buffered bytes
+			unsigned const catchup = xxh3_stripe_size - s.buffered;
+			std::memcpy(
+				last_stripe,
+				s.buffer + xxh3_buffer_size - catchup, catchup
+			);
+			std::memcpy(last_stripe + catchup, s.buffer, s.buffered);
+			last = last_stripe;
+		}
+		xxh3_accumulate(
+			acc, last,
+			s.secret + xxh3_secret_size - xxh3_stripe_size - 7u, 1u
+		);
+		return variant::long_value(acc, s.size, s.secret);
+	}
+
+	static unsigned
+	state_size(
+		state_type const& s
+	) noexcept {
+		return static_cast<unsigned>(s.size);
+	}
+};
+
+/** @endcond */ // INTERNAL
+
+} // namespace hash
+} // namespace detail
+
+/** @cond INTERNAL */
+namespace hash {
+
+template<HashLength L>
+struct impl_is_stateful<detail::hash::xxh64_impl<L>> {
+	static constexpr bool const value = true;
+};
+template<HashLength L>
+struct impl_is_stateful<detail::hash::xxh3_impl<L>> {
+	static constexpr bool const value = true;
+};
+
+template<HashLength L>
+struct impl_is_seeded<detail::hash::xxh64_impl<L>> {
+	static constexpr bool const value = true;
+};
+template<HashLength L>
+struct impl_is_seeded<detail::hash::xxh3_impl<L>> {
+	static constexpr bool const value = true;
+};
+
+} // namespace hash
+/** @endcond */ // INTERNAL
+
+} // namespace am
@@ -0,0 +1,381 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Lane packs for batch kernels.
+*/
+
+#pragma once
+
+#include "../../config.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <type_traits>
+
+#if defined(AM_DETAIL_AVX2)
+	#include <immintrin.h>
+#elif defined(AM_DETAIL_SSE2)
+	#include <emmintrin.h>
+#endif
+
+namespace am {
+namespace detail {
+namespace linear {
+
+/** @cond INTERNAL */
+
+// A lane pack holds one value for each of L independent problems
+// (e.g., L matrices being decomposed at once). Every operation is a
+// loop over the lanes with a constant trip count and no branches, so
+// the compiler can turn each into a single SIMD instruction. Kernels
+// written against the lane_* functions below work both on packs and
+// on plain scalars (one lane).
+
+// lane_select() blends bit patterns through an all-ones or all-zeros
+// word per lane rather than with ?:, which compilers tend to leave as
+// a branch per lane. lane_sqrt() uses SSE/AVX square roots where it
+// can: std::sqrt must set errno for negative arguments, so without
+// -fno-math-errno every lane gets a scalar square root and a branch.
+
+// Number of lanes batch kernels process at once
+constexpr std::size_t const lane_width = 8;
+
+template<
+	std::size_t L
+>
+struct lane_mask {
+	bool v[L];
+};
+
+template<
+	class T,
+	std::size_t L
+>
+struct lane_pack {
+	using value_type = T;
+	using mask_type = lane_mask<L>;
+
+	T v[L];
+
+	static lane_pack
+	broadcast(
+		T const s
+	) noexcept {
+		lane_pack p;
+		for (std::size_t l = 0; l < L; ++l) {
+			p.v[l] = s;
+		}
+		return p;
+	}
+};
+
+#define AM_DETAIL_LANE_BINARY_OP(op_)									\
+	template<class T, std::size_t L>									\
+	inline lane_pack<T, L>												\
+	operator op_(														\
+		lane_pack<T, L> const& a,										\
+		lane_pack<T, L> const& b										\
+	) noexcept {														\
+		lane_pack<T, L> r;												\
+		for (std::size_t l = 0; l < L; ++l) {							\
+			r.v[l] = a.v[l] op_ b.v[l];									\
+		}																\
+		return r;														\
+	}																	\
+	template<class T, std::size_t L>									\
+	inline lane_pack<T, L>												\
+	operator op_(														\
+		lane_pack<T, L> const& a,										\
+		T const b														\
+	) noexcept {														\
+		lane_pack<T, L> r;												\
+		for (std::size_t l = 0; l < L; ++l) {							\
+			r.v[l] = a.v[l] op_ b;										\
+		}																\
+		return r;														\
+	}																	\
+	template<class T, std::size_t L>									\
+	inline lane_pack<T, L>												\
+	operator op_(														\
+		T const a,														\
+		lane_pack<T, L> const& b										\
+	) noexcept {														\
+		lane_pack<T, L> r;												\
+		for (std::size_t l = 0; l < L; ++l) {							\
+			r.v[l] = a op_ b.v[l];										\
+		}																\
+		return r;														\
+	}
+
+#define AM_DETAIL_LANE_COMPARE_OP(op_)									\
+	template<class T, std::size_t L>									\
+	inline lane_mask<L>													\
+	operator op_(														\
+		lane_pack<T, L> const& a,										\
+		lane_pack<T, L> const& b										\
+	) noexcept {														\
+		lane_mask<L> r;													\
+		for (std::size_t l = 0; l < L; ++l) {							\
+			r.v[l] = a.v[l] op_ b.v[l];									\
+		}																\
+		return r;														\
+	}																	\
+	template<class T, std::size_t L>									\
+	inline lane_mask<L>													\
+	operator op_(														\
+		lane_pack<T, L> const& a,										\
+		T const b														\
+	) noexcept {														\
+		lane_mask<L> r;													\
+		for (std::size_t l = 0; l < L; ++l) {							\
+			r.v[l] = a.v[l] op_ b;										\
+		}																\
+		return r;														\
+	}
+
+AM_DETAIL_LANE_BINARY_OP(+)
+AM_DETAIL_LANE_BINARY_OP(-)
+AM_DETAIL_LANE_BINARY_OP(*)
+AM_DETAIL_LANE_BINARY_OP(/)
+AM_DETAIL_LANE_COMPARE_OP(<)
+AM_DETAIL_LANE_COMPARE_OP(>)
+AM_DETAIL_LANE_COMPARE_OP(<=)
+AM_DETAIL_LANE_COMPARE_OP(>=)
+
+#undef AM_DETAIL_LANE_BINARY_OP
+#undef AM_DETAIL_LANE_COMPARE_OP
+
+template<class T, std::size_t L>
+inline lane_pack<T, L>
+operator-(
+	lane_pack<T, L> const& a
+) noexcept {
+	lane_pack<T, L> r;
+	for (std::size_t l = 0; l < L; ++l) {
+		r.v[l] = -a.v[l];
+	}
+	return r;
+}
+
+template<std::size_t L>
+inline lane_mask<L>
+operator&(
+	lane_mask<L> const& a,
+	lane_mask<L> const& b
+) noexcept {
+	lane_mask<L> r;
+	for (std::size_t l = 0; l < L; ++l) {
+		r.v[l] = a.v[l] & b.v[l];
+	}
+	return r;
+}
+
+template<std::size_t L>
+inline lane_mask<L>
+operator|(
+	lane_mask<L> const& a,
+	lane_mask<L> const& b
+) noexcept {
+	lane_mask<L> r;
+	for (std::size_t l = 0; l < L; ++l) {
+		r.v[l] = a.v[l] | b.v[l];
+	}
+	return r;
+}
+
+template<class T, std::size_t L>
+inline lane_pack<T, L>
+lane_select(
+	lane_mask<L> const& m,
+	lane_pack<T, L> const& a,
+	lane_pack<T, L> const& b
+) noexcept {
+	using bits_type = typename std::conditional<
+		sizeof(T) == sizeof(std::uint32_t),
+		std::uint32_t,
+		std::uint64_t
+	>::type;
+	AM_STATIC_ASSERT(
+		sizeof(T) == sizeof(bits_type),
+		"T must be a 32- or 64-bit type"
+	);
+	lane_pack<T, L> r;
+	for (std::size_t l = 0; l < L; ++l) {
+		bits_type const k = bits_type(0) - static_cast<bits_type>(m.v[l]);
+		bits_type x, y;
+		std::memcpy(&x, &a.v[l], sizeof(T));
+		std::memcpy(&y, &b.v[l], sizeof(T));
+		x = (x & k) | (y & ~k);
+		std::memcpy(&r.v[l], &x, sizeof(T));
+	}
+	return r;
+}
+
+template<class T, std::size_t L>
+inline void
+lane_sqrt_impl(
+	T const (&a)[L],
+	T (&r)[L]
+) noexcept {
+	for (std::size_t l = 0; l < L; ++l) {
+		r[l] = std::sqrt(a[l]);
+	}
+}
+
+#if defined(AM_DETAIL_SSE2)
+template<std::size_t L>
+inline typename std::enable_if<0 == (L & 3)>::type
+lane_sqrt_impl(
+	float const (&a)[L],
+	float (&r)[L]
+) noexcept {
+#if defined(AM_DETAIL_AVX2)
+	if (0 == (L & 7)) {
+		for (std::size_t l = 0; l < L; l += 8) {
+			_mm256_storeu_ps(r + l, _mm256_sqrt_ps(_mm256_loadu_ps(a + l)));
+		}
+		return;
+	}
+#endif
+	for (std::size_t l = 0; l < L; l += 4) {
+		_mm_storeu_ps(r + l, _mm_sqrt_ps(_mm_loadu_ps(a + l)));
+	}
+}
+
+template<std::size_t L>
+inline typename std::enable_if<0 == (L & 1)>::type
+lane_sqrt_impl(
+	double const (&a)[L],
+	double (&r)[L]
+) noexcept {
+#if defined(AM_DETAIL_AVX2)
+	if (0 == (L & 3)) {
+		for (std::size_t l = 0; l < L; l += 4) {
+			_mm256_storeu_pd(r + l, _mm256_sqrt_pd(_mm256_loadu_pd(a + l)));
+		}
+		return;
+	}
+#endif
+	for (std::size_t l = 0; l < L; l += 2) {
+		_mm_storeu_pd(r + l, _mm_sqrt_pd(_mm_loadu_pd(a + l)));
+	}
+}
+#endif
+
+template<class T, std::size_t L>
+inline lane_pack<T, L>
+lane_sqrt(
+	lane_pack<T, L> const& a
+) noexcept {
+	lane_pack<T, L> r;
+	lane_sqrt_impl(a.v, r.v);
+	return r;
+}
+
+template<class T, std::size_t L>
+inline lane_pack<T, L>
+lane_abs(
+	lane_pack<T, L> const& a
+) noexcept {
+	lane_pack<T, L> r;
+	for (std::size_t l = 0; l < L; ++l) {
+		r.v[l] = std::abs(a.v[l]);
+	}
+	return r;
+}
+
+template<class T, std::size_t L>
+inline lane_pack<T, L>
+lane_max(
+	lane_pack<T, L> const& a,
+	lane_pack<T, L> const& b
+) noexcept {
+	lane_pack<T, L> r;
+	for (std::size_t l = 0; l < L; ++l) {
+		r.v[l] = a.v[l] < b.v[l] ? b.v[l] : a.v[l];
+	}
+	return r;
+}
+
+template<class T, std::size_t L>
+inline lane_pack<T, L>
+lane_broadcast(
+	lane_pack<T, L> const&,
+	T const s
+) noexcept {
+	return lane_pack<T, L>::broadcast(s);
+}
+
+template<std::size_t L>
+inline bool
+lane_any(
+	lane_mask<L> const& m
+) noexcept {
+	bool r = false;
+	for (std::size_t l = 0; l < L; ++l) {
+		r |= m.v[l];
+	}
+	return r;
+}
+
+// Scalar (single-lane) forms
+
+template<class T>
+inline T
+lane_select(
+	bool const m,
+	T const a,
+	T const b
+) noexcept {
+	return m ? a : b;
+}
+
+template<class T>
+inline T
+lane_sqrt(
+	T const a
+) noexcept {
+	return std::sqrt(a);
+}
+
+template<class T>
+inline T
+lane_abs(
+	T const a
+) noexcept {
+	return std::abs(a);
+}
+
+template<class T>
+inline T
+lane_max(
+	T const a,
+	T const b
+) noexcept {
+	return a < b ? b : a;
+}
+
+template<class T>
+inline T
+lane_broadcast(
+	T const&,
+	T const s
+) noexcept {
+	return s;
+}
+
+inline bool
+lane_any(
+	bool const m
+) noexcept {
+	return m;
+}
+
+/** @endcond */ // INTERNAL
+
+} // namespace linear
+} // namespace detail
+} // namespace am
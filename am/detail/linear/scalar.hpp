@@ -0,0 +1,83 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Scalar component operations.
+*/
+
+#pragma once
+
+#include "../../config.hpp"
+
+#include <cmath>
+#include <type_traits>
+
+namespace am {
+namespace detail {
+namespace linear {
+
+/** @cond INTERNAL */
+
+// NOTE: Operand order matches SSE min/max (the second operand is
+// returned if either is NaN), so these compile to single instructions
+template<class T>
+inline constexpr T
+scalar_min(
+	T const a,
+	T const b
+) noexcept {
+	return (a < b) ? a : b;
+}
+
+template<class T>
+inline constexpr T
+scalar_max(
+	T const a,
+	T const b
+) noexcept {
+	return (a > b) ? a : b;
+}
+
+template<class T>
+inline constexpr T
+scalar_clamp(
+	T const x,
+	T const lo,
+	T const hi
+) noexcept {
+	return scalar_min(scalar_max(x, lo), hi);
+}
+
+template<class T>
+inline typename std::enable_if<std::is_floating_point<T>::value, T>::type
+scalar_abs(
+	T const x
+) noexcept {
+	return std::abs(x);
+}
+
+template<class T>
+inline constexpr typename std::enable_if<
+	std::is_integral<T>::value && std::is_signed<T>::value, T
+>::type
+scalar_abs(
+	T const x
+) noexcept {
+	return (x < T(0)) ? T(-x) : x;
+}
+
+template<class T>
+inline constexpr typename std::enable_if<
+	std::is_unsigned<T>::value, T
+>::type
+scalar_abs(
+	T const x
+) noexcept {
+	return x;
+}
+
+/** @endcond */ // INTERNAL
+
+} // namespace linear
+} // namespace detail
+} // namespace am
@@ -85,6 +85,16 @@ public:
 	col_type data[3];
 
 /** @name Constructors */ /// @{
+#ifdef AM_CONFIG_TRIVIAL_DEFAULT_CONSTRUCT
+	/**
+		Construct uninitialized (trivial).
+
+		@note The default constructor is trivial because
+		@c AM_CONFIG_TRIVIAL_DEFAULT_CONSTRUCT is defined; use
+		identity() or zero() for an initialized value.
+	*/
+	tmat3x4() = default;
+#else
 	/**
 		Construct to identity.
 	*/
@@ -93,6 +103,7 @@ public:
 		col_type{T(0), T(1), T(0), T(0)},
 		col_type{T(0), T(0), T(1), T(0)}
 	} {}
+#endif
 	/**
 		Construct uninitialized.
 	*/
@@ -244,6 +255,29 @@ public:
 	} {}
 /// @}
 
+/** @name Factories */ /// @{
+	/**
+		Make identity matrix.
+
+		@returns A matrix with @c 1 on the main diagonal and @c 0
+		elsewhere.
+	*/
+	static type
+	identity() {
+		return type{T(1)};
+	}
+
+	/**
+		Make zero matrix.
+
+		@returns A matrix with all components @c 0.
+	*/
+	static type
+	zero() {
+		return type{T(0)};
+	}
+/// @}
+
 /** @name Properties */ /// @{
 	/**
 		Get number of columns.
@@ -0,0 +1,668 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Polynomial transcendental kernels.
+*/
+
+#pragma once
+
+#include "../../config.hpp"
+#include "./scalar.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <limits>
+
+namespace am {
+namespace detail {
+namespace linear {
+
+/** @cond INTERNAL */
+
+// Every kernel is straight-line code: special cases are resolved by
+// selects rather than branches and there are no library calls, so
+// loops over arrays vectorize. The rounding trick below relies on
+// strict IEEE evaluation (no -ffast-math or equivalent).
+//
+// Coefficients are from Cephes (sin, cos, exp, atan) and fdlibm
+// (log).
+
+inline std::uint32_t
+bits_of(
+	float const x
+) noexcept {
+	std::uint32_t u;
+	std::memcpy(&u, &x, sizeof(u));
+	return u;
+}
+
+inline std::uint64_t
+bits_of(
+	double const x
+) noexcept {
+	std::uint64_t u;
+	std::memcpy(&u, &x, sizeof(u));
+	return u;
+}
+
+inline float
+from_bits(
+	std::uint32_t const u
+) noexcept {
+	float x;
+	std::memcpy(&x, &u, sizeof(x));
+	return x;
+}
+
+inline double
+from_bits(
+	std::uint64_t const u
+) noexcept {
+	double x;
+	std::memcpy(&x, &u, sizeof(x));
+	return x;
+}
+
+// std::signbit does not vectorize for double in GCC
+inline bool
+sign_bit(
+	float const x
+) noexcept {
+	return 0 != (bits_of(x) >> 31);
+}
+
+inline bool
+sign_bit(
+	double const x
+) noexcept {
+	return 0 != (bits_of(x) >> 63);
+}
+
+// Round to nearest integer (valid for |x| < 2^22 / 2^51)
+inline float
+round_nearest(
+	float const x
+) noexcept {
+	float const magic = 12582912.0f; // 1.5 * 2^23
+	return (x + magic) - magic;
+}
+
+inline double
+round_nearest(
+	double const x
+) noexcept {
+	double const magic = 6755399441055744.0; // 1.5 * 2^52
+	return (x + magic) - magic;
+}
+
+// x * 2^n for n in [-252, 254] / [-2044, 2046], in two steps so that
+// neither factor leaves the normal range
+inline float
+scale_pow2(
+	float const x,
+	std::int32_t const n
+) noexcept {
+	std::int32_t const n1 = n / 2;
+	std::int32_t const n2 = n - n1;
+	return
+		x
+		* from_bits(static_cast<std::uint32_t>(n1 + 127) << 23)
+		* from_bits(static_cast<std::uint32_t>(n2 + 127) << 23)
+	;
+}
+
+inline double
+scale_pow2(
+	double const x,
+	std::int32_t const n
+) noexcept {
+	std::int32_t const n1 = n / 2;
+	std::int32_t const n2 = n - n1;
+	return
+		x
+		* from_bits(static_cast<std::uint64_t>(n1 + 1023) << 52)
+		* from_bits(static_cast<std::uint64_t>(n2 + 1023) << 52)
+	;
+}
+
+// sin and cos of r in [-pi/4, pi/4], then rotated into quadrant q
+template<
+	class T
+>
+inline void
+sincos_quadrant(
+	T const ps,
+	T const pc,
+	std::int32_t const q,
+	T& s,
+	T& c
+) noexcept {
+	bool const swap = 0 != (q & 1);
+	T const sv = swap ? pc : ps;
+	T const cv = swap ? ps : pc;
+	s = 0 != (q & 2) ? -sv : sv;
+	c = 0 != ((q + 1) & 2) ? -cv : cv;
+}
+
+// sin of signed zero keeps the sign; sin and cos of infinity are NaN
+template<
+	class T
+>
+inline void
+sincos_finite(
+	T const x,
+	T& s,
+	T& c
+) noexcept {
+	bool const finite = std::abs(x) <= std::numeric_limits<T>::max();
+	s = x == T(0) ? x : finite ? s : x - x;
+	c = finite ? c : x - x;
+}
+
+inline void
+kernel_sincos(
+	float const x,
+	float& s,
+	float& c
+) noexcept {
+	float const j = scalar_clamp(
+		round_nearest(x * 0.636619772367581343f),
+		-4194304.0f, 4194304.0f
+	);
+	// pi/2 in four parts of at most 11 significant bits (the last
+	// rounded), so every product with j is exact for |j| < 2^13
+	float const r
+		= (((x - j * 1.5703125f)
+		- j * 4.837512969970703125e-4f)
+		- j * 7.549533620476722717e-8f)
+		- j * 2.563344068257089599e-12f
+	;
+	float const z = r * r;
+	float const ps
+		= ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f)
+		* z * r + r
+	;
+	float const pc
+		= ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f)
+		* z * z - 0.5f * z + 1.0f
+	;
+	sincos_quadrant(ps, pc, static_cast<std::int32_t>(j), s, c);
+	sincos_finite(x, s, c);
+}
+
+inline void
+kernel_sincos(
+	double const x,
+	double& s,
+	double& c
+) noexcept {
+	double const j = scalar_clamp(
+		round_nearest(x * 0.636619772367581343),
+		-1073741824.0, 1073741824.0
+	);
+	double const r
+		= ((x - j * 1.57079625129699707031e0)
+		- j * 7.54978941586159635335e-8)
+		- j * 5.39030285815811905290e-15
+	;
+	double const z = r * r;
+	double const ps = r + r * z * (((((
+		  1.58962301576546568060e-10 * z
+		- 2.50507477628578072866e-8) * z
+		+ 2.75573136213857245213e-6) * z
+		- 1.98412698295895385996e-4) * z
+		+ 8.33333333332211858878e-3) * z
+		- 1.66666666666666307295e-1
+	);
+	double const pc = 1.0 - 0.5 * z + z * z * (((((
+		- 1.13585365213876817300e-11 * z
+		+ 2.08757008419747316778e-9) * z
+		- 2.75573141792967388112e-7) * z
+		+ 2.48015872888517045348e-5) * z
+		- 1.38888888888730564116e-3) * z
+		+ 4.16666666666665929218e-2
+	);
+	sincos_quadrant(ps, pc, static_cast<std::int32_t>(j), s, c);
+	sincos_finite(x, s, c);
+}
+
+template<
+	class T
+>
+inline T
+kernel_sin(
+	T const x
+) noexcept {
+	T s, c;
+	kernel_sincos(x, s, c);
+	return s;
+}
+
+template<
+	class T
+>
+inline T
+kernel_cos(
+	T const x
+) noexcept {
+	T s, c;
+	kernel_sincos(x, s, c);
+	return c;
+}
+
+inline float
+kernel_exp(
+	float const x
+) noexcept {
+	float const hi = 88.72283935546875f;
+	float const xc = scalar_clamp(x, -104.0f, hi);
+	float const j = round_nearest(xc * 1.44269504088896341f);
+	float const r = (xc - j * 0.693359375f) + j * 2.12194440e-4f;
+	float const p
+		= (((((1.9875691500e-4f * r
+		+ 1.3981999507e-3f) * r
+		+ 8.3334519073e-3f) * r
+		+ 4.1665795894e-2f) * r
+		+ 1.6666665459e-1f) * r
+		+ 5.0000001201e-1f) * r * r + r + 1.0f
+	;
+	float const y = scale_pow2(p, static_cast<std::int32_t>(j));
+	return
+		x != x ? x :
+		x > hi ? std::numeric_limits<float>::infinity() :
+		y
+	;
+}
+
+inline double
+kernel_exp(
+	double const x
+) noexcept {
+	double const hi = 709.782712893383973096;
+	double const xc = scalar_clamp(x, -746.0, hi);
+	double const j = round_nearest(xc * 1.4426950408889634073599);
+	double const r
+		= (xc - j * 6.93145751953125e-1)
+		- j * 1.42860682030941723212e-6
+	;
+	double const z = r * r;
+	double const px = r * ((
+		  1.26177193074810590878e-4 * z
+		+ 3.02994407707441961300e-2) * z
+		+ 9.99999999999999999910e-1
+	);
+	double const qx = (((
+		  3.00198505138664455042e-6 * z
+		+ 2.52448340349684104192e-3) * z
+		+ 2.27265548208155028766e-1) * z
+		+ 2.00000000000000000009e0
+	);
+	double const p = 1.0 + 2.0 * (px / (qx - px));
+	double const y = scale_pow2(p, static_cast<std::int32_t>(j));
+	return
+		x != x ? x :
+		x > hi ? std::numeric_limits<double>::infinity() :
+		y
+	;
+}
+
+// log(x) = k ln2 + log(1 + f), with 1 + f in [sqrt(2)/2, sqrt(2)) and
+// log(1 + f) = f - f^2/2 + s (f^2/2 + R(s^2)), s = f / (2 + f)
+inline float
+kernel_log(
+	float const x
+) noexcept {
+	bool const subnormal = x < std::numeric_limits<float>::min();
+	float const xs = subnormal ? x * 33554432.0f : x;
+	std::uint32_t ix = bits_of(xs) + (0x3f800000u - 0x3f3504f3u);
+	std::int32_t const k = static_cast<std::int32_t>(ix >> 23) - 0x7f;
+	ix = (ix & 0x007fffffu) + 0x3f3504f3u;
+	float const f = from_bits(ix) - 1.0f;
+	float const s = f / (2.0f + f);
+	float const z = s * s;
+	float const w = z * z;
+	float const r
+		= z * (0.66666662693f + w * 0.28498786688f)
+		+ w * (0.40000972152f + w * 0.24279078841f)
+	;
+	float const hfsq = 0.5f * f * f;
+	float const dk = static_cast<float>(k) - (subnormal ? 25.0f : 0.0f);
+	float const y
+		= s * (hfsq + r) + dk * 9.0580006145e-06f
+		- hfsq + f + dk * 6.9313812256e-01f
+	;
+	bool const negative = !(x >= 0.0f);
+	bool const zero = x == 0.0f;
+	bool const infinite = x == std::numeric_limits<float>::infinity();
+	return
+		negative ? std::numeric_limits<float>::quiet_NaN() :
+		zero ? -std::numeric_limits<float>::infinity() :
+		infinite ? x :
+		y
+	;
+}
+
+inline double
+kernel_log(
+	double const x
+) noexcept {
+	bool const subnormal = x < std::numeric_limits<double>::min();
+	double const xs = subnormal ? x * 18014398509481984.0 : x;
+	std::uint64_t ix = bits_of(xs);
+	std::uint32_t hx
+		= static_cast<std::uint32_t>(ix >> 32)
+		+ (0x3ff00000u - 0x3fe6a09eu)
+	;
+	std::int32_t const k = static_cast<std::int32_t>(hx >> 20) - 0x3ff;
+	hx = (hx & 0x000fffffu) + 0x3fe6a09eu;
+	ix = (static_cast<std::uint64_t>(hx) << 32) | (ix & 0xffffffffu);
+	double const f = from_bits(ix) - 1.0;
+	double const hfsq = 0.5 * f * f;
+	double const s = f / (2.0 + f);
+	double const z = s * s;
+	double const w = z * z;
+	double const t1 = w * (
+		3.999999999940941908e-01 + w * (
+		2.222219843214978396e-01 + w *
+		1.531383769920937332e-01
+	));
+	double const t2 = z * (
+		6.666666666666735130e-01 + w * (
+		2.857142874366239149e-01 + w * (
+		1.818357216161805012e-01 + w *
+		1.479819860511658591e-01
+	)));
+	double const dk = static_cast<double>(k) - (subnormal ? 54.0 : 0.0);
+	double const y
+		= s * (hfsq + t1 + t2) + dk * 1.90821492927058770002e-10
+		- hfsq + f + dk * 6.93147180369123816490e-01
+	;
+	bool const negative = !(x >= 0.0);
+	bool const zero = x == 0.0;
+	bool const infinite = x == std::numeric_limits<double>::infinity();
+	return
+		negative ? std::numeric_limits<double>::quiet_NaN() :
+		zero ? -std::numeric_limits<double>::infinity() :
+		infinite ? x :
+		y
+	;
+}
+
+// atan(t) for t in [0, 1]
+inline float
+kernel_atan01(
+	float const t
+) noexcept {
+	bool const reduce = t > 0.4142135623730950f;
+	float const u = reduce ? (t - 1.0f) / (t + 1.0f) : t;
+	float const z = u * u;
+	float const y
+		= (((8.05374449538e-2f * z
+		- 1.38776856032e-1f) * z
+		+ 1.99777106478e-1f) * z
+		- 3.33329491539e-1f) * z * u + u
+	;
+	return reduce ? y + 0.785398163397448310f : y;
+}
+
+inline double
+kernel_atan01(
+	double const t
+) noexcept {
+	// Rational approximation; the reduction adds pi/4 in two parts
+	bool const reduce = t > 0.66;
+	double const u = reduce ? (t - 1.0) / (t + 1.0) : t;
+	double const z = u * u;
+	double const p = ((((
+		- 8.750608600031904122785e-1 * z
+		- 1.615753718733365076637e1) * z
+		- 7.500855792314704667340e1) * z
+		- 1.228866684490136173410e2) * z
+		- 6.485021904942025371773e1
+	);
+	double const q = (((((
+		  z
+		+ 2.485846490142306297962e1) * z
+		+ 1.650270098316988542046e2) * z
+		+ 4.328810604912902668951e2) * z
+		+ 4.853903996359136964868e2) * z
+		+ 1.945506571482613964425e2
+	);
+	double const y = u * z * p / q + u;
+	return reduce
+		? 0.78539816339744830962 + (y + 3.061616997868382943065e-17)
+		: y
+	;
+}
+
+template<
+	class T
+>
+inline T
+kernel_atan2_finish(
+	T const y,
+	T const x,
+	T const a,
+	bool const steep
+) noexcept {
+	T const half_pi = T(1.57079632679489661923);
+	T const pi = T(3.14159265358979323846);
+	T r = steep ? half_pi - a : a;
+	r = sign_bit(x) ? pi - r : r;
+	bool const nan = (x != x) | (y != y);
+	return nan ? x + y : std::copysign(r, y);
+}
+
+template<
+	class T
+>
+inline T
+kernel_atan2(
+	T const y,
+	T const x
+) noexcept {
+	T const ax = std::abs(x), ay = std::abs(y);
+	T const mx = scalar_max(ax, ay), mn = scalar_min(ax, ay);
+	bool const both_inf = mn == std::numeric_limits<T>::infinity();
+	T const q = mn / (mx == T(0) ? T(1) : mx);
+	T const t = both_inf ? T(1) : q;
+	return kernel_atan2_finish(y, x, kernel_atan01(t), ay > ax);
+}
+
+// pow(x, y) = exp(y log|x|), with the sign and special cases of C99
+inline double
+kernel_pow(
+	double const x,
+	double const y
+) noexcept {
+	// Integers (and parity) of y; all |y| >= 2^52 are even.
+	// Adding and subtracting 2^52 rounds |y| below it to an
+	// integer exactly, without a conversion (which would not
+	// vectorize)
+	double const big = 4503599627370496.0;
+	double const ay = std::abs(y);
+	bool const small = ay < big;
+	double const ry = (ay + big) - big;
+	bool const integer = (!small) | (ry == ay);
+	double const half = ry * 0.5;
+	bool const odd = small & integer & (((half + big) - big) != half);
+
+	// The cases are made disjoint and the NaN one (which is not a
+	// constant) applied last; otherwise GCC turns the selects back
+	// into branches and the loops calling this do not vectorize
+	double const ax = std::abs(x);
+	double const m = kernel_exp(y * kernel_log(ax));
+	bool const one
+		= (y == 0.0) | (x == 1.0)
+		| ((ax == 1.0) & (ay == std::numeric_limits<double>::infinity()))
+	;
+	bool const nan = (!one) & ((x != x) | (y != y));
+	// -inf to a non-integer power is +inf or +0 (as for +inf)
+	bool const invalid
+		= (x < 0.0) & (x != -std::numeric_limits<double>::infinity())
+		& (!integer)
+	;
+	double r = (sign_bit(x) & odd) ? -m : m;
+	r = invalid ? std::numeric_limits<double>::quiet_NaN() : r;
+	r = one ? 1.0 : r;
+	r = nan ? x + y : r;
+	return r;
+}
+
+inline float
+kernel_pow(
+	float const x,
+	float const y
+) noexcept {
+	// Double precision throughout, so the result is correctly rounded
+	// in nearly all cases (and float overflow still gives infinity)
+	return static_cast<float>(kernel_pow(
+		static_cast<double>(x), static_cast<double>(y)
+	));
+}
+
+// Fast tier: shorter polynomials, no special-case handling
+
+template<
+	class T
+>
+inline void
+kernel_fast_sincos(
+	T const x,
+	T& s,
+	T& c
+) noexcept {
+	T const j = scalar_clamp(
+		round_nearest(x * T(0.636619772367581343)),
+		T(-4194304), T(4194304)
+	);
+	T const r = (x - j * T(1.5703125)) - j * T(4.83826794896619231e-4);
+	T const z = r * r;
+	T const ps = r + r * z * (
+		T(-1.0 / 6.0) + z * (T(1.0 / 120.0) + z * T(-1.0 / 5040.0))
+	);
+	T const pc = T(1) + z * (
+		T(-0.5) + z * (T(1.0 / 24.0) + z * T(-1.0 / 720.0))
+	);
+	sincos_quadrant(ps, pc, static_cast<std::int32_t>(j), s, c);
+}
+
+template<
+	class T
+>
+inline T
+kernel_fast_sin(
+	T const x
+) noexcept {
+	T s, c;
+	kernel_fast_sincos(x, s, c);
+	return s;
+}
+
+template<
+	class T
+>
+inline T
+kernel_fast_cos(
+	T const x
+) noexcept {
+	T s, c;
+	kernel_fast_sincos(x, s, c);
+	return c;
+}
+
+template<
+	class T
+>
+inline T
+kernel_fast_exp(
+	T const x
+) noexcept {
+	// Results saturate near the ends of the range instead of
+	// overflowing to infinity or flushing to zero
+	T const ln2 = T(0.693147180559945309);
+	T const lo = T(std::numeric_limits<T>::min_exponent) * ln2;
+	T const hi = T(std::numeric_limits<T>::max_exponent - 1) * ln2;
+	T const xc = scalar_clamp(x, lo, hi);
+	T const j = round_nearest(xc * T(1.44269504088896341));
+	T const r = xc - j * ln2;
+	T const p = T(1) + r * (T(1) + r * (T(1.0 / 2.0) + r * (
+		T(1.0 / 6.0) + r * (T(1.0 / 24.0) + r * T(1.0 / 120.0))
+	)));
+	return scale_pow2(p, static_cast<std::int32_t>(j));
+}
+
+// log(1 + f) = 2 atanh(s), s = f / (2 + f), truncated after s^5
+template<
+	class T
+>
+inline T
+kernel_fast_log1p_reduced(
+	T const f,
+	std::int32_t const k
+) noexcept {
+	T const s = f / (T(2) + f);
+	T const z = s * s;
+	return
+		T(2) * s * (T(1) + z * (T(1.0 / 3.0) + z * T(1.0 / 5.0)))
+		+ T(k) * T(0.693147180559945309)
+	;
+}
+
+inline float
+kernel_fast_log(
+	float const x
+) noexcept {
+	std::uint32_t ix = bits_of(x) + (0x3f800000u - 0x3f3504f3u);
+	std::int32_t const k = static_cast<std::int32_t>(ix >> 23) - 0x7f;
+	ix = (ix & 0x007fffffu) + 0x3f3504f3u;
+	return kernel_fast_log1p_reduced(from_bits(ix) - 1.0f, k);
+}
+
+inline double
+kernel_fast_log(
+	double const x
+) noexcept {
+	std::uint64_t ix = bits_of(x) + (0x3ff0000000000000u - 0x3fe6a09e667f3bcdu);
+	std::int32_t const k = static_cast<std::int32_t>(ix >> 52) - 0x3ff;
+	ix = (ix & 0x000fffffffffffffu) + 0x3fe6a09e667f3bcdu;
+	return kernel_fast_log1p_reduced(from_bits(ix) - 1.0, k);
+}
+
+template<
+	class T
+>
+inline T
+kernel_fast_atan2(
+	T const y,
+	T const x
+) noexcept {
+	// Abramowitz and Stegun 4.4.49 on [0, 1]
+	T const ax = std::abs(x), ay = std::abs(y);
+	T const mx = scalar_max(ax, ay), mn = scalar_min(ax, ay);
+	T const t = mn / (mx == T(0) ? T(1) : mx);
+	T const z = t * t;
+	T const a = t * (T(0.9998660) + z * (T(-0.3302995) + z * (
+		T(0.1801410) + z * (T(-0.0851330) + z * T(0.0208351))
+	)));
+	return kernel_atan2_finish(y, x, a, ay > ax);
+}
+
+template<
+	class T
+>
+inline T
+kernel_fast_pow(
+	T const x,
+	T const y
+) noexcept {
+	return kernel_fast_exp(y * kernel_fast_log(x));
+}
+
+/** @endcond */ // INTERNAL
+
+} // namespace linear
+} // namespace detail
+} // namespace am
@@ -75,12 +75,23 @@ struct tvec1 {
 /// @}
 
 /** @name Constructors */ /// @{
+#ifdef AM_CONFIG_TRIVIAL_DEFAULT_CONSTRUCT
+	/**
+		Construct uninitialized (trivial).
+
+		@note The default constructor is trivial because
+		@c AM_CONFIG_TRIVIAL_DEFAULT_CONSTRUCT is defined; use
+		zero() for an initialized value.
+	*/
+	tvec1() = default;
+#else
 	/**
 		Construct zeroed.
 	*/
 	tvec1() :
 		x{T(0)}
 	{}
+#endif
 	/**
 		Construct uninitialized.
 	*/
@@ -175,6 +186,18 @@ struct tvec1 {
 	{}
 /// @}
 
+/** @name Factories */ /// @{
+	/**
+		Make zero vector.
+
+		@returns A vector with all components @c 0.
+	*/
+	static type
+	zero() {
+		return type{T(0)};
+	}
+/// @}
+
 /** @name Properties */ /// @{
 	/**
 		Get number of components.
@@ -9,6 +9,7 @@
 
 #include "../../config.hpp"
 #include "./tvec1.hpp"
+#include "./scalar.hpp"
 
 #include <cmath>
 
@@ -36,6 +37,8 @@ struct tvec1<T>::operations {
 	using type_cref = type const&;
 	using value_type = typename type::value_type;
 	using value_cref = typename type::value_type const&;
+	using mask_type = tvec1<bool>;
+	using mask_cref = mask_type const&;
 
 	static value_type
 	length(
@@ -96,6 +99,120 @@ struct tvec1<T>::operations {
 			? type{value_type(0)}
 			: type{eta * i.x - (eta * d + std::sqrt(k)) * n.x};
 	}
+
+	static type
+	min(
+		type_cref v,
+		type_cref r
+	) {
+		return type{
+			scalar_min(v.x, r.x)};
+	}
+
+	static type
+	max(
+		type_cref v,
+		type_cref r
+	) {
+		return type{
+			scalar_max(v.x, r.x)};
+	}
+
+	static type
+	clamp(
+		type_cref v,
+		type_cref lo,
+		type_cref hi
+	) {
+		return type{
+			scalar_clamp(v.x, lo.x, hi.x)};
+	}
+
+	static type
+	abs(
+		type_cref v
+	) {
+		return type{
+			scalar_abs(v.x)};
+	}
+
+	static mask_type
+	less(
+		type_cref v,
+		type_cref r
+	) {
+		return mask_type{
+			v.x < r.x};
+	}
+
+	static mask_type
+	less_equal(
+		type_cref v,
+		type_cref r
+	) {
+		return mask_type{
+			v.x <= r.x};
+	}
+
+	static mask_type
+	greater(
+		type_cref v,
+		type_cref r
+	) {
+		return mask_type{
+			v.x > r.x};
+	}
+
+	static mask_type
+	greater_equal(
+		type_cref v,
+		type_cref r
+	) {
+		return mask_type{
+			v.x >= r.x};
+	}
+
+	static mask_type
+	equal(
+		type_cref v,
+		type_cref r
+	) {
+		return mask_type{
+			v.x == r.x};
+	}
+
+	static mask_type
+	not_equal(
+		type_cref v,
+		type_cref r
+	) {
+		return mask_type{
+			v.x != r.x};
+	}
+
+	static type
+	select(
+		mask_cref m,
+		type_cref a,
+		type_cref b
+	) {
+		return type{
+			m.x ? a.x : b.x};
+	}
+
+	static bool
+	any(
+		type_cref v
+	) {
+		return bool(v.x);
+	}
+
+	static bool
+	all(
+		type_cref v
+	) {
+		return bool(v.x);
+	}
 }; // struct tvec1<T>::operations
 /** @endcond */ // INTERNAL
 
@@ -83,12 +83,23 @@ struct tvec2 {
 /// @}
 
 /** @name Constructors */ /// @{
+#ifdef AM_CONFIG_TRIVIAL_DEFAULT_CONSTRUCT
+	/**
+		Construct uninitialized (trivial).
+
+		@note The default constructor is trivial because
+		@c AM_CONFIG_TRIVIAL_DEFAULT_CONSTRUCT is defined; use
+		zero() for an initialized value.
+	*/
+	tvec2() = default;
+#else
 	/**
 		Construct zeroed.
 	*/
 	tvec2() :
 		x{T(0)}, y{T(0)}
 	{}
+#endif
 	/**
 		Construct uninitialized.
 	*/
@@ -207,6 +218,18 @@ struct tvec2 {
 	{}
 /// @}
 
+/** @name Factories */ /// @{
+	/**
+		Make zero vector.
+
+		@returns A vector with all components @c 0.
+	*/
+	static type
+	zero() {
+		return type{T(0)};
+	}
+/// @}
+
 /** @name Properties */ /// @{
 	/**
 		Get number of components.
@@ -76,12 +76,23 @@ struct tvec3 {
 /// @}
 
 /** @name Constructors */ /// @{
+#ifdef AM_CONFIG_TRIVIAL_DEFAULT_CONSTRUCT
+	/**
+		Construct uninitialized (trivial).
+
+		@note The default constructor is trivial because
+		@c AM_CONFIG_TRIVIAL_DEFAULT_CONSTRUCT is defined; use
+		zero() for an initialized value.
+	*/
+	tvec3() = default;
+#else
 	/**
 		Construct zeroed.
 	*/
 	tvec3() :
 		x{T(0)}, y{T(0)}, z{T(0)}
 	{}
+#endif
 	/**
 		Construct uninitialized.
 	*/
@@ -231,6 +242,18 @@ struct tvec3 {
 	{}
 /// @}
 
+/** @name Factories */ /// @{
+	/**
+		Make zero vector.
+
+		@returns A vector with all components @c 0.
+	*/
+	static type
+	zero() {
+		return type{T(0)};
+	}
+/// @}
+
 /** @name Properties */ /// @{
 	/**
 		Get number of components.
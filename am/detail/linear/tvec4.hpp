@@ -42,12 +42,15 @@ AM_DETAIL_TYPE_IS_VECTOR(tvec4);
 /**
 	Generic 4-dimensional vector.
 
+	@note If @c AM_CONFIG_ALIGN_SIMD is defined, this is aligned to
+	its size.
+
 	@tparam T An arithmetic type.
 */
 template<
 	class T
 >
-struct tvec4 {
+struct AM_DETAIL_ALIGN_SIMD(4 * sizeof(T)) tvec4 {
 	/** @cond INTERNAL */
 	AM_STATIC_ASSERT(
 		true == std::is_arithmetic<T>::value,
@@ -95,12 +98,23 @@ struct tvec4 {
 /// @}
 
 /** @name Constructors */ /// @{
+#ifdef AM_CONFIG_TRIVIAL_DEFAULT_CONSTRUCT
+	/**
+		Construct uninitialized (trivial).
+
+		@note The default constructor is trivial because
+		@c AM_CONFIG_TRIVIAL_DEFAULT_CONSTRUCT is defined; use
+		zero() for an initialized value.
+	*/
+	tvec4() = default;
+#else
 	/**
 		Construct zeroed.
 	*/
 	tvec4() :
 		x{T(0)}, y{T(0)}, z{T(0)}, w{T(0)}
 	{}
+#endif
 	/**
 		Construct uninitialized.
 	*/
@@ -293,6 +307,18 @@ struct tvec4 {
 		x{T(v1.x)}, y{T(v1.y)}, z{T(v2.x)}, w{T(v2.y)} {}
 /// @}
 
+/** @name Factories */ /// @{
+	/**
+		Make zero vector.
+
+		@returns A vector with all components @c 0.
+	*/
+	static type
+	zero() {
+		return type{T(0)};
+	}
+/// @}
+
 /** @name Properties */ /// @{
 	/**
 		Get number of components.
@@ -9,6 +9,7 @@
 
 #include "../../config.hpp"
 #include "./tvec4.hpp"
+#include "./scalar.hpp"
 
 #include <cmath>
 
@@ -36,6 +37,8 @@ struct tvec4<T>::operations {
 	using type_cref = type const&;
 	using value_type = typename type::value_type;
 	using value_cref = typename type::value_type const&;
+	using mask_type = tvec4<bool>;
+	using mask_cref = mask_type const&;
 
 	static value_type
 	length(
@@ -98,6 +101,153 @@ struct tvec4<T>::operations {
 			? type{value_type(0)}
 			: type{eta * i - (eta * d + std::sqrt(k)) * n};
 	}
+
+	static type
+	min(
+		type_cref v,
+		type_cref r
+	) {
+		return type{
+			scalar_min(v.x, r.x),
+			scalar_min(v.y, r.y),
+			scalar_min(v.z, r.z),
+			scalar_min(v.w, r.w)};
+	}
+
+	static type
+	max(
+		type_cref v,
+		type_cref r
+	) {
+		return type{
+			scalar_max(v.x, r.x),
+			scalar_max(v.y, r.y),
+			scalar_max(v.z, r.z),
+			scalar_max(v.w, r.w)};
+	}
+
+	static type
+	clamp(
+		type_cref v,
+		type_cref lo,
+		type_cref hi
+	) {
+		return type{
+			scalar_clamp(v.x, lo.x, hi.x),
+			scalar_clamp(v.y, lo.y, hi.y),
+			scalar_clamp(v.z, lo.z, hi.z),
+			scalar_clamp(v.w, lo.w, hi.w)};
+	}
+
+	static type
+	abs(
+		type_cref v
+	) {
+		return type{
+			scalar_abs(v.x),
+			scalar_abs(v.y),
+			scalar_abs(v.z),
+			scalar_abs(v.w)};
+	}
+
+	static mask_type
+	less(
+		type_cref v,
+		type_cref r
+	) {
+		return mask_type{
+			v.x < r.x,
+			v.y < r.y,
+			v.z < r.z,
+			v.w < r.w};
+	}
+
+	static mask_type
+	less_equal(
+		type_cref v,
+		type_cref r
+	) {
+		return mask_type{
+			v.x <= r.x,
+			v.y <= r.y,
+			v.z <= r.z,
+			v.w <= r.w};
+	}
+
+	static mask_type
+	greater(
+		type_cref v,
+		type_cref r
+	) {
+		return mask_type{
+			v.x > r.x,
+			v.y > r.y,
+			v.z > r.z,
+			v.w > r.w};
+	}
+
+	static mask_type
+	greater_equal(
+		type_cref v,
+		type_cref r
+	) {
+		return mask_type{
+			v.x >= r.x,
+			v.y >= r.y,
+			v.z >= r.z,
+			v.w >= r.w};
+	}
+
+	static mask_type
+	equal(
+		type_cref v,
+		type_cref r
+	) {
+		return mask_type{
+			v.x == r.x,
+			v.y == r.y,
+			v.z == r.z,
+			v.w == r.w};
+	}
+
+	static mask_type
+	not_equal(
+		type_cref v,
+		type_cref r
+	) {
+		return mask_type{
+			v.x != r.x,
+			v.y != r.y,
+			v.z != r.z,
+			v.w != r.w};
+	}
+
+	static type
+	select(
+		mask_cref m,
+		type_cref a,
+		type_cref b
+	) {
+		return type{
+			m.x ? a.x : b.x,
+			m.y ? a.y : b.y,
+			m.z ? a.z : b.z,
+			m.w ? a.w : b.w};
+	}
+
+	static bool
+	any(
+		type_cref v
+	) {
+		return bool(v.x) | bool(v.y) | bool(v.z) | bool(v.w);
+	}
+
+	static bool
+	all(
+		type_cref v
+	) {
+		return bool(v.x) & bool(v.y) & bool(v.z) & bool(v.w);
+	}
 }; // struct tvec4<T>::operations
 /** @endcond */ // INTERNAL
 
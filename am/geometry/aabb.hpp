@@ -0,0 +1,234 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Axis-aligned bounding boxes.
+*/
+
+#pragma once
+
+#include "../config.hpp"
+#include "../detail/linear/type_traits.hpp"
+#include "../linear/vector_operations.hpp"
+#include "../linear/vec3.hpp"
+#include "../linear/mat4x4.hpp"
+#include "../linear/strided_span.hpp"
+
+#include <cstddef>
+#include <limits>
+
+namespace am {
+namespace detail {
+namespace geometry {
+
+/** @cond INTERNAL */
+template<
+	class Cons,
+	class Points
+>
+inline void
+aabb_of_impl(
+	std::size_t const count,
+	Points const& points,
+	Cons& lo,
+	Cons& hi
+) {
+	Cons lo0 = lo, lo1 = lo, lo2 = lo, lo3 = lo;
+	Cons hi0 = hi, hi1 = hi, hi2 = hi, hi3 = hi;
+	std::size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		lo0 = am::linear::min(lo0, points[i + 0]);
+		hi0 = am::linear::max(hi0, points[i + 0]);
+		lo1 = am::linear::min(lo1, points[i + 1]);
+		hi1 = am::linear::max(hi1, points[i + 1]);
+		lo2 = am::linear::min(lo2, points[i + 2]);
+		hi2 = am::linear::max(hi2, points[i + 2]);
+		lo3 = am::linear::min(lo3, points[i + 3]);
+		hi3 = am::linear::max(hi3, points[i + 3]);
+	}
+	for (; i < count; ++i) {
+		lo0 = am::linear::min(lo0, points[i]);
+		hi0 = am::linear::max(hi0, points[i]);
+	}
+	lo = am::linear::min(am::linear::min(lo0, lo1), am::linear::min(lo2, lo3));
+	hi = am::linear::max(am::linear::max(hi0, hi1), am::linear::max(hi2, hi3));
+}
+/** @endcond */ // INTERNAL
+
+} // namespace geometry
+} // namespace detail
+
+namespace geometry {
+
+/**
+	@addtogroup geometry
+	@{
+*/
+/**
+	@defgroup aabb Axis-aligned bounding boxes
+	@{
+*/
+
+/**
+	Axis-aligned bounding box.
+
+	@tparam Cons A vector type.
+*/
+template<
+	class Cons
+>
+struct aabb {
+	/** Vector type. */
+	using vector_type = Cons;
+	/** Type of components. */
+	using value_type = typename Cons::value_type;
+
+	/** Minimum corner. */
+	vector_type min;
+	/** Maximum corner. */
+	vector_type max;
+};
+
+/**
+	Get an empty bounding box.
+
+	The minimum corner is at the largest representable value and the
+	maximum corner at the smallest, so merging any point or box into
+	it gives that point or box.
+
+	@tparam Cons A vector type.
+	@returns An empty bounding box.
+*/
+template<
+	class Cons
+>
+inline aabb<Cons>
+aabb_empty() {
+	using V = typename Cons::value_type;
+	return aabb<Cons>{
+		Cons{std::numeric_limits<V>::max()},
+		Cons{std::numeric_limits<V>::lowest()}
+	};
+}
+
+/**
+	Merge two bounding boxes.
+
+	@remarks This can be used to combine partial results of
+	aabb_of() computed in parallel over subranges.
+
+	@tparam Cons A vector type.
+	@returns The bounding box enclosing @a a and @a b.
+	@param a,b Bounding boxes.
+*/
+template<
+	class Cons
+>
+inline aabb<Cons>
+aabb_merge(
+	aabb<Cons> const& a,
+	aabb<Cons> const& b
+) {
+	return aabb<Cons>{
+		linear::min(a.min, b.min),
+		linear::max(a.max, b.max)
+	};
+}
+
+/**
+	Calculate the bounding box of a sequence of points.
+
+	@note The reduction runs four independent accumulators to
+	avoid serializing on the min/max dependency chain.
+
+	@tparam Cons A vector type.
+	@returns The bounding box of @a points, or aabb_empty() if
+	@a count is @c 0.
+	@param count Number of points.
+	@param points Points.
+*/
+template<
+	class Cons
+>
+inline aabb<Cons>
+aabb_of(
+	std::size_t const count,
+	Cons const* const points
+) {
+	aabb<Cons> b = geometry::aabb_empty<Cons>();
+	detail::geometry::aabb_of_impl(count, points, b.min, b.max);
+	return b;
+}
+
+/**
+	Calculate the bounding box of a view of points.
+
+	@tparam Cons A vector type.
+	@returns The bounding box of @a points, or aabb_empty() if
+	@a points is empty.
+	@param points Points.
+*/
+template<
+	class Cons
+>
+inline aabb<Cons>
+aabb_of(
+	linear::vec_view<Cons> const& points
+) {
+	aabb<Cons> b = geometry::aabb_empty<Cons>();
+	if (points.is_contiguous()) {
+		detail::geometry::aabb_of_impl(
+			points.size(),
+			detail::linear::contiguous_access<Cons const>{points.data()},
+			b.min, b.max
+		);
+	} else {
+		detail::geometry::aabb_of_impl(
+			points.size(),
+			detail::linear::strided_access<Cons const>{points.data(), points.stride()},
+			b.min, b.max
+		);
+	}
+	return b;
+}
+
+/**
+	Transform a bounding box.
+
+	This uses Arvo's method: each column of the linear part contributes
+	its minimum and maximum over the box's extent, so only the 3x3 part
+	and the translation of @a m are used.
+
+	@note @a m must be an affine transform.
+
+	@tparam T A floating-point type.
+	@returns The bounding box enclosing @a b transformed by @a m.
+	@param b Bounding box.
+	@param m Affine transform.
+*/
+template<
+	class T
+>
+inline aabb<detail::linear::tvec3<T>>
+aabb_transform(
+	aabb<detail::linear::tvec3<T>> const& b,
+	detail::linear::tmat4x4<T> const& m
+) {
+	using vec_type = detail::linear::tvec3<T>;
+	vec_type lo{m.data[3]};
+	vec_type hi{lo};
+	for (unsigned j = 0; j < 3; ++j) {
+		vec_type const col{m.data[j]};
+		vec_type const e = col * b.min[j];
+		vec_type const f = col * b.max[j];
+		lo += linear::min(e, f);
+		hi += linear::max(e, f);
+	}
+	return aabb<vec_type>{lo, hi};
+}
+
+/** @} */ // end of doc-group aabb
+/** @} */ // end of doc-group geometry
+
+} // namespace geometry
+} // namespace am
@@ -0,0 +1,463 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief View frustums.
+*/
+
+#pragma once
+
+#include "../config.hpp"
+#include "../linear/vector_operations.hpp"
+#include "../linear/vec3.hpp"
+#include "../linear/vec4.hpp"
+#include "../linear/mat4x4.hpp"
+#include "../linear/strided_span.hpp"
+#include "./aabb.hpp"
+#include "./sphere.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+
+namespace am {
+namespace detail {
+namespace geometry {
+
+/** @cond INTERNAL */
+template<
+	class TestF
+>
+inline void
+frustum_cull_impl(
+	std::size_t const count,
+	std::uint64_t* const mask,
+	TestF const& test
+) {
+	std::size_t const blocks = (count + 63) >> 6;
+	for (std::size_t b = 0; b < blocks; ++b) {
+		std::size_t const base = b << 6;
+		std::size_t const n = (count - base < 64) ? count - base : 64;
+		std::uint64_t word = 0;
+		for (std::size_t k = 0; k < n; ++k) {
+			word |= static_cast<std::uint64_t>(test(base + k)) << k;
+		}
+		mask[b] = word;
+	}
+}
+
+// Objects is a pointer or element accessor; frustum_intersects() is
+// found by ADL at instantiation
+template<
+	class Frustum,
+	class Objects
+>
+inline void
+frustum_cull_objects(
+	Frustum const& f,
+	std::size_t const count,
+	Objects const& objects,
+	std::uint64_t* const mask
+) {
+	Frustum const g = f;
+	geometry::frustum_cull_impl(
+		count, mask,
+		[&g, &objects](std::size_t const i) {
+			return frustum_intersects(g, objects[i]);
+		}
+	);
+}
+/** @endcond */ // INTERNAL
+
+} // namespace geometry
+} // namespace detail
+
+namespace geometry {
+
+/**
+	@addtogroup geometry
+	@{
+*/
+/**
+	@defgroup frustum Frustums
+	@details
+	Planes are stored as @c tvec4 with the normal in @c xyz and the
+	offset in @c w; a point @c p is on the inner side of a plane if
+	<code>dot(plane.xyz, p) + plane.w >= 0</code>.
+
+	The culling kernels write one bit per object to a mask of 64-bit
+	words: bit <code>i % 64</code> of word <code>i / 64</code> is set
+	if object @c i is (potentially) visible. Bits past the last object
+	in the last word are cleared. Objects are tested in blocks of 64
+	with the plane values hoisted out of the loop, and the inner loop
+	has no branches, so the compiler can vectorize it.
+	@{
+*/
+
+/**
+	Clip-space depth range of a projection.
+*/
+enum class ClipDepth : unsigned {
+	/** OpenGL convention: <code>-w <= z <= w</code>. */
+	negative_one_to_one,
+	/** Direct3D/Vulkan convention: <code>0 <= z <= w</code>. */
+	zero_to_one,
+};
+
+/**
+	Frustum plane indices.
+*/
+enum FrustumPlane : unsigned {
+	/** Left plane. */
+	FP_LEFT = 0u,
+	/** Right plane. */
+	FP_RIGHT,
+	/** Bottom plane. */
+	FP_BOTTOM,
+	/** Top plane. */
+	FP_TOP,
+	/** Near plane. */
+	FP_NEAR,
+	/** Far plane. */
+	FP_FAR,
+	/** Number of planes. */
+	FP_COUNT
+};
+
+/**
+	View frustum.
+
+	@tparam T A floating-point type.
+*/
+template<
+	class T
+>
+struct frustum {
+	/** Type of components. */
+	using value_type = T;
+	/** Plane type. */
+	using plane_type = detail::linear::tvec4<T>;
+
+	/** Planes (normals point inward); indexed by FrustumPlane. */
+	plane_type planes[FP_COUNT];
+};
+
+/**
+	Extract frustum planes from a view-projection matrix.
+
+	This is the Gribb-Hartmann method: each plane is a sum or
+	difference of the fourth row of @a m and one of the others.
+	If @a m is a projection matrix, the planes are in view space; if it
+	is a view-projection matrix, they are in world space.
+
+	@tparam T A floating-point type.
+	@returns The frustum of @a m.
+	@param m (View-)projection matrix.
+	@param depth Clip-space depth range of @a m.
+	@param normalize Whether to normalize the planes. Normalized planes
+	are required for sphere tests.
+*/
+template<
+	class T
+>
+inline frustum<T>
+frustum_planes(
+	detail::linear::tmat4x4<T> const& m,
+	ClipDepth const depth = ClipDepth::negative_one_to_one,
+	bool const normalize = true
+) {
+	using plane_type = typename frustum<T>::plane_type;
+	plane_type const r0{m.data[0].x, m.data[1].x, m.data[2].x, m.data[3].x};
+	plane_type const r1{m.data[0].y, m.data[1].y, m.data[2].y, m.data[3].y};
+	plane_type const r2{m.data[0].z, m.data[1].z, m.data[2].z, m.data[3].z};
+	plane_type const r3{m.data[0].w, m.data[1].w, m.data[2].w, m.data[3].w};
+
+	frustum<T> f;
+	f.planes[FP_LEFT] = r3 + r0;
+	f.planes[FP_RIGHT] = r3 - r0;
+	f.planes[FP_BOTTOM] = r3 + r1;
+	f.planes[FP_TOP] = r3 - r1;
+	f.planes[FP_NEAR]
+		= (ClipDepth::zero_to_one == depth)
+		? r2
+		: r3 + r2
+	;
+	f.planes[FP_FAR] = r3 - r2;
+	if (normalize) {
+		for (auto& p : f.planes) {
+			p /= linear::length(detail::linear::tvec3<T>{p});
+		}
+	}
+	return f;
+}
+
+/**
+	Test whether a sphere intersects a frustum.
+
+	@note The planes of @a f must be normalized.
+
+	@tparam T A floating-point type.
+	@returns @c false if @a s is completely outside @a f.
+	@param f Frustum.
+	@param s Sphere.
+*/
+template<
+	class T
+>
+inline bool
+frustum_intersects(
+	frustum<T> const& f,
+	sphere<detail::linear::tvec3<T>> const& s
+) {
+	bool inside = true;
+	for (auto const& p : f.planes) {
+		inside &=
+			p.x * s.center.x + p.y * s.center.y + p.z * s.center.z + p.w
+			>= -s.radius
+		;
+	}
+	return inside;
+}
+
+/**
+	Test whether a bounding box intersects a frustum.
+
+	@note This is conservative: boxes near a frustum corner may pass
+	even if they are outside.
+
+	@tparam T A floating-point type.
+	@returns @c false if @a b is completely outside @a f.
+	@param f Frustum.
+	@param b Bounding box.
+*/
+template<
+	class T
+>
+inline bool
+frustum_intersects(
+	frustum<T> const& f,
+	aabb<detail::linear::tvec3<T>> const& b
+) {
+	auto const c = (b.min + b.max) * T(0.5);
+	auto const e = (b.max - b.min) * T(0.5);
+	bool inside = true;
+	for (auto const& p : f.planes) {
+		inside &=
+			p.x * c.x + p.y * c.y + p.z * c.z + p.w >=
+			-(std::abs(p.x) * e.x + std::abs(p.y) * e.y + std::abs(p.z) * e.z)
+		;
+	}
+	return inside;
+}
+
+/**
+	Cull spheres against a frustum (structure of arrays).
+
+	@note The planes of @a f must be normalized.
+
+	@tparam T A floating-point type.
+	@param f Frustum.
+	@param count Number of spheres.
+	@param x,y,z Sphere centers; each must have @a count values.
+	@param r Sphere radii; must have @a count values.
+	@param[out] mask Visibility mask; must have room for
+	<code>(count + 63) / 64</code> words.
+*/
+template<
+	class T
+>
+inline void
+frustum_cull_spheres(
+	frustum<T> const& f,
+	std::size_t const count,
+	T const* const x,
+	T const* const y,
+	T const* const z,
+	T const* const r,
+	std::uint64_t* const mask
+) {
+	frustum<T> const g = f;
+	detail::geometry::frustum_cull_impl(
+		count, mask,
+		[&g, x, y, z, r](std::size_t const i) {
+			bool inside = true;
+			for (auto const& p : g.planes) {
+				inside &= p.x * x[i] + p.y * y[i] + p.z * z[i] + p.w >= -r[i];
+			}
+			return inside;
+		}
+	);
+}
+
+/**
+	Cull spheres against a frustum.
+
+	@note The planes of @a f must be normalized.
+
+	@tparam T A floating-point type.
+	@param f Frustum.
+	@param count Number of spheres.
+	@param spheres Spheres.
+	@param[out] mask Visibility mask; must have room for
+	<code>(count + 63) / 64</code> words.
+*/
+template<
+	class T
+>
+inline void
+frustum_cull_spheres(
+	frustum<T> const& f,
+	std::size_t const count,
+	sphere<detail::linear::tvec3<T>> const* const spheres,
+	std::uint64_t* const mask
+) {
+	detail::geometry::frustum_cull_objects(f, count, spheres, mask);
+}
+
+/**
+	Cull a view of spheres against a frustum.
+
+	@note The planes of @a f must be normalized.
+
+	@tparam T A floating-point type.
+	@param f Frustum.
+	@param spheres Spheres.
+	@param[out] mask Visibility mask; must have room for
+	<code>(spheres.size() + 63) / 64</code> words.
+*/
+template<
+	class T
+>
+inline void
+frustum_cull_spheres(
+	frustum<T> const& f,
+	linear::strided_span<sphere<detail::linear::tvec3<T>> const> const& spheres,
+	std::uint64_t* const mask
+) {
+	using sphere_type = sphere<detail::linear::tvec3<T>>;
+	if (spheres.is_contiguous()) {
+		detail::geometry::frustum_cull_objects(
+			f, spheres.size(),
+			detail::linear::contiguous_access<sphere_type const>{spheres.data()},
+			mask
+		);
+	} else {
+		detail::geometry::frustum_cull_objects(
+			f, spheres.size(),
+			detail::linear::strided_access<sphere_type const>{spheres.data(), spheres.stride()},
+			mask
+		);
+	}
+}
+
+/**
+	Cull bounding boxes against a frustum (structure of arrays).
+
+	@tparam T A floating-point type.
+	@param f Frustum.
+	@param count Number of boxes.
+	@param cx,cy,cz Box centers; each must have @a count values.
+	@param ex,ey,ez Box half-extents; each must have @a count values.
+	@param[out] mask Visibility mask; must have room for
+	<code>(count + 63) / 64</code> words.
+*/
+template<
+	class T
+>
+inline void
+frustum_cull_aabbs(
+	frustum<T> const& f,
+	std::size_t const count,
+	T const* const cx,
+	T const* const cy,
+	T const* const cz,
+	T const* const ex,
+	T const* const ey,
+	T const* const ez,
+	std::uint64_t* const mask
+) {
+	frustum<T> const g = f;
+	// Plane normal magnitudes, hoisted
+	frustum<T> a;
+	for (unsigned k = 0; k < FP_COUNT; ++k) {
+		a.planes[k] = linear::abs(g.planes[k]);
+	}
+	detail::geometry::frustum_cull_impl(
+		count, mask,
+		[&](std::size_t const i) {
+			bool inside = true;
+			for (unsigned k = 0; k < FP_COUNT; ++k) {
+				auto const& p = g.planes[k];
+				auto const& q = a.planes[k];
+				inside &=
+					p.x * cx[i] + p.y * cy[i] + p.z * cz[i] + p.w >=
+					-(q.x * ex[i] + q.y * ey[i] + q.z * ez[i])
+				;
+			}
+			return inside;
+		}
+	);
+}
+
+/**
+	Cull bounding boxes against a frustum.
+
+	@tparam T A floating-point type.
+	@param f Frustum.
+	@param count Number of boxes.
+	@param boxes Bounding boxes.
+	@param[out] mask Visibility mask; must have room for
+	<code>(count + 63) / 64</code> words.
+*/
+template<
+	class T
+>
+inline void
+frustum_cull_aabbs(
+	frustum<T> const& f,
+	std::size_t const count,
+	aabb<detail::linear::tvec3<T>> const* const boxes,
+	std::uint64_t* const mask
+) {
+	detail::geometry::frustum_cull_objects(f, count, boxes, mask);
+}
+
+/**
+	Cull a view of bounding boxes against a frustum.
+
+	@tparam T A floating-point type.
+	@param f Frustum.
+	@param boxes Bounding boxes.
+	@param[out] mask Visibility mask; must have room for
+	<code>(boxes.size() + 63) / 64</code> words.
+*/
+template<
+	class T
+>
+inline void
+frustum_cull_aabbs(
+	frustum<T> const& f,
+	linear::strided_span<aabb<detail::linear::tvec3<T>> const> const& boxes,
+	std::uint64_t* const mask
+) {
+	using aabb_type = aabb<detail::linear::tvec3<T>>;
+	if (boxes.is_contiguous()) {
+		detail::geometry::frustum_cull_objects(
+			f, boxes.size(),
+			detail::linear::contiguous_access<aabb_type const>{boxes.data()},
+			mask
+		);
+	} else {
+		detail::geometry::frustum_cull_objects(
+			f, boxes.size(),
+			detail::linear::strided_access<aabb_type const>{boxes.data(), boxes.stride()},
+			mask
+		);
+	}
+}
+
+/** @} */ // end of doc-group frustum
+/** @} */ // end of doc-group geometry
+
+} // namespace geometry
+} // namespace am
@@ -0,0 +1,492 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Ray intersection.
+*/
+
+#pragma once
+
+#include "../config.hpp"
+#include "../linear/vector_operations.hpp"
+#include "../linear/vec3.hpp"
+#include "./aabb.hpp"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace am {
+namespace geometry {
+
+/**
+	@addtogroup geometry
+	@{
+*/
+/**
+	@defgroup intersection Ray intersection
+	@details
+	All intersection functions take the current closest hit distance
+	@c t as an in/out parameter. A primitive is only hit if it is
+	closer than @c t, in which case @c t is updated. This lets a closest
+	hit search run over many primitives without extra comparisons.
+
+	Packet forms operate on @c N lanes stored as structures of arrays
+	(typically @c N is @c 4 or @c 8 to match SSE or AVX registers).
+	They compute every lane without branching and return a bitmask of
+	the lanes that were hit.
+	@{
+*/
+
+/**
+	Ray.
+
+	@tparam T A floating-point type.
+*/
+template<
+	class T
+>
+struct ray {
+	/** Vector type. */
+	using vector_type = detail::linear::tvec3<T>;
+
+	/** Origin. */
+	vector_type origin;
+	/** Direction. */
+	vector_type direction;
+};
+
+/**
+	Packet of rays.
+
+	@tparam T A floating-point type.
+	@tparam N Number of rays.
+*/
+template<
+	class T,
+	unsigned N
+>
+struct ray_packet {
+	/** Origins. */
+	T ox[N], oy[N], oz[N];
+	/** Directions. */
+	T dx[N], dy[N], dz[N];
+};
+
+/**
+	Packet of triangles.
+
+	Triangles are stored as a vertex and two edges so that the
+	edges need not be recomputed for every ray.
+
+	@tparam T A floating-point type.
+	@tparam N Number of triangles.
+*/
+template<
+	class T,
+	unsigned N
+>
+struct triangle_packet {
+	/** First vertices. */
+	T v0x[N], v0y[N], v0z[N];
+	/** First edges (<code>v1 - v0</code>). */
+	T e1x[N], e1y[N], e1z[N];
+	/** Second edges (<code>v2 - v0</code>). */
+	T e2x[N], e2y[N], e2z[N];
+
+	/**
+		Assign a lane.
+
+		@param i Lane.
+		@param v0,v1,v2 Vertices.
+	*/
+	void
+	set(
+		unsigned const i,
+		detail::linear::tvec3<T> const& v0,
+		detail::linear::tvec3<T> const& v1,
+		detail::linear::tvec3<T> const& v2
+	) noexcept {
+		v0x[i] = v0.x; v0y[i] = v0.y; v0z[i] = v0.z;
+		e1x[i] = v1.x - v0.x; e1y[i] = v1.y - v0.y; e1z[i] = v1.z - v0.z;
+		e2x[i] = v2.x - v0.x; e2y[i] = v2.y - v0.y; e2z[i] = v2.z - v0.z;
+	}
+};
+
+/**
+	Packet of bounding boxes.
+
+	@tparam T A floating-point type.
+	@tparam N Number of boxes.
+*/
+template<
+	class T,
+	unsigned N
+>
+struct aabb_packet {
+	/** Minimum corners. */
+	T min_x[N], min_y[N], min_z[N];
+	/** Maximum corners. */
+	T max_x[N], max_y[N], max_z[N];
+
+	/**
+		Assign a lane.
+
+		@param i Lane.
+		@param b Bounding box.
+	*/
+	void
+	set(
+		unsigned const i,
+		aabb<detail::linear::tvec3<T>> const& b
+	) noexcept {
+		min_x[i] = b.min.x; min_y[i] = b.min.y; min_z[i] = b.min.z;
+		max_x[i] = b.max.x; max_y[i] = b.max.y; max_z[i] = b.max.z;
+	}
+};
+
+/**
+	Calculate the component-wise inverse of a ray direction.
+
+	@note Zero components become infinities, which the slab test
+	handles.
+
+	@tparam T A floating-point type.
+	@returns <code>1 / r.direction</code>.
+	@param r Ray.
+*/
+template<
+	class T
+>
+inline detail::linear::tvec3<T>
+inverse_direction(
+	ray<T> const& r
+) {
+	return T(1) / r.direction;
+}
+
+/**
+	Intersect a ray with a triangle.
+
+	This uses the Möller-Trumbore algorithm. Both faces are hit.
+
+	@tparam T A floating-point type.
+	@returns Whether the triangle was hit closer than @a t.
+	@param r Ray.
+	@param v0,v1,v2 Triangle vertices.
+	@param[in,out] t Closest hit distance (in units of the ray
+	direction).
+	@param[out] u,v Barycentric coordinates of the hit (for @a v1 and
+	@a v2, respectively); only assigned on hit.
+*/
+template<
+	class T
+>
+inline bool
+intersect_triangle(
+	ray<T> const& r,
+	detail::linear::tvec3<T> const& v0,
+	detail::linear::tvec3<T> const& v1,
+	detail::linear::tvec3<T> const& v2,
+	T& t,
+	T& u,
+	T& v
+) {
+	using vec_type = detail::linear::tvec3<T>;
+	vec_type const e1 = v1 - v0;
+	vec_type const e2 = v2 - v0;
+	vec_type const p = linear::cross(r.direction, e2);
+	T const det = linear::dot(e1, p);
+	if (std::abs(det) <= std::numeric_limits<T>::min()) {
+		return false;
+	}
+	T const inv_det = T(1) / det;
+	vec_type const s = r.origin - v0;
+	T const hu = linear::dot(s, p) * inv_det;
+	if (T(0) > hu || T(1) < hu) {
+		return false;
+	}
+	vec_type const q = linear::cross(s, e1);
+	T const hv = linear::dot(r.direction, q) * inv_det;
+	if (T(0) > hv || T(1) < hu + hv) {
+		return false;
+	}
+	T const ht = linear::dot(e2, q) * inv_det;
+	if (T(0) >= ht || t <= ht) {
+		return false;
+	}
+	t = ht;
+	u = hu;
+	v = hv;
+	return true;
+}
+
+/**
+	Intersect a ray with a bounding box.
+
+	This is the slab test.
+
+	@tparam T A floating-point type.
+	@returns Whether the box was entered closer than @a t.
+	@param r Ray.
+	@param inv_dir Inverse ray direction (see inverse_direction()).
+	@param b Bounding box.
+	@param[in,out] t Closest hit distance; set to the entry distance on
+	hit (@c 0 if the origin is inside the box).
+*/
+template<
+	class T
+>
+inline bool
+intersect_aabb(
+	ray<T> const& r,
+	detail::linear::tvec3<T> const& inv_dir,
+	aabb<detail::linear::tvec3<T>> const& b,
+	T& t
+) {
+	using vec_type = detail::linear::tvec3<T>;
+	vec_type const t0 = (b.min - r.origin) * inv_dir;
+	vec_type const t1 = (b.max - r.origin) * inv_dir;
+	vec_type const tn = linear::min(t0, t1);
+	vec_type const tf = linear::max(t0, t1);
+	T const enter = std::max(std::max(tn.x, tn.y), std::max(tn.z, T(0)));
+	T const exit = std::min(std::min(tf.x, tf.y), std::min(tf.z, t));
+	if (!(enter <= exit && enter < t)) {
+		return false;
+	}
+	t = enter;
+	return true;
+}
+
+/**
+	Intersect a packet of rays with a triangle.
+
+	@tparam T A floating-point type.
+	@tparam N Number of rays.
+	@returns Bitmask of rays that hit the triangle closer than their
+	@a t.
+	@param p Rays.
+	@param v0,v1,v2 Triangle vertices.
+	@param[in,out] t Closest hit distance for each ray.
+	@param[in,out] u,v Barycentric coordinates of each hit; unchanged
+	for rays that miss (each lane is selected without branching, so
+	these must be initialized).
+*/
+template<
+	class T,
+	unsigned N
+>
+inline unsigned
+intersect_triangle(
+	ray_packet<T, N> const& p,
+	detail::linear::tvec3<T> const& v0,
+	detail::linear::tvec3<T> const& v1,
+	detail::linear::tvec3<T> const& v2,
+	T (&t)[N],
+	T (&u)[N],
+	T (&v)[N]
+) {
+	AM_STATIC_ASSERT(32 >= N, "N must fit in the result mask");
+	using vec_type = detail::linear::tvec3<T>;
+	vec_type const e1 = v1 - v0;
+	vec_type const e2 = v2 - v0;
+	unsigned mask = 0;
+	for (unsigned i = 0; i < N; ++i) {
+		// p = d × e2
+		T const px = p.dy[i] * e2.z - p.dz[i] * e2.y;
+		T const py = p.dz[i] * e2.x - p.dx[i] * e2.z;
+		T const pz = p.dx[i] * e2.y - p.dy[i] * e2.x;
+		T const det = e1.x * px + e1.y * py + e1.z * pz;
+		T const inv_det = T(1) / det;
+		T const sx = p.ox[i] - v0.x;
+		T const sy = p.oy[i] - v0.y;
+		T const sz = p.oz[i] - v0.z;
+		T const hu = (sx * px + sy * py + sz * pz) * inv_det;
+		// q = s × e1
+		T const qx = sy * e1.z - sz * e1.y;
+		T const qy = sz * e1.x - sx * e1.z;
+		T const qz = sx * e1.y - sy * e1.x;
+		T const hv = (p.dx[i] * qx + p.dy[i] * qy + p.dz[i] * qz) * inv_det;
+		T const ht = (e2.x * qx + e2.y * qy + e2.z * qz) * inv_det;
+		bool const hit
+			= (std::abs(det) > std::numeric_limits<T>::min())
+			& (T(0) <= hu) & (T(0) <= hv) & (T(1) >= hu + hv)
+			& (T(0) < ht) & (t[i] > ht)
+		;
+		t[i] = hit ? ht : t[i];
+		u[i] = hit ? hu : u[i];
+		v[i] = hit ? hv : v[i];
+		mask |= static_cast<unsigned>(hit) << i;
+	}
+	return mask;
+}
+
+/**
+	Intersect a ray with a packet of triangles.
+
+	@tparam T A floating-point type.
+	@tparam N Number of triangles.
+	@returns Bitmask of triangles that were hit closer than the
+	closest hit at the time they were tested; the last bit set is
+	the closest hit.
+	@param r Ray.
+	@param tris Triangles.
+	@param[in,out] t Closest hit distance.
+	@param[out] u,v Barycentric coordinates of the closest hit; only
+	assigned on hit.
+*/
+template<
+	class T,
+	unsigned N
+>
+inline unsigned
+intersect_triangle(
+	ray<T> const& r,
+	triangle_packet<T, N> const& tris,
+	T& t,
+	T& u,
+	T& v
+) {
+	AM_STATIC_ASSERT(32 >= N, "N must fit in the result mask");
+	T ht[N], hu[N], hv[N];
+	bool hit[N];
+	T const dx = r.direction.x, dy = r.direction.y, dz = r.direction.z;
+	for (unsigned i = 0; i < N; ++i) {
+		T const px = dy * tris.e2z[i] - dz * tris.e2y[i];
+		T const py = dz * tris.e2x[i] - dx * tris.e2z[i];
+		T const pz = dx * tris.e2y[i] - dy * tris.e2x[i];
+		T const det = tris.e1x[i] * px + tris.e1y[i] * py + tris.e1z[i] * pz;
+		T const inv_det = T(1) / det;
+		T const sx = r.origin.x - tris.v0x[i];
+		T const sy = r.origin.y - tris.v0y[i];
+		T const sz = r.origin.z - tris.v0z[i];
+		hu[i] = (sx * px + sy * py + sz * pz) * inv_det;
+		T const qx = sy * tris.e1z[i] - sz * tris.e1y[i];
+		T const qy = sz * tris.e1x[i] - sx * tris.e1z[i];
+		T const qz = sx * tris.e1y[i] - sy * tris.e1x[i];
+		hv[i] = (dx * qx + dy * qy + dz * qz) * inv_det;
+		ht[i] = (tris.e2x[i] * qx + tris.e2y[i] * qy + tris.e2z[i] * qz) * inv_det;
+		hit[i]
+			= (std::abs(det) > std::numeric_limits<T>::min())
+			& (T(0) <= hu[i]) & (T(0) <= hv[i]) & (T(1) >= hu[i] + hv[i])
+			& (T(0) < ht[i])
+		;
+	}
+	// Reduce to the closest hit
+	unsigned mask = 0;
+	for (unsigned i = 0; i < N; ++i) {
+		if (hit[i] && t > ht[i]) {
+			t = ht[i];
+			u = hu[i];
+			v = hv[i];
+			mask |= 1u << i;
+		}
+	}
+	return mask;
+}
+
+/**
+	Intersect a packet of rays with a bounding box.
+
+	@tparam T A floating-point type.
+	@tparam N Number of rays.
+	@returns Bitmask of rays that entered the box closer than their
+	@a t.
+	@param p Rays.
+	@param inv_dx,inv_dy,inv_dz Inverse ray directions.
+	@param b Bounding box.
+	@param[in,out] t Closest hit distance for each ray; set to the entry
+	distance for rays that hit.
+*/
+template<
+	class T,
+	unsigned N
+>
+inline unsigned
+intersect_aabb(
+	ray_packet<T, N> const& p,
+	T const (&inv_dx)[N],
+	T const (&inv_dy)[N],
+	T const (&inv_dz)[N],
+	aabb<detail::linear::tvec3<T>> const& b,
+	T (&t)[N]
+) {
+	AM_STATIC_ASSERT(32 >= N, "N must fit in the result mask");
+	unsigned mask = 0;
+	for (unsigned i = 0; i < N; ++i) {
+		T const x0 = (b.min.x - p.ox[i]) * inv_dx[i];
+		T const x1 = (b.max.x - p.ox[i]) * inv_dx[i];
+		T const y0 = (b.min.y - p.oy[i]) * inv_dy[i];
+		T const y1 = (b.max.y - p.oy[i]) * inv_dy[i];
+		T const z0 = (b.min.z - p.oz[i]) * inv_dz[i];
+		T const z1 = (b.max.z - p.oz[i]) * inv_dz[i];
+		T const enter = std::max(
+			std::max(std::min(x0, x1), std::min(y0, y1)),
+			std::max(std::min(z0, z1), T(0))
+		);
+		T const exit = std::min(
+			std::min(std::max(x0, x1), std::max(y0, y1)),
+			std::min(std::max(z0, z1), t[i])
+		);
+		bool const hit = (enter <= exit) & (enter < t[i]);
+		t[i] = hit ? enter : t[i];
+		mask |= static_cast<unsigned>(hit) << i;
+	}
+	return mask;
+}
+
+/**
+	Intersect a ray with a packet of bounding boxes.
+
+	This is the typical test for the children of a wide BVH node.
+
+	@tparam T A floating-point type.
+	@tparam N Number of boxes.
+	@returns Bitmask of boxes entered closer than @a t.
+	@param r Ray.
+	@param inv_dir Inverse ray direction (see inverse_direction()).
+	@param boxes Bounding boxes.
+	@param t Closest hit distance.
+	@param[out] enter Entry distance for each box; only meaningful for
+	boxes that were hit.
+*/
+template<
+	class T,
+	unsigned N
+>
+inline unsigned
+intersect_aabb(
+	ray<T> const& r,
+	detail::linear::tvec3<T> const& inv_dir,
+	aabb_packet<T, N> const& boxes,
+	T const t,
+	T (&enter)[N]
+) {
+	AM_STATIC_ASSERT(32 >= N, "N must fit in the result mask");
+	unsigned mask = 0;
+	for (unsigned i = 0; i < N; ++i) {
+		T const x0 = (boxes.min_x[i] - r.origin.x) * inv_dir.x;
+		T const x1 = (boxes.max_x[i] - r.origin.x) * inv_dir.x;
+		T const y0 = (boxes.min_y[i] - r.origin.y) * inv_dir.y;
+		T const y1 = (boxes.max_y[i] - r.origin.y) * inv_dir.y;
+		T const z0 = (boxes.min_z[i] - r.origin.z) * inv_dir.z;
+		T const z1 = (boxes.max_z[i] - r.origin.z) * inv_dir.z;
+		T const tn = std::max(
+			std::max(std::min(x0, x1), std::min(y0, y1)),
+			std::max(std::min(z0, z1), T(0))
+		);
+		T const tf = std::min(
+			std::min(std::max(x0, x1), std::max(y0, y1)),
+			std::min(std::max(z0, z1), t)
+		);
+		enter[i] = tn;
+		mask |= static_cast<unsigned>((tn <= tf) & (tn < t)) << i;
+	}
+	return mask;
+}
+
+/** @} */ // end of doc-group intersection
+/** @} */ // end of doc-group geometry
+
+} // namespace geometry
+} // namespace am
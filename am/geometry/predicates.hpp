@@ -0,0 +1,597 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Robust geometric predicates.
+*/
+
+#pragma once
+
+#include "../config.hpp"
+#include "../linear/vec2.hpp"
+#include "../linear/vec3.hpp"
+
+#include <cstddef>
+#include <cmath>
+#include <limits>
+
+namespace am {
+namespace detail {
+namespace geometry {
+
+/** @cond INTERNAL */
+
+// Floating-point expansion arithmetic (Shewchuk, 1997).
+// An expansion is a sum of non-overlapping components stored in
+// order of increasing magnitude; its sign is the sign of the last
+// component. All routines eliminate zero components, but every
+// expansion has at least one component.
+
+template<
+	class T
+>
+struct expansion_constants {
+	AM_STATIC_ASSERT(
+		std::numeric_limits<T>::is_iec559,
+		"T must be an IEEE 754 floating-point type"
+	);
+
+	// 2^-p, where p is the number of significand bits
+	static constexpr T epsilon = std::numeric_limits<T>::epsilon() / T(2);
+	// 2^ceil(p / 2) + 1
+	static constexpr T splitter
+		= T(1ull << ((std::numeric_limits<T>::digits + 1) / 2)) + T(1)
+	;
+
+	static constexpr T orient2d_bound = (T(3) + T(16) * epsilon) * epsilon;
+	static constexpr T orient3d_bound = (T(7) + T(56) * epsilon) * epsilon;
+	static constexpr T incircle_bound = (T(10) + T(96) * epsilon) * epsilon;
+};
+
+template<class T> constexpr T expansion_constants<T>::epsilon;
+template<class T> constexpr T expansion_constants<T>::splitter;
+template<class T> constexpr T expansion_constants<T>::orient2d_bound;
+template<class T> constexpr T expansion_constants<T>::orient3d_bound;
+template<class T> constexpr T expansion_constants<T>::incircle_bound;
+
+template<
+	class T
+>
+inline void
+two_sum(
+	T const a,
+	T const b,
+	T& x,
+	T& y
+) noexcept {
+	x = a + b;
+	T const bv = x - a;
+	T const av = x - bv;
+	y = (a - av) + (b - bv);
+}
+
+template<
+	class T
+>
+inline void
+fast_two_sum(
+	T const a,
+	T const b,
+	T& x,
+	T& y
+) noexcept {
+	x = a + b;
+	y = b - (x - a);
+}
+
+template<
+	class T
+>
+inline void
+two_diff(
+	T const a,
+	T const b,
+	T& x,
+	T& y
+) noexcept {
+	x = a - b;
+	T const bv = a - x;
+	T const av = x + bv;
+	y = (a - av) + (bv - b);
+}
+
+template<
+	class T
+>
+inline void
+split(
+	T const a,
+	T& hi,
+	T& lo
+) noexcept {
+	T const c = expansion_constants<T>::splitter * a;
+	hi = c - (c - a);
+	lo = a - hi;
+}
+
+template<
+	class T
+>
+inline void
+two_product(
+	T const a,
+	T const b,
+	T& x,
+	T& y
+) noexcept {
+	x = a * b;
+	T ahi, alo, bhi, blo;
+	split(a, ahi, alo);
+	split(b, bhi, blo);
+	T const e1 = x - ahi * bhi;
+	T const e2 = e1 - alo * bhi;
+	T const e3 = e2 - ahi * blo;
+	y = alo * blo - e3;
+}
+
+// h = e + f; h must have room for en + fn components
+template<
+	class T
+>
+inline std::size_t
+expansion_sum(
+	std::size_t const en,
+	T const* const e,
+	std::size_t const fn,
+	T const* const f,
+	T* const h
+) noexcept {
+	std::size_t ei = 0, fi = 0, hi = 0;
+	T q, qn, hh;
+	auto const take_e = [&]() {
+		return fi == fn || (
+			ei < en && (f[fi] > e[ei]) == (f[fi] > -e[ei])
+		);
+	};
+	if (take_e()) {
+		q = e[ei++];
+	} else {
+		q = f[fi++];
+	}
+	if (ei < en && fi < fn) {
+		if (take_e()) {
+			fast_two_sum(e[ei++], q, qn, hh);
+		} else {
+			fast_two_sum(f[fi++], q, qn, hh);
+		}
+		q = qn;
+		if (hh != T(0)) {
+			h[hi++] = hh;
+		}
+	}
+	while (ei < en || fi < fn) {
+		if (take_e()) {
+			two_sum(q, e[ei++], qn, hh);
+		} else {
+			two_sum(q, f[fi++], qn, hh);
+		}
+		q = qn;
+		if (hh != T(0)) {
+			h[hi++] = hh;
+		}
+	}
+	if (q != T(0) || hi == 0) {
+		h[hi++] = q;
+	}
+	return hi;
+}
+
+// h = e * b; h must have room for 2 * en components
+template<
+	class T
+>
+inline std::size_t
+expansion_scale(
+	std::size_t const en,
+	T const* const e,
+	T const b,
+	T* const h
+) noexcept {
+	std::size_t hi = 0;
+	T q, hh, p1, p0, s;
+	two_product(e[0], b, q, hh);
+	if (hh != T(0)) {
+		h[hi++] = hh;
+	}
+	for (std::size_t i = 1; i < en; ++i) {
+		two_product(e[i], b, p1, p0);
+		two_sum(q, p0, s, hh);
+		if (hh != T(0)) {
+			h[hi++] = hh;
+		}
+		fast_two_sum(p1, s, q, hh);
+		if (hh != T(0)) {
+			h[hi++] = hh;
+		}
+	}
+	if (q != T(0) || hi == 0) {
+		h[hi++] = q;
+	}
+	return hi;
+}
+
+template<
+	class T
+>
+inline void
+expansion_negate(
+	std::size_t const en,
+	T* const e
+) noexcept {
+	for (std::size_t i = 0; i < en; ++i) {
+		e[i] = -e[i];
+	}
+}
+
+// h = e * f; h must have room for 2 * EN * FN components
+template<
+	std::size_t EN,
+	std::size_t FN,
+	class T
+>
+inline std::size_t
+expansion_product(
+	std::size_t const en,
+	T const* const e,
+	std::size_t const fn,
+	T const* const f,
+	T* const h
+) noexcept {
+	T term[2 * EN];
+	T buffer[2 * EN * FN];
+	// Accumulate so that the final sum lands in h
+	T* acc = (fn & 1u) ? h : buffer;
+	T* out = (fn & 1u) ? buffer : h;
+	std::size_t n = expansion_scale(en, e, f[0], acc);
+	for (std::size_t i = 1; i < fn; ++i) {
+		std::size_t const tn = expansion_scale(en, e, f[i], term);
+		n = expansion_sum(n, acc, tn, term, out);
+		T* const swap = acc;
+		acc = out;
+		out = swap;
+	}
+	return n;
+}
+
+// h = a - b; returns the number of components
+template<
+	class T
+>
+inline std::size_t
+expansion_diff(
+	T const a,
+	T const b,
+	T (&h)[2]
+) noexcept {
+	two_diff(a, b, h[1], h[0]);
+	if (h[0] == T(0)) {
+		h[0] = h[1];
+		return 1;
+	}
+	return 2;
+}
+
+// h = a * d - b * c
+template<
+	class T
+>
+inline std::size_t
+expansion_cross(
+	std::size_t const an, T const (&a)[2],
+	std::size_t const bn, T const (&b)[2],
+	std::size_t const cn, T const (&c)[2],
+	std::size_t const dn, T const (&d)[2],
+	T (&h)[16]
+) noexcept {
+	T ad[8], bc[8];
+	std::size_t const adn = expansion_product<2, 2>(an, a, dn, d, ad);
+	std::size_t const bcn = expansion_product<2, 2>(bn, b, cn, c, bc);
+	expansion_negate(bcn, bc);
+	return expansion_sum(adn, ad, bcn, bc, h);
+}
+
+template<
+	class T
+>
+T
+orient2d_exact(
+	T const ax, T const ay,
+	T const bx, T const by,
+	T const cx, T const cy
+) noexcept {
+	T acx[2], acy[2], bcx[2], bcy[2];
+	std::size_t const acxn = expansion_diff(ax, cx, acx);
+	std::size_t const acyn = expansion_diff(ay, cy, acy);
+	std::size_t const bcxn = expansion_diff(bx, cx, bcx);
+	std::size_t const bcyn = expansion_diff(by, cy, bcy);
+	T det[16];
+	std::size_t const n = expansion_cross(
+		acxn, acx, acyn, acy, bcxn, bcx, bcyn, bcy, det
+	);
+	return det[n - 1];
+}
+
+template<
+	class T
+>
+T
+orient3d_exact(
+	T const (&a)[3],
+	T const (&b)[3],
+	T const (&c)[3],
+	T const (&d)[3]
+) noexcept {
+	T ad[3][2], bd[3][2], cd[3][2];
+	std::size_t adn[3], bdn[3], cdn[3];
+	for (unsigned k = 0; k < 3; ++k) {
+		adn[k] = expansion_diff(a[k], d[k], ad[k]);
+		bdn[k] = expansion_diff(b[k], d[k], bd[k]);
+		cdn[k] = expansion_diff(c[k], d[k], cd[k]);
+	}
+
+	// Cofactor expansion along z
+	T bc[16], ca[16], ab[16];
+	std::size_t const bcn = expansion_cross(
+		bdn[0], bd[0], bdn[1], bd[1], cdn[0], cd[0], cdn[1], cd[1], bc
+	);
+	std::size_t const can = expansion_cross(
+		cdn[0], cd[0], cdn[1], cd[1], adn[0], ad[0], adn[1], ad[1], ca
+	);
+	std::size_t const abn = expansion_cross(
+		adn[0], ad[0], adn[1], ad[1], bdn[0], bd[0], bdn[1], bd[1], ab
+	);
+
+	T at[64], bt[64], ct[64];
+	std::size_t const atn = expansion_product<16, 2>(bcn, bc, adn[2], ad[2], at);
+	std::size_t const btn = expansion_product<16, 2>(can, ca, bdn[2], bd[2], bt);
+	std::size_t const ctn = expansion_product<16, 2>(abn, ab, cdn[2], cd[2], ct);
+
+	T abt[128], det[192];
+	std::size_t const abtn = expansion_sum(atn, at, btn, bt, abt);
+	std::size_t const n = expansion_sum(abtn, abt, ctn, ct, det);
+	return det[n - 1];
+}
+
+template<
+	class T
+>
+T
+incircle_exact(
+	T const (&a)[2],
+	T const (&b)[2],
+	T const (&c)[2],
+	T const (&d)[2]
+) noexcept {
+	T const (*const p[3])[2] = {&a, &b, &c};
+	T dx[3][2], dy[3][2];
+	std::size_t dxn[3], dyn[3];
+	for (unsigned i = 0; i < 3; ++i) {
+		dxn[i] = expansion_diff((*p[i])[0], d[0], dx[i]);
+		dyn[i] = expansion_diff((*p[i])[1], d[1], dy[i]);
+	}
+
+	T xx[8], yy[8], lift[16], minor[16];
+	T term[3][512];
+	std::size_t termn[3];
+	for (unsigned i = 0; i < 3; ++i) {
+		unsigned const j = (i + 1) % 3;
+		unsigned const k = (i + 2) % 3;
+		std::size_t const xn = expansion_product<2, 2>(
+			dxn[i], dx[i], dxn[i], dx[i], xx
+		);
+		std::size_t const yn = expansion_product<2, 2>(
+			dyn[i], dy[i], dyn[i], dy[i], yy
+		);
+		std::size_t const liftn = expansion_sum(xn, xx, yn, yy, lift);
+		std::size_t const minorn = expansion_cross(
+			dxn[j], dx[j], dyn[j], dy[j], dxn[k], dx[k], dyn[k], dy[k], minor
+		);
+		termn[i] = expansion_product<16, 16>(
+			liftn, lift, minorn, minor, term[i]
+		);
+	}
+
+	T sum[1024], det[1536];
+	std::size_t const sumn = expansion_sum(
+		termn[0], term[0], termn[1], term[1], sum
+	);
+	std::size_t const n = expansion_sum(
+		sumn, sum, termn[2], term[2], det
+	);
+	return det[n - 1];
+}
+
+/** @endcond */ // INTERNAL
+
+} // namespace geometry
+} // namespace detail
+
+namespace geometry {
+
+/**
+	@addtogroup geometry
+	@{
+*/
+/**
+	@defgroup predicates Robust predicates
+	@details
+	Adaptive-precision orientation and in-circle tests after
+	Shewchuk, <em>Adaptive Precision Floating-Point Arithmetic and
+	Fast Robust Geometric Predicates</em> (1997).
+
+	Each predicate first evaluates its determinant in ordinary
+	floating-point arithmetic and compares it against a bound on the
+	rounding error of that evaluation. Only if the result is within the
+	bound (i.e., its sign is uncertain) is the determinant re-evaluated
+	with exact expansion arithmetic. The sign of the result is always
+	correct; its magnitude approximates the determinant.
+
+	The filtered path costs a handful of extra operations over a plain
+	determinant; the exact path is much slower, but is only taken for
+	(nearly) degenerate inputs.
+
+	@note The predicates require IEEE 754 arithmetic with
+	round-to-nearest and no extended intermediate precision; they are
+	not robust under @c -ffast-math or x87 arithmetic. The result is
+	only guaranteed if no intermediate value overflows or underflows.
+	@{
+*/
+
+/**
+	Orientation of three points in the plane.
+
+	@tparam T A floating-point type.
+	@returns A positive value if @a a, @a b, @a c are in
+	counter-clockwise order, a negative value if they are in clockwise
+	order, or zero if they are collinear.
+	@param a,b,c Points.
+*/
+template<
+	class T
+>
+inline T
+orient2d(
+	detail::linear::tvec2<T> const& a,
+	detail::linear::tvec2<T> const& b,
+	detail::linear::tvec2<T> const& c
+) noexcept {
+	using constants = detail::geometry::expansion_constants<T>;
+	T const l = (a.x - c.x) * (b.y - c.y);
+	T const r = (a.y - c.y) * (b.x - c.x);
+	T const det = l - r;
+	T sum;
+	if (l > T(0)) {
+		if (r <= T(0)) {
+			return det;
+		}
+		sum = l + r;
+	} else if (l < T(0)) {
+		if (r >= T(0)) {
+			return det;
+		}
+		sum = -l - r;
+	} else {
+		return det;
+	}
+	T const bound = constants::orient2d_bound * sum;
+	if (det >= bound || -det >= bound) {
+		return det;
+	}
+	return detail::geometry::orient2d_exact(a.x, a.y, b.x, b.y, c.x, c.y);
+}
+
+/**
+	Orientation of four points in space.
+
+	@tparam T A floating-point type.
+	@returns A positive value if @a d lies below the plane through
+	@a a, @a b, @a c (where "above" is the side from which they appear
+	in counter-clockwise order), a negative value if it lies above, or
+	zero if the points are coplanar.
+	@param a,b,c,d Points.
+*/
+template<
+	class T
+>
+inline T
+orient3d(
+	detail::linear::tvec3<T> const& a,
+	detail::linear::tvec3<T> const& b,
+	detail::linear::tvec3<T> const& c,
+	detail::linear::tvec3<T> const& d
+) noexcept {
+	using constants = detail::geometry::expansion_constants<T>;
+	T const adx = a.x - d.x, ady = a.y - d.y, adz = a.z - d.z;
+	T const bdx = b.x - d.x, bdy = b.y - d.y, bdz = b.z - d.z;
+	T const cdx = c.x - d.x, cdy = c.y - d.y, cdz = c.z - d.z;
+
+	T const bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+	T const cdxady = cdx * ady, adxcdy = adx * cdy;
+	T const adxbdy = adx * bdy, bdxady = bdx * ady;
+
+	T const det
+		= adz * (bdxcdy - cdxbdy)
+		+ bdz * (cdxady - adxcdy)
+		+ cdz * (adxbdy - bdxady)
+	;
+	T const permanent
+		= (std::abs(bdxcdy) + std::abs(cdxbdy)) * std::abs(adz)
+		+ (std::abs(cdxady) + std::abs(adxcdy)) * std::abs(bdz)
+		+ (std::abs(adxbdy) + std::abs(bdxady)) * std::abs(cdz)
+	;
+	T const bound = constants::orient3d_bound * permanent;
+	if (det > bound || -det > bound) {
+		return det;
+	}
+	T const ea[3]{a.x, a.y, a.z}, eb[3]{b.x, b.y, b.z};
+	T const ec[3]{c.x, c.y, c.z}, ed[3]{d.x, d.y, d.z};
+	return detail::geometry::orient3d_exact(ea, eb, ec, ed);
+}
+
+/**
+	Position of a point relative to the circle through three others.
+
+	@tparam T A floating-point type.
+	@returns If @a a, @a b, @a c are in counter-clockwise order, a
+	positive value if @a d lies inside their circumcircle, a negative
+	value if it lies outside, or zero if the four points are cocircular.
+	The sign is reversed if @a a, @a b, @a c are in clockwise order.
+	@param a,b,c Points on the circle.
+	@param d Query point.
+*/
+template<
+	class T
+>
+inline T
+incircle(
+	detail::linear::tvec2<T> const& a,
+	detail::linear::tvec2<T> const& b,
+	detail::linear::tvec2<T> const& c,
+	detail::linear::tvec2<T> const& d
+) noexcept {
+	using constants = detail::geometry::expansion_constants<T>;
+	T const adx = a.x - d.x, ady = a.y - d.y;
+	T const bdx = b.x - d.x, bdy = b.y - d.y;
+	T const cdx = c.x - d.x, cdy = c.y - d.y;
+
+	T const bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+	T const cdxady = cdx * ady, adxcdy = adx * cdy;
+	T const adxbdy = adx * bdy, bdxady = bdx * ady;
+	T const alift = adx * adx + ady * ady;
+	T const blift = bdx * bdx + bdy * bdy;
+	T const clift = cdx * cdx + cdy * cdy;
+
+	T const det
+		= alift * (bdxcdy - cdxbdy)
+		+ blift * (cdxady - adxcdy)
+		+ clift * (adxbdy - bdxady)
+	;
+	T const permanent
+		= (std::abs(bdxcdy) + std::abs(cdxbdy)) * alift
+		+ (std::abs(cdxady) + std::abs(adxcdy)) * blift
+		+ (std::abs(adxbdy) + std::abs(bdxady)) * clift
+	;
+	T const bound = constants::incircle_bound * permanent;
+	if (det > bound || -det > bound) {
+		return det;
+	}
+	T const ea[2]{a.x, a.y}, eb[2]{b.x, b.y};
+	T const ec[2]{c.x, c.y}, ed[2]{d.x, d.y};
+	return detail::geometry::incircle_exact(ea, eb, ec, ed);
+}
+
+/** @} */ // end of doc-group predicates
+/** @} */ // end of doc-group geometry
+
+} // namespace geometry
+} // namespace am
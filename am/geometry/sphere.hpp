@@ -0,0 +1,179 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Bounding spheres.
+*/
+
+#pragma once
+
+#include "../config.hpp"
+#include "../detail/linear/type_traits.hpp"
+#include "../linear/vector_operations.hpp"
+#include "../linear/strided_span.hpp"
+
+#include <cstddef>
+#include <cmath>
+
+namespace am {
+namespace detail {
+namespace geometry {
+
+/** @cond INTERNAL */
+template<
+	class Cons,
+	class Points
+>
+inline void
+bounding_sphere_impl(
+	std::size_t const count,
+	Points const& points,
+	Cons& center,
+	typename Cons::value_type& radius
+) {
+	using V = typename Cons::value_type;
+	if (0 == count) {
+		center = Cons{};
+		radius = V{0};
+		return;
+	}
+
+	// Most separated pair of extremal points along each axis
+	std::size_t p0 = 0, p1 = 0;
+	V best{-1};
+	for (std::size_t axis = 0; axis < Cons::size(); ++axis) {
+		std::size_t lo = 0, hi = 0;
+		for (std::size_t i = 1; i < count; ++i) {
+			if (points[i][axis] < points[lo][axis]) {
+				lo = i;
+			}
+			if (points[i][axis] > points[hi][axis]) {
+				hi = i;
+			}
+		}
+		Cons const d = points[hi] - points[lo];
+		V const dist2 = am::linear::dot(d, d);
+		if (dist2 > best) {
+			best = dist2;
+			p0 = lo;
+			p1 = hi;
+		}
+	}
+
+	center = (points[p0] + points[p1]) * V(0.5);
+	radius = am::linear::distance(center, points[p1]);
+	V radius2 = radius * radius;
+
+	// Grow to enclose outliers
+	for (std::size_t i = 0; i < count; ++i) {
+		Cons const d = points[i] - center;
+		V const dist2 = am::linear::dot(d, d);
+		if (dist2 > radius2) {
+			V const dist = std::sqrt(dist2);
+			V const new_radius = (radius + dist) * V(0.5);
+			center += d * ((new_radius - radius) / dist);
+			radius = new_radius;
+			radius2 = radius * radius;
+		}
+	}
+}
+/** @endcond */ // INTERNAL
+
+} // namespace geometry
+} // namespace detail
+
+namespace geometry {
+
+/**
+	@addtogroup geometry
+	@{
+*/
+/**
+	@defgroup sphere Bounding spheres
+	@{
+*/
+
+/**
+	Sphere.
+
+	@tparam Cons A floating-point vector type.
+*/
+template<
+	class Cons
+>
+struct sphere {
+	/** Vector type. */
+	using vector_type = Cons;
+	/** Type of components. */
+	using value_type = typename Cons::value_type;
+
+	/** Center. */
+	vector_type center;
+	/** Radius. */
+	value_type radius;
+};
+
+/**
+	Calculate a bounding sphere of a sequence of points.
+
+	This is Ritter's algorithm seeded with the most separated pair of
+	axis-extremal points rather than an arbitrary point, which gives a
+	tighter initial sphere. The result is generally within a few
+	percent of the minimal sphere.
+
+	@tparam Cons A floating-point vector type.
+	@returns A sphere enclosing all @a points, or a zero sphere if
+	@a count is @c 0.
+	@param count Number of points.
+	@param points Points.
+*/
+template<
+	class Cons
+>
+inline sphere<Cons>
+bounding_sphere(
+	std::size_t const count,
+	Cons const* const points
+) {
+	sphere<Cons> s;
+	detail::geometry::bounding_sphere_impl(count, points, s.center, s.radius);
+	return s;
+}
+
+/**
+	Calculate a bounding sphere of a view of points.
+
+	@tparam Cons A floating-point vector type.
+	@returns A sphere enclosing all @a points, or a zero sphere if
+	@a points is empty.
+	@param points Points.
+*/
+template<
+	class Cons
+>
+inline sphere<Cons>
+bounding_sphere(
+	linear::vec_view<Cons> const& points
+) {
+	sphere<Cons> s;
+	if (points.is_contiguous()) {
+		detail::geometry::bounding_sphere_impl(
+			points.size(),
+			detail::linear::contiguous_access<Cons const>{points.data()},
+			s.center, s.radius
+		);
+	} else {
+		detail::geometry::bounding_sphere_impl(
+			points.size(),
+			detail::linear::strided_access<Cons const>{points.data(), points.stride()},
+			s.center, s.radius
+		);
+	}
+	return s;
+}
+
+/** @} */ // end of doc-group sphere
+/** @} */ // end of doc-group geometry
+
+} // namespace geometry
+} // namespace am
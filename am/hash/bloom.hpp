@@ -0,0 +1,625 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Bloom filters.
+*/
+
+#pragma once
+
+#include "../config.hpp"
+#include "../memory.hpp"
+#include "./common.hpp"
+#include "./hasher.hpp"
+#include "./xxhash.hpp"
+#include "../detail/hash/common_impl.hpp"
+#include "../detail/hash/murmur_impl.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#if defined(AM_DETAIL_SSE2)
+	#include <xmmintrin.h>
+#endif
+
+namespace am {
+namespace detail {
+namespace hash {
+
+/** @cond INTERNAL */
+
+inline void
+bloom_prefetch(
+	void const* const p
+) noexcept {
+#if defined(AM_DETAIL_SSE2)
+	_mm_prefetch(static_cast<char const*>(p), _MM_HINT_T0);
+#else
+	static_cast<void>(p);
+#endif
+}
+
+// Map x uniformly onto [0, n) (Lemire's multiply-shift; cheaper than
+// a modulo)
+inline std::size_t
+bloom_reduce(
+	std::uint64_t const x,
+	std::size_t const n
+) noexcept {
+	std::uint64_t lo, hi;
+	hash_mul128(x, n, lo, hi);
+	return static_cast<std::size_t>(hi);
+}
+
+// Second hash for Kirsch-Mitzenmacher double hashing: probe i is
+// (h1 + i * h2). h1 is the input hash; h2 is a remix of it, odd so
+// that probes within a power-of-two range are distinct
+inline std::uint64_t
+bloom_second(
+	std::uint64_t h
+) noexcept {
+	h = (h ^ (h >> 32)) * 0x9e3779b97f4a7c15ULL;
+	return (h ^ (h >> 29)) | 1u;
+}
+
+// Bits set by each probe are spread over the whole filter
+struct bloom_standard {
+	static constexpr std::size_t const block_words = 1u;
+
+	static void
+	insert(
+		std::uint64_t* const words,
+		std::size_t const num_words,
+		unsigned const k,
+		std::uint64_t const h
+	) noexcept {
+		std::size_t const bits = num_words * 64u;
+		std::uint64_t const h2 = bloom_second(h);
+		std::uint64_t g = h;
+		for (unsigned i = 0; i < k; ++i, g += h2) {
+			std::size_t const bit = bloom_reduce(g, bits);
+			words[bit >> 6] |= std::uint64_t(1) << (bit & 63u);
+		}
+	}
+
+	static bool
+	contains(
+		std::uint64_t const* const words,
+		std::size_t const num_words,
+		unsigned const k,
+		std::uint64_t const h
+	) noexcept {
+		std::size_t const bits = num_words * 64u;
+		std::uint64_t const h2 = bloom_second(h);
+		std::uint64_t g = h;
+		for (unsigned i = 0; i < k; ++i, g += h2) {
+			std::size_t const bit = bloom_reduce(g, bits);
+			if (0u == (words[bit >> 6] & (std::uint64_t(1) << (bit & 63u)))) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static void
+	prefetch(
+		std::uint64_t const* const words,
+		std::size_t const num_words,
+		std::uint64_t const h
+	) noexcept {
+		bloom_prefetch(words + (bloom_reduce(h, num_words * 64u) >> 6));
+	}
+};
+
+// All probes land in one 512-bit block (one cache line); the block is
+// chosen by h1 and the 9-bit offsets in it by double hashing with the
+// halves of h2
+struct bloom_cache_line {
+	static constexpr std::size_t const block_words = 8u;
+
+	static void
+	masks(
+		std::uint64_t (&m)[8],
+		unsigned const k,
+		std::uint64_t const h
+	) noexcept {
+		std::uint64_t const h2 = bloom_second(h);
+		std::uint32_t a = static_cast<std::uint32_t>(h2);
+		std::uint32_t const b = static_cast<std::uint32_t>(h2 >> 32) | 1u;
+		for (unsigned w = 0; w < 8u; ++w) {
+			m[w] = 0u;
+		}
+		for (unsigned i = 0; i < k; ++i, a += b) {
+			unsigned const bit = a >> 23;
+			m[bit >> 6] |= std::uint64_t(1) << (bit & 63u);
+		}
+	}
+
+	static void
+	insert(
+		std::uint64_t* const words,
+		std::size_t const num_words,
+		unsigned const k,
+		std::uint64_t const h
+	) noexcept {
+		std::uint64_t* const block = words + 8u * bloom_reduce(h, num_words / 8u);
+		std::uint64_t m[8];
+		masks(m, k, h);
+		for (unsigned w = 0; w < 8u; ++w) {
+			block[w] |= m[w];
+		}
+	}
+
+	static bool
+	contains(
+		std::uint64_t const* const words,
+		std::size_t const num_words,
+		unsigned const k,
+		std::uint64_t const h
+	) noexcept {
+		std::uint64_t const* const block
+			= words + 8u * bloom_reduce(h, num_words / 8u)
+		;
+		std::uint64_t const h2 = bloom_second(h);
+		std::uint32_t a = static_cast<std::uint32_t>(h2);
+		std::uint32_t const b = static_cast<std::uint32_t>(h2 >> 32) | 1u;
+		std::uint64_t missing = 0u;
+		for (unsigned i = 0; i < k; ++i, a += b) {
+			unsigned const bit = a >> 23;
+			missing |= ~block[bit >> 6] & (std::uint64_t(1) << (bit & 63u));
+		}
+		return 0u == missing;
+	}
+
+	static void
+	prefetch(
+		std::uint64_t const* const words,
+		std::size_t const num_words,
+		std::uint64_t const h
+	) noexcept {
+		bloom_prefetch(words + 8u * bloom_reduce(h, num_words / 8u));
+	}
+};
+
+// All probes land in one 64-bit word, so a query is one load and one
+// compare
+struct bloom_register {
+	static constexpr std::size_t const block_words = 1u;
+
+	static std::uint64_t
+	mask(
+		unsigned const k,
+		std::uint64_t const h
+	) noexcept {
+		std::uint64_t const h2 = bloom_second(h);
+		std::uint32_t a = static_cast<std::uint32_t>(h2);
+		std::uint32_t const b = static_cast<std::uint32_t>(h2 >> 32) | 1u;
+		std::uint64_t m = 0u;
+		for (unsigned i = 0; i < k; ++i, a += b) {
+			m |= std::uint64_t(1) << (a >> 26);
+		}
+		return m;
+	}
+
+	static void
+	insert(
+		std::uint64_t* const words,
+		std::size_t const num_words,
+		unsigned const k,
+		std::uint64_t const h
+	) noexcept {
+		words[bloom_reduce(h, num_words)] |= mask(k, h);
+	}
+
+	static bool
+	contains(
+		std::uint64_t const* const words,
+		std::size_t const num_words,
+		unsigned const k,
+		std::uint64_t const h
+	) noexcept {
+		std::uint64_t const m = mask(k, h);
+		return m == (words[bloom_reduce(h, num_words)] & m);
+	}
+
+	static void
+	prefetch(
+		std::uint64_t const* const words,
+		std::size_t const num_words,
+		std::uint64_t const h
+	) noexcept {
+		bloom_prefetch(words + bloom_reduce(h, num_words));
+	}
+};
+
+// Keys per batch step: all are hashed (and their lines prefetched)
+// before any is probed, so the cache misses overlap
+constexpr std::size_t const bloom_batch = 16u;
+
+/** @endcond */ // INTERNAL
+
+/**
+	Bloom filter.
+
+	The common implementation of @c am::hash::bloom_filter,
+	@c am::hash::blocked_bloom_filter and
+	@c am::hash::register_bloom_filter.
+
+	@tparam Layout Probe layout.
+	@tparam Hash Hash functor.
+*/
+template<
+	class Layout,
+	class Hash
+>
+class basic_bloom_filter {
+public:
+	/** Size/length type. */
+	using size_type = std::size_t;
+	/** Hash functor type. */
+	using hasher = Hash;
+
+private:
+	aligned_vector<std::uint64_t> m_words;
+	unsigned m_hashes;
+	Hash m_hash;
+
+	// The layouts take the block from the high bits of the hash, so
+	// it is remixed for 32-bit (or weak) hash functors
+	static std::uint64_t
+	mix(
+		std::uint64_t const hash
+	) noexcept {
+		return detail::hash::fmix64(hash);
+	}
+
+public:
+/** @name Special member functions */ /// @{
+	/** Destructor. */
+	~basic_bloom_filter() = default;
+	/** Copy constructor. */
+	basic_bloom_filter(basic_bloom_filter const&) = default;
+	/** Move constructor. */
+	basic_bloom_filter(basic_bloom_filter&&) = default;
+	/** Copy assignment operator. */
+	basic_bloom_filter& operator=(basic_bloom_filter const&) = default;
+	/** Move assignment operator. */
+	basic_bloom_filter& operator=(basic_bloom_filter&&) = default;
+
+	/**
+		Constructor.
+
+		@note The number of bits is rounded up to a whole number of
+		blocks (64 bits, or 512 for the blocked filter).
+
+		@param bits Number of bits; see bloom_optimal_bits().
+		@param hashes Number of probes per key; see
+		bloom_optimal_hashes().
+		@param hash Hash functor.
+	*/
+	basic_bloom_filter(
+		size_type const bits,
+		unsigned const hashes,
+		Hash const& hash = Hash()
+	)
+		: m_words(
+			((bits + 64u * Layout::block_words - 1u) / (64u * Layout::block_words))
+			* Layout::block_words + (0u == bits ? Layout::block_words : 0u),
+			0u
+		)
+		, m_hashes(0u != hashes ? hashes : 1u)
+		, m_hash(hash)
+	{}
+/// @}
+
+/** @name Properties */ /// @{
+	/**
+		Get the number of bits.
+	*/
+	size_type
+	bit_count() const noexcept {
+		return m_words.size() * 64u;
+	}
+
+	/**
+		Get the number of probes per key.
+	*/
+	unsigned
+	hash_count() const noexcept {
+		return m_hashes;
+	}
+
+	/**
+		Get the bit array.
+
+		@note The array is bit_count() / 64 words, with bit @c i in bit
+		<code>i % 64</code> of word <code>i / 64</code>. It can be
+		saved and restored with data() and the same parameters and
+		hash functor.
+	*/
+	std::uint64_t*
+	data() noexcept {
+		return m_words.data();
+	}
+
+	/** @copydoc data() */
+	std::uint64_t const*
+	data() const noexcept {
+		return m_words.data();
+	}
+
+	/**
+		Get the hash functor.
+	*/
+	hasher
+	hash_function() const {
+		return m_hash;
+	}
+/// @}
+
+/** @name Operations */ /// @{
+	/**
+		Insert a key by hash.
+
+		@param hash Hash of the key.
+	*/
+	void
+	insert_hash(
+		std::uint64_t const hash
+	) noexcept {
+		Layout::insert(m_words.data(), m_words.size(), m_hashes, mix(hash));
+	}
+
+	/**
+		Check if a key may have been inserted, by hash.
+
+		@returns @c false if the key was definitely not inserted.
+		@param hash Hash of the key.
+	*/
+	bool
+	contains_hash(
+		std::uint64_t const hash
+	) const noexcept {
+		return Layout::contains(m_words.data(), m_words.size(), m_hashes, mix(hash));
+	}
+
+	/**
+		Insert a key.
+
+		@tparam K Key type; any type the hash functor takes.
+		@param key Key.
+	*/
+	template<
+		class K
+	>
+	void
+	insert(
+		K const& key
+	) {
+		insert_hash(static_cast<std::uint64_t>(m_hash(key)));
+	}
+
+	/**
+		Check if a key may have been inserted.
+
+		@returns @c false if @a key was definitely not inserted.
+		@tparam K Key type; any type the hash functor takes.
+		@param key Key.
+	*/
+	template<
+		class K
+	>
+	bool
+	contains(
+		K const& key
+	) const {
+		return contains_hash(static_cast<std::uint64_t>(m_hash(key)));
+	}
+
+	/**
+		Insert keys.
+
+		@param count Number of keys.
+		@param keys Keys (@a count values).
+	*/
+	template<
+		class K
+	>
+	void
+	insert(
+		size_type const count,
+		K const* const keys
+	) {
+		std::uint64_t h[bloom_batch];
+		for (size_type i = 0; i < count; i += bloom_batch) {
+			size_type const n = (count - i < bloom_batch) ? count - i : bloom_batch;
+			for (size_type j = 0; j < n; ++j) {
+				h[j] = mix(static_cast<std::uint64_t>(m_hash(keys[i + j])));
+				Layout::prefetch(m_words.data(), m_words.size(), h[j]);
+			}
+			for (size_type j = 0; j < n; ++j) {
+				Layout::insert(m_words.data(), m_words.size(), m_hashes, h[j]);
+			}
+		}
+	}
+
+	/**
+		Check if keys may have been inserted.
+
+		@returns The number of keys that may have been inserted.
+		@param count Number of keys.
+		@param keys Keys (@a count values).
+		@param[out] out Results (@a count values).
+	*/
+	template<
+		class K
+	>
+	size_type
+	contains(
+		size_type const count,
+		K const* const keys,
+		bool* const out
+	) const {
+		std::uint64_t h[bloom_batch];
+		size_type found = 0u;
+		for (size_type i = 0; i < count; i += bloom_batch) {
+			size_type const n = (count - i < bloom_batch) ? count - i : bloom_batch;
+			for (size_type j = 0; j < n; ++j) {
+				h[j] = mix(static_cast<std::uint64_t>(m_hash(keys[i + j])));
+				Layout::prefetch(m_words.data(), m_words.size(), h[j]);
+			}
+			for (size_type j = 0; j < n; ++j) {
+				bool const c = Layout::contains(m_words.data(), m_words.size(), m_hashes, h[j]);
+				out[i + j] = c;
+				found += c ? 1u : 0u;
+			}
+		}
+		return found;
+	}
+
+	/**
+		Remove all keys.
+	*/
+	void
+	clear() noexcept {
+		for (std::uint64_t& word : m_words) {
+			word = 0u;
+		}
+	}
+/// @}
+};
+
+} // namespace hash
+} // namespace detail
+
+namespace hash {
+
+/**
+	@addtogroup hash
+	@{
+*/
+/**
+	@defgroup bloom Bloom filters
+	@details
+	A Bloom filter answers "was this key inserted?" with no false
+	negatives and a tunable rate of false positives, in a few bits per
+	key. Keys cannot be removed.
+
+	All three filters take one hash per key, remix it to 64 bits (so
+	32-bit hash functors work as well), and derive the probe
+	positions from it by Kirsch-Mitzenmacher double hashing
+	(probe @c i uses <code>h1 + i * h2</code>), so each key is hashed
+	once however many probes there are. They differ in where the
+	probes land:
+
+	- @c bloom_filter spreads them over the whole filter: the lowest
+	  false positive rate for the size, but up to @c k cache misses
+	  per query;
+	- @c blocked_bloom_filter keeps them in one 512-bit block (a
+	  cache line): one cache miss per query, for a slightly higher
+	  false positive rate;
+	- @c register_bloom_filter keeps them in one 64-bit word: one load
+	  and compare per query, for a higher false positive rate again
+	  (use a few more bits per key).
+
+	The batch forms of insert() and contains() hash a group of keys
+	and prefetch their blocks before probing any of them, so the
+	cache misses of a batch overlap.
+
+	@note With the default @c hasher, keys can be integers or strings
+	(see @ref hasher).
+	@{
+*/
+
+/**
+	Get the number of bits for a Bloom filter.
+
+	@note @a fpp is clamped to <code>[DBL_MIN, 1]</code> (a rate of 1
+	or more, or NaN, gives 0 bits), and the result saturates at the
+	largest @c std::size_t.
+
+	@returns The optimal number of bits for a standard Bloom filter
+	(blocked filters need somewhat more for the same rate).
+	@param count Expected number of keys.
+	@param fpp Target false positive rate (e.g., @c 0.01).
+*/
+inline std::size_t
+bloom_optimal_bits(
+	std::size_t const count,
+	double const fpp
+) noexcept {
+	double const ln2 = 0.6931471805599453;
+	double const p
+		= (fpp < std::numeric_limits<double>::min())
+		? std::numeric_limits<double>::min()
+		: ((fpp < 1.0) ? fpp : 1.0)
+	;
+	double const bits = std::ceil(
+		-static_cast<double>(count) * std::log(p) / (ln2 * ln2)
+	);
+	// The largest std::size_t rounds up to a power of two as a double
+	return (bits < static_cast<double>(std::numeric_limits<std::size_t>::max()))
+		? static_cast<std::size_t>(bits)
+		: std::numeric_limits<std::size_t>::max()
+	;
+}
+
+/**
+	Get the number of probes per key for a Bloom filter.
+
+	@returns The optimal number of probes per key (at least 1).
+	@param bits Number of bits.
+	@param count Expected number of keys.
+*/
+inline unsigned
+bloom_optimal_hashes(
+	std::size_t const bits,
+	std::size_t const count
+) noexcept {
+	double const k = std::round(
+		static_cast<double>(bits) / static_cast<double>(count ? count : 1u)
+		* 0.6931471805599453
+	);
+	return k < 1.0 ? 1u : static_cast<unsigned>(k);
+}
+
+/**
+	Standard Bloom filter.
+
+	@tparam Hash Hash functor.
+*/
+template<
+	class Hash = hasher<xxh3<HashLength::HL64>>
+>
+using bloom_filter
+= detail::hash::basic_bloom_filter<detail::hash::bloom_standard, Hash>;
+
+/**
+	Cache-line-blocked Bloom filter.
+
+	@tparam Hash Hash functor.
+*/
+template<
+	class Hash = hasher<xxh3<HashLength::HL64>>
+>
+using blocked_bloom_filter
+= detail::hash::basic_bloom_filter<detail::hash::bloom_cache_line, Hash>;
+
+/**
+	Register-blocked Bloom filter.
+
+	@tparam Hash Hash functor.
+*/
+template<
+	class Hash = hasher<xxh3<HashLength::HL64>>
+>
+using register_bloom_filter
+= detail::hash::basic_bloom_filter<detail::hash::bloom_register, Hash>;
+
+/** @} */ // end of doc-group bloom
+/** @} */ // end of doc-group hash
+
+} // namespace hash
+} // namespace am
@@ -0,0 +1,71 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief CRC-32C.
+*/
+
+#pragma once
+
+#include "../config.hpp"
+#include "./common.hpp"
+#include "../detail/hash/crc32c_impl.hpp"
+
+#include <cstdint>
+
+namespace am {
+namespace hash {
+
+/**
+	@addtogroup hash
+	@{
+*/
+/**
+	@defgroup crc32c CRC-32C
+	@details
+	CRC-32C is the 32-bit cyclic redundancy check with the Castagnoli
+	polynomial (@c 0x1EDC6F41), as used by iSCSI, ext4 and SSE4.2's
+	@c crc32 instruction. It is a checksum, not a hash: it detects
+	accidental corruption well but distributes poorly as a hash.
+
+	When the compiler targets SSE4.2 on x86-64 (see
+	@c AM_CONFIG_NO_INTRINSICS), large buffers are checksummed in
+	three interleaved streams with the @c crc32 instruction; otherwise
+	slicing-by-8 tables (8 KiB, built on first use) are used. Results
+	are the same either way.
+
+	@c crc32c is stateful, so chunks can be added in sequence with
+	@c generic_combiner. Chunks checksummed independently (e.g., in
+	parallel) can be joined with crc32c_combine().
+	@{
+*/
+
+/**
+	CRC-32C checksum implementation.
+*/
+using crc32c = detail::hash::crc32c_impl<am::hash::HashLength::HL32>;
+
+/**
+	Combine the CRC-32C checksums of two adjacent chunks.
+
+	@returns The checksum of the first chunk followed by the second.
+	@param crc1 Checksum of the first chunk.
+	@param crc2 Checksum of the second chunk.
+	@param size2 Size in bytes of the second chunk.
+*/
+inline crc32c::hash_type
+crc32c_combine(
+	crc32c::hash_type const crc1,
+	crc32c::hash_type const crc2,
+	std::uint64_t const size2
+) noexcept {
+	return detail::hash::crc32c_multiply(
+		detail::hash::crc32c_power(size2), crc1
+	) ^ crc2;
+}
+
+/** @} */ // end of doc-group crc32c
+/** @} */ // end of doc-group hash
+
+} // namespace hash
+} // namespace am
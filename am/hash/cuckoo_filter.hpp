@@ -0,0 +1,555 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Cuckoo filter.
+*/
+
+#pragma once
+
+#include "../config.hpp"
+#include "../memory.hpp"
+#include "../random/engine.hpp"
+#include "./common.hpp"
+#include "./hasher.hpp"
+#include "./murmur.hpp"
+#include "./bloom.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace am {
+namespace detail {
+namespace hash {
+
+/** @cond INTERNAL */
+
+// A bucket of four fingerprints, loaded as one word so that all four
+// are compared at once
+template<
+	class F
+>
+struct cuckoo_bucket;
+
+template<>
+struct cuckoo_bucket<std::uint8_t> {
+	using word_type = std::uint32_t;
+	static constexpr word_type const lsbs = 0x01010101u;
+	static constexpr word_type const msbs = 0x80808080u;
+};
+
+template<>
+struct cuckoo_bucket<std::uint16_t> {
+	using word_type = std::uint64_t;
+	static constexpr word_type const lsbs = 0x0001000100010001ULL;
+	static constexpr word_type const msbs = 0x8000800080008000ULL;
+};
+
+constexpr std::size_t const cuckoo_slots = 4u;
+constexpr unsigned const cuckoo_max_kicks = 500u;
+
+/** @endcond */ // INTERNAL
+
+} // namespace hash
+} // namespace detail
+
+namespace hash {
+
+/**
+	@addtogroup hash
+	@{
+*/
+/**
+	@defgroup cuckoo_filter Cuckoo filter
+	@details
+	A cuckoo filter (Fan et al., "Cuckoo Filter: Practically Better
+	Than Bloom", 2014) stores a small fingerprint of each key in one
+	of two candidate buckets of four slots. Like a Bloom filter it has
+	no false negatives, but keys can also be removed, and a query
+	reads at most two buckets (each well within a cache line).
+
+	The filter fills to about 95% of its slots before an insert fails.
+	At that load a 16-bit fingerprint costs about 17 bits per key for
+	a false positive rate of about 0.012%, and an 8-bit fingerprint
+	about 8.5 bits per key for about 3%. For a set that never changes,
+	@ref fuse_filter is smaller for the same rate.
+
+	The batch forms of insert() and contains() hash a group of keys
+	and prefetch both of their buckets before probing any of them, so
+	the cache misses of a batch overlap.
+
+	@note Only remove keys that were inserted: removing a key that was
+	not can remove the fingerprint of another key. A key can be
+	inserted more than once (and then has to be removed as many
+	times), but not more than eight times.
+	@{
+*/
+
+/**
+	Cuckoo filter.
+
+	@tparam F Fingerprint type; @c std::uint8_t or @c std::uint16_t.
+	@tparam Hash Hash functor; must give 64-bit hashes.
+*/
+template<
+	class F = std::uint16_t,
+	class Hash = hasher<murmur2<HashLength::HL64>>
+>
+class cuckoo_filter {
+public:
+	/** Size/length type. */
+	using size_type = std::size_t;
+	/** Fingerprint type. */
+	using fingerprint_type = F;
+	/** Hash functor type. */
+	using hasher = Hash;
+
+private:
+	using bucket = detail::hash::cuckoo_bucket<F>;
+	using word_type = typename bucket::word_type;
+
+	aligned_vector<F, 64u> m_slots;
+	size_type m_mask;
+	size_type m_size;
+	// Fingerprint evicted by the last failed insert (0 if none) and its
+	// bucket; while there is one, inserts fail
+	F m_victim;
+	size_type m_victim_index;
+	random::splitmix64 m_random;
+	Hash m_hash;
+
+	static size_type
+	bucket_count_for(
+		size_type const capacity
+	) noexcept {
+		size_type count = 1u;
+		while (count * detail::hash::cuckoo_slots < capacity) {
+			count <<= 1;
+		}
+		// Past ~96% the inserts get slow, then fail
+		if (100u * capacity > 96u * detail::hash::cuckoo_slots * count) {
+			count <<= 1;
+		}
+		return count;
+	}
+
+	// Fingerprint (never 0, which marks an empty slot) and first bucket
+	// of a key hash
+	void
+	locate(
+		std::uint64_t hash,
+		F& fp,
+		size_type& index
+	) const noexcept {
+		hash = detail::hash::fmix64(hash);
+		fp = static_cast<F>(hash >> (64u - 8u * sizeof(F)));
+		fp += (0u == fp) ? 1u : 0u;
+		index = static_cast<size_type>(hash) & m_mask;
+	}
+
+	// Partial-key cuckoo hashing: the alternate bucket depends only on
+	// the bucket and the fingerprint, so a fingerprint can be moved
+	// without its key
+	size_type
+	alternate(
+		size_type const index,
+		F const fp
+	) const noexcept {
+		return (index ^ (static_cast<size_type>(fp) * 0x5bd1e995u)) & m_mask;
+	}
+
+	bool
+	bucket_has(
+		size_type const index,
+		F const fp
+	) const noexcept {
+		word_type w;
+		std::memcpy(&w, m_slots.data() + index * detail::hash::cuckoo_slots, sizeof(w));
+		w ^= bucket::lsbs * fp;
+		return 0u != ((w - bucket::lsbs) & ~w & bucket::msbs);
+	}
+
+	bool
+	bucket_put(
+		size_type const index,
+		F const fp
+	) noexcept {
+		F* const slots = m_slots.data() + index * detail::hash::cuckoo_slots;
+		for (size_type s = 0; s < detail::hash::cuckoo_slots; ++s) {
+			if (0u == slots[s]) {
+				slots[s] = fp;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool
+	bucket_remove(
+		size_type const index,
+		F const fp
+	) noexcept {
+		F* const slots = m_slots.data() + index * detail::hash::cuckoo_slots;
+		for (size_type s = 0; s < detail::hash::cuckoo_slots; ++s) {
+			if (fp == slots[s]) {
+				slots[s] = 0u;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Put a fingerprint in one of its buckets, evicting others to
+	// their alternate buckets as needed; the last evicted fingerprint
+	// becomes the victim if that does not end
+	void
+	place(
+		size_type index,
+		F fp
+	) noexcept {
+		size_type const other = alternate(index, fp);
+		if (bucket_put(index, fp) || bucket_put(other, fp)) {
+			return;
+		}
+		std::uint64_t r = m_random();
+		index = (r & 1u) ? other : index;
+		for (unsigned kick = 0; kick < detail::hash::cuckoo_max_kicks; ++kick) {
+			if (0u == (kick & 31u)) {
+				r = m_random();
+			}
+			F& slot = m_slots[index * detail::hash::cuckoo_slots + (r & 3u)];
+			r >>= 2;
+			std::swap(fp, slot);
+			index = alternate(index, fp);
+			if (bucket_put(index, fp)) {
+				return;
+			}
+		}
+		m_victim = fp;
+		m_victim_index = index;
+	}
+
+	void
+	prefetch(
+		std::uint64_t const hash
+	) const noexcept {
+		F fp;
+		size_type index;
+		locate(hash, fp, index);
+		detail::hash::bloom_prefetch(m_slots.data() + index * detail::hash::cuckoo_slots);
+		detail::hash::bloom_prefetch(
+			m_slots.data() + alternate(index, fp) * detail::hash::cuckoo_slots
+		);
+	}
+
+public:
+/** @name Special member functions */ /// @{
+	/** Destructor. */
+	~cuckoo_filter() = default;
+	/** Copy constructor. */
+	cuckoo_filter(cuckoo_filter const&) = default;
+	/** Move constructor. */
+	cuckoo_filter(cuckoo_filter&&) = default;
+	/** Copy assignment operator. */
+	cuckoo_filter& operator=(cuckoo_filter const&) = default;
+	/** Move assignment operator. */
+	cuckoo_filter& operator=(cuckoo_filter&&) = default;
+
+	/**
+		Constructor.
+
+		@note The number of slots is the smallest power of two that
+		holds @a capacity keys at no more than 96% load.
+
+		@param capacity Number of keys to make room for.
+		@param hash Hash functor.
+	*/
+	explicit
+	cuckoo_filter(
+		size_type const capacity,
+		Hash const& hash = Hash()
+	)
+		: m_slots(bucket_count_for(capacity) * detail::hash::cuckoo_slots, 0u)
+		, m_mask(bucket_count_for(capacity) - 1u)
+		, m_size(0u)
+		, m_victim(0u)
+		, m_victim_index(0u)
+		, m_random()
+		, m_hash(hash)
+	{
+		AM_STATIC_ASSERT(
+			(std::is_same<F, std::uint8_t>::value ||
+			std::is_same<F, std::uint16_t>::value),
+			"fingerprint type must be std::uint8_t or std::uint16_t"
+		);
+	}
+/// @}
+
+/** @name Properties */ /// @{
+	/**
+		Get the number of keys.
+	*/
+	size_type
+	size() const noexcept {
+		return m_size;
+	}
+
+	/**
+		Get the number of slots.
+	*/
+	size_type
+	capacity() const noexcept {
+		return m_slots.size();
+	}
+
+	/**
+		Get the ratio of keys to slots.
+	*/
+	float
+	load_factor() const noexcept {
+		return static_cast<float>(m_size) / static_cast<float>(m_slots.size());
+	}
+
+	/**
+		Check if an insert has failed.
+
+		@note Once full, inserts fail until a key is removed.
+	*/
+	bool
+	full() const noexcept {
+		return 0u != m_victim;
+	}
+
+	/**
+		Get the hash functor.
+	*/
+	hasher
+	hash_function() const {
+		return m_hash;
+	}
+/// @}
+
+/** @name Operations */ /// @{
+	/**
+		Insert a key by hash.
+
+		@returns @c false if the filter is full (the key is not
+		inserted).
+		@param hash Hash of the key.
+	*/
+	bool
+	insert_hash(
+		std::uint64_t const hash
+	) noexcept {
+		if (full()) {
+			return false;
+		}
+		F fp;
+		size_type index;
+		locate(hash, fp, index);
+		place(index, fp);
+		++m_size;
+		return true;
+	}
+
+	/**
+		Check if a key may have been inserted, by hash.
+
+		@returns @c false if the key was definitely not inserted.
+		@param hash Hash of the key.
+	*/
+	bool
+	contains_hash(
+		std::uint64_t const hash
+	) const noexcept {
+		F fp;
+		size_type index;
+		locate(hash, fp, index);
+		size_type const other = alternate(index, fp);
+		return
+			bucket_has(index, fp) ||
+			bucket_has(other, fp) ||
+			(fp == m_victim && (index == m_victim_index || other == m_victim_index))
+		;
+	}
+
+	/**
+		Remove a key by hash.
+
+		@returns @c false if the key was not found.
+		@param hash Hash of the key.
+	*/
+	bool
+	erase_hash(
+		std::uint64_t const hash
+	) noexcept {
+		F fp;
+		size_type index;
+		locate(hash, fp, index);
+		size_type const other = alternate(index, fp);
+		if (bucket_remove(index, fp) || bucket_remove(other, fp)) {
+			--m_size;
+			if (full()) {
+				// Room for the victim now
+				F const victim = m_victim;
+				m_victim = 0u;
+				place(m_victim_index, victim);
+			}
+			return true;
+		} else if (
+			fp == m_victim && (index == m_victim_index || other == m_victim_index)
+		) {
+			m_victim = 0u;
+			--m_size;
+			return true;
+		}
+		return false;
+	}
+
+	/**
+		Insert a key.
+
+		@returns @c false if the filter is full (the key is not
+		inserted).
+		@tparam K Key type; any type the hash functor takes.
+		@param key Key.
+	*/
+	template<
+		class K
+	>
+	bool
+	insert(
+		K const& key
+	) {
+		return insert_hash(static_cast<std::uint64_t>(m_hash(key)));
+	}
+
+	/**
+		Check if a key may have been inserted.
+
+		@returns @c false if @a key was definitely not inserted.
+		@tparam K Key type; any type the hash functor takes.
+		@param key Key.
+	*/
+	template<
+		class K
+	>
+	bool
+	contains(
+		K const& key
+	) const {
+		return contains_hash(static_cast<std::uint64_t>(m_hash(key)));
+	}
+
+	/**
+		Remove a key.
+
+		@returns @c false if @a key was not found.
+		@tparam K Key type; any type the hash functor takes.
+		@param key Key.
+	*/
+	template<
+		class K
+	>
+	bool
+	erase(
+		K const& key
+	) {
+		return erase_hash(static_cast<std::uint64_t>(m_hash(key)));
+	}
+
+	/**
+		Insert keys.
+
+		@returns The number of keys inserted (less than @a count if
+		the filter became full).
+		@param count Number of keys.
+		@param keys Keys (@a count values).
+	*/
+	template<
+		class K
+	>
+	size_type
+	insert(
+		size_type const count,
+		K const* const keys
+	) {
+		std::uint64_t h[detail::hash::bloom_batch];
+		size_type inserted = 0u;
+		for (size_type i = 0; i < count; i += detail::hash::bloom_batch) {
+			size_type const n
+				= (count - i < detail::hash::bloom_batch)
+				? count - i
+				: detail::hash::bloom_batch
+			;
+			for (size_type j = 0; j < n; ++j) {
+				h[j] = static_cast<std::uint64_t>(m_hash(keys[i + j]));
+				prefetch(h[j]);
+			}
+			for (size_type j = 0; j < n; ++j) {
+				inserted += insert_hash(h[j]) ? 1u : 0u;
+			}
+		}
+		return inserted;
+	}
+
+	/**
+		Check if keys may have been inserted.
+
+		@returns The number of keys that may have been inserted.
+		@param count Number of keys.
+		@param keys Keys (@a count values).
+		@param[out] out Results (@a count values).
+	*/
+	template<
+		class K
+	>
+	size_type
+	contains(
+		size_type const count,
+		K const* const keys,
+		bool* const out
+	) const {
+		std::uint64_t h[detail::hash::bloom_batch];
+		size_type found = 0u;
+		for (size_type i = 0; i < count; i += detail::hash::bloom_batch) {
+			size_type const n
+				= (count - i < detail::hash::bloom_batch)
+				? count - i
+				: detail::hash::bloom_batch
+			;
+			for (size_type j = 0; j < n; ++j) {
+				h[j] = static_cast<std::uint64_t>(m_hash(keys[i + j]));
+				prefetch(h[j]);
+			}
+			for (size_type j = 0; j < n; ++j) {
+				bool const c = contains_hash(h[j]);
+				out[i + j] = c;
+				found += c ? 1u : 0u;
+			}
+		}
+		return found;
+	}
+
+	/**
+		Remove all keys.
+	*/
+	void
+	clear() noexcept {
+		for (F& slot : m_slots) {
+			slot = 0u;
+		}
+		m_size = 0u;
+		m_victim = 0u;
+	}
+/// @}
+};
+
+/** @} */ // end of doc-group cuckoo_filter
+/** @} */ // end of doc-group hash
+
+} // namespace hash
+} // namespace am
@@ -0,0 +1,276 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Flat hash tables.
+*/
+
+#pragma once
+
+#include "../config.hpp"
+#include "./common.hpp"
+#include "./hasher.hpp"
+#include "./xxhash.hpp"
+#include "../detail/hash/flat_table.hpp"
+
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+namespace am {
+namespace hash {
+
+/**
+	@addtogroup hash
+	@{
+*/
+/**
+	@defgroup flat_map Flat hash tables
+	@details
+	@c flat_map and @c flat_set are open-addressing hash tables in
+	the style of Abseil's SwissTable. All values and a byte of
+	metadata per slot live in one allocation. Lookups probe the
+	metadata a group of slots at a time (16 with SSE2, otherwise 8
+	with word operations) and only compare keys whose 7-bit hash
+	fragment matches, so a lookup usually touches one metadata line
+	and one slot.
+
+	The interface follows the standard unordered containers, except
+	that:
+
+	- inserting can invalidate all iterators and references (values
+	  move when the table grows);
+	- there are no buckets or bucket interface; capacity() is the
+	  number of slots, and tables grow at 7/8 full;
+	- with a transparent hash and key equality functor (the
+	  defaults), lookups take any key type that hashes and compares
+	  the same as the key type (e.g., a C string for an
+	  @c std::string key);
+	- lookups can take a precomputed hash (e.g., from a
+	  @c generic_combiner fed the key in pieces).
+
+	The default hash functor is @c hasher<xxh3<HL64>>; any
+	@c hasher<Impl> (or standard-style hash functor) can be used.
+	Values with throwing move constructors are copied when the table
+	grows, so growth gives the strong exception guarantee.
+	@{
+*/
+
+/**
+	Flat hash map.
+
+	@tparam K Key type.
+	@tparam V Mapped type.
+	@tparam Hash Hash functor.
+	@tparam Eq Key equality functor.
+*/
+template<
+	class K,
+	class V,
+	class Hash = hasher<xxh3<HashLength::HL64>>,
+	class Eq = equal_to
+>
+class flat_map
+	: public detail::hash::flat_table<detail::hash::flat_map_policy<K, V>, Hash, Eq>
+{
+private:
+	using base = detail::hash::flat_table<detail::hash::flat_map_policy<K, V>, Hash, Eq>;
+
+	template<class Q>
+	using key_arg = typename base::template key_arg<Q>;
+
+public:
+	/** Mapped type. */
+	using mapped_type = V;
+	/** Key type. */
+	using typename base::key_type;
+	/** Value type (<code>std::pair<K const, V></code>). */
+	using typename base::value_type;
+	/** Iterator type. */
+	using typename base::iterator;
+	/** Const iterator type. */
+	using typename base::const_iterator;
+
+	using base::base;
+
+	/** Default constructor. */
+	flat_map() = default;
+
+/** @name Element access */ /// @{
+	/**
+		Get the value mapped to a key.
+
+		@throws std::out_of_range If @a key is not in the map.
+		@param key Key.
+	*/
+	template<
+		class Q = key_type
+	>
+	mapped_type&
+	at(
+		key_arg<Q> const& key
+	) {
+		auto const it = this->find(key);
+		if (it == this->end()) {
+			throw std::out_of_range{"am::hash::flat_map::at(): key not found"};
+		}
+		return it->second;
+	}
+
+	/** @copydoc at(key_arg<Q> const&) */
+	template<
+		class Q = key_type
+	>
+	mapped_type const&
+	at(
+		key_arg<Q> const& key
+	) const {
+		auto const it = this->find(key);
+		if (it == this->end()) {
+			throw std::out_of_range{"am::hash::flat_map::at(): key not found"};
+		}
+		return it->second;
+	}
+
+	/**
+		Get the value mapped to a key, inserting a value-initialized
+		one if there is none.
+
+		@param key Key.
+	*/
+	mapped_type&
+	operator[](
+		key_type const& key
+	) {
+		return try_emplace(key).first->second;
+	}
+
+	/** @copydoc operator[](key_type const&) */
+	mapped_type&
+	operator[](
+		key_type&& key
+	) {
+		return try_emplace(std::move(key)).first->second;
+	}
+/// @}
+
+/** @name Modifiers */ /// @{
+	/**
+		Insert a value constructed in place if a key is not in the
+		map.
+
+		@note Unlike emplace(), nothing is constructed if @a key is
+		already in the map.
+
+		@returns An iterator to the value with @a key and whether a
+		value was inserted.
+		@param key Key.
+		@param args Mapped value constructor arguments.
+	*/
+	template<
+		class... Args
+	>
+	std::pair<iterator, bool>
+	try_emplace(
+		key_type const& key,
+		Args&&... args
+	) {
+		return this->emplace_key(
+			key,
+			std::piecewise_construct,
+			std::forward_as_tuple(key),
+			std::forward_as_tuple(std::forward<Args>(args)...)
+		);
+	}
+
+	/** @copydoc try_emplace(key_type const&, Args&&...) */
+	template<
+		class... Args
+	>
+	std::pair<iterator, bool>
+	try_emplace(
+		key_type&& key,
+		Args&&... args
+	) {
+		return this->emplace_key(
+			key,
+			std::piecewise_construct,
+			std::forward_as_tuple(std::move(key)),
+			std::forward_as_tuple(std::forward<Args>(args)...)
+		);
+	}
+
+	/**
+		Insert a value, or assign to the mapped value if the key is
+		already in the map.
+
+		@returns An iterator to the value with @a key and whether a
+		value was inserted.
+		@param key Key.
+		@param value Mapped value.
+	*/
+	template<
+		class M
+	>
+	std::pair<iterator, bool>
+	insert_or_assign(
+		key_type const& key,
+		M&& value
+	) {
+		auto res = try_emplace(key, std::forward<M>(value));
+		if (!res.second) {
+			res.first->second = std::forward<M>(value);
+		}
+		return res;
+	}
+
+	/** @copydoc insert_or_assign(key_type const&, M&&) */
+	template<
+		class M
+	>
+	std::pair<iterator, bool>
+	insert_or_assign(
+		key_type&& key,
+		M&& value
+	) {
+		auto res = try_emplace(std::move(key), std::forward<M>(value));
+		if (!res.second) {
+			res.first->second = std::forward<M>(value);
+		}
+		return res;
+	}
+/// @}
+};
+
+/**
+	Flat hash set.
+
+	@note Iterators are constant; keys cannot be modified in place.
+
+	@tparam K Key type.
+	@tparam Hash Hash functor.
+	@tparam Eq Key equality functor.
+*/
+template<
+	class K,
+	class Hash = hasher<xxh3<HashLength::HL64>>,
+	class Eq = equal_to
+>
+class flat_set
+	: public detail::hash::flat_table<detail::hash::flat_set_policy<K>, Hash, Eq>
+{
+private:
+	using base = detail::hash::flat_table<detail::hash::flat_set_policy<K>, Hash, Eq>;
+
+public:
+	using base::base;
+
+	/** Default constructor. */
+	flat_set() = default;
+};
+
+/** @} */ // end of doc-group flat_map
+/** @} */ // end of doc-group hash
+
+} // namespace hash
+} // namespace am
@@ -0,0 +1,320 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Hash functors.
+*/
+
+#pragma once
+
+#include "../config.hpp"
+#include "./common.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace am {
+namespace detail {
+namespace hash {
+
+/** @cond INTERNAL */
+
+#define AM_HASH_HASHER_RESTRICT_LENGTH(hash_length)						\
+	AM_STATIC_ASSERT(													\
+		(::am::hash::HashLength::HL32 == hash_length ||					\
+		::am::hash::HashLength::HL64 == hash_length),					\
+		"hasher requires a 32- or 64-bit hash implementation"			\
+	)
+
+template<
+	class Impl,
+	bool = ::am::hash::impl_is_seeded<Impl>::value
+>
+struct hasher_base {
+	typename Impl::hash_type
+	calc(
+		uint8_t const* const data,
+		unsigned const size
+	) const noexcept {
+		return Impl::calc(data, size);
+	}
+};
+
+template<
+	class Impl
+>
+struct hasher_base<Impl, true> {
+	using seed_type = typename Impl::seed_type;
+
+	seed_type seed;
+
+	hasher_base() noexcept
+		: seed()
+	{}
+
+	explicit
+	hasher_base(
+		seed_type const& seed
+	) noexcept
+		: seed(seed)
+	{}
+
+	typename Impl::hash_type
+	calc(
+		uint8_t const* const data,
+		unsigned const size
+	) const noexcept {
+		return Impl::calc(data, size, seed);
+	}
+};
+
+template<
+	class T
+>
+struct hasher_is_char
+	: std::integral_constant<bool,
+		std::is_same<T, char>::value ||
+		std::is_same<T, wchar_t>::value ||
+		std::is_same<T, char16_t>::value ||
+		std::is_same<T, char32_t>::value
+	>
+{};
+
+// Integers and enumerations, hashed by value as 64-bit integers so
+// that heterogeneous lookups with a different integer type agree
+template<
+	class T
+>
+struct hasher_is_integer
+	: std::integral_constant<bool,
+		std::is_integral<T>::value || std::is_enum<T>::value
+	>
+{};
+
+template<
+	class T,
+	bool = std::is_enum<T>::value
+>
+struct hasher_integer_cast {
+	static std::uint64_t
+	cast(
+		T const value
+	) noexcept {
+		return static_cast<std::uint64_t>(value);
+	}
+};
+
+template<
+	class T
+>
+struct hasher_integer_cast<T, true> {
+	static std::uint64_t
+	cast(
+		T const value
+	) noexcept {
+		return static_cast<std::uint64_t>(
+			static_cast<typename std::underlying_type<T>::type>(value)
+		);
+	}
+};
+
+// Pointers other than character pointers (which are C strings),
+// hashed by address
+template<
+	class T
+>
+struct hasher_is_object_pointer
+	: std::integral_constant<bool,
+		std::is_pointer<T>::value &&
+		!hasher_is_char<
+			typename std::remove_cv<
+				typename std::remove_pointer<T>::type
+			>::type
+		>::value
+	>
+{};
+
+/** @endcond */ // INTERNAL
+
+} // namespace hash
+} // namespace detail
+
+namespace hash {
+
+/**
+	@addtogroup hash
+	@{
+*/
+/**
+	@defgroup hasher Hash functors
+	@details
+	@c hasher<Impl> adapts a 32- or 64-bit hash implementation to the
+	standard @c Hash requirements (e.g., for @c std::unordered_map or
+	@c flat_map). It hashes:
+
+	- integers and enumerations by value, as 64-bit integers (so
+	  looking up an @c std::uint64_t key with an @c int finds it);
+	- pointers by address;
+	- C strings and contiguous strings (anything with @c data() and
+	  @c size() over integers, such as @c std::string) by the bytes of
+	  their characters.
+
+	A string hashes the same whichever form it is in, so @c hasher is
+	transparent: tables using it can look up @c std::string keys
+	with a C string without constructing a @c std::string.
+
+	32-bit hashes are widened to 64 bits without mixing. Tables that
+	take bits from both ends of the hash should mix it first (the
+	@ref flat_map "flat tables" do).
+	@{
+*/
+
+/**
+	Hash functor for a hash implementation.
+
+	@tparam Impl Hash implementation; must be 32- or 64-bit.
+*/
+template<
+	class Impl
+>
+struct hasher
+	: detail::hash::hasher_base<Impl>
+{
+	/** @cond INTERNAL */
+	AM_HASH_HASHER_RESTRICT_LENGTH(Impl::hash_length);
+	/** @endcond */
+
+	/** Hash implementation type. */
+	using impl_type = Impl;
+	/** Result type. */
+	using result_type = std::uint64_t;
+	/** Transparent tag (enables heterogeneous lookup). */
+	using is_transparent = void;
+
+	/**
+		Constructor.
+
+		@note Only available for seeded implementations. Seeded
+		hashers are default-constructed with a value-initialized seed.
+	*/
+	using detail::hash::hasher_base<Impl>::hasher_base;
+
+	/** Default constructor. */
+	hasher() = default;
+
+	/**
+		Hash an integer or enumeration.
+
+		@returns The hash of @a value as a 64-bit integer.
+		@param value Value.
+	*/
+	template<
+		class T
+	>
+	typename std::enable_if<
+		detail::hash::hasher_is_integer<T>::value,
+		result_type
+	>::type
+	operator()(
+		T const value
+	) const noexcept {
+		std::uint64_t const x = detail::hash::hasher_integer_cast<T>::cast(value);
+		return this->calc(reinterpret_cast<uint8_t const*>(&x), sizeof(x));
+	}
+
+	/**
+		Hash a pointer.
+
+		@returns The hash of the address in @a value.
+		@param value Pointer.
+	*/
+	template<
+		class T
+	>
+	typename std::enable_if<
+		detail::hash::hasher_is_object_pointer<T>::value,
+		result_type
+	>::type
+	operator()(
+		T const value
+	) const noexcept {
+		return this->calc(reinterpret_cast<uint8_t const*>(&value), sizeof(T));
+	}
+
+	/**
+		Hash a C string.
+
+		@returns The hash of the characters of @a str.
+		@param str NUL-terminated string.
+	*/
+	result_type
+	operator()(
+		char const* const str
+	) const noexcept {
+		return this->calc(
+			reinterpret_cast<uint8_t const*>(str),
+			static_cast<unsigned>(std::strlen(str))
+		);
+	}
+
+	/**
+		Hash a contiguous string.
+
+		@returns The hash of the characters of @a str.
+		@tparam StringT String type with @c data() and @c size() (e.g.,
+		@c std::string); inferred from @a str.
+		@param str String.
+	*/
+	template<
+		class StringT,
+		class C = typename std::remove_cv<
+			typename std::remove_pointer<
+				decltype(std::declval<StringT const&>().data())
+			>::type
+		>::type
+	>
+	typename std::enable_if<std::is_integral<C>::value, result_type>::type
+	operator()(
+		StringT const& str
+	) const noexcept {
+		return this->calc(
+			reinterpret_cast<uint8_t const*>(str.data()),
+			static_cast<unsigned>(str.size() * sizeof(C))
+		);
+	}
+};
+
+/**
+	Transparent equality functor.
+
+	Compares with <code>==</code> between any two types (like C++14's
+	<code>std::equal_to<void></code>).
+*/
+struct equal_to {
+	/** Transparent tag (enables heterogeneous lookup). */
+	using is_transparent = void;
+
+	/**
+		Compare values.
+
+		@returns <code>x == y</code>.
+	*/
+	template<
+		class T,
+		class U
+	>
+	bool
+	operator()(
+		T const& x,
+		U const& y
+	) const noexcept(noexcept(x == y)) {
+		return x == y;
+	}
+};
+
+/** @} */ // end of doc-group hasher
+/** @} */ // end of doc-group hash
+
+} // namespace hash
+} // namespace am
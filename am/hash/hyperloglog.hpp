@@ -0,0 +1,736 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief HyperLogLog cardinality estimator.
+*/
+
+#pragma once
+
+#include "../config.hpp"
+#include "../memory.hpp"
+#include "./common.hpp"
+#include "./hasher.hpp"
+#include "./xxhash.hpp"
+#include "./bloom.hpp"
+#include "../detail/hash/murmur_impl.hpp"
+#include "../detail/hash/flat_table.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(AM_DETAIL_AVX2)
+	#include <immintrin.h>
+#elif defined(AM_DETAIL_SSE2)
+	#include <emmintrin.h>
+#endif
+
+namespace am {
+namespace detail {
+namespace hash {
+
+/** @cond INTERNAL */
+
+// Sparse entries are (index << 6) | rank at this precision
+constexpr unsigned const hll_sparse_precision = 25u;
+constexpr unsigned const hll_min_precision = 4u;
+constexpr unsigned const hll_max_precision = 18u;
+constexpr std::uint8_t const hll_format = 1u;
+
+// Leading zeros; x must be non-zero
+inline unsigned
+hll_clz(
+	std::uint64_t x
+) noexcept {
+	x |= x >> 1;
+	x |= x >> 2;
+	x |= x >> 4;
+	x |= x >> 8;
+	x |= x >> 16;
+	x |= x >> 32;
+	return 63u - flat_ctz(x ^ (x >> 1));
+}
+
+// Register index and rank (leading zeros + 1 of the rest of the hash,
+// at most 65 - p) of a hash at precision p
+inline std::size_t
+hll_index(
+	std::uint64_t const hash,
+	unsigned const p
+) noexcept {
+	return static_cast<std::size_t>(hash >> (64u - p));
+}
+
+inline std::uint8_t
+hll_rank(
+	std::uint64_t const hash,
+	unsigned const p
+) noexcept {
+	return static_cast<std::uint8_t>(
+		hll_clz((hash << p) | (std::uint64_t{1u} << (p - 1u))) + 1u
+	);
+}
+
+inline std::uint32_t
+hll_sparse_entry(
+	std::uint64_t const hash
+) noexcept {
+	return static_cast<std::uint32_t>(
+		(hll_index(hash, hll_sparse_precision) << 6)
+		| hll_rank(hash, hll_sparse_precision)
+	);
+}
+
+// The dense register and rank at precision p of a sparse entry; the
+// same as inserting the hash directly
+inline void
+hll_sparse_to_dense(
+	std::uint32_t const entry,
+	unsigned const p,
+	std::size_t& index,
+	std::uint8_t& rank
+) noexcept {
+	unsigned const extra = hll_sparse_precision - p;
+	std::uint32_t const sparse_index = entry >> 6;
+	std::uint32_t const low = sparse_index & ((std::uint32_t{1u} << extra) - 1u);
+	index = sparse_index >> extra;
+	rank
+		= (0u != low)
+		? static_cast<std::uint8_t>(hll_clz(std::uint64_t{low} << (64u - extra)) + 1u)
+		: static_cast<std::uint8_t>(extra + (entry & 0x3fu))
+	;
+}
+
+// Sort entries and keep the highest rank for each index
+inline void
+hll_normalize(
+	std::vector<std::uint32_t>& entries
+) {
+	std::sort(entries.begin(), entries.end());
+	std::size_t n = 0u;
+	for (std::size_t i = 0; i < entries.size(); ++i) {
+		if (
+			0u < n &&
+			(entries[n - 1u] >> 6) == (entries[i] >> 6)
+		) {
+			entries[n - 1u] = entries[i];
+		} else {
+			entries[n++] = entries[i];
+		}
+	}
+	entries.resize(n);
+}
+
+// Register-wise maximum
+inline void
+hll_max(
+	std::uint8_t* const dst,
+	std::uint8_t const* const src,
+	std::size_t const size
+) noexcept {
+	std::size_t i = 0u;
+#if defined(AM_DETAIL_AVX2)
+	for (; i + 32u <= size; i += 32u) {
+		__m256i const a = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(dst + i));
+		__m256i const b = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_max_epu8(a, b));
+	}
+#elif defined(AM_DETAIL_SSE2)
+	for (; i + 16u <= size; i += 16u) {
+		__m128i const a = _mm_loadu_si128(reinterpret_cast<__m128i const*>(dst + i));
+		__m128i const b = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_max_epu8(a, b));
+	}
+#endif
+	for (; i < size; ++i) {
+		dst[i] = std::max(dst[i], src[i]);
+	}
+}
+
+// Ertl's improved estimator ("New cardinality estimation algorithms
+// for HyperLogLog sketches", 2017) from a histogram of register ranks
+// (counts[0] empty registers through counts[q + 1] saturated ones).
+// It corrects the small- and large-range bias of the raw estimate
+// analytically, so it needs no empirical bias tables or
+// linear-counting threshold
+inline double
+hll_sigma(
+	double x
+) noexcept {
+	if (1.0 == x) {
+		return std::numeric_limits<double>::infinity();
+	}
+	double y = 1.0;
+	double z = x;
+	double prev;
+	do {
+		x *= x;
+		prev = z;
+		z += x * y;
+		y += y;
+	} while (z != prev);
+	return z;
+}
+
+inline double
+hll_tau(
+	double x
+) noexcept {
+	if (0.0 == x || 1.0 == x) {
+		return 0.0;
+	}
+	double y = 1.0;
+	double z = 1.0 - x;
+	double prev;
+	do {
+		x = std::sqrt(x);
+		prev = z;
+		y *= 0.5;
+		z -= (1.0 - x) * (1.0 - x) * y;
+	} while (z != prev);
+	return z / 3.0;
+}
+
+inline double
+hll_estimate(
+	std::uint64_t const* const counts,
+	unsigned const q,
+	double const m
+) noexcept {
+	double z = m * hll_tau(1.0 - static_cast<double>(counts[q + 1u]) / m);
+	for (unsigned k = q; 0u < k; --k) {
+		z = 0.5 * (z + static_cast<double>(counts[k]));
+	}
+	z += m * hll_sigma(static_cast<double>(counts[0]) / m);
+	return m * m / (2.0 * std::log(2.0) * z);
+}
+
+inline void
+hll_put_varint(
+	std::vector<std::uint8_t>& out,
+	std::uint32_t x
+) {
+	while (0x80u <= x) {
+		out.push_back(static_cast<std::uint8_t>(x | 0x80u));
+		x >>= 7;
+	}
+	out.push_back(static_cast<std::uint8_t>(x));
+}
+
+inline bool
+hll_get_varint(
+	std::uint8_t const*& data,
+	std::uint8_t const* const end,
+	std::uint32_t& x
+) noexcept {
+	x = 0u;
+	for (unsigned shift = 0u; shift < 35u; shift += 7u) {
+		if (data == end) {
+			return false;
+		}
+		std::uint32_t const byte = *data++;
+		x |= (byte & 0x7fu) << shift;
+		if (0u == (byte & 0x80u)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/** @endcond */ // INTERNAL
+
+} // namespace hash
+} // namespace detail
+
+namespace hash {
+
+/**
+	@addtogroup hash
+	@{
+*/
+/**
+	@defgroup hyperloglog HyperLogLog
+	@details
+	@c hyperloglog estimates the number of distinct keys inserted in
+	a fixed amount of memory, following HyperLogLog++ (Heule et al.,
+	"HyperLogLog in Practice", 2013): 64-bit hashes (so there is no
+	large-range correction; hashes are remixed, so 32-bit hash
+	functors work as well), and a sparse representation for small
+	cardinalities.
+
+	A sketch of precision @c p has <code>m = 2^p</code> one-byte
+	registers and a relative standard error of about
+	<code>1.04 / sqrt(m)</code> (0.81% at the default precision of
+	14, in 16 KiB). It starts sparse: a sorted list of the distinct
+	(index, rank) pairs at precision 25, which is nearly exact for
+	small cardinalities, and becomes dense once the list would
+	outgrow the registers (at about <code>m / 4</code> entries).
+
+	Estimates use Ertl's improved estimator, which corrects the bias
+	of the raw HyperLogLog estimate at small and large cardinalities
+	analytically rather than with HyperLogLog++'s empirical bias
+	tables, and is at least as accurate over the whole range.
+
+	Sketches of the same precision and hash functor merge into the
+	sketch of the union of their keys (dense registers are merged
+	16 or 32 at a time with SSE2 or AVX2), so a stream can be split
+	over threads with one sketch each, then the sketches merged. A
+	sketch is not safe to modify from several threads at once.
+	serialize() and deserialize() move sketches between processes;
+	the sparse form is delta- and varint-coded.
+	@{
+*/
+
+/**
+	HyperLogLog cardinality estimator.
+
+	@tparam Hash Hash functor.
+*/
+template<
+	class Hash = hasher<xxh3<HashLength::HL64>>
+>
+class hyperloglog {
+public:
+	/** Size/length type. */
+	using size_type = std::size_t;
+	/** Hash functor type. */
+	using hasher = Hash;
+
+private:
+	unsigned m_precision;
+	// Sorted and normalized while sparse (see hll_normalize()); new
+	// entries collect unsorted in the buffer first
+	std::vector<std::uint32_t> m_sparse;
+	std::vector<std::uint32_t> m_buffer;
+	// Empty while sparse
+	aligned_vector<std::uint8_t> m_registers;
+	Hash m_hash;
+
+	// The index is taken from the high bits of the hash, so it is
+	// remixed for 32-bit (or weak) hash functors
+	static std::uint64_t
+	mix(
+		std::uint64_t const hash
+	) noexcept {
+		return detail::hash::fmix64(hash);
+	}
+
+	void
+	insert_mixed(
+		std::uint64_t const hash
+	) {
+		if (sparse()) {
+			m_buffer.push_back(detail::hash::hll_sparse_entry(hash));
+			if (buffer_limit() <= m_buffer.size()) {
+				flush();
+			}
+		} else {
+			size_type const index = detail::hash::hll_index(hash, m_precision);
+			std::uint8_t const rank = detail::hash::hll_rank(hash, m_precision);
+			m_registers[index] = std::max(m_registers[index], rank);
+		}
+	}
+
+	size_type
+	sparse_limit() const noexcept {
+		return register_count() / 4u;
+	}
+
+	size_type
+	buffer_limit() const noexcept {
+		return std::max<size_type>(register_count() / 16u, 16u);
+	}
+
+	void
+	to_dense() {
+		m_registers.assign(register_count(), 0u);
+		insert_sparse(m_sparse);
+		insert_sparse(m_buffer);
+		m_sparse.clear();
+		m_sparse.shrink_to_fit();
+		m_buffer.clear();
+		m_buffer.shrink_to_fit();
+	}
+
+	void
+	insert_sparse(
+		std::vector<std::uint32_t> const& entries
+	) noexcept {
+		for (std::uint32_t const entry : entries) {
+			size_type index;
+			std::uint8_t rank;
+			detail::hash::hll_sparse_to_dense(entry, m_precision, index, rank);
+			m_registers[index] = std::max(m_registers[index], rank);
+		}
+	}
+
+	// Fold the buffer into the sparse list, and go dense if the list
+	// got too long
+	void
+	flush() {
+		m_sparse.insert(m_sparse.end(), m_buffer.begin(), m_buffer.end());
+		m_buffer.clear();
+		detail::hash::hll_normalize(m_sparse);
+		if (sparse_limit() < m_sparse.size()) {
+			to_dense();
+		}
+	}
+
+	std::vector<std::uint32_t>
+	sparse_entries() const {
+		std::vector<std::uint32_t> entries{m_sparse};
+		entries.insert(entries.end(), m_buffer.begin(), m_buffer.end());
+		detail::hash::hll_normalize(entries);
+		return entries;
+	}
+
+public:
+/** @name Special member functions */ /// @{
+	/** Destructor. */
+	~hyperloglog() = default;
+	/** Copy constructor. */
+	hyperloglog(hyperloglog const&) = default;
+	/** Move constructor. */
+	hyperloglog(hyperloglog&&) = default;
+	/** Copy assignment operator. */
+	hyperloglog& operator=(hyperloglog const&) = default;
+	/** Move assignment operator. */
+	hyperloglog& operator=(hyperloglog&&) = default;
+
+	/**
+		Constructor.
+
+		@param precision Precision (base-2 logarithm of the number of
+		registers); clamped to [4, 18].
+		@param hash Hash functor.
+	*/
+	explicit
+	hyperloglog(
+		unsigned const precision = 14u,
+		Hash const& hash = Hash()
+	)
+		: m_precision(std::min(
+			std::max(precision, detail::hash::hll_min_precision),
+			detail::hash::hll_max_precision
+		))
+		, m_sparse()
+		, m_buffer()
+		, m_registers()
+		, m_hash(hash)
+	{}
+/// @}
+
+/** @name Properties */ /// @{
+	/**
+		Get the precision.
+	*/
+	unsigned
+	precision() const noexcept {
+		return m_precision;
+	}
+
+	/**
+		Get the number of registers.
+	*/
+	size_type
+	register_count() const noexcept {
+		return size_type{1u} << m_precision;
+	}
+
+	/**
+		Check if the sketch is sparse.
+	*/
+	bool
+	sparse() const noexcept {
+		return m_registers.empty();
+	}
+
+	/**
+		Get the hash functor.
+	*/
+	hasher
+	hash_function() const {
+		return m_hash;
+	}
+/// @}
+
+/** @name Operations */ /// @{
+	/**
+		Insert a key by hash.
+
+		@param hash Hash of the key.
+	*/
+	void
+	insert_hash(
+		std::uint64_t const hash
+	) {
+		insert_mixed(mix(hash));
+	}
+
+	/**
+		Insert a key.
+
+		@tparam K Key type; any type the hash functor takes.
+		@param key Key.
+	*/
+	template<
+		class K
+	>
+	void
+	insert(
+		K const& key
+	) {
+		insert_hash(static_cast<std::uint64_t>(m_hash(key)));
+	}
+
+	/**
+		Insert keys.
+
+		@param count Number of keys.
+		@param keys Keys (@a count values).
+	*/
+	template<
+		class K
+	>
+	void
+	insert(
+		size_type const count,
+		K const* const keys
+	) {
+		std::uint64_t h[detail::hash::bloom_batch];
+		for (size_type i = 0; i < count; i += detail::hash::bloom_batch) {
+			size_type const n
+				= (count - i < detail::hash::bloom_batch)
+				? count - i
+				: detail::hash::bloom_batch
+			;
+			for (size_type j = 0; j < n; ++j) {
+				h[j] = mix(static_cast<std::uint64_t>(m_hash(keys[i + j])));
+			}
+			if (sparse()) {
+				for (size_type j = 0; j < n; ++j) {
+					insert_mixed(h[j]);
+				}
+				continue;
+			}
+			std::uint8_t* const registers = m_registers.data();
+			for (size_type j = 0; j < n; ++j) {
+				detail::hash::bloom_prefetch(
+					registers + detail::hash::hll_index(h[j], m_precision)
+				);
+			}
+			for (size_type j = 0; j < n; ++j) {
+				size_type const index = detail::hash::hll_index(h[j], m_precision);
+				std::uint8_t const rank = detail::hash::hll_rank(h[j], m_precision);
+				registers[index] = std::max(registers[index], rank);
+			}
+		}
+	}
+
+	/**
+		Estimate the number of distinct keys inserted.
+	*/
+	double
+	estimate() const {
+		std::uint64_t counts[66]{};
+		if (sparse()) {
+			auto const entries = sparse_entries();
+			for (std::uint32_t const entry : entries) {
+				++counts[entry & 0x3fu];
+			}
+			counts[0] = (std::uint64_t{1u} << detail::hash::hll_sparse_precision) - entries.size();
+			return detail::hash::hll_estimate(
+				counts,
+				64u - detail::hash::hll_sparse_precision,
+				static_cast<double>(std::uint64_t{1u} << detail::hash::hll_sparse_precision)
+			);
+		}
+		for (std::uint8_t const rank : m_registers) {
+			++counts[rank];
+		}
+		return detail::hash::hll_estimate(
+			counts, 64u - m_precision, static_cast<double>(register_count())
+		);
+	}
+
+	/**
+		Merge another sketch into this one.
+
+		@note Afterwards this is the sketch of the union of the keys
+		inserted in both.
+
+		@throws std::invalid_argument If the precisions differ.
+		@param other Sketch with the same precision and hash functor.
+	*/
+	void
+	merge(
+		hyperloglog const& other
+	) {
+		if (this == &other) {
+			return;
+		} else if (m_precision != other.m_precision) {
+			throw std::invalid_argument{
+				"am::hash::hyperloglog::merge(): precisions differ"
+			};
+		}
+		if (other.sparse()) {
+			if (sparse()) {
+				m_buffer.insert(m_buffer.end(), other.m_sparse.begin(), other.m_sparse.end());
+				m_buffer.insert(m_buffer.end(), other.m_buffer.begin(), other.m_buffer.end());
+				flush();
+			} else {
+				insert_sparse(other.m_sparse);
+				insert_sparse(other.m_buffer);
+			}
+		} else {
+			if (sparse()) {
+				to_dense();
+			}
+			detail::hash::hll_max(
+				m_registers.data(), other.m_registers.data(), m_registers.size()
+			);
+		}
+	}
+
+	/**
+		Remove all keys.
+
+		@note The sketch becomes sparse again.
+	*/
+	void
+	clear() noexcept {
+		m_sparse.clear();
+		m_buffer.clear();
+		m_registers.clear();
+		m_registers.shrink_to_fit();
+	}
+
+	/**
+		Serialize.
+
+		@note The format is a byte each for the format version, the
+		precision and the representation, then either the number of
+		sparse entries and the differences between successive sorted
+		entries (all as LEB128 varints) or the dense registers.
+	*/
+	std::vector<std::uint8_t>
+	serialize() const {
+		if (sparse() && !m_buffer.empty()) {
+			// Same form whether or not the buffer was flushed
+			hyperloglog flushed{*this};
+			flushed.flush();
+			return flushed.serialize();
+		}
+		std::vector<std::uint8_t> out{
+			detail::hash::hll_format,
+			static_cast<std::uint8_t>(m_precision),
+			static_cast<std::uint8_t>(sparse() ? 0u : 1u)
+		};
+		if (sparse()) {
+			auto const& entries = m_sparse;
+			detail::hash::hll_put_varint(out, static_cast<std::uint32_t>(entries.size()));
+			std::uint32_t prev = 0u;
+			for (std::uint32_t const entry : entries) {
+				detail::hash::hll_put_varint(out, entry - prev);
+				prev = entry;
+			}
+		} else {
+			out.insert(out.end(), m_registers.begin(), m_registers.end());
+		}
+		return out;
+	}
+
+	/**
+		Deserialize.
+
+		@note The sketch is unchanged if @a data is not a valid
+		serialized sketch. The hash functor is not part of the
+		serialized form; it must be the same as the one that built
+		the sketch.
+
+		@returns Whether @a data was valid.
+		@param data Serialized sketch (from serialize()).
+		@param size Size of @a data in bytes.
+	*/
+	bool
+	deserialize(
+		std::uint8_t const* const data,
+		size_type const size
+	) {
+		if (
+			3u > size ||
+			detail::hash::hll_format != data[0] ||
+			detail::hash::hll_min_precision > data[1] ||
+			detail::hash::hll_max_precision < data[1] ||
+			1u < data[2]
+		) {
+			return false;
+		}
+		unsigned const precision = data[1];
+		size_type const m = size_type{1u} << precision;
+		std::uint8_t const* p = data + 3u;
+		std::uint8_t const* const end = data + size;
+		if (1u == data[2]) {
+			unsigned const max_rank = 65u - precision;
+			if (static_cast<size_type>(end - p) != m) {
+				return false;
+			}
+			for (; p != end; ++p) {
+				if (max_rank < *p) {
+					return false;
+				}
+			}
+			m_precision = precision;
+			m_sparse.clear();
+			m_buffer.clear();
+			m_registers.assign(data + 3u, end);
+			return true;
+		}
+
+		std::uint32_t count;
+		if (!detail::hash::hll_get_varint(p, end, count) || m / 4u < count) {
+			return false;
+		}
+		std::vector<std::uint32_t> entries(count);
+		std::uint64_t entry = 0u;
+		for (std::uint32_t i = 0; i < count; ++i) {
+			std::uint32_t delta;
+			if (!detail::hash::hll_get_varint(p, end, delta)) {
+				return false;
+			}
+			std::uint64_t const next = entry + delta;
+			if (
+				(0u < i && (next >> 6) <= (entry >> 6)) ||
+				0u != (next >> 31) ||
+				0u == (next & 0x3fu) ||
+				64u - detail::hash::hll_sparse_precision + 1u < (next & 0x3fu)
+			) {
+				return false;
+			}
+			entry = next;
+			entries[i] = static_cast<std::uint32_t>(entry);
+		}
+		if (p != end) {
+			return false;
+		}
+		m_precision = precision;
+		m_sparse = std::move(entries);
+		m_buffer.clear();
+		m_registers.clear();
+		m_registers.shrink_to_fit();
+		return true;
+	}
+/// @}
+};
+
+/** @} */ // end of doc-group hyperloglog
+/** @} */ // end of doc-group hash
+
+} // namespace hash
+} // namespace am
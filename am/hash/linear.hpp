@@ -0,0 +1,345 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Hashing of vectors and matrices.
+*/
+
+#pragma once
+
+#include "../config.hpp"
+#include "./common.hpp"
+#include "../detail/hash/murmur_impl.hpp"
+#include "../detail/linear/type_traits.hpp"
+#include "../linear/matrix_types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+namespace am {
+namespace detail {
+namespace hash {
+
+/** @cond INTERNAL */
+
+// Component representation for hashing: floating-point components
+// map -0 to +0 and every NaN to the default quiet NaN (so values
+// comparing equal hash equal, and NaNs hash together); the others are
+// unchanged
+template<
+	class T,
+	bool = std::is_floating_point<T>::value
+>
+struct canonical_component {
+	AM_STATIC_ASSERT(
+		std::is_integral<T>::value,
+		"components must be integral or floating-point"
+	);
+
+	using bits_type = T;
+
+	static T
+	get(
+		T const x
+	) noexcept {
+		return x;
+	}
+
+	static std::uint64_t
+	word(
+		T const x
+	) noexcept {
+		return static_cast<std::uint64_t>(x);
+	}
+};
+
+template<
+	class T
+>
+struct canonical_component<T, true> {
+	AM_STATIC_ASSERT(
+		std::numeric_limits<T>::is_iec559
+		&& (sizeof(T) == 4u || sizeof(T) == 8u),
+		"floating-point components must be IEEE 754 single or double"
+	);
+
+	using bits_type = typename std::conditional<
+		sizeof(T) == 4u, std::uint32_t, std::uint64_t
+	>::type;
+
+	static T
+	get(
+		T const x
+	) noexcept {
+		return
+			x == T(0) ? T(0)
+			: x != x ? std::numeric_limits<T>::quiet_NaN()
+			: x
+		;
+	}
+
+	static std::uint64_t
+	word(
+		T const x
+	) noexcept {
+		// Same as get(), on the bits (branchless)
+		constexpr unsigned const shift = 8u * sizeof(T) - 1u;
+		constexpr bits_type const abs_mask = ~(bits_type(1) << shift);
+		constexpr bits_type const inf
+			= sizeof(T) == 4u
+			? bits_type(0x7f800000u)
+			: bits_type(0x7ff0000000000000ULL)
+		;
+		constexpr bits_type const qnan
+			= sizeof(T) == 4u
+			? bits_type(0x7fc00000u)
+			: bits_type(0x7ff8000000000000ULL)
+		;
+		bits_type bits;
+		std::memcpy(&bits, &x, sizeof(bits));
+		bits = (bits & abs_mask) == 0u ? bits_type(0u) : bits;
+		bits = (bits & abs_mask) > inf ? qnan : bits;
+		return bits;
+	}
+};
+
+// Visit the components of a vector or matrix in memory order
+template<
+	class Cons,
+	bool = linear::is_matrix<Cons>::value
+>
+struct construct_components {
+	AM_STATIC_ASSERT(
+		linear::is_vector<Cons>::value,
+		"Cons must be a vector or matrix type"
+	);
+
+	static constexpr std::size_t const count = Cons::size();
+
+	static typename Cons::value_type
+	get(
+		Cons const& value,
+		std::size_t const i
+	) noexcept {
+		return value[i];
+	}
+};
+
+template<
+	class Cons
+>
+struct construct_components<Cons, true> {
+	static constexpr std::size_t const rows = Cons::col_type::size();
+	static constexpr std::size_t const count = Cons::size() * rows;
+
+	static typename Cons::value_type
+	get(
+		Cons const& value,
+		std::size_t const i
+	) noexcept {
+		return value[i / rows][i % rows];
+	}
+};
+
+// One word per component through the MurmurHash3 x64 block mix, then
+// the finalizer
+template<
+	class Cons
+>
+inline std::uint64_t
+construct_hash(
+	Cons const& value,
+	std::uint64_t const seed
+) noexcept {
+	using access = construct_components<Cons>;
+	using canonical = canonical_component<typename Cons::value_type>;
+	std::uint64_t h = seed ^ (access::count * 0x9e3779b97f4a7c15ULL);
+	for (std::size_t i = 0; i < access::count; ++i) {
+		std::uint64_t k = canonical::word(access::get(value, i));
+		k *= 0x87c37b91114253d5ULL;
+		k = (k << 31) | (k >> 33);
+		k *= 0x4cf5ad432745937fULL;
+		h ^= k;
+		h = ((h << 27) | (h >> 37)) * 5u + 0x52dce729u;
+	}
+	return fmix64(h);
+}
+
+// Canonical components, as stored in the construct
+template<
+	class Cons
+>
+struct canonical_construct {
+	using access = construct_components<Cons>;
+	using canonical = canonical_component<typename Cons::value_type>;
+
+	typename Cons::value_type data[access::count];
+
+	explicit
+	canonical_construct(
+		Cons const& value
+	) noexcept {
+		for (std::size_t i = 0; i < access::count; ++i) {
+			data[i] = canonical::get(access::get(value, i));
+		}
+	}
+};
+
+/** @endcond */ // INTERNAL
+
+} // namespace hash
+} // namespace detail
+
+namespace hash {
+
+/**
+	@addtogroup hash
+	@{
+*/
+
+/** @name Vector and matrix hashing */ /// @{
+
+/**
+	Calculate the hash of a vector or matrix.
+
+	Components are mixed a word at a time (with the MurmurHash3 block
+	mix and finalizer), which is much faster than hashing the bytes.
+	This is the hash used by the @c std::hash specializations.
+
+	Floating-point components are canonicalized first: @c -0 hashes
+	as @c +0 and all NaNs hash the same. Values that compare equal
+	therefore hash equal.
+
+	@note The hash is not the same across platforms with different
+	integer or floating-point representations.
+
+	@tparam Cons Vector or matrix type; inferred from @a value.
+	@returns 64-bit hash of @a value.
+	@param value Vector or matrix.
+	@param seed Seed value.
+*/
+template<
+	class Cons
+>
+inline std::uint64_t
+linear_hash(
+	Cons const& value,
+	std::uint64_t const seed = 0u
+) noexcept {
+	return detail::hash::construct_hash(value, seed);
+}
+
+/**
+	Calculate the hash of a vector or matrix with a hash
+	implementation.
+
+	The hash is that of the components' bytes (in memory order) after
+	the canonicalization described in linear_hash().
+
+	@tparam Impl Implementation interface.
+	@tparam Cons Vector or matrix type; inferred from @a value.
+	@returns The hash of @a value.
+	@param value Vector or matrix.
+*/
+template<
+	class Impl,
+	class Cons,
+	class = typename std::enable_if<
+		!impl_is_seeded<Impl>::value && (
+			detail::linear::is_vector<Cons>::value ||
+			detail::linear::is_matrix<Cons>::value
+		)
+	>::type
+>
+inline typename Impl::hash_type
+calc(
+	Cons const& value
+) {
+	detail::hash::canonical_construct<Cons> const c{value};
+	return Impl::calc(
+		reinterpret_cast<uint8_t const*>(c.data),
+		static_cast<unsigned>(sizeof(c.data))
+	);
+}
+
+/**
+	Calculate the hash of a vector or matrix with a hash
+	implementation (seeded).
+
+	@tparam Impl Implementation interface.
+	@tparam Cons Vector or matrix type; inferred from @a value.
+	@returns The hash of @a value.
+	@param value Vector or matrix.
+	@param seed Seed value.
+*/
+template<
+	class Impl,
+	class Cons,
+	class = typename std::enable_if<
+		impl_is_seeded<Impl>::value && (
+			detail::linear::is_vector<Cons>::value ||
+			detail::linear::is_matrix<Cons>::value
+		)
+	>::type
+>
+inline typename Impl::hash_type
+calc(
+	Cons const& value,
+	typename Impl::seed_type const seed
+) {
+	detail::hash::canonical_construct<Cons> const c{value};
+	return Impl::calc(
+		reinterpret_cast<uint8_t const*>(c.data),
+		static_cast<unsigned>(sizeof(c.data)),
+		seed
+	);
+}
+
+/// @}
+
+/** @} */ // end of doc-group hash
+
+} // namespace hash
+} // namespace am
+
+/** @cond INTERNAL */
+
+#define AM_DETAIL_STD_HASH(TYPE)									\
+	template<class T>												\
+	struct hash< ::am::detail::linear::TYPE<T> > {					\
+		std::size_t													\
+		operator()(													\
+			::am::detail::linear::TYPE<T> const& value				\
+		) const noexcept {											\
+			return static_cast<std::size_t>(						\
+				::am::hash::linear_hash(value)						\
+			);														\
+		}															\
+	} /**/
+
+namespace std {
+
+AM_DETAIL_STD_HASH(tvec1);
+AM_DETAIL_STD_HASH(tvec2);
+AM_DETAIL_STD_HASH(tvec3);
+AM_DETAIL_STD_HASH(tvec4);
+
+AM_DETAIL_STD_HASH(tmat2x2);
+AM_DETAIL_STD_HASH(tmat2x3);
+AM_DETAIL_STD_HASH(tmat2x4);
+AM_DETAIL_STD_HASH(tmat3x2);
+AM_DETAIL_STD_HASH(tmat3x3);
+AM_DETAIL_STD_HASH(tmat3x4);
+AM_DETAIL_STD_HASH(tmat4x2);
+AM_DETAIL_STD_HASH(tmat4x3);
+AM_DETAIL_STD_HASH(tmat4x4);
+
+} // namespace std
+
+#undef AM_DETAIL_STD_HASH
+
+/** @endcond */ // INTERNAL
@@ -0,0 +1,70 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief SipHash.
+*/
+
+#pragma once
+
+#include "../config.hpp"
+#include "./common.hpp"
+#include "../detail/hash/siphash_impl.hpp"
+
+namespace am {
+namespace hash {
+
+/**
+	@addtogroup hash
+	@{
+*/
+/**
+	@defgroup siphash SipHash
+	@details
+	SipHash is a keyed pseudorandom function by Jean-Philippe Aumasson
+	and Daniel J. Bernstein. With a secret key, an attacker cannot
+	construct inputs that collide, so it protects hash tables keyed on
+	untrusted input from hash flooding. None of the other hashes in
+	@ref hash do this, seeded or not.
+
+	AM implements <strong>SipHash-2-4</strong> (the original) and
+	<strong>SipHash-1-3</strong> (faster, with a smaller security
+	margin; used by Python and Rust for their hash tables). Both take
+	a 128-bit key as their seed and produce a 64-bit hash.
+
+	Both are stateful (for @c generic_combiner) and supply @c calc_ce.
+	The one-shot forms are tuned for short inputs: the last partial
+	word is read with at most two loads.
+
+	@note The key must be secret and random (e.g., from
+	@c std::random_device) for flooding resistance.
+
+	@note Although the AM implementations are under the MIT license,
+	SipHash itself is by Jean-Philippe Aumasson and Daniel J.
+	Bernstein and is in the public domain (CC0).
+	@{
+*/
+
+/**
+	SipHash key.
+
+	@c k0 and @c k1 are the first and last 8 bytes of the reference
+	implementation's 16-byte key, read as little-endian.
+*/
+using siphash_key = detail::hash::siphash_key;
+
+/**
+	SipHash-2-4 hash implementation.
+*/
+using siphash24 = detail::hash::siphash_impl<2u, 4u>;
+
+/**
+	SipHash-1-3 hash implementation.
+*/
+using siphash13 = detail::hash::siphash_impl<1u, 3u>;
+
+/** @} */ // end of doc-group siphash
+/** @} */ // end of doc-group hash
+
+} // namespace hash
+} // namespace am
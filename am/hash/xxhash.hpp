@@ -0,0 +1,72 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief xxHash.
+*/
+
+#pragma once
+
+#include "../config.hpp"
+#include "./common.hpp"
+#include "../detail/hash/xxhash_impl.hpp"
+
+namespace am {
+namespace hash {
+
+/**
+	@addtogroup hash
+	@{
+*/
+/**
+	@defgroup xxhash xxHash
+	@details
+	The xxHash hashes are fast non-cryptographic algorithms created by
+	Yann Collet.
+
+	AM implements <strong>XXH64</strong> and <strong>XXH3</strong>
+	(64-bit and 128-bit). Both are seeded and stateful (so they can be
+	used with @c generic_combiner), and both produce the same output as
+	the reference implementation (0.8) on all hosts.
+
+	XXH3 is much faster than the other algorithms for all but the
+	smallest inputs. Its long-input loop uses SSE2 or AVX2 when the
+	compiler targets them (see @c AM_CONFIG_NO_INTRINSICS); results
+	are the same either way.
+
+	There are a few quirks of the AM implementations:
+
+	- @c xxh3<HL128> returns its 128-bit hash as a
+	  @c common_hash_type<HL128>, with the low 64 bits followed by
+	  the high 64 bits, each in host byte order (the layout of the
+	  reference @c XXH128_hash_t).
+	- A zero seed gives the unseeded reference hash (e.g.,
+	  @c XXH3_64bits()).
+	- Custom secrets are not supported.
+	- The XXH3 state is about 500 bytes.
+
+	@note Although the AM implementations are under the MIT license,
+	the xxHash algorithms themselves are Copyright (C) Yann Collet
+	under the BSD 2-clause license.
+	@{
+*/
+
+/**
+	XXH64 hash implementation.
+*/
+using xxh64 = detail::hash::xxh64_impl<am::hash::HashLength::HL64>;
+
+/**
+	XXH3 hash implementation.
+
+	@remarks Only lengths @c HashLength::HL64 and @c HashLength::HL128
+	are supplied.
+*/
+template<HashLength L>
+using xxh3 = detail::hash::xxh3_impl<L>;
+
+/** @} */ // end of doc-group xxhash
+/** @} */ // end of doc-group hash
+
+} // namespace hash
+} // namespace am
@@ -0,0 +1,497 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Polar and translation-rotation-scale decomposition.
+*/
+
+#pragma once
+
+#include "../config.hpp"
+#include "../detail/linear/lane_pack.hpp"
+#include "./vec3.hpp"
+#include "./vec4.hpp"
+#include "./mat3x3.hpp"
+#include "./mat4x4.hpp"
+#include "./matrix_operations.hpp"
+#include "./eigen.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace am {
+namespace detail {
+namespace linear {
+
+/** @cond INTERNAL */
+
+template<
+	class T
+>
+constexpr unsigned
+polar_default_iterations() noexcept {
+	return 16u;
+}
+
+// c = transpose of the adjugate (columns are cross products of the
+// columns of a); returns the determinant
+template<
+	class S
+>
+inline S
+cofactor(
+	S const (&a)[3][3],
+	S (&c)[3][3]
+) noexcept {
+	for (std::size_t i = 0; i < 3; ++i) {
+		S const (&u)[3] = a[(i + 1) % 3];
+		S const (&v)[3] = a[(i + 2) % 3];
+		c[i][0] = u[1] * v[2] - u[2] * v[1];
+		c[i][1] = u[2] * v[0] - u[0] * v[2];
+		c[i][2] = u[0] * v[1] - u[1] * v[0];
+	}
+	return a[0][0] * c[0][0] + a[0][1] * c[0][1] + a[0][2] * c[0][2];
+}
+
+template<
+	class S
+>
+inline S
+frobenius2(
+	S const (&a)[3][3]
+) noexcept {
+	S r = a[0][0] * a[0][0];
+	for (std::size_t i = 1; i < 9; ++i) {
+		r = r + a[i / 3][i % 3] * a[i / 3][i % 3];
+	}
+	return r;
+}
+
+// Scaled Newton iteration (Higham, "Computing the polar
+// decomposition—with applications", 1986):
+//
+//   Q' = (g Q + Q^-T / g) / 2,  g = (|Q^-1| / |Q|)^(1/2)
+//
+// Converges quadratically; all lanes stop once every lane has
+// converged. Lanes that are (numerically) singular are flagged
+// instead, since the iteration breaks down for them. The rotation
+// always has determinant 1; for a negative determinant the
+// reflection is left in the stretch as a negation.
+template<
+	class T,
+	class S,
+	class M
+>
+inline void
+polar_kernel(
+	S const (&a)[3][3],
+	S (&r)[3][3],
+	S (&p)[3][3],
+	M& singular,
+	unsigned const max_iterations
+) noexcept {
+	T const epsilon = std::numeric_limits<T>::epsilon();
+	T const tolerance = T(16) * epsilon * T(16) * epsilon;
+	S const scale = normalization_scale<T>(a, false);
+	S const inv = inverse_scale<T>(scale);
+	S const one = lane_broadcast(scale, T(1));
+
+	S c[3][3];
+	for (std::size_t i = 0; i < 3; ++i) {
+		for (std::size_t j = 0; j < 3; ++j) {
+			r[i][j] = a[i][j] * inv;
+		}
+	}
+	S const det0 = cofactor(r, c);
+	singular = lane_abs(det0) <= epsilon;
+	S const flip = lane_select(det0 < T(0), -one, one);
+	for (std::size_t i = 0; i < 3; ++i) {
+		for (std::size_t j = 0; j < 3; ++j) {
+			r[i][j] = r[i][j] * flip;
+		}
+	}
+
+	for (unsigned k = 0; k < max_iterations; ++k) {
+		S det = cofactor(r, c);
+		det = lane_select(lane_abs(det) > T(0), det, one);
+		S const g = lane_sqrt(lane_sqrt(frobenius2(c) / frobenius2(r)) / lane_abs(det));
+		S const cg = one / (g * det);
+		S delta = one - one;
+		for (std::size_t i = 0; i < 3; ++i) {
+			for (std::size_t j = 0; j < 3; ++j) {
+				S const x = T(0.5) * (g * r[i][j] + cg * c[i][j]);
+				S const d = x - r[i][j];
+				delta = delta + d * d;
+				r[i][j] = x;
+			}
+		}
+		if (!lane_any(delta > tolerance)) {
+			break;
+		}
+	}
+
+	// P = R^T A, symmetrized
+	S ra[3][3];
+	for (std::size_t i = 0; i < 3; ++i) {
+		for (std::size_t j = 0; j < 3; ++j) {
+			ra[i][j]
+				= r[i][0] * a[j][0]
+				+ r[i][1] * a[j][1]
+				+ r[i][2] * a[j][2]
+			;
+		}
+	}
+	for (std::size_t i = 0; i < 3; ++i) {
+		for (std::size_t j = 0; j < 3; ++j) {
+			p[j][i] = T(0.5) * (ra[i][j] + ra[j][i]);
+		}
+	}
+}
+
+// Rank-deficient fallback through the SVD: A = (U V^T)(V S V^T)
+template<
+	class T
+>
+inline void
+polar_svd(
+	tmat3x3<T> const& m,
+	tmat3x3<T>& r,
+	tmat3x3<T>& p
+) noexcept {
+	tmat3x3<T> u{tmat3x3<T>::no_init}, v{tmat3x3<T>::no_init};
+	tvec3<T> sigma{tvec3<T>::no_init};
+	am::linear::svd(m, u, sigma, v);
+	tmat3x3<T> sv = v;
+	for (std::size_t c = 0; c < 3; ++c) {
+		sv.data[c] = v.data[c] * sigma[c];
+	}
+	r = u * am::linear::transpose(v);
+	p = sv * am::linear::transpose(v);
+}
+
+template<
+	class T
+>
+inline void
+polar_scalar(
+	tmat3x3<T> const& m,
+	tmat3x3<T>& r,
+	tmat3x3<T>& p,
+	unsigned const max_iterations
+) noexcept {
+	T a[3][3], ra[3][3], pa[3][3];
+	for (std::size_t c = 0; c < 3; ++c) {
+		for (std::size_t i = 0; i < 3; ++i) {
+			a[c][i] = m.data[c][i];
+		}
+	}
+	bool singular;
+	polar_kernel<T>(a, ra, pa, singular, max_iterations);
+	if (singular) {
+		polar_svd(m, r, p);
+		return;
+	}
+	for (std::size_t c = 0; c < 3; ++c) {
+		r.data[c] = tvec3<T>{ra[c][0], ra[c][1], ra[c][2]};
+		p.data[c] = tvec3<T>{pa[c][0], pa[c][1], pa[c][2]};
+	}
+}
+
+template<
+	class T,
+	std::size_t L
+>
+inline void
+lane_load(
+	lane_pack<T, L> (&a)[3][3],
+	tmat4x4<T> const* const m,
+	std::size_t const n
+) noexcept {
+	for (std::size_t c = 0; c < 3; ++c) {
+		for (std::size_t r = 0; r < 3; ++r) {
+			for (std::size_t l = 0; l < L; ++l) {
+				a[c][r].v[l] = l < n ? m[l].data[c][r] : T(c == r);
+			}
+		}
+	}
+}
+
+template<
+	class T
+>
+inline tmat3x3<T> const&
+upper3x3(
+	tmat3x3<T> const& m
+) noexcept {
+	return m;
+}
+
+template<
+	class T
+>
+inline tmat3x3<T>
+upper3x3(
+	tmat4x4<T> const& m
+) noexcept {
+	return tmat3x3<T>{
+		tvec3<T>{m.data[0]},
+		tvec3<T>{m.data[1]},
+		tvec3<T>{m.data[2]}
+	};
+}
+
+template<
+	class T
+>
+inline void
+polar_to_trs(
+	tmat4x4<T> const& m,
+	tmat3x3<T> const& p,
+	tvec3<T>& t,
+	tvec3<T>& s
+) noexcept {
+	t = tvec3<T>{m.data[3]};
+	s = tvec3<T>{p.data[0].x, p.data[1].y, p.data[2].z};
+}
+
+// Polar decomposition of up to L matrices; M is tmat3x3 or tmat4x4
+// (upper-left block)
+template<
+	class T,
+	class M
+>
+inline void
+polar_block(
+	M const* const m,
+	tmat3x3<T>* const r,
+	tmat3x3<T>* const p,
+	std::size_t const n,
+	unsigned const max_iterations
+) noexcept {
+	using pack = lane_pack<T, lane_width>;
+	pack a[3][3], ra[3][3], pa[3][3];
+	lane_mask<lane_width> singular;
+	lane_load(a, m, n);
+	polar_kernel<T>(a, ra, pa, singular, max_iterations);
+	lane_store(ra, r, n);
+	lane_store(pa, p, n);
+	for (std::size_t l = 0; l < n; ++l) {
+		if (singular.v[l]) {
+			polar_svd(upper3x3(m[l]), r[l], p[l]);
+		}
+	}
+}
+
+/** @endcond */ // INTERNAL
+
+} // namespace linear
+} // namespace detail
+
+namespace linear {
+
+/**
+	@addtogroup linear
+	@{
+*/
+/**
+	@addtogroup matrix
+	@{
+*/
+/**
+	@defgroup matrix_decompose Polar and TRS decomposition
+	@details
+	Polar decomposition by scaled Newton iteration, which stops as
+	soon as it has converged (usually 4 to 7 iterations). The batch
+	forms iterate @c detail::linear::lane_width matrices at once until
+	all of them have converged.
+
+	The rotation is always proper (determinant @c 1). If the input has
+	a negative determinant, the reflection is carried by the stretch
+	(or scale) as a negation. Rank-deficient inputs fall back to the
+	SVD.
+	@{
+*/
+
+/**
+	Calculate the polar decomposition of a matrix.
+
+	@post <code>m == r * p</code>, with @a r a rotation and @a p
+	symmetric. @a p is positive semi-definite when
+	<code>determinant(m) >= 0</code> and negative semi-definite
+	otherwise.
+
+	@tparam T A floating-point type.
+	@param m Matrix.
+	@param[out] r Rotation.
+	@param[out] p Stretch.
+	@param max_iterations Maximum number of Newton iterations.
+*/
+template<
+	class T
+>
+inline void
+polar_decompose(
+	detail::linear::tmat3x3<T> const& m,
+	detail::linear::tmat3x3<T>& r,
+	detail::linear::tmat3x3<T>& p,
+	unsigned const max_iterations = detail::linear::polar_default_iterations<T>()
+) noexcept {
+	AM_STATIC_ASSERT(
+		std::is_floating_point<T>::value,
+		"T must be a floating-point type"
+	);
+	detail::linear::polar_scalar(m, r, p, max_iterations);
+}
+
+/**
+	Calculate the polar decompositions of an array of matrices.
+
+	@note Results match the single-matrix form.
+
+	@tparam T A floating-point type.
+	@param count Number of matrices.
+	@param m Matrices.
+	@param[out] r Rotations (@a count values).
+	@param[out] p Stretches (@a count values).
+	@param max_iterations Maximum number of Newton iterations.
+*/
+template<
+	class T
+>
+inline void
+polar_decompose(
+	std::size_t const count,
+	detail::linear::tmat3x3<T> const* const m,
+	detail::linear::tmat3x3<T>* const r,
+	detail::linear::tmat3x3<T>* const p,
+	unsigned const max_iterations = detail::linear::polar_default_iterations<T>()
+) noexcept {
+	AM_STATIC_ASSERT(
+		std::is_floating_point<T>::value,
+		"T must be a floating-point type"
+	);
+	for (std::size_t i = 0; i < count; i += detail::linear::lane_width) {
+		std::size_t const n
+			= count - i < detail::linear::lane_width
+			? count - i
+			: detail::linear::lane_width
+		;
+		detail::linear::polar_block(m + i, r + i, p + i, n, max_iterations);
+	}
+}
+
+/**
+	Decompose an affine transform into translation, rotation and
+	scale.
+
+	@note The bottom row of @a m is ignored. The scale is the diagonal
+	of the polar stretch, so it is exact for transforms without shear
+	(and the best diagonal fit otherwise).
+
+	@post <code>m == compose(t, r, s)</code> for transforms without
+	shear.
+
+	@tparam T A floating-point type.
+	@param m Transform.
+	@param[out] t Translation.
+	@param[out] r Rotation.
+	@param[out] s Scale.
+	@param max_iterations Maximum number of Newton iterations.
+*/
+template<
+	class T
+>
+inline void
+decompose(
+	detail::linear::tmat4x4<T> const& m,
+	detail::linear::tvec3<T>& t,
+	detail::linear::tmat3x3<T>& r,
+	detail::linear::tvec3<T>& s,
+	unsigned const max_iterations = detail::linear::polar_default_iterations<T>()
+) noexcept {
+	AM_STATIC_ASSERT(
+		std::is_floating_point<T>::value,
+		"T must be a floating-point type"
+	);
+	detail::linear::tmat3x3<T> p{detail::linear::tmat3x3<T>::no_init};
+	detail::linear::polar_scalar(detail::linear::upper3x3(m), r, p, max_iterations);
+	detail::linear::polar_to_trs(m, p, t, s);
+}
+
+/**
+	Decompose an array of affine transforms into translation,
+	rotation and scale.
+
+	@note Results match the single-matrix form.
+
+	@tparam T A floating-point type.
+	@param count Number of transforms.
+	@param m Transforms.
+	@param[out] t Translations (@a count values).
+	@param[out] r Rotations (@a count values).
+	@param[out] s Scales (@a count values).
+	@param max_iterations Maximum number of Newton iterations.
+*/
+template<
+	class T
+>
+inline void
+decompose(
+	std::size_t const count,
+	detail::linear::tmat4x4<T> const* const m,
+	detail::linear::tvec3<T>* const t,
+	detail::linear::tmat3x3<T>* const r,
+	detail::linear::tvec3<T>* const s,
+	unsigned const max_iterations = detail::linear::polar_default_iterations<T>()
+) noexcept {
+	AM_STATIC_ASSERT(
+		std::is_floating_point<T>::value,
+		"T must be a floating-point type"
+	);
+	detail::linear::tmat3x3<T> p[detail::linear::lane_width];
+	for (std::size_t i = 0; i < count; i += detail::linear::lane_width) {
+		std::size_t const n
+			= count - i < detail::linear::lane_width
+			? count - i
+			: detail::linear::lane_width
+		;
+		detail::linear::polar_block(m + i, r + i, p, n, max_iterations);
+		for (std::size_t l = 0; l < n; ++l) {
+			detail::linear::polar_to_trs(m[i + l], p[l], t[i + l], s[i + l]);
+		}
+	}
+}
+
+/**
+	Compose an affine transform from translation, rotation and scale.
+
+	@returns <code>T * R * S</code> as a transform.
+	@tparam T A floating-point type.
+	@param t Translation.
+	@param r Rotation.
+	@param s Scale.
+*/
+template<
+	class T
+>
+inline detail::linear::tmat4x4<T>
+compose(
+	detail::linear::tvec3<T> const& t,
+	detail::linear::tmat3x3<T> const& r,
+	detail::linear::tvec3<T> const& s
+) noexcept {
+	return detail::linear::tmat4x4<T>{
+		detail::linear::tvec4<T>{r.data[0] * s.x, T(0)},
+		detail::linear::tvec4<T>{r.data[1] * s.y, T(0)},
+		detail::linear::tvec4<T>{r.data[2] * s.z, T(0)},
+		detail::linear::tvec4<T>{t, T(1)}
+	};
+}
+
+/** @} */ // end of doc-group matrix_decompose
+/** @} */ // end of doc-group matrix
+/** @} */ // end of doc-group linear
+
+} // namespace linear
+} // namespace am
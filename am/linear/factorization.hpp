@@ -0,0 +1,688 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Small-matrix factorizations and solvers.
+*/
+
+#pragma once
+
+#include "../config.hpp"
+#include "../detail/linear/type_traits.hpp"
+#include "../detail/linear/lane_pack.hpp"
+#include "./matrix_types.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace am {
+namespace detail {
+namespace linear {
+
+/** @cond INTERNAL */
+
+// Kernels are written over S (T or a lane_pack<T, L>) and a fixed
+// size N, with matrices held as S a[column][row]. All loop bounds
+// are compile-time constants, so compilers unroll them fully.
+// Success is accumulated into a mask (bool for scalars) rather than
+// branched on.
+
+template<
+	class Cons
+>
+struct square_traits {
+	AM_STATIC_ASSERT(
+		is_square_matrix<Cons>::value,
+		"Cons must be a square matrix"
+	);
+	AM_STATIC_ASSERT(
+		std::is_floating_point<typename Cons::value_type>::value,
+		"Cons must have a floating-point value type"
+	);
+
+	using value_type = typename Cons::value_type;
+	using col_type = typename Cons::col_type;
+	static constexpr std::size_t const size = col_type::size();
+};
+
+// A = L L^T; L in the lower triangle, upper triangle zeroed
+template<
+	class T,
+	std::size_t N,
+	class S,
+	class M
+>
+inline void
+cholesky_kernel(
+	S (&a)[N][N],
+	M& ok
+) noexcept {
+	S const one = lane_broadcast(a[0][0], T(1));
+	for (std::size_t j = 0; j < N; ++j) {
+		S d = a[j][j];
+		for (std::size_t k = 0; k < j; ++k) {
+			d = d - a[k][j] * a[k][j];
+		}
+		auto const positive = d > T(0);
+		ok = ok & positive;
+		S const ljj = lane_sqrt(lane_select(positive, d, one));
+		S const inv = one / ljj;
+		a[j][j] = ljj;
+		for (std::size_t i = j + 1; i < N; ++i) {
+			S x = a[j][i];
+			for (std::size_t k = 0; k < j; ++k) {
+				x = x - a[k][i] * a[k][j];
+			}
+			a[j][i] = x * inv;
+			a[i][j] = one - one;
+		}
+	}
+}
+
+template<
+	class T,
+	std::size_t N,
+	class S
+>
+inline void
+cholesky_solve_kernel(
+	S const (&l)[N][N],
+	S (&x)[N]
+) noexcept {
+	for (std::size_t i = 0; i < N; ++i) {
+		for (std::size_t k = 0; k < i; ++k) {
+			x[i] = x[i] - l[k][i] * x[k];
+		}
+		x[i] = x[i] / l[i][i];
+	}
+	for (std::size_t i = N; i-- > 0;) {
+		for (std::size_t k = i + 1; k < N; ++k) {
+			x[i] = x[i] - l[i][k] * x[k];
+		}
+		x[i] = x[i] / l[i][i];
+	}
+}
+
+// A = L D L^T; unit L below the diagonal, D on the diagonal, upper
+// triangle zeroed
+template<
+	class T,
+	std::size_t N,
+	class S,
+	class M
+>
+inline void
+ldlt_kernel(
+	S (&a)[N][N],
+	M& ok
+) noexcept {
+	S const one = lane_broadcast(a[0][0], T(1));
+	for (std::size_t j = 0; j < N; ++j) {
+		S d = a[j][j];
+		for (std::size_t k = 0; k < j; ++k) {
+			d = d - a[k][j] * a[k][j] * a[k][k];
+		}
+		auto const nonzero = lane_abs(d) > T(0);
+		ok = ok & nonzero;
+		S const inv = one / lane_select(nonzero, d, one);
+		a[j][j] = d;
+		for (std::size_t i = j + 1; i < N; ++i) {
+			S x = a[j][i];
+			for (std::size_t k = 0; k < j; ++k) {
+				x = x - a[k][i] * a[k][j] * a[k][k];
+			}
+			a[j][i] = x * inv;
+			a[i][j] = one - one;
+		}
+	}
+}
+
+template<
+	class T,
+	std::size_t N,
+	class S
+>
+inline void
+ldlt_solve_kernel(
+	S const (&ld)[N][N],
+	S (&x)[N]
+) noexcept {
+	for (std::size_t i = 0; i < N; ++i) {
+		for (std::size_t k = 0; k < i; ++k) {
+			x[i] = x[i] - ld[k][i] * x[k];
+		}
+	}
+	for (std::size_t i = 0; i < N; ++i) {
+		x[i] = x[i] / ld[i][i];
+	}
+	for (std::size_t i = N; i-- > 0;) {
+		for (std::size_t k = i + 1; k < N; ++k) {
+			x[i] = x[i] - ld[i][k] * x[k];
+		}
+	}
+}
+
+// Householder QR in LAPACK's compact form: R in the upper triangle,
+// reflector k is I - tau[k] v v^T with v[k] = 1 and v[k+1..] below
+// the diagonal of column k
+template<
+	class T,
+	std::size_t N,
+	class S,
+	class M
+>
+inline void
+qr_kernel(
+	S (&a)[N][N],
+	S (&tau)[N],
+	M& ok
+) noexcept {
+	S const one = lane_broadcast(a[0][0], T(1));
+	S const zero = one - one;
+	for (std::size_t k = 0; k + 1 < N; ++k) {
+		S const x0 = a[k][k];
+		S tail = zero;
+		for (std::size_t i = k + 1; i < N; ++i) {
+			tail = tail + a[k][i] * a[k][i];
+		}
+		auto const reflect = tail > T(0);
+		S const norm = lane_sqrt(x0 * x0 + tail);
+		S const beta = lane_select(
+			reflect,
+			lane_select(x0 < T(0), norm, -norm),
+			x0
+		);
+		S const safe_beta = lane_select(reflect, beta, one);
+		S const t = lane_select(reflect, (safe_beta - x0) / safe_beta, zero);
+		S const scale = one / lane_select(reflect, x0 - safe_beta, one);
+		for (std::size_t i = k + 1; i < N; ++i) {
+			a[k][i] = a[k][i] * scale;
+		}
+		a[k][k] = beta;
+		tau[k] = t;
+		ok = ok & (lane_abs(beta) > T(0));
+
+		for (std::size_t j = k + 1; j < N; ++j) {
+			S w = a[j][k];
+			for (std::size_t i = k + 1; i < N; ++i) {
+				w = w + a[k][i] * a[j][i];
+			}
+			w = w * t;
+			a[j][k] = a[j][k] - w;
+			for (std::size_t i = k + 1; i < N; ++i) {
+				a[j][i] = a[j][i] - a[k][i] * w;
+			}
+		}
+	}
+	tau[N - 1] = zero;
+	ok = ok & (lane_abs(a[N - 1][N - 1]) > T(0));
+}
+
+template<
+	class T,
+	std::size_t N,
+	class S
+>
+inline void
+qr_solve_kernel(
+	S const (&qr)[N][N],
+	S const (&tau)[N],
+	S (&x)[N]
+) noexcept {
+	// x = Q^T b
+	for (std::size_t k = 0; k + 1 < N; ++k) {
+		S w = x[k];
+		for (std::size_t i = k + 1; i < N; ++i) {
+			w = w + qr[k][i] * x[i];
+		}
+		w = w * tau[k];
+		x[k] = x[k] - w;
+		for (std::size_t i = k + 1; i < N; ++i) {
+			x[i] = x[i] - qr[k][i] * w;
+		}
+	}
+	// R x = Q^T b
+	for (std::size_t i = N; i-- > 0;) {
+		for (std::size_t k = i + 1; k < N; ++k) {
+			x[i] = x[i] - qr[k][i] * x[k];
+		}
+		x[i] = x[i] / qr[i][i];
+	}
+}
+
+template<
+	std::size_t N,
+	class T,
+	class Cons
+>
+inline void
+load_square(
+	T (&a)[N][N],
+	Cons const& m
+) noexcept {
+	for (std::size_t c = 0; c < N; ++c) {
+		for (std::size_t r = 0; r < N; ++r) {
+			a[c][r] = m.data[c][r];
+		}
+	}
+}
+
+template<
+	std::size_t N,
+	class T,
+	class Cons
+>
+inline void
+store_square(
+	T const (&a)[N][N],
+	Cons& m
+) noexcept {
+	for (std::size_t c = 0; c < N; ++c) {
+		for (std::size_t r = 0; r < N; ++r) {
+			m.data[c][r] = a[c][r];
+		}
+	}
+}
+
+template<
+	std::size_t N,
+	class T,
+	class Vec
+>
+inline void
+load_column(
+	T (&x)[N],
+	Vec const& v
+) noexcept {
+	for (std::size_t i = 0; i < N; ++i) {
+		x[i] = v[i];
+	}
+}
+
+template<
+	std::size_t N,
+	class T,
+	class Vec
+>
+inline Vec
+store_column(
+	T const (&x)[N]
+) noexcept {
+	Vec v{Vec::no_init};
+	for (std::size_t i = 0; i < N; ++i) {
+		v[i] = x[i];
+	}
+	return v;
+}
+
+enum class factorization : unsigned {
+	cholesky,
+	ldlt,
+	qr,
+};
+
+// Factor and solve up to L systems; lanes past n are padded with
+// identity systems
+template<
+	factorization F,
+	class Cons
+>
+inline bool
+solve_block(
+	Cons const* const m,
+	typename Cons::col_type const* const b,
+	typename Cons::col_type* const x,
+	std::size_t const n
+) noexcept {
+	using traits = square_traits<Cons>;
+	using T = typename traits::value_type;
+	constexpr std::size_t const N = traits::size;
+	using pack = lane_pack<T, lane_width>;
+
+	pack a[N][N], v[N], tau[N];
+	for (std::size_t c = 0; c < N; ++c) {
+		for (std::size_t r = 0; r < N; ++r) {
+			for (std::size_t l = 0; l < lane_width; ++l) {
+				a[c][r].v[l] = l < n ? m[l].data[c][r] : T(c == r);
+			}
+		}
+		for (std::size_t l = 0; l < lane_width; ++l) {
+			v[c].v[l] = l < n ? b[l][c] : T(0);
+		}
+	}
+
+	lane_mask<lane_width> ok;
+	for (std::size_t l = 0; l < lane_width; ++l) {
+		ok.v[l] = true;
+	}
+	switch (F) {
+	case factorization::cholesky:
+		cholesky_kernel<T>(a, ok);
+		cholesky_solve_kernel<T>(a, v);
+		break;
+	case factorization::ldlt:
+		ldlt_kernel<T>(a, ok);
+		ldlt_solve_kernel<T>(a, v);
+		break;
+	case factorization::qr:
+		qr_kernel<T>(a, tau, ok);
+		qr_solve_kernel<T>(a, tau, v);
+		break;
+	}
+
+	bool all = true;
+	for (std::size_t l = 0; l < n; ++l) {
+		for (std::size_t i = 0; i < N; ++i) {
+			x[l][i] = v[i].v[l];
+		}
+		all = all && ok.v[l];
+	}
+	return all;
+}
+
+template<
+	factorization F,
+	class Cons
+>
+inline bool
+solve_batch(
+	std::size_t const count,
+	Cons const* const m,
+	typename Cons::col_type const* const b,
+	typename Cons::col_type* const x
+) noexcept {
+	bool all = true;
+	for (std::size_t i = 0; i < count; i += lane_width) {
+		std::size_t const n = count - i < lane_width ? count - i : lane_width;
+		all = solve_block<F>(m + i, b + i, x + i, n) && all;
+	}
+	return all;
+}
+
+/** @endcond */ // INTERNAL
+
+} // namespace linear
+} // namespace detail
+
+namespace linear {
+
+/**
+	@addtogroup linear
+	@{
+*/
+/**
+	@addtogroup matrix
+	@{
+*/
+/**
+	@defgroup matrix_factorization Factorizations and solvers
+	@details
+	In-place factorizations of @c mat2x2, @c mat3x3 and @c mat4x4
+	(and their @c double forms) with matching solvers. These are
+	both faster and more stable than solving by inverse().
+
+	- cholesky(): symmetric positive-definite matrices.
+	- ldlt(): symmetric matrices (including indefinite ones) without
+	  square roots.
+	- qr(): any non-singular matrix, by Householder reflections.
+
+	The batch forms factor and solve one system per element,
+	@c detail::linear::lane_width systems at once.
+	@{
+*/
+
+/**
+	Factor a symmetric positive-definite matrix in place.
+
+	@note Only the lower triangle of @a m is read.
+
+	@post @a m holds @c L, lower-triangular with a positive diagonal,
+	such that <code>m == L * transpose(L)</code>.
+
+	@tparam Cons A floating-point square matrix type.
+	@returns @c false if @a m is not positive-definite (the contents
+	of @a m are then unspecified).
+	@param[in,out] m Matrix.
+*/
+template<
+	class Cons
+>
+inline bool
+cholesky(
+	Cons& m
+) noexcept {
+	using traits = detail::linear::square_traits<Cons>;
+	using T = typename traits::value_type;
+	T a[traits::size][traits::size];
+	detail::linear::load_square(a, m);
+	bool ok = true;
+	detail::linear::cholesky_kernel<T>(a, ok);
+	detail::linear::store_square(a, m);
+	return ok;
+}
+
+/**
+	Solve a system from its Cholesky factor.
+
+	@tparam Cons A floating-point square matrix type.
+	@returns @c x such that <code>L * transpose(L) * x == b</code>.
+	@param l Factor from cholesky().
+	@param b Right-hand side.
+*/
+template<
+	class Cons
+>
+inline typename Cons::col_type
+cholesky_solve(
+	Cons const& l,
+	typename Cons::col_type const& b
+) noexcept {
+	using traits = detail::linear::square_traits<Cons>;
+	using T = typename traits::value_type;
+	T a[traits::size][traits::size], x[traits::size];
+	detail::linear::load_square(a, l);
+	detail::linear::load_column(x, b);
+	detail::linear::cholesky_solve_kernel<T>(a, x);
+	return detail::linear::store_column<traits::size, T, typename Cons::col_type>(x);
+}
+
+/**
+	Solve an array of symmetric positive-definite systems.
+
+	@tparam Cons A floating-point square matrix type.
+	@returns @c false if any matrix is not positive-definite (its
+	solution is then unspecified).
+	@param count Number of systems.
+	@param m Matrices (lower triangles are read).
+	@param b Right-hand sides.
+	@param[out] x Solutions.
+*/
+template<
+	class Cons
+>
+inline bool
+cholesky_solve(
+	std::size_t const count,
+	Cons const* const m,
+	typename Cons::col_type const* const b,
+	typename Cons::col_type* const x
+) noexcept {
+	return detail::linear::solve_batch<
+		detail::linear::factorization::cholesky
+	>(count, m, b, x);
+}
+
+/**
+	Factor a symmetric matrix in place.
+
+	@note Only the lower triangle of @a m is read. No pivoting is
+	done, so indefinite matrices may fail even when non-singular.
+
+	@post @a m holds @c D on the diagonal and the strictly lower part
+	of unit lower-triangular @c L below it, such that
+	<code>m == L * D * transpose(L)</code>.
+
+	@tparam Cons A floating-point square matrix type.
+	@returns @c false if a zero pivot was encountered.
+	@param[in,out] m Matrix.
+*/
+template<
+	class Cons
+>
+inline bool
+ldlt(
+	Cons& m
+) noexcept {
+	using traits = detail::linear::square_traits<Cons>;
+	using T = typename traits::value_type;
+	T a[traits::size][traits::size];
+	detail::linear::load_square(a, m);
+	bool ok = true;
+	detail::linear::ldlt_kernel<T>(a, ok);
+	detail::linear::store_square(a, m);
+	return ok;
+}
+
+/**
+	Solve a system from its LDLT factorization.
+
+	@tparam Cons A floating-point square matrix type.
+	@returns @c x such that <code>L * D * transpose(L) * x == b</code>.
+	@param ld Factorization from ldlt().
+	@param b Right-hand side.
+*/
+template<
+	class Cons
+>
+inline typename Cons::col_type
+ldlt_solve(
+	Cons const& ld,
+	typename Cons::col_type const& b
+) noexcept {
+	using traits = detail::linear::square_traits<Cons>;
+	using T = typename traits::value_type;
+	T a[traits::size][traits::size], x[traits::size];
+	detail::linear::load_square(a, ld);
+	detail::linear::load_column(x, b);
+	detail::linear::ldlt_solve_kernel<T>(a, x);
+	return detail::linear::store_column<traits::size, T, typename Cons::col_type>(x);
+}
+
+/**
+	Solve an array of symmetric systems by LDLT.
+
+	@tparam Cons A floating-point square matrix type.
+	@returns @c false if any factorization hit a zero pivot (its
+	solution is then unspecified).
+	@param count Number of systems.
+	@param m Matrices (lower triangles are read).
+	@param b Right-hand sides.
+	@param[out] x Solutions.
+*/
+template<
+	class Cons
+>
+inline bool
+ldlt_solve(
+	std::size_t const count,
+	Cons const* const m,
+	typename Cons::col_type const* const b,
+	typename Cons::col_type* const x
+) noexcept {
+	return detail::linear::solve_batch<
+		detail::linear::factorization::ldlt
+	>(count, m, b, x);
+}
+
+/**
+	Factor a matrix in place by Householder reflections.
+
+	@post @a m holds @c R in its upper triangle. Below the diagonal,
+	column @c k holds the tail of reflector
+	<code>H(k) = I - tau[k] * v * transpose(v)</code> (where
+	<code>v[k] == 1</code>), and <code>m == H(0) * ... * H(N-2) * R</code>.
+
+	@tparam Cons A floating-point square matrix type.
+	@returns @c false if @a m is singular.
+	@param[in,out] m Matrix.
+	@param[out] tau Reflector scales.
+*/
+template<
+	class Cons
+>
+inline bool
+qr(
+	Cons& m,
+	typename Cons::col_type& tau
+) noexcept {
+	using traits = detail::linear::square_traits<Cons>;
+	using T = typename traits::value_type;
+	T a[traits::size][traits::size], t[traits::size];
+	detail::linear::load_square(a, m);
+	bool ok = true;
+	detail::linear::qr_kernel<T>(a, t, ok);
+	detail::linear::store_square(a, m);
+	tau = detail::linear::store_column<traits::size, T, typename Cons::col_type>(t);
+	return ok;
+}
+
+/**
+	Solve a system from its QR factorization.
+
+	@tparam Cons A floating-point square matrix type.
+	@returns @c x such that <code>Q * R * x == b</code>.
+	@param qr Factorization from qr().
+	@param tau Reflector scales from qr().
+	@param b Right-hand side.
+*/
+template<
+	class Cons
+>
+inline typename Cons::col_type
+qr_solve(
+	Cons const& qr,
+	typename Cons::col_type const& tau,
+	typename Cons::col_type const& b
+) noexcept {
+	using traits = detail::linear::square_traits<Cons>;
+	using T = typename traits::value_type;
+	T a[traits::size][traits::size], t[traits::size], x[traits::size];
+	detail::linear::load_square(a, qr);
+	detail::linear::load_column(t, tau);
+	detail::linear::load_column(x, b);
+	detail::linear::qr_solve_kernel<T>(a, t, x);
+	return detail::linear::store_column<traits::size, T, typename Cons::col_type>(x);
+}
+
+/**
+	Solve an array of systems by QR.
+
+	@tparam Cons A floating-point square matrix type.
+	@returns @c false if any matrix is singular (its solution is then
+	unspecified).
+	@param count Number of systems.
+	@param m Matrices.
+	@param b Right-hand sides.
+	@param[out] x Solutions.
+*/
+template<
+	class Cons
+>
+inline bool
+qr_solve(
+	std::size_t const count,
+	Cons const* const m,
+	typename Cons::col_type const* const b,
+	typename Cons::col_type* const x
+) noexcept {
+	return detail::linear::solve_batch<
+		detail::linear::factorization::qr
+	>(count, m, b, x);
+}
+
+/** @} */ // end of doc-group matrix_factorization
+/** @} */ // end of doc-group matrix
+/** @} */ // end of doc-group linear
+
+} // namespace linear
+} // namespace am
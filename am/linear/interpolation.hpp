@@ -9,8 +9,55 @@
 
 #include "../config.hpp"
 #include "../detail/linear/type_traits.hpp"
+#include "./strided_span.hpp"
+
+#include <cstddef>
 
 namespace am {
+namespace detail {
+namespace linear {
+
+/** @cond INTERNAL */
+// Values are pointers or element accessors
+template<
+	class Cons,
+	class Values
+>
+inline void
+bezier_cubic_tessellate_impl(
+	std::size_t const count,
+	Values const& v0,
+	Values const& v1,
+	Values const& v2,
+	Values const& v3,
+	std::size_t const n,
+	Cons* const out
+) {
+	using V = value_type<Cons>;
+	V const h = (0 == n) ? V{0} : V{1} / static_cast<V>(n);
+	for (std::size_t k = 0; k <= n; ++k) {
+		V const t = (0 != n && k == n) ? V{1} : static_cast<V>(k) * h;
+		V const r = V{1} - t;
+		V const w0 = r*r*r;
+		V const w1 = V{3}*r*r*t;
+		V const w2 = V{3}*r*t*t;
+		V const w3 = t*t*t;
+		Cons* const row = out + k * count;
+		for (std::size_t i = 0; i < count; ++i) {
+			row[i] =
+				(v0[i] * w0) +
+				(v1[i] * w1) +
+				(v2[i] * w2) +
+				(v3[i] * w3)
+			;
+		}
+	}
+}
+/** @endcond */ // INTERNAL
+
+} // namespace linear
+} // namespace detail
+
 namespace linear {
 
 /**
@@ -108,17 +155,287 @@ bezier_cubic(
 	// v1 * (1-t)² * 3*t +
 	// v2 * 3*(1-t) * t² +
 	// v3 * t³
-	V r = V{1} - t;
-	Cons const i2 = v2 * V{3}*r * t*t;
-	r *= r;
+	V const r = V{1} - t;
+	V const r2 = r*r;
 	return
-		(v0 * r*r) +
-		(v1 * r * V{3}*t) +
-		i2 +
+		(v0 * r2*r) +
+		(v1 * r2 * V{3}*t) +
+		(v2 * V{3}*r * t*t) +
 		(v3 * t*t*t)
 	;
 }
 
+/**
+	Evaluate point in a quadratic Bézier curve.
+
+	@note @a t must be in the range <code>[0, 1]</code>.
+
+	@tparam Cons Floating-point vector or scalar.
+	@returns Interpolant.
+	@param v0,v1,v2 Values.
+	@param t Interpolation value.
+*/
+template<
+	class Cons
+>
+inline Cons
+bezier_quadratic(
+	Cons const& v0,
+	Cons const& v1,
+	Cons const& v2,
+	detail::linear::value_type<Cons> t
+) {
+	using V = detail::linear::value_type<Cons>;
+	// v0 * (1-t)² +
+	// v1 * 2*(1-t)*t +
+	// v2 * t²
+	V const r = V{1} - t;
+	return
+		(v0 * r*r) +
+		(v1 * V{2}*r*t) +
+		(v2 * t*t)
+	;
+}
+
+/**
+	Split a quadratic Bézier curve in two (de Casteljau subdivision).
+
+	@note @a t must be in the range <code>[0, 1]</code>.
+
+	@tparam Cons Floating-point vector or scalar.
+	@param v0,v1,v2 Values.
+	@param t Split point.
+	@param[out] left Control points of the curve over <code>[0, t]</code>.
+	@param[out] right Control points of the curve over <code>[t, 1]</code>.
+*/
+template<
+	class Cons
+>
+inline void
+bezier_quadratic_split(
+	Cons const& v0,
+	Cons const& v1,
+	Cons const& v2,
+	detail::linear::value_type<Cons> const t,
+	Cons (&left)[3],
+	Cons (&right)[3]
+) {
+	Cons const a = linear::lerp(v0, v1, t);
+	Cons const b = linear::lerp(v1, v2, t);
+	Cons const p = linear::lerp(a, b, t);
+	left[0] = v0; left[1] = a; left[2] = p;
+	right[0] = p; right[1] = b; right[2] = v2;
+}
+
+/**
+	Split a cubic Bézier curve in two (de Casteljau subdivision).
+
+	@note @a t must be in the range <code>[0, 1]</code>.
+
+	@tparam Cons Floating-point vector or scalar.
+	@param v0,v1,v2,v3 Values.
+	@param t Split point.
+	@param[out] left Control points of the curve over <code>[0, t]</code>.
+	@param[out] right Control points of the curve over <code>[t, 1]</code>.
+*/
+template<
+	class Cons
+>
+inline void
+bezier_cubic_split(
+	Cons const& v0,
+	Cons const& v1,
+	Cons const& v2,
+	Cons const& v3,
+	detail::linear::value_type<Cons> const t,
+	Cons (&left)[4],
+	Cons (&right)[4]
+) {
+	Cons const a = linear::lerp(v0, v1, t);
+	Cons const b = linear::lerp(v1, v2, t);
+	Cons const c = linear::lerp(v2, v3, t);
+	Cons const ab = linear::lerp(a, b, t);
+	Cons const bc = linear::lerp(b, c, t);
+	Cons const p = linear::lerp(ab, bc, t);
+	left[0] = v0; left[1] = a; left[2] = ab; left[3] = p;
+	right[0] = p; right[1] = bc; right[2] = c; right[3] = v3;
+}
+
+/**
+	Tessellate a quadratic Bézier curve.
+
+	This uses forward differencing, so each point costs two additions.
+	The last point is set to @a v2 exactly.
+
+	@tparam Cons Floating-point vector or scalar.
+	@param v0,v1,v2 Values.
+	@param n Number of segments.
+	@param[out] out Points; must have room for <code>n + 1</code>
+	values.
+*/
+template<
+	class Cons
+>
+inline void
+bezier_quadratic_tessellate(
+	Cons const& v0,
+	Cons const& v1,
+	Cons const& v2,
+	std::size_t const n,
+	Cons* const out
+) {
+	using V = detail::linear::value_type<Cons>;
+	if (0 == n) {
+		out[0] = v0;
+		return;
+	}
+	// p(t) = a*t² + b*t + c
+	V const h = V{1} / static_cast<V>(n);
+	Cons const a = v0 - (v1 * V{2}) + v2;
+	Cons const b = (v1 - v0) * V{2};
+	Cons f = v0;
+	Cons d1 = (a * (h*h)) + (b * h);
+	Cons const d2 = a * (V{2}*h*h);
+	for (std::size_t i = 0; i < n; ++i) {
+		out[i] = f;
+		f += d1;
+		d1 += d2;
+	}
+	out[n] = v2;
+}
+
+/**
+	Tessellate a cubic Bézier curve.
+
+	This uses forward differencing, so each point costs three
+	additions. The last point is set to @a v3 exactly.
+
+	@tparam Cons Floating-point vector or scalar.
+	@param v0,v1,v2,v3 Values.
+	@param n Number of segments.
+	@param[out] out Points; must have room for <code>n + 1</code>
+	values.
+*/
+template<
+	class Cons
+>
+inline void
+bezier_cubic_tessellate(
+	Cons const& v0,
+	Cons const& v1,
+	Cons const& v2,
+	Cons const& v3,
+	std::size_t const n,
+	Cons* const out
+) {
+	using V = detail::linear::value_type<Cons>;
+	if (0 == n) {
+		out[0] = v0;
+		return;
+	}
+	// p(t) = a*t³ + b*t² + c*t + d
+	V const h = V{1} / static_cast<V>(n);
+	V const h2 = h*h;
+	V const h3 = h2*h;
+	Cons const a = (v3 - v0) + ((v1 - v2) * V{3});
+	Cons const b = (v0 - (v1 * V{2}) + v2) * V{3};
+	Cons const c = (v1 - v0) * V{3};
+	Cons f = v0;
+	Cons d1 = (a * h3) + (b * h2) + (c * h);
+	Cons d2 = (a * (V{6}*h3)) + (b * (V{2}*h2));
+	Cons const d3 = a * (V{6}*h3);
+	for (std::size_t i = 0; i < n; ++i) {
+		out[i] = f;
+		f += d1;
+		d1 += d2;
+		d2 += d3;
+	}
+	out[n] = v3;
+}
+
+/**
+	Tessellate many cubic Bézier curves.
+
+	The Bernstein weights for each step are computed once and applied
+	to every curve, so the inner loop runs across curves without any
+	dependency between iterations (allowing the compiler to vectorize
+	it).
+
+	@note Point @c k of curve @c i is written to
+	<code>out[k * count + i]</code>.
+
+	@tparam Cons Floating-point vector or scalar.
+	@param count Number of curves.
+	@param v0,v1,v2,v3 Values for each curve; each must have @a count
+	values.
+	@param n Number of segments.
+	@param[out] out Points; must have room for
+	<code>(n + 1) * count</code> values.
+*/
+template<
+	class Cons
+>
+inline void
+bezier_cubic_tessellate_n(
+	std::size_t const count,
+	Cons const* const v0,
+	Cons const* const v1,
+	Cons const* const v2,
+	Cons const* const v3,
+	std::size_t const n,
+	Cons* const out
+) {
+	detail::linear::bezier_cubic_tessellate_impl(count, v0, v1, v2, v3, n, out);
+}
+
+/**
+	Tessellate many cubic Bézier curves from views.
+
+	@note Point @c k of curve @c i is written to
+	<code>out[k * count + i]</code>, where @c count is the size of
+	@a v0.
+
+	@tparam Cons Floating-point vector or scalar.
+	@param v0,v1,v2,v3 Values for each curve; each must have the same
+	size.
+	@param n Number of segments.
+	@param[out] out Points; must have room for
+	<code>(n + 1) * count</code> values.
+*/
+template<
+	class Cons
+>
+inline void
+bezier_cubic_tessellate_n(
+	vec_view<Cons> const& v0,
+	vec_view<Cons> const& v1,
+	vec_view<Cons> const& v2,
+	vec_view<Cons> const& v3,
+	std::size_t const n,
+	Cons* const out
+) {
+	if (
+		v0.is_contiguous() && v1.is_contiguous() &&
+		v2.is_contiguous() && v3.is_contiguous()
+	) {
+		using access = detail::linear::contiguous_access<Cons const>;
+		detail::linear::bezier_cubic_tessellate_impl(
+			v0.size(),
+			access{v0.data()}, access{v1.data()},
+			access{v2.data()}, access{v3.data()},
+			n, out
+		);
+	} else {
+		using access = detail::linear::strided_access<Cons const>;
+		detail::linear::bezier_cubic_tessellate_impl(
+			v0.size(),
+			access{v0.data(), v0.stride()}, access{v1.data(), v1.stride()},
+			access{v2.data(), v2.stride()}, access{v3.data(), v3.stride()},
+			n, out
+		);
+	}
+}
+
 /** @} */ // end of doc-group interpolation
 /** @} */ // end of doc-group linear
 
@@ -0,0 +1,674 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Cubic splines.
+*/
+
+#pragma once
+
+#include "../config.hpp"
+#include "../detail/linear/type_traits.hpp"
+#include "./vector_operations.hpp"
+#include "./interpolation.hpp"
+#include "./strided_span.hpp"
+
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+namespace am {
+namespace detail {
+namespace linear {
+
+/** @cond INTERNAL */
+// Points is a pointer or element accessor
+template<
+	class Cons,
+	class Points
+>
+inline Cons
+spline_blend_at(
+	Points const& points,
+	std::size_t const i,
+	value_type<Cons> const (&w)[4]
+) {
+	return
+		(points[i + 0] * w[0]) +
+		(points[i + 1] * w[1]) +
+		(points[i + 2] * w[2]) +
+		(points[i + 3] * w[3])
+	;
+}
+
+template<
+	class Cons,
+	class Basis,
+	class Points
+>
+inline std::size_t
+spline_cubic_sample_impl(
+	Basis const& basis,
+	std::size_t const count,
+	Points const& points,
+	std::size_t const steps,
+	Cons* const out
+) {
+	using V = value_type<Cons>;
+	std::size_t const segments = basis.segment_count(count);
+	if (0 == segments || 0 == steps) {
+		return 0;
+	}
+	V const h = V{1} / static_cast<V>(steps);
+	V w[4];
+	for (std::size_t k = 0; k < steps; ++k) {
+		basis.weights(static_cast<V>(k) * h, w);
+		Cons* dst = out + k;
+		std::size_t src = 0;
+		for (std::size_t s = 0; s < segments; ++s) {
+			*dst = linear::spline_blend_at<Cons>(points, src, w);
+			dst += steps;
+			src += basis.stride;
+		}
+	}
+	basis.weights(V{1}, w);
+	out[segments * steps] = linear::spline_blend_at<Cons>(
+		points, (segments - 1) * basis.stride, w
+	);
+	return segments * steps + 1;
+}
+/** @endcond */ // INTERNAL
+
+} // namespace linear
+} // namespace detail
+
+namespace linear {
+
+/**
+	@addtogroup linear
+	@{
+*/
+/**
+	@defgroup spline Splines
+	@details
+	Uniform cubic splines are expressed through a basis matrix
+	(cubic_basis). Evaluating a segment computes four weights from
+	the matrix and blends the segment's four control values with them.
+
+	The samplers compute the weights for each step once and reuse them
+	for every segment.
+	@{
+*/
+
+/**
+	Uniform cubic spline basis matrix.
+
+	@tparam V Floating-point type.
+*/
+template<
+	class V
+>
+struct cubic_basis {
+	/**
+		Coefficients.
+
+		<code>coeff[i][j]</code> is the coefficient of @c t<sup>i</sup>
+		in the weight of the <code>j</code>th control value.
+	*/
+	V coeff[4][4];
+
+	/**
+		Number of control values between the starts of two
+		consecutive segments.
+	*/
+	std::size_t stride;
+
+	/**
+		Bézier basis.
+
+		Segments are <code>{v0, v1, v2, v3}</code> and share their end
+		points.
+	*/
+	static constexpr cubic_basis
+	bezier() {
+		return cubic_basis{{
+			{V( 1), V( 0), V( 0), V(0)},
+			{V(-3), V( 3), V( 0), V(0)},
+			{V( 3), V(-6), V( 3), V(0)},
+			{V(-1), V( 3), V(-3), V(1)}
+		}, 3};
+	}
+
+	/**
+		Hermite basis.
+
+		Segments are <code>{p0, m0, p1, m1}</code>: two points and
+		their tangents.
+	*/
+	static constexpr cubic_basis
+	hermite() {
+		return cubic_basis{{
+			{V( 1), V( 0), V( 0), V( 0)},
+			{V( 0), V( 1), V( 0), V( 0)},
+			{V(-3), V(-2), V( 3), V(-1)},
+			{V( 2), V( 1), V(-2), V( 1)}
+		}, 2};
+	}
+
+	/**
+		Uniform Catmull-Rom basis.
+
+		Segments are <code>{p0, p1, p2, p3}</code>; the curve passes
+		through @c p1 and @c p2.
+	*/
+	static constexpr cubic_basis
+	catmull_rom() {
+		return cubic_basis{{
+			{V( 0.0), V( 1.0), V( 0.0), V( 0.0)},
+			{V(-0.5), V( 0.0), V( 0.5), V( 0.0)},
+			{V( 1.0), V(-2.5), V( 2.0), V(-0.5)},
+			{V(-0.5), V( 1.5), V(-1.5), V( 0.5)}
+		}, 1};
+	}
+
+	/**
+		Uniform cubic B-spline basis.
+
+		Segments are <code>{p0, p1, p2, p3}</code>; the curve does not
+		generally pass through the control points.
+	*/
+	static constexpr cubic_basis
+	bspline() {
+		return cubic_basis{{
+			{V( 1) / V(6), V( 4) / V(6), V( 1) / V(6), V(0)},
+			{V(-3) / V(6), V( 0)       , V( 3) / V(6), V(0)},
+			{V( 3) / V(6), V(-6) / V(6), V( 3) / V(6), V(0)},
+			{V(-1) / V(6), V( 3) / V(6), V(-3) / V(6), V(1) / V(6)}
+		}, 1};
+	}
+
+	/**
+		Calculate control value weights.
+
+		@param t Segment parameter.
+		@param[out] w Weights.
+	*/
+	void
+	weights(
+		V const t,
+		V (&w)[4]
+	) const noexcept {
+		for (unsigned j = 0; j < 4; ++j) {
+			w[j] = coeff[0][j] + t * (coeff[1][j] + t * (
+				coeff[2][j] + t * coeff[3][j]
+			));
+		}
+	}
+
+	/**
+		Get the number of segments in a sequence of control values.
+
+		@returns The number of segments, or @c 0 if @a count is less
+		than @c 4.
+		@param count Number of control values.
+	*/
+	std::size_t
+	segment_count(
+		std::size_t const count
+	) const noexcept {
+		return (4 > count) ? 0 : (count - 4) / stride + 1;
+	}
+};
+
+/**
+	Blend four control values with weights.
+
+	@tparam Cons Floating-point vector or scalar.
+	@returns <code>Σ v[j] * w[j]</code>.
+	@param v Control values.
+	@param w Weights.
+*/
+template<
+	class Cons
+>
+inline Cons
+spline_blend(
+	Cons const* const v,
+	detail::linear::value_type<Cons> const (&w)[4]
+) {
+	return
+		(v[0] * w[0]) +
+		(v[1] * w[1]) +
+		(v[2] * w[2]) +
+		(v[3] * w[3])
+	;
+}
+
+/**
+	Evaluate point in a cubic spline segment.
+
+	@tparam Cons Floating-point vector or scalar.
+	@returns Interpolant.
+	@param basis Basis matrix.
+	@param v0,v1,v2,v3 Segment control values.
+	@param t Segment parameter in <code>[0, 1]</code>.
+*/
+template<
+	class Cons
+>
+inline Cons
+spline_cubic(
+	cubic_basis<detail::linear::value_type<Cons>> const& basis,
+	Cons const& v0,
+	Cons const& v1,
+	Cons const& v2,
+	Cons const& v3,
+	detail::linear::value_type<Cons> const t
+) {
+	detail::linear::value_type<Cons> w[4];
+	basis.weights(t, w);
+	return
+		(v0 * w[0]) +
+		(v1 * w[1]) +
+		(v2 * w[2]) +
+		(v3 * w[3])
+	;
+}
+
+/**
+	Evaluate point in a cubic Hermite curve.
+
+	@tparam Cons Floating-point vector or scalar.
+	@returns Interpolant.
+	@param p0,m0 First point and its tangent.
+	@param p1,m1 Second point and its tangent.
+	@param t Interpolation value in <code>[0, 1]</code>.
+*/
+template<
+	class Cons
+>
+inline Cons
+hermite(
+	Cons const& p0,
+	Cons const& m0,
+	Cons const& p1,
+	Cons const& m1,
+	detail::linear::value_type<Cons> const t
+) {
+	using V = detail::linear::value_type<Cons>;
+	return linear::spline_cubic(
+		cubic_basis<V>::hermite(), p0, m0, p1, m1, t
+	);
+}
+
+/**
+	Evaluate point in a uniform Catmull-Rom segment.
+
+	@tparam Cons Floating-point vector or scalar.
+	@returns Interpolant between @a p1 and @a p2.
+	@param p0,p1,p2,p3 Control points.
+	@param t Interpolation value in <code>[0, 1]</code>.
+*/
+template<
+	class Cons
+>
+inline Cons
+catmull_rom(
+	Cons const& p0,
+	Cons const& p1,
+	Cons const& p2,
+	Cons const& p3,
+	detail::linear::value_type<Cons> const t
+) {
+	using V = detail::linear::value_type<Cons>;
+	return linear::spline_cubic(
+		cubic_basis<V>::catmull_rom(), p0, p1, p2, p3, t
+	);
+}
+
+/**
+	Evaluate point in a non-uniform Catmull-Rom segment.
+
+	The knot intervals are <code>|p<sub>i+1</sub> - p<sub>i</sub>|<sup>alpha</sup></code>:
+	@c 0 gives the uniform curve, @c 0.5 the centripetal curve, and
+	@c 1 the chordal curve. The segment is converted to Hermite form.
+
+	@note Coincident consecutive control points are not supported.
+
+	@tparam Cons Floating-point vector.
+	@returns Interpolant between @a p1 and @a p2.
+	@param p0,p1,p2,p3 Control points.
+	@param t Interpolation value in <code>[0, 1]</code>.
+	@param alpha Knot parameterization exponent.
+*/
+template<
+	class Cons
+>
+inline Cons
+catmull_rom_centripetal(
+	Cons const& p0,
+	Cons const& p1,
+	Cons const& p2,
+	Cons const& p3,
+	detail::linear::value_type<Cons> const t,
+	detail::linear::value_type<Cons> const alpha
+		= detail::linear::value_type<Cons>(0.5)
+) {
+	using V = detail::linear::value_type<Cons>;
+	// Knot intervals
+	V const d0 = std::pow(linear::distance(p0, p1), alpha);
+	V const d1 = std::pow(linear::distance(p1, p2), alpha);
+	V const d2 = std::pow(linear::distance(p2, p3), alpha);
+	// Tangents, scaled to the [0, 1] segment
+	Cons const m1 = (
+		(p1 - p0) / d0 -
+		(p2 - p0) / (d0 + d1) +
+		(p2 - p1) / d1
+	) * d1;
+	Cons const m2 = (
+		(p2 - p1) / d1 -
+		(p3 - p1) / (d1 + d2) +
+		(p3 - p2) / d2
+	) * d1;
+	return linear::hermite(p1, m1, p2, m2, t);
+}
+
+/**
+	Evaluate point in a uniform cubic B-spline segment.
+
+	@tparam Cons Floating-point vector or scalar.
+	@returns Interpolant.
+	@param p0,p1,p2,p3 Control points.
+	@param t Interpolation value in <code>[0, 1]</code>.
+*/
+template<
+	class Cons
+>
+inline Cons
+bspline_cubic(
+	Cons const& p0,
+	Cons const& p1,
+	Cons const& p2,
+	Cons const& p3,
+	detail::linear::value_type<Cons> const t
+) {
+	using V = detail::linear::value_type<Cons>;
+	return linear::spline_cubic(
+		cubic_basis<V>::bspline(), p0, p1, p2, p3, t
+	);
+}
+
+/**
+	Sample a sequence of uniform cubic spline segments.
+
+	Every segment is sampled at <code>t = k / steps</code> for
+	<code>k</code> in <code>[0, steps)</code>, followed by the end of
+	the last segment. The weights for each @c k are computed once.
+
+	@tparam Cons Floating-point vector or scalar.
+	@returns The number of points written:
+	<code>segments * steps + 1</code>, or @c 0 if there are no
+	segments.
+	@param basis Basis matrix.
+	@param count Number of control values.
+	@param points Control values.
+	@param steps Number of samples per segment.
+	@param[out] out Points; must have room for the returned number of
+	values.
+*/
+template<
+	class Cons
+>
+inline std::size_t
+spline_cubic_sample(
+	cubic_basis<detail::linear::value_type<Cons>> const& basis,
+	std::size_t const count,
+	Cons const* const points,
+	std::size_t const steps,
+	Cons* const out
+) {
+	return detail::linear::spline_cubic_sample_impl(
+		basis, count, points, steps, out
+	);
+}
+
+/**
+	Sample a view of uniform cubic spline segments.
+
+	@tparam Cons Floating-point vector or scalar.
+	@returns The number of points written:
+	<code>segments * steps + 1</code>, or @c 0 if there are no
+	segments.
+	@param basis Basis matrix.
+	@param points Control values.
+	@param steps Number of samples per segment.
+	@param[out] out Points; must have room for the returned number of
+	values.
+*/
+template<
+	class Cons
+>
+inline std::size_t
+spline_cubic_sample(
+	cubic_basis<detail::linear::value_type<Cons>> const& basis,
+	vec_view<Cons> const& points,
+	std::size_t const steps,
+	Cons* const out
+) {
+	if (points.is_contiguous()) {
+		return detail::linear::spline_cubic_sample_impl(
+			basis, points.size(),
+			detail::linear::contiguous_access<Cons const>{points.data()},
+			steps, out
+		);
+	} else {
+		return detail::linear::spline_cubic_sample_impl(
+			basis, points.size(),
+			detail::linear::strided_access<Cons const>{points.data(), points.stride()},
+			steps, out
+		);
+	}
+}
+
+/**
+	Arc-length reparameterization table.
+
+	The table maps arc length to curve parameter. It is built once from
+	samples of a curve and can then be queried any number of times.
+
+	@tparam V Floating-point type.
+*/
+template<
+	class V
+>
+class arc_length_table {
+private:
+	V m_param_begin{0};
+	V m_param_step{0};
+	std::vector<V> m_lengths{};
+
+public:
+	/** Value type. */
+	using value_type = V;
+	/** Size/length type. */
+	using size_type = std::size_t;
+
+/** @name Special member functions */ /// @{
+	/** Destructor. */
+	~arc_length_table() = default;
+	/** Default constructor. */
+	arc_length_table() = default;
+	/** Copy constructor. */
+	arc_length_table(arc_length_table const&) = default;
+	/** Move constructor. */
+	arc_length_table(arc_length_table&&) = default;
+	/** Copy assignment operator. */
+	arc_length_table& operator=(arc_length_table const&) = default;
+	/** Move assignment operator. */
+	arc_length_table& operator=(arc_length_table&&) = default;
+/// @}
+
+/** @name Properties */ /// @{
+	/**
+		Get the number of samples.
+	*/
+	size_type
+	size() const noexcept {
+		return m_lengths.size();
+	}
+
+	/**
+		Get the total length of the curve.
+	*/
+	value_type
+	length() const noexcept {
+		return m_lengths.empty() ? V{0} : m_lengths.back();
+	}
+/// @}
+
+/** @name Operations */ /// @{
+	/**
+		Build from curve points.
+
+		@note @a points must be the curve sampled at evenly-spaced
+		parameters from @a param_begin to @a param_end.
+
+		@tparam Cons Floating-point vector.
+		@param count Number of points.
+		@param points Curve points.
+		@param param_begin Parameter of the first point.
+		@param param_end Parameter of the last point.
+	*/
+	template<
+		class Cons
+	>
+	void
+	build(
+		size_type const count,
+		Cons const* const points,
+		value_type const param_begin,
+		value_type const param_end
+	) {
+		m_lengths.resize(count);
+		m_param_begin = param_begin;
+		m_param_step
+			= (1 < count)
+			? (param_end - param_begin) / static_cast<V>(count - 1)
+			: V{0}
+		;
+		V total{0};
+		for (size_type i = 0; i < count; ++i) {
+			if (0 < i) {
+				total += linear::distance(points[i - 1], points[i]);
+			}
+			m_lengths[i] = total;
+		}
+	}
+
+	/**
+		Build from a curve function.
+
+		@tparam F Function object taking a parameter and returning a
+		floating-point vector.
+		@param curve Curve function.
+		@param param_begin First parameter.
+		@param param_end Last parameter.
+		@param samples Number of samples; must be at least @c 2.
+	*/
+	template<
+		class F
+	>
+	void
+	build_from(
+		F const& curve,
+		value_type const param_begin,
+		value_type const param_end,
+		size_type const samples
+	) {
+		using Cons = decltype(curve(param_begin));
+		std::vector<Cons> points;
+		points.reserve(samples);
+		V const step = (param_end - param_begin) / static_cast<V>(samples - 1);
+		for (size_type i = 0; i + 1 < samples; ++i) {
+			points.push_back(curve(param_begin + static_cast<V>(i) * step));
+		}
+		points.push_back(curve(param_end));
+		build(samples, points.data(), param_begin, param_end);
+	}
+
+	/**
+		Get the parameter at an arc length.
+
+		@returns The curve parameter at arc length @a s (clamped to the
+		curve).
+		@param s Arc length.
+	*/
+	value_type
+	parameter(
+		value_type const s
+	) const noexcept {
+		if (2 > m_lengths.size()) {
+			return m_param_begin;
+		}
+		auto const it = std::upper_bound(
+			m_lengths.cbegin() + 1, m_lengths.cend() - 1, s
+		);
+		return interpolate(
+			static_cast<size_type>(it - m_lengths.cbegin()), s
+		);
+	}
+
+	/**
+		Get parameters at evenly-spaced arc lengths.
+
+		This walks the table once rather than searching it for every
+		value.
+
+		@param n Number of intervals.
+		@param[out] out Parameters at arc lengths
+		<code>length() * k / n</code>; must have room for
+		<code>n + 1</code> values.
+	*/
+	void
+	uniform_parameters(
+		size_type const n,
+		value_type* const out
+	) const noexcept {
+		if (2 > m_lengths.size() || 0 == n) {
+			for (size_type k = 0; k <= n; ++k) {
+				out[k] = m_param_begin;
+			}
+			return;
+		}
+		V const step = length() / static_cast<V>(n);
+		size_type i = 1;
+		for (size_type k = 0; k <= n; ++k) {
+			V const s = static_cast<V>(k) * step;
+			while (i + 1 < m_lengths.size() && m_lengths[i] <= s) {
+				++i;
+			}
+			out[k] = interpolate(i, s);
+		}
+	}
+/// @}
+
+private:
+	value_type
+	interpolate(
+		size_type const i,
+		value_type const s
+	) const noexcept {
+		V const l0 = m_lengths[i - 1];
+		V const dl = m_lengths[i] - l0;
+		V f = (V{0} < dl) ? (s - l0) / dl : V{0};
+		f = std::min(std::max(f, V{0}), V{1});
+		return m_param_begin + (static_cast<V>(i - 1) + f) * m_param_step;
+	}
+};
+
+/** @} */ // end of doc-group spline
+/** @} */ // end of doc-group linear
+
+} // namespace linear
+} // namespace am
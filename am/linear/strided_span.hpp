@@ -0,0 +1,347 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Non-owning strided views.
+*/
+
+#pragma once
+
+#include "../config.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace am {
+namespace detail {
+namespace linear {
+
+/** @cond INTERNAL */
+
+// Element access for batch kernels. All go through memcpy, so
+// elements need no particular alignment; the contiguous form has a
+// compile-time stride, which lets the compiler vectorize.
+
+template<
+	class T
+>
+struct contiguous_access {
+	using value_type = typename std::remove_const<T>::type;
+
+	unsigned char const* data;
+
+	value_type
+	operator[](
+		std::size_t const i
+	) const noexcept {
+		value_type value;
+		std::memcpy(&value, data + i * sizeof(value_type), sizeof(value_type));
+		return value;
+	}
+};
+
+template<
+	class T
+>
+struct strided_access {
+	using value_type = typename std::remove_const<T>::type;
+
+	unsigned char const* data;
+	std::size_t stride;
+
+	value_type
+	operator[](
+		std::size_t const i
+	) const noexcept {
+		value_type value;
+		std::memcpy(&value, data + i * stride, sizeof(value_type));
+		return value;
+	}
+};
+
+// Element stores, the write side of the above
+
+template<
+	class T
+>
+struct contiguous_store {
+	unsigned char* data;
+
+	void
+	set(
+		std::size_t const i,
+		T const& value
+	) const noexcept {
+		std::memcpy(data + i * sizeof(T), &value, sizeof(T));
+	}
+};
+
+template<
+	class T
+>
+struct strided_store {
+	unsigned char* data;
+	std::size_t stride;
+
+	void
+	set(
+		std::size_t const i,
+		T const& value
+	) const noexcept {
+		std::memcpy(data + i * stride, &value, sizeof(T));
+	}
+};
+
+/** @endcond */ // INTERNAL
+
+} // namespace linear
+} // namespace detail
+
+namespace linear {
+
+/**
+	@addtogroup linear
+	@{
+*/
+/**
+	@defgroup strided_span Strided views
+	@details
+	A strided_span is a non-owning view of elements spaced a fixed
+	number of bytes apart in external memory, such as one attribute of
+	an interleaved vertex buffer:
+
+	@code
+	struct Vertex { float position[3]; float normal[3]; float uv[2]; };
+	am::linear::vec_view<am::linear::vec3> const positions{
+		buffer + offsetof(Vertex, position), count, sizeof(Vertex)
+	};
+	auto const bounds = am::geometry::aabb_of(positions);
+	@endcode
+
+	Elements are read and written through @c std::memcpy, so the
+	memory does not need to hold actual objects of the element type,
+	and elements do not need to be aligned. Batch kernels that accept
+	views test for a contiguous stride and take a fast path if it is.
+	@{
+*/
+
+/**
+	Non-owning strided view.
+
+	@tparam T A trivially-copyable type; if @c const, the view is
+	read-only.
+*/
+template<
+	class T
+>
+class strided_span {
+public:
+	/** @cond INTERNAL */
+	AM_STATIC_ASSERT(
+		std::is_trivially_copyable<T>::value,
+		"T must be trivially copyable"
+	);
+	/** @endcond */
+
+	/** Element type. */
+	using element_type = T;
+	/** Value type (@a T without @c const). */
+	using value_type = typename std::remove_const<T>::type;
+	/** Size/length type. */
+	using size_type = std::size_t;
+	/** Byte pointer type. */
+	using byte_pointer = typename std::conditional<
+		std::is_const<T>::value,
+		unsigned char const*,
+		unsigned char*
+	>::type;
+	/** Untyped pointer type. */
+	using void_pointer = typename std::conditional<
+		std::is_const<T>::value,
+		void const*,
+		void*
+	>::type;
+
+private:
+	byte_pointer m_data;
+	size_type m_size;
+	size_type m_stride;
+
+public:
+/** @name Constructors */ /// @{
+	/**
+		Construct empty.
+	*/
+	strided_span() noexcept
+		: m_data(nullptr)
+		, m_size(0)
+		, m_stride(sizeof(value_type))
+	{}
+
+	/**
+		Construct over strided memory.
+
+		@param data Pointer to the first element.
+		@param size Number of elements.
+		@param stride Distance in bytes between elements; must be at
+		least <code>sizeof(T)</code>.
+	*/
+	strided_span(
+		void_pointer const data,
+		size_type const size,
+		size_type const stride
+	) noexcept
+		: m_data(static_cast<byte_pointer>(data))
+		, m_size(size)
+		, m_stride(stride)
+	{}
+
+	/**
+		Construct over an array.
+
+		@param data Array.
+		@param size Number of elements.
+	*/
+	strided_span(
+		T* const data,
+		size_type const size
+	) noexcept
+		: m_data(reinterpret_cast<byte_pointer>(data))
+		, m_size(size)
+		, m_stride(sizeof(value_type))
+	{}
+
+	/**
+		Construct read-only view from mutable view.
+
+		@param other View.
+	*/
+	template<
+		class U,
+		class = typename std::enable_if<
+			std::is_const<T>::value &&
+			std::is_same<U, value_type>::value
+		>::type
+	>
+	strided_span(
+		strided_span<U> const& other
+	) noexcept
+		: m_data(other.data())
+		, m_size(other.size())
+		, m_stride(other.stride())
+	{}
+
+	/** Copy constructor. */
+	strided_span(strided_span const&) = default;
+	/** Copy assignment operator. */
+	strided_span& operator=(strided_span const&) = default;
+/// @}
+
+/** @name Properties */ /// @{
+	/**
+		Get pointer to the first element.
+	*/
+	byte_pointer
+	data() const noexcept {
+		return m_data;
+	}
+
+	/**
+		Get the number of elements.
+	*/
+	size_type
+	size() const noexcept {
+		return m_size;
+	}
+
+	/**
+		Check whether the view is empty.
+	*/
+	bool
+	empty() const noexcept {
+		return 0 == m_size;
+	}
+
+	/**
+		Get the distance in bytes between elements.
+	*/
+	size_type
+	stride() const noexcept {
+		return m_stride;
+	}
+
+	/**
+		Check whether the elements are tightly packed.
+	*/
+	bool
+	is_contiguous() const noexcept {
+		return sizeof(value_type) == m_stride;
+	}
+/// @}
+
+/** @name Operations */ /// @{
+	/**
+		Get element.
+
+		@returns A copy of the element at @a i.
+		@param i Index.
+	*/
+	value_type
+	operator[](
+		size_type const i
+	) const noexcept {
+		value_type value;
+		std::memcpy(&value, m_data + i * m_stride, sizeof(value_type));
+		return value;
+	}
+
+	/**
+		Set element.
+
+		@param i Index.
+		@param value Value.
+	*/
+	void
+	set(
+		size_type const i,
+		value_type const& value
+	) const noexcept {
+		AM_STATIC_ASSERT(
+			!std::is_const<T>::value,
+			"view is read-only"
+		);
+		std::memcpy(m_data + i * m_stride, &value, sizeof(value_type));
+	}
+
+	/**
+		Get a view of a range of elements.
+
+		@param offset Index of the first element.
+		@param count Number of elements.
+	*/
+	strided_span
+	subspan(
+		size_type const offset,
+		size_type const count
+	) const noexcept {
+		return strided_span{m_data + offset * m_stride, count, m_stride};
+	}
+/// @}
+};
+
+/**
+	Read-only strided view of vectors.
+
+	@tparam Cons A vector type.
+*/
+template<
+	class Cons
+>
+using vec_view = strided_span<Cons const>;
+
+/** @} */ // end of doc-group strided_span
+/** @} */ // end of doc-group linear
+
+} // namespace linear
+} // namespace am
@@ -61,6 +61,13 @@ namespace linear {
 	using uvec1 = detail::linear::tvec1<component_uint>;
 #endif
 
+/**
+	1-dimensional boolean vector.
+
+	This is the mask type of the component-wise comparisons.
+*/
+using bvec1 = detail::linear::tvec1<bool>;
+
 /** @} */ // end of doc-group vec1
 /** @} */ // end of doc-group vector
 /** @} */ // end of doc-group linear
@@ -61,6 +61,13 @@ namespace linear {
 	using uvec2 = detail::linear::tvec2<component_uint>;
 #endif
 
+/**
+	2-dimensional boolean vector.
+
+	This is the mask type of the component-wise comparisons.
+*/
+using bvec2 = detail::linear::tvec2<bool>;
+
 /** @} */ // end of doc-group vec2
 /** @} */ // end of doc-group vector
 /** @} */ // end of doc-group linear
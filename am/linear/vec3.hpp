@@ -61,6 +61,13 @@ namespace linear {
 	using uvec3 = detail::linear::tvec3<component_uint>;
 #endif
 
+/**
+	3-dimensional boolean vector.
+
+	This is the mask type of the component-wise comparisons.
+*/
+using bvec3 = detail::linear::tvec3<bool>;
+
 /** @} */ // end of doc-group vec3
 /** @} */ // end of doc-group vector
 /** @} */ // end of doc-group linear
@@ -61,6 +61,13 @@ namespace linear {
 	using uvec4 = detail::linear::tvec4<component_uint>;
 #endif
 
+/**
+	4-dimensional boolean vector.
+
+	This is the mask type of the component-wise comparisons.
+*/
+using bvec4 = detail::linear::tvec4<bool>;
+
 /** @} */ // end of doc-group vec4
 /** @} */ // end of doc-group vector
 /** @} */ // end of doc-group linear
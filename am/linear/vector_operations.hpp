@@ -12,6 +12,8 @@
 #include "./vector_interface.hpp"
 #include "./interpolation.hpp"
 
+#include <type_traits>
+
 namespace am {
 namespace linear {
 
@@ -38,6 +40,12 @@ namespace linear {
 		detail::linear::is_construct_floating_point<Cons>::value,		\
 		"Cons must be floating-point"									\
 	);
+
+#define AM_VEC_OP_REQUIRE_VECTOR(Cons)									\
+	AM_STATIC_ASSERT(													\
+		detail::linear::is_vector<Cons>::value,							\
+		"Cons must be a vector"											\
+	);
 /** @endcond */
 
 /**
@@ -240,8 +248,385 @@ mix(
 	return linear::lerp(x, y, a);
 }
 
+/**
+	Calculate the component-wise minimum of two vectors.
+
+	@remarks Defined for all vector types.
+
+	@tparam Cons A vector type.
+	@returns The minimum of @a v and @a r.
+	@param v First vector.
+	@param r Second vector.
+*/
+template<
+	class Cons
+>
+inline Cons
+min(
+	Cons const& v,
+	Cons const& r
+) {
+	AM_VEC_OP_REQUIRE_VECTOR(Cons);
+	return Cons::operations::min(v, r);
+}
+
+/**
+	Calculate the component-wise minimum of a vector and a value.
+
+	@remarks Defined for all vector types.
+
+	@tparam Cons A vector type.
+	@returns The minimum of @a v and @a s.
+	@param v Vector.
+	@param s Value.
+*/
+template<
+	class Cons
+>
+inline Cons
+min(
+	Cons const& v,
+	detail::linear::value_type<Cons> const s
+) {
+	AM_VEC_OP_REQUIRE_VECTOR(Cons);
+	return Cons::operations::min(v, Cons{s});
+}
+
+/**
+	Calculate the component-wise maximum of two vectors.
+
+	@remarks Defined for all vector types.
+
+	@tparam Cons A vector type.
+	@returns The maximum of @a v and @a r.
+	@param v First vector.
+	@param r Second vector.
+*/
+template<
+	class Cons
+>
+inline Cons
+max(
+	Cons const& v,
+	Cons const& r
+) {
+	AM_VEC_OP_REQUIRE_VECTOR(Cons);
+	return Cons::operations::max(v, r);
+}
+
+/**
+	Calculate the component-wise maximum of a vector and a value.
+
+	@remarks Defined for all vector types.
+
+	@tparam Cons A vector type.
+	@returns The maximum of @a v and @a s.
+	@param v Vector.
+	@param s Value.
+*/
+template<
+	class Cons
+>
+inline Cons
+max(
+	Cons const& v,
+	detail::linear::value_type<Cons> const s
+) {
+	AM_VEC_OP_REQUIRE_VECTOR(Cons);
+	return Cons::operations::max(v, Cons{s});
+}
+
+/**
+	Clamp a vector component-wise.
+
+	@remarks Defined for all vector types.
+
+	@tparam Cons A vector type.
+	@returns @a v constrained to <code>[lo, hi]</code>.
+	@param v Vector.
+	@param lo Lower bound.
+	@param hi Upper bound.
+*/
+template<
+	class Cons
+>
+inline Cons
+clamp(
+	Cons const& v,
+	Cons const& lo,
+	Cons const& hi
+) {
+	AM_VEC_OP_REQUIRE_VECTOR(Cons);
+	return Cons::operations::clamp(v, lo, hi);
+}
+
+/**
+	Clamp a vector component-wise to values.
+
+	@remarks Defined for all vector types.
+
+	@tparam Cons A vector type.
+	@returns @a v constrained to <code>[lo, hi]</code>.
+	@param v Vector.
+	@param lo Lower bound.
+	@param hi Upper bound.
+*/
+template<
+	class Cons
+>
+inline Cons
+clamp(
+	Cons const& v,
+	detail::linear::value_type<Cons> const lo,
+	detail::linear::value_type<Cons> const hi
+) {
+	AM_VEC_OP_REQUIRE_VECTOR(Cons);
+	return Cons::operations::clamp(v, Cons{lo}, Cons{hi});
+}
+
+/**
+	Calculate the component-wise absolute value of a vector.
+
+	@remarks Defined for all vector types.
+
+	@tparam Cons A vector type.
+	@returns The absolute value of @a v.
+	@param v Vector.
+*/
+template<
+	class Cons
+>
+inline Cons
+abs(
+	Cons const& v
+) {
+	AM_VEC_OP_REQUIRE_VECTOR(Cons);
+	return Cons::operations::abs(v);
+}
+
+/** @cond INTERNAL */
+#define AM_VEC_OP_REQUIRE_MASK(Cons)									\
+	AM_STATIC_ASSERT(													\
+		detail::linear::is_vector<Cons>::value,							\
+		"Cons must be a vector"											\
+	);																	\
+	AM_STATIC_ASSERT(													\
+		(std::is_same<bool, typename Cons::value_type>::value),			\
+		"Cons must be a boolean vector"									\
+	);
+/** @endcond */
+
+/**
+	Compare two vectors component-wise (less than).
+
+	@remarks Defined for all vector types.
+
+	@tparam Cons A vector type.
+	@returns A mask with each component set if the component of @a v
+	is less than the component of @a r.
+	@param v First vector.
+	@param r Second vector.
+*/
+template<
+	class Cons
+>
+inline typename Cons::operations::mask_type
+less(
+	Cons const& v,
+	Cons const& r
+) {
+	AM_VEC_OP_REQUIRE_VECTOR(Cons);
+	return Cons::operations::less(v, r);
+}
+
+/**
+	Compare two vectors component-wise (less than or equal to).
+
+	@remarks Defined for all vector types.
+
+	@tparam Cons A vector type.
+	@returns A mask with each component set if the component of @a v
+	is less than or equal to the component of @a r.
+	@param v First vector.
+	@param r Second vector.
+*/
+template<
+	class Cons
+>
+inline typename Cons::operations::mask_type
+less_equal(
+	Cons const& v,
+	Cons const& r
+) {
+	AM_VEC_OP_REQUIRE_VECTOR(Cons);
+	return Cons::operations::less_equal(v, r);
+}
+
+/**
+	Compare two vectors component-wise (greater than).
+
+	@remarks Defined for all vector types.
+
+	@tparam Cons A vector type.
+	@returns A mask with each component set if the component of @a v
+	is greater than the component of @a r.
+	@param v First vector.
+	@param r Second vector.
+*/
+template<
+	class Cons
+>
+inline typename Cons::operations::mask_type
+greater(
+	Cons const& v,
+	Cons const& r
+) {
+	AM_VEC_OP_REQUIRE_VECTOR(Cons);
+	return Cons::operations::greater(v, r);
+}
+
+/**
+	Compare two vectors component-wise (greater than or equal to).
+
+	@remarks Defined for all vector types.
+
+	@tparam Cons A vector type.
+	@returns A mask with each component set if the component of @a v
+	is greater than or equal to the component of @a r.
+	@param v First vector.
+	@param r Second vector.
+*/
+template<
+	class Cons
+>
+inline typename Cons::operations::mask_type
+greater_equal(
+	Cons const& v,
+	Cons const& r
+) {
+	AM_VEC_OP_REQUIRE_VECTOR(Cons);
+	return Cons::operations::greater_equal(v, r);
+}
+
+/**
+	Compare two vectors component-wise (equal to).
+
+	@remarks Defined for all vector types.
+
+	@tparam Cons A vector type.
+	@returns A mask with each component set if the component of @a v
+	is equal to the component of @a r.
+	@param v First vector.
+	@param r Second vector.
+*/
+template<
+	class Cons
+>
+inline typename Cons::operations::mask_type
+equal(
+	Cons const& v,
+	Cons const& r
+) {
+	AM_VEC_OP_REQUIRE_VECTOR(Cons);
+	return Cons::operations::equal(v, r);
+}
+
+/**
+	Compare two vectors component-wise (not equal to).
+
+	@remarks Defined for all vector types.
+
+	@tparam Cons A vector type.
+	@returns A mask with each component set if the component of @a v
+	is not equal to the component of @a r.
+	@param v First vector.
+	@param r Second vector.
+*/
+template<
+	class Cons
+>
+inline typename Cons::operations::mask_type
+not_equal(
+	Cons const& v,
+	Cons const& r
+) {
+	AM_VEC_OP_REQUIRE_VECTOR(Cons);
+	return Cons::operations::not_equal(v, r);
+}
+
+/**
+	Check whether any component of a mask is set.
+
+	@remarks Defined for all boolean vector types.
+
+	@tparam Cons A boolean vector type.
+	@returns @c true if any component of @a m is @c true.
+	@param m Mask.
+*/
+template<
+	class Cons
+>
+inline bool
+any(
+	Cons const& m
+) {
+	AM_VEC_OP_REQUIRE_MASK(Cons);
+	return Cons::operations::any(m);
+}
+
+/**
+	Check whether all components of a mask are set.
+
+	@remarks Defined for all boolean vector types.
+
+	@tparam Cons A boolean vector type.
+	@returns @c true if all components of @a m are @c true.
+	@param m Mask.
+*/
+template<
+	class Cons
+>
+inline bool
+all(
+	Cons const& m
+) {
+	AM_VEC_OP_REQUIRE_MASK(Cons);
+	return Cons::operations::all(m);
+}
+
+/**
+	Select components from two vectors by a mask.
+
+	This is the vector form of <code>m ? a : b</code>. Every component
+	of both @a a and @a b is evaluated, so there is no branch; the
+	compiler can lower it to a blend.
+
+	@remarks Defined for all vector types.
+
+	@tparam Cons A vector type.
+	@returns A vector with each component taken from @a a if the
+	component of @a m is set, and from @a b otherwise.
+	@param m Mask.
+	@param a Vector to select set components from.
+	@param b Vector to select unset components from.
+*/
+template<
+	class Cons
+>
+inline Cons
+select(
+	typename Cons::operations::mask_type const& m,
+	Cons const& a,
+	Cons const& b
+) {
+	AM_VEC_OP_REQUIRE_VECTOR(Cons);
+	return Cons::operations::select(m, a, b);
+}
+
 /** @cond INTERNAL */
 #undef AM_VEC_OP_REQUIRE_FLOATING_POINT
+#undef AM_VEC_OP_REQUIRE_VECTOR
+#undef AM_VEC_OP_REQUIRE_MASK
 /** @endcond */
 
 /** @} */ // end of doc-group vector_ops
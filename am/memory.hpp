@@ -0,0 +1,384 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Aligned memory.
+*/
+
+#pragma once
+
+#include "./config.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace am {
+namespace detail {
+
+/** @cond INTERNAL */
+
+// Over-allocate and keep the original pointer just before the
+// aligned block; C++11 has no aligned allocation function.
+constexpr std::size_t
+aligned_overhead(
+	std::size_t const alignment
+) noexcept {
+	return alignment - 1 + sizeof(void*);
+}
+
+inline void*
+aligned_allocate(
+	std::size_t const size,
+	std::size_t const alignment
+) {
+	if (size > std::numeric_limits<std::size_t>::max() - aligned_overhead(alignment)) {
+		throw std::bad_alloc{};
+	}
+	void* const raw = ::operator new(size + aligned_overhead(alignment));
+	std::uintptr_t const base
+		= reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*)
+	;
+	std::uintptr_t const aligned
+		= (base + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1)
+	;
+	reinterpret_cast<void**>(aligned)[-1] = raw;
+	return reinterpret_cast<void*>(aligned);
+}
+
+inline void
+aligned_deallocate(
+	void* const p
+) noexcept {
+	if (p) {
+		::operator delete(static_cast<void**>(p)[-1]);
+	}
+}
+
+/** @endcond */ // INTERNAL
+
+} // namespace detail
+
+/**
+	@defgroup memory Aligned memory
+	@details
+	Helpers for keeping bulk data aligned to cache lines (and, with
+	@c AM_CONFIG_ALIGN_SIMD, for keeping over-aligned vectors and
+	matrices aligned in dynamic storage, which @c new does not do
+	before C++17).
+	@{
+*/
+
+/**
+	Assumed cache line size in bytes.
+*/
+constexpr std::size_t const cache_line_size = 64;
+
+/**
+	Aligned allocator.
+
+	@tparam T Value type.
+	@tparam Alignment Alignment in bytes; must be a power of two no
+	less than <code>alignof(T)</code>.
+*/
+template<
+	class T,
+	std::size_t Alignment = cache_line_size
+>
+struct aligned_allocator {
+	/** @cond INTERNAL */
+	AM_STATIC_ASSERT(
+		0 == (Alignment & (Alignment - 1)),
+		"Alignment must be a power of two"
+	);
+	AM_STATIC_ASSERT(
+		Alignment >= alignof(T),
+		"Alignment must be at least the alignment of T"
+	);
+	/** @endcond */
+
+	/** Value type. */
+	using value_type = T;
+	/** Size/length type. */
+	using size_type = std::size_t;
+
+	/** Alignment in bytes. */
+	static constexpr std::size_t const alignment = Alignment;
+
+	/** Allocator rebind. */
+	template<
+		class U
+	>
+	struct rebind {
+		/** Allocator type for @a U. */
+		using other = aligned_allocator<U, Alignment>;
+	};
+
+	/** Default constructor. */
+	aligned_allocator() noexcept = default;
+
+	/** Converting constructor. */
+	template<
+		class U
+	>
+	aligned_allocator(
+		aligned_allocator<U, Alignment> const&
+	) noexcept {}
+
+	/**
+		Allocate storage.
+
+		@throws std::bad_alloc If allocation fails.
+		@returns Storage for @a n values aligned to @a Alignment.
+		@param n Number of values.
+	*/
+	T*
+	allocate(
+		size_type const n
+	) {
+		if (n > (
+			std::numeric_limits<size_type>::max()
+			- detail::aligned_overhead(Alignment)
+		) / sizeof(T)) {
+			throw std::bad_alloc{};
+		}
+		return static_cast<T*>(detail::aligned_allocate(n * sizeof(T), Alignment));
+	}
+
+	/**
+		Deallocate storage.
+
+		@param p Storage from allocate().
+	*/
+	void
+	deallocate(
+		T* const p,
+		size_type const /*n*/
+	) noexcept {
+		detail::aligned_deallocate(p);
+	}
+};
+
+/** @cond INTERNAL */
+template<class T, std::size_t Alignment>
+constexpr std::size_t const aligned_allocator<T, Alignment>::alignment;
+/** @endcond */
+
+/**
+	Equality operator.
+
+	@returns @c true; all aligned allocators of the same alignment are
+	interchangeable.
+*/
+template<class T, class U, std::size_t Alignment>
+inline bool
+operator==(
+	aligned_allocator<T, Alignment> const&,
+	aligned_allocator<U, Alignment> const&
+) noexcept {
+	return true;
+}
+
+/**
+	Inequality operator.
+
+	@returns @c false.
+*/
+template<class T, class U, std::size_t Alignment>
+inline bool
+operator!=(
+	aligned_allocator<T, Alignment> const&,
+	aligned_allocator<U, Alignment> const&
+) noexcept {
+	return false;
+}
+
+/**
+	Vector with aligned storage.
+
+	@tparam T Value type.
+	@tparam Alignment Alignment in bytes.
+*/
+template<
+	class T,
+	std::size_t Alignment = cache_line_size
+>
+using aligned_vector = std::vector<T, aligned_allocator<T, Alignment>>;
+
+/**
+	Default-initializing allocator adaptor.
+
+	Standard containers value-initialize elements they create without
+	a value (e.g., <code>std::vector<T>(n)</code> and @c resize()),
+	which zeroes trivial types. This adaptor default-initializes them
+	instead, so with @c AM_CONFIG_TRIVIAL_DEFAULT_CONSTRUCT, bulk
+	storage of vectors and matrices is left uninitialized and costs
+	only the allocation. Construction with arguments is forwarded to
+	@a Allocator.
+
+	@tparam T Value type.
+	@tparam Allocator Underlying allocator.
+*/
+template<
+	class T,
+	class Allocator = std::allocator<T>
+>
+class default_init_allocator
+	: public Allocator
+{
+private:
+	using traits = std::allocator_traits<Allocator>;
+
+public:
+	/** Allocator rebind. */
+	template<
+		class U
+	>
+	struct rebind {
+		/** Allocator type for @a U. */
+		using other = default_init_allocator<
+			U, typename traits::template rebind_alloc<U>
+		>;
+	};
+
+	/** Default constructor. */
+	default_init_allocator() = default;
+
+	/**
+		Construct from underlying allocator.
+
+		@param allocator Underlying allocator.
+	*/
+	explicit
+	default_init_allocator(
+		Allocator const& allocator
+	) noexcept
+		: Allocator(allocator)
+	{}
+
+	/** Converting constructor. */
+	template<
+		class U,
+		class OtherAllocator
+	>
+	default_init_allocator(
+		default_init_allocator<U, OtherAllocator> const& other
+	) noexcept
+		: Allocator(static_cast<OtherAllocator const&>(other))
+	{}
+
+	/**
+		Default-initialize value.
+
+		@param p Storage.
+	*/
+	template<
+		class U
+	>
+	void
+	construct(
+		U* const p
+	) noexcept(std::is_nothrow_default_constructible<U>::value) {
+		::new(static_cast<void*>(p)) U;
+	}
+
+	/**
+		Construct value from arguments.
+
+		@param p Storage.
+		@param args Constructor arguments.
+	*/
+	template<
+		class U,
+		class... Args
+	>
+	void
+	construct(
+		U* const p,
+		Args&&... args
+	) {
+		traits::construct(
+			static_cast<Allocator&>(*this), p, std::forward<Args>(args)...
+		);
+	}
+};
+
+/**
+	Fixed-size aligned array.
+
+	@note Dynamically-allocated arrays are only aligned if allocated
+	through aligned_allocator (or C++17 @c new).
+
+	@tparam T Value type.
+	@tparam N Number of values.
+	@tparam Alignment Alignment in bytes.
+*/
+template<
+	class T,
+	std::size_t N,
+	std::size_t Alignment = cache_line_size
+>
+struct alignas(Alignment) aligned_array {
+	/** @cond INTERNAL */
+	AM_STATIC_ASSERT(
+		0 == (Alignment & (Alignment - 1)),
+		"Alignment must be a power of two"
+	);
+	/** @endcond */
+
+	/** Value type. */
+	using value_type = T;
+	/** Size/length type. */
+	using size_type = std::size_t;
+
+	/** Values. */
+	T data[N];
+
+	/**
+		Get number of values.
+
+		@returns @a N.
+	*/
+	static constexpr size_type
+	size() noexcept {
+		return N;
+	}
+
+	/**
+		Get value at index.
+
+		@returns The value at @a i.
+		@param i Index.
+	*/
+	T&
+	operator[](
+		size_type const i
+	) noexcept {
+		return data[i];
+	}
+	/** @copydoc operator[](size_type const) */
+	T const&
+	operator[](
+		size_type const i
+	) const noexcept {
+		return data[i];
+	}
+
+	/** Get pointer to the first value. */
+	T* begin() noexcept { return data; }
+	/** Get pointer to the first value. */
+	T const* begin() const noexcept { return data; }
+	/** Get pointer past the last value. */
+	T* end() noexcept { return data + N; }
+	/** Get pointer past the last value. */
+	T const* end() const noexcept { return data + N; }
+};
+
+/** @} */ // end of doc-group memory
+
+} // namespace am
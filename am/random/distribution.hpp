@@ -0,0 +1,578 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Random distributions over scalars and vectors.
+*/
+
+#pragma once
+
+#include "../config.hpp"
+#include "../detail/linear/type_traits.hpp"
+#include "../detail/linear/transcendental.hpp"
+#include "../linear/vec2.hpp"
+#include "../linear/vec3.hpp"
+#include "./engine.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace am {
+namespace detail {
+namespace random {
+
+/** @cond INTERNAL */
+
+// Number of random bits in an engine output. This comes from the
+// output range rather than from result_type, which may be wider (e.g.,
+// std::mt19937 on LP64). Outputs are used as raw bits, so only full
+// 32- and 64-bit ranges are accepted.
+template<
+	class Engine
+>
+struct engine_bits {
+	static constexpr std::uint64_t const range
+		= static_cast<std::uint64_t>(Engine::max() - Engine::min())
+	;
+	static constexpr unsigned const value
+		= range == 0xffffffffu ? 32u
+		: range == ~std::uint64_t(0) ? 64u
+		: 0u
+	;
+	AM_STATIC_ASSERT(
+		0u != value,
+		"Engine must produce a full 32- or 64-bit range"
+	);
+};
+
+// Random values are built from 64 bits: a 64-bit output, one 32-bit
+// output in the high half (enough for float), or two 32-bit outputs
+// (for double)
+template<
+	class T,
+	class Engine
+>
+struct words_per_value {
+	static constexpr std::size_t const value
+		= static_cast<unsigned>(std::numeric_limits<T>::digits)
+		> engine_bits<Engine>::value
+		? 2u : 1u
+	;
+};
+
+template<
+	class T,
+	class Engine
+>
+inline std::uint64_t
+next_bits(
+	Engine& rng
+) noexcept {
+	unsigned const shift = 64u - engine_bits<Engine>::value;
+	std::uint64_t bits = std::uint64_t(rng() - Engine::min()) << shift;
+	if (words_per_value<T, Engine>::value == 2u) {
+		bits |= std::uint64_t(rng() - Engine::min());
+	}
+	return bits;
+}
+
+// Fill bits for count values from one generate() call per chunk
+template<
+	class T,
+	class Engine
+>
+inline void
+generate_bits(
+	Engine& rng,
+	std::size_t const count,
+	std::uint64_t* const bits
+) noexcept {
+	using word = typename Engine::result_type;
+	std::size_t const w = words_per_value<T, Engine>::value;
+	unsigned const shift = 64u - engine_bits<Engine>::value;
+	word const low = Engine::min();
+	word words[128];
+	for (std::size_t i = 0; i < count;) {
+		std::size_t const n = count - i < 128u / w ? count - i : 128u / w;
+		rng.generate(n * w, words);
+		for (std::size_t j = 0; j < n; ++j) {
+			bits[i + j]
+				= (std::uint64_t(words[j * w] - low) << shift)
+				| (w == 2u ? std::uint64_t(words[j * w + 1u] - low) : 0u)
+			;
+		}
+		i += n;
+	}
+}
+
+// [0, 1) from the high bits
+inline float
+unit(
+	std::uint64_t const bits,
+	float
+) noexcept {
+	return static_cast<float>(bits >> 40) * 5.9604644775390625e-8f;
+}
+
+inline double
+unit(
+	std::uint64_t const bits,
+	double
+) noexcept {
+	return static_cast<double>(bits >> 11) * 1.1102230246251565404e-16;
+}
+
+// (0, 1) from the high bits, for logarithms
+inline float
+unit_open(
+	std::uint64_t const bits,
+	float
+) noexcept {
+	return (static_cast<float>(bits >> 40) + 0.5f) * 5.9604644775390625e-8f;
+}
+
+inline double
+unit_open(
+	std::uint64_t const bits,
+	double
+) noexcept {
+	return (static_cast<double>(bits >> 11) + 0.5) * 1.1102230246251565404e-16;
+}
+
+// Box-Muller: two independent standard normals from two uniforms
+template<
+	class T
+>
+inline void
+box_muller(
+	std::uint64_t const b0,
+	std::uint64_t const b1,
+	T& z0,
+	T& z1
+) noexcept {
+	T const r = std::sqrt(T(-2) * detail::linear::kernel_log(unit_open(b0, T())));
+	T s, c;
+	detail::linear::kernel_sincos(
+		T(6.28318530717958647693) * unit(b1, T()), s, c
+	);
+	z0 = r * c;
+	z1 = r * s;
+}
+
+template<
+	class T
+>
+inline linear::tvec3<T>
+sphere_point(
+	std::uint64_t const b0,
+	std::uint64_t const b1
+) noexcept {
+	T const z = T(1) - T(2) * unit(b0, T());
+	T const r = std::sqrt(detail::linear::scalar_max(T(0), T(1) - z * z));
+	T s, c;
+	detail::linear::kernel_sincos(
+		T(6.28318530717958647693) * unit(b1, T()), s, c
+	);
+	return linear::tvec3<T>{r * c, r * s, z};
+}
+
+template<
+	class T
+>
+inline linear::tvec2<T>
+disk_point(
+	std::uint64_t const b0,
+	std::uint64_t const b1
+) noexcept {
+	T const r = std::sqrt(unit(b0, T()));
+	T s, c;
+	detail::linear::kernel_sincos(
+		T(6.28318530717958647693) * unit(b1, T()), s, c
+	);
+	return linear::tvec2<T>{r * c, r * s};
+}
+
+// Uniform component access for scalars and vectors
+template<
+	class Cons,
+	class = void
+>
+struct components {
+	AM_STATIC_ASSERT(
+		std::is_floating_point<Cons>::value,
+		"Cons must be a floating-point type or vector"
+	);
+
+	static constexpr std::size_t const size = 1u;
+
+	static Cons&
+	get(
+		Cons& x,
+		std::size_t const
+	) noexcept {
+		return x;
+	}
+};
+
+template<
+	class Cons
+>
+struct components<
+	Cons,
+	typename std::enable_if<detail::linear::is_vector<Cons>::value>::type
+> {
+	AM_STATIC_ASSERT(
+		detail::linear::is_construct_floating_point<Cons>::value,
+		"Cons must be a floating-point type or vector"
+	);
+
+	static constexpr std::size_t const size = Cons::size();
+
+	static typename Cons::value_type&
+	get(
+		Cons& x,
+		std::size_t const i
+	) noexcept {
+		return x[i];
+	}
+};
+
+/** @endcond */ // INTERNAL
+
+} // namespace random
+} // namespace detail
+
+namespace random {
+
+/**
+	@addtogroup random
+	@{
+*/
+
+/**
+	Generate a uniformly distributed value in <code>[0, 1)</code>.
+
+	float values have 24 random bits and double values 53.
+
+	@note Any engine with a full 32- or 64-bit output range works
+	here, including @c std::mt19937 and @c std::mt19937_64; engines
+	with other ranges (e.g., @c std::minstd_rand) are rejected at
+	compile time.
+
+	@tparam Cons Floating-point type or vector; for a vector, each
+	component is independent.
+	@tparam Engine Engine type; inferred from @a rng.
+	@returns A value in <code>[0, 1)</code>.
+	@param rng Engine.
+*/
+template<
+	class Cons,
+	class Engine
+>
+inline Cons
+uniform(
+	Engine& rng
+) noexcept {
+	using access = detail::random::components<Cons>;
+	using T = detail::linear::value_type<Cons>;
+	Cons r;
+	for (std::size_t i = 0; i < access::size; ++i) {
+		access::get(r, i) = detail::random::unit(
+			detail::random::next_bits<T>(rng), T()
+		);
+	}
+	return r;
+}
+
+/**
+	Generate a uniformly distributed value in <code>[lo, hi)</code>.
+
+	@tparam Cons Floating-point type or vector; inferred from @a lo
+	and @a hi.
+	@tparam Engine Engine type; inferred from @a rng.
+	@returns A value in <code>[lo, hi)</code> (per component).
+	@param rng Engine.
+	@param lo Lower bound.
+	@param hi Upper bound.
+*/
+template<
+	class Cons,
+	class Engine
+>
+inline Cons
+uniform(
+	Engine& rng,
+	Cons const& lo,
+	Cons const& hi
+) noexcept {
+	return lo + (hi - lo) * random::uniform<Cons>(rng);
+}
+
+/**
+	Generate a normally distributed value.
+
+	@tparam Cons Floating-point type or vector; for a vector, each
+	component is independent.
+	@tparam Engine Engine type; inferred from @a rng.
+	@returns A value from the standard normal distribution.
+	@param rng Engine.
+*/
+template<
+	class Cons,
+	class Engine
+>
+inline Cons
+normal(
+	Engine& rng
+) noexcept {
+	using access = detail::random::components<Cons>;
+	using T = detail::linear::value_type<Cons>;
+	Cons r;
+	for (std::size_t i = 0; i < access::size; i += 2) {
+		std::uint64_t const b0 = detail::random::next_bits<T>(rng);
+		std::uint64_t const b1 = detail::random::next_bits<T>(rng);
+		T z0, z1;
+		detail::random::box_muller(b0, b1, z0, z1);
+		access::get(r, i) = z0;
+		if (i + 1 < access::size) {
+			access::get(r, i + 1) = z1;
+		}
+	}
+	return r;
+}
+
+/**
+	Generate a normally distributed value with a mean and standard
+	deviation.
+
+	@tparam Cons Floating-point type or vector; inferred from @a mean
+	and @a stddev.
+	@tparam Engine Engine type; inferred from @a rng.
+	@returns A value from the normal distribution.
+	@param rng Engine.
+	@param mean Mean.
+	@param stddev Standard deviation.
+*/
+template<
+	class Cons,
+	class Engine
+>
+inline Cons
+normal(
+	Engine& rng,
+	Cons const& mean,
+	Cons const& stddev
+) noexcept {
+	return mean + stddev * random::normal<Cons>(rng);
+}
+
+/**
+	Generate a point uniformly distributed on the unit sphere.
+
+	@tparam T Floating-point type.
+	@tparam Engine Engine type; inferred from @a rng.
+	@returns A unit vector.
+	@param rng Engine.
+*/
+template<
+	class T,
+	class Engine
+>
+inline detail::linear::tvec3<T>
+on_sphere(
+	Engine& rng
+) noexcept {
+	AM_STATIC_ASSERT(
+		std::is_floating_point<T>::value,
+		"T must be a floating-point type"
+	);
+	std::uint64_t const b0 = detail::random::next_bits<T>(rng);
+	std::uint64_t const b1 = detail::random::next_bits<T>(rng);
+	return detail::random::sphere_point<T>(b0, b1);
+}
+
+/**
+	Generate a point uniformly distributed in the unit disk.
+
+	@tparam T Floating-point type.
+	@tparam Engine Engine type; inferred from @a rng.
+	@returns A vector of length less than @c 1.
+	@param rng Engine.
+*/
+template<
+	class T,
+	class Engine
+>
+inline detail::linear::tvec2<T>
+in_disk(
+	Engine& rng
+) noexcept {
+	AM_STATIC_ASSERT(
+		std::is_floating_point<T>::value,
+		"T must be a floating-point type"
+	);
+	std::uint64_t const b0 = detail::random::next_bits<T>(rng);
+	std::uint64_t const b1 = detail::random::next_bits<T>(rng);
+	return detail::random::disk_point<T>(b0, b1);
+}
+
+/**
+	Fill an array with uniformly distributed values in
+	<code>[0, 1)</code>.
+
+	@note Bits are drawn in bulk through <code>Engine::generate()</code>
+	and converted in a separate loop that vectorizes. The sequence
+	is not the same as from repeated calls to uniform(Engine&).
+
+	@tparam Engine Engine type; inferred from @a rng.
+	@tparam T Floating-point type; inferred from @a out.
+	@param rng Engine.
+	@param count Number of values.
+	@param[out] out Values (@a count values).
+*/
+template<
+	class Engine,
+	class T
+>
+inline void
+uniform(
+	Engine& rng,
+	std::size_t const count,
+	T* const out
+) noexcept {
+	AM_STATIC_ASSERT(
+		std::is_floating_point<T>::value,
+		"T must be a floating-point type"
+	);
+	std::uint64_t bits[64];
+	for (std::size_t i = 0; i < count; i += 64u) {
+		std::size_t const n = count - i < 64u ? count - i : 64u;
+		detail::random::generate_bits<T>(rng, n, bits);
+		for (std::size_t j = 0; j < n; ++j) {
+			out[i + j] = detail::random::unit(bits[j], T());
+		}
+	}
+}
+
+/**
+	Fill an array with normally distributed values.
+
+	@note See uniform(Engine&, std::size_t, T*).
+
+	@tparam Engine Engine type; inferred from @a rng.
+	@tparam T Floating-point type; inferred from @a out.
+	@param rng Engine.
+	@param count Number of values.
+	@param[out] out Values from the standard normal distribution
+	(@a count values).
+*/
+template<
+	class Engine,
+	class T
+>
+inline void
+normal(
+	Engine& rng,
+	std::size_t const count,
+	T* const out
+) noexcept {
+	AM_STATIC_ASSERT(
+		std::is_floating_point<T>::value,
+		"T must be a floating-point type"
+	);
+	std::uint64_t bits[64];
+	T z[64];
+	for (std::size_t i = 0; i < count; i += 64u) {
+		std::size_t const n = count - i < 64u ? count - i : 64u;
+		std::size_t const pairs = (n + 1u) / 2u;
+		detail::random::generate_bits<T>(rng, 2u * pairs, bits);
+		for (std::size_t j = 0; j < pairs; ++j) {
+			detail::random::box_muller(
+				bits[j], bits[pairs + j], z[j], z[pairs + j]
+			);
+		}
+		for (std::size_t j = 0; j < n; ++j) {
+			out[i + j] = z[j];
+		}
+	}
+}
+
+/**
+	Fill an array with points uniformly distributed on the unit
+	sphere.
+
+	@note See uniform(Engine&, std::size_t, T*).
+
+	@tparam Engine Engine type; inferred from @a rng.
+	@tparam T Floating-point type; inferred from @a out.
+	@param rng Engine.
+	@param count Number of points.
+	@param[out] out Unit vectors (@a count values).
+*/
+template<
+	class Engine,
+	class T
+>
+inline void
+on_sphere(
+	Engine& rng,
+	std::size_t const count,
+	detail::linear::tvec3<T>* const out
+) noexcept {
+	AM_STATIC_ASSERT(
+		std::is_floating_point<T>::value,
+		"T must be a floating-point type"
+	);
+	std::uint64_t bits[64];
+	for (std::size_t i = 0; i < count; i += 32u) {
+		std::size_t const n = count - i < 32u ? count - i : 32u;
+		detail::random::generate_bits<T>(rng, 2u * n, bits);
+		for (std::size_t j = 0; j < n; ++j) {
+			out[i + j] = detail::random::sphere_point<T>(bits[j], bits[n + j]);
+		}
+	}
+}
+
+/**
+	Fill an array with points uniformly distributed in the unit
+	disk.
+
+	@note See uniform(Engine&, std::size_t, T*).
+
+	@tparam Engine Engine type; inferred from @a rng.
+	@tparam T Floating-point type; inferred from @a out.
+	@param rng Engine.
+	@param count Number of points.
+	@param[out] out Points (@a count values).
+*/
+template<
+	class Engine,
+	class T
+>
+inline void
+in_disk(
+	Engine& rng,
+	std::size_t const count,
+	detail::linear::tvec2<T>* const out
+) noexcept {
+	AM_STATIC_ASSERT(
+		std::is_floating_point<T>::value,
+		"T must be a floating-point type"
+	);
+	std::uint64_t bits[64];
+	for (std::size_t i = 0; i < count; i += 32u) {
+		std::size_t const n = count - i < 32u ? count - i : 32u;
+		detail::random::generate_bits<T>(rng, 2u * n, bits);
+		for (std::size_t j = 0; j < n; ++j) {
+			out[i + j] = detail::random::disk_point<T>(bits[j], bits[n + j]);
+		}
+	}
+}
+
+/** @} */ // end of doc-group random
+
+} // namespace random
+} // namespace am
@@ -0,0 +1,748 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Pseudo-random number engines.
+
+@note The xoshiro256++ and splitmix64 algorithms are by David Blackman
+and Sebastiano Vigna (public domain); PCG is by Melissa O'Neill
+(Apache 2.0 / MIT); Philox is by Salmon, Moraes, Dror and Shaw
+(D. E. Shaw Research, BSD-style).
+*/
+
+#pragma once
+
+#include "../config.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace am {
+namespace detail {
+namespace random {
+
+/** @cond INTERNAL */
+
+inline constexpr std::uint64_t
+rotl(
+	std::uint64_t const x,
+	unsigned const k
+) noexcept {
+	return (x << k) | (x >> (64u - k));
+}
+
+inline void
+xoshiro256pp_step(
+	std::uint64_t (&s)[4]
+) noexcept {
+	std::uint64_t const t = s[1] << 17;
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rotl(s[3], 45);
+}
+
+// Polynomial jump: the state after 2^128 (jump) or 2^192 (long
+// jump) steps is a fixed linear combination of the next 256 states
+inline void
+xoshiro256pp_jump(
+	std::uint64_t (&s)[4],
+	std::uint64_t const (&poly)[4]
+) noexcept {
+	std::uint64_t acc[4]{0, 0, 0, 0};
+	for (std::uint64_t const word : poly) {
+		for (unsigned b = 0; b < 64; ++b) {
+			if (word & (std::uint64_t(1) << b)) {
+				acc[0] ^= s[0];
+				acc[1] ^= s[1];
+				acc[2] ^= s[2];
+				acc[3] ^= s[3];
+			}
+			xoshiro256pp_step(s);
+		}
+	}
+	s[0] = acc[0];
+	s[1] = acc[1];
+	s[2] = acc[2];
+	s[3] = acc[3];
+}
+
+constexpr std::uint64_t const
+xoshiro256pp_jump_poly[4]{
+	0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+	0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+};
+
+constexpr std::uint64_t const
+xoshiro256pp_long_jump_poly[4]{
+	0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL,
+	0x77710069854ee241ULL, 0x39109bb02acbe635ULL
+};
+
+// One Philox-4x32 round. Written with 64-bit products of 32-bit
+// values so loops over blocks vectorize (pmuludq)
+inline void
+philox4x32_round(
+	std::uint32_t (&c)[4],
+	std::uint32_t const k0,
+	std::uint32_t const k1
+) noexcept {
+	std::uint64_t const p0 = std::uint64_t(0xD2511F53u) * c[0];
+	std::uint64_t const p1 = std::uint64_t(0xCD9E8D57u) * c[2];
+	std::uint32_t const r0 = static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ k0;
+	std::uint32_t const r2 = static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ k1;
+	c[0] = r0;
+	c[1] = static_cast<std::uint32_t>(p1);
+	c[2] = r2;
+	c[3] = static_cast<std::uint32_t>(p0);
+}
+
+// Low 64 bits of a Philox counter (the block index)
+inline std::uint64_t
+philox_low(
+	std::uint32_t const (&c)[4]
+) noexcept {
+	return std::uint64_t(c[0]) | (std::uint64_t(c[1]) << 32);
+}
+
+// Add to the 128-bit Philox counter
+inline void
+philox_add(
+	std::uint32_t (&c)[4],
+	std::uint64_t const n
+) noexcept {
+	std::uint64_t const low = philox_low(c) + n;
+	std::uint64_t const high
+		= (std::uint64_t(c[2]) | (std::uint64_t(c[3]) << 32))
+		+ (low < n ? 1u : 0u)
+	;
+	c[0] = static_cast<std::uint32_t>(low);
+	c[1] = static_cast<std::uint32_t>(low >> 32);
+	c[2] = static_cast<std::uint32_t>(high);
+	c[3] = static_cast<std::uint32_t>(high >> 32);
+}
+
+/** @endcond */ // INTERNAL
+
+} // namespace random
+} // namespace detail
+
+namespace random {
+
+/**
+	@addtogroup random
+	@{
+*/
+
+/**
+	splitmix64 engine.
+
+	A 64-bit counter passed through a strong mixer. Mostly useful for
+	expanding a single seed into the state of another engine, which is
+	how the other engines here are seeded.
+*/
+struct splitmix64 {
+	/** Output type. */
+	using result_type = std::uint64_t;
+
+	/** State. */
+	std::uint64_t state;
+
+	/** Smallest output. */
+	static constexpr result_type
+	min() noexcept {
+		return 0u;
+	}
+
+	/** Largest output. */
+	static constexpr result_type
+	max() noexcept {
+		return ~result_type(0);
+	}
+
+	/**
+		Constructor with seed.
+
+		@param seed Seed; any value is valid.
+	*/
+	explicit
+	splitmix64(
+		std::uint64_t const seed = 0u
+	) noexcept
+		: state(seed)
+	{}
+
+	/** Get the next output. */
+	result_type
+	operator()() noexcept {
+		std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return z ^ (z >> 31);
+	}
+
+	/**
+		Fill an array with outputs.
+
+		@param count Number of outputs.
+		@param[out] out Outputs (@a count values).
+	*/
+	void
+	generate(
+		std::size_t const count,
+		result_type* const out
+	) noexcept {
+		for (std::size_t i = 0; i < count; ++i) {
+			out[i] = (*this)();
+		}
+	}
+
+	/**
+		Skip outputs.
+
+		@param n Number of outputs to skip.
+	*/
+	void
+	discard(
+		std::uint64_t const n
+	) noexcept {
+		state += n * 0x9e3779b97f4a7c15ULL;
+	}
+};
+
+/**
+	xoshiro256++ engine.
+
+	A fast, general-purpose 64-bit generator with a period of
+	<code>2^256 - 1</code>.
+
+	For parallel work, give each worker a copy of one engine and
+	jump() it by a different number of times; each jump skips
+	<code>2^128</code> outputs, so the streams never overlap.
+	long_jump() skips <code>2^192</code> outputs, for a second level
+	of splitting.
+*/
+struct xoshiro256pp {
+	/** Output type. */
+	using result_type = std::uint64_t;
+
+	/** State; must not be all zero. */
+	std::uint64_t state[4];
+
+	/** Smallest output. */
+	static constexpr result_type
+	min() noexcept {
+		return 0u;
+	}
+
+	/** Largest output. */
+	static constexpr result_type
+	max() noexcept {
+		return ~result_type(0);
+	}
+
+	/**
+		Constructor with seed.
+
+		@param seed Seed; expanded with splitmix64, so any value is
+		valid.
+	*/
+	explicit
+	xoshiro256pp(
+		std::uint64_t const seed = 0u
+	) noexcept {
+		splitmix64 sm{seed};
+		sm.generate(4, state);
+	}
+
+	/** Get the next output. */
+	result_type
+	operator()() noexcept {
+		result_type const r
+			= detail::random::rotl(state[0] + state[3], 23) + state[0]
+		;
+		detail::random::xoshiro256pp_step(state);
+		return r;
+	}
+
+	/**
+		Fill an array with outputs.
+
+		@param count Number of outputs.
+		@param[out] out Outputs (@a count values).
+	*/
+	void
+	generate(
+		std::size_t const count,
+		result_type* const out
+	) noexcept {
+		for (std::size_t i = 0; i < count; ++i) {
+			out[i] = (*this)();
+		}
+	}
+
+	/** Skip <code>2^128</code> outputs. */
+	void
+	jump() noexcept {
+		detail::random::xoshiro256pp_jump(state, detail::random::xoshiro256pp_jump_poly);
+	}
+
+	/** Skip <code>2^192</code> outputs. */
+	void
+	long_jump() noexcept {
+		detail::random::xoshiro256pp_jump(state, detail::random::xoshiro256pp_long_jump_poly);
+	}
+};
+
+/**
+	Interleaved xoshiro256++ engine.
+
+	Runs @a L xoshiro256++ streams side by side so that generate()
+	vectorizes. Lane @c i starts where a xoshiro256pp with the same
+	seed would be after @c i calls to xoshiro256pp::jump(), so the
+	lanes never overlap. Outputs are taken from the lanes in turn.
+
+	long_jump() advances every lane by <code>2^192</code>, which keeps
+	workers independent for @a L up to <code>2^64</code>.
+
+	@tparam L Number of lanes.
+*/
+template<
+	std::size_t L = 8u
+>
+struct xoshiro256pp_lanes {
+	/** Output type. */
+	using result_type = std::uint64_t;
+
+	/** Number of lanes. */
+	static constexpr std::size_t const lanes = L;
+
+	/** State; <code>state[w][l]</code> is word @c w of lane @c l. */
+	std::uint64_t state[4][L];
+
+	/** Outputs of the last step. */
+	result_type buffer[L];
+	/** Index of the next output in @c buffer (@a L when empty). */
+	std::size_t index;
+
+	/** Smallest output. */
+	static constexpr result_type
+	min() noexcept {
+		return 0u;
+	}
+
+	/** Largest output. */
+	static constexpr result_type
+	max() noexcept {
+		return ~result_type(0);
+	}
+
+	/**
+		Advance every lane once.
+
+		@param[out] out One output per lane (@a L values).
+	*/
+	void
+	step(
+		result_type* const out
+	) noexcept {
+		auto& s = state;
+		for (std::size_t l = 0; l < L; ++l) {
+			out[l] = detail::random::rotl(s[0][l] + s[3][l], 23) + s[0][l];
+			std::uint64_t const t = s[1][l] << 17;
+			s[2][l] ^= s[0][l];
+			s[3][l] ^= s[1][l];
+			s[1][l] ^= s[2][l];
+			s[0][l] ^= s[3][l];
+			s[2][l] ^= t;
+			s[3][l] = detail::random::rotl(s[3][l], 45);
+		}
+	}
+
+	/**
+		Constructor with seed.
+
+		@param seed Seed; see xoshiro256pp::xoshiro256pp().
+	*/
+	explicit
+	xoshiro256pp_lanes(
+		std::uint64_t const seed = 0u
+	) noexcept
+		: xoshiro256pp_lanes(xoshiro256pp{seed})
+	{}
+
+	/**
+		Constructor with base engine.
+
+		@param base Engine for lane 0; lane @c i is @a base jumped
+		@c i times.
+	*/
+	explicit
+	xoshiro256pp_lanes(
+		xoshiro256pp base
+	) noexcept
+		: index(L)
+	{
+		for (std::size_t l = 0; l < L; ++l) {
+			for (std::size_t w = 0; w < 4; ++w) {
+				state[w][l] = base.state[w];
+			}
+			base.jump();
+		}
+	}
+
+	/** Get the next output. */
+	result_type
+	operator()() noexcept {
+		if (index == L) {
+			step(buffer);
+			index = 0;
+		}
+		return buffer[index++];
+	}
+
+	/**
+		Fill an array with outputs.
+
+		@note This produces the same sequence as repeated calls to
+		operator()().
+
+		@param count Number of outputs.
+		@param[out] out Outputs (@a count values).
+	*/
+	void
+	generate(
+		std::size_t const count,
+		result_type* out
+	) noexcept {
+		std::size_t n = count;
+		for (; n > 0 && index < L; --n) {
+			*out++ = buffer[index++];
+		}
+		for (; n >= L; n -= L, out += L) {
+			step(out);
+		}
+		for (; n > 0; --n) {
+			*out++ = (*this)();
+		}
+	}
+
+	/** Skip <code>2^192</code> outputs in every lane. */
+	void
+	long_jump() noexcept {
+		for (std::size_t l = 0; l < L; ++l) {
+			std::uint64_t s[4]{state[0][l], state[1][l], state[2][l], state[3][l]};
+			detail::random::xoshiro256pp_jump(s, detail::random::xoshiro256pp_long_jump_poly);
+			for (std::size_t w = 0; w < 4; ++w) {
+				state[w][l] = s[w];
+			}
+		}
+	}
+};
+
+/**
+	PCG32 engine (XSH-RR variant).
+
+	A small 32-bit generator with a period of <code>2^64</code> and
+	<code>2^63</code> selectable streams. Engines with different
+	streams are independent; advance() skips any number of outputs in
+	logarithmic time.
+*/
+struct pcg32 {
+	/** Output type. */
+	using result_type = std::uint32_t;
+
+	/** Multiplier of the underlying LCG. */
+	static constexpr std::uint64_t const multiplier = 6364136223846793005ULL;
+
+	/** State. */
+	std::uint64_t state;
+	/** Increment (always odd); selects the stream. */
+	std::uint64_t increment;
+
+	/** Smallest output. */
+	static constexpr result_type
+	min() noexcept {
+		return 0u;
+	}
+
+	/** Largest output. */
+	static constexpr result_type
+	max() noexcept {
+		return ~result_type(0);
+	}
+
+	/**
+		Constructor with seed and stream.
+
+		@param seed Seed; any value is valid.
+		@param stream Stream; only the low 63 bits are used.
+	*/
+	explicit
+	pcg32(
+		std::uint64_t const seed = 0x853c49e6748fea9bULL,
+		std::uint64_t const stream = 0xda3e39cb94b95bdbULL >> 1
+	) noexcept
+		: state(0u)
+		, increment((stream << 1) | 1u)
+	{
+		state = state * multiplier + increment;
+		state += seed;
+		state = state * multiplier + increment;
+	}
+
+	/** Get the next output. */
+	result_type
+	operator()() noexcept {
+		std::uint64_t const old = state;
+		state = state * multiplier + increment;
+		std::uint32_t const x = static_cast<std::uint32_t>(
+			((old >> 18) ^ old) >> 27
+		);
+		unsigned const rot = static_cast<unsigned>(old >> 59);
+		return (x >> rot) | (x << ((32u - rot) & 31u));
+	}
+
+	/**
+		Fill an array with outputs.
+
+		@param count Number of outputs.
+		@param[out] out Outputs (@a count values).
+	*/
+	void
+	generate(
+		std::size_t const count,
+		result_type* const out
+	) noexcept {
+		for (std::size_t i = 0; i < count; ++i) {
+			out[i] = (*this)();
+		}
+	}
+
+	/**
+		Skip outputs.
+
+		@param delta Number of outputs to skip; the sequence wraps
+		every <code>2^64</code> outputs, so a "negative" @a delta
+		(two's complement) steps backward.
+	*/
+	void
+	advance(
+		std::uint64_t delta
+	) noexcept {
+		// Brown, "Random number generation with arbitrary strides":
+		// square-and-multiply on the affine map x -> m x + c
+		std::uint64_t m = multiplier, c = increment;
+		std::uint64_t acc_m = 1u, acc_c = 0u;
+		while (delta > 0u) {
+			if (delta & 1u) {
+				acc_m *= m;
+				acc_c = acc_c * m + c;
+			}
+			c = (m + 1u) * c;
+			m *= m;
+			delta >>= 1;
+		}
+		state = acc_m * state + acc_c;
+	}
+
+	/** @copydoc advance() */
+	void
+	discard(
+		std::uint64_t const delta
+	) noexcept {
+		advance(delta);
+	}
+};
+
+/**
+	Philox-4x32-10 engine.
+
+	A counter-based generator: output block @c n is a keyed bijection
+	of @c n, so any position is reachable in constant time with seek()
+	and generate() computes blocks independently (and vectorizes).
+	Engines with different keys, or with different stream words, are
+	independent.
+
+	The counter is 128 bits: the low 64 bits index blocks of four
+	outputs and the high 64 bits hold the stream (so each stream has
+	<code>2^66</code> outputs before it runs into the next).
+*/
+struct philox4x32 {
+	/** Output type. */
+	using result_type = std::uint32_t;
+
+	/** Key. */
+	std::uint32_t key[2];
+	/** Counter of the next block. */
+	std::uint32_t counter[4];
+
+	/** Outputs of the last block. */
+	std::uint32_t buffer[4];
+	/** Index of the next output in @c buffer (4 when empty). */
+	unsigned index;
+
+	/** Smallest output. */
+	static constexpr result_type
+	min() noexcept {
+		return 0u;
+	}
+
+	/** Largest output. */
+	static constexpr result_type
+	max() noexcept {
+		return ~result_type(0);
+	}
+
+	/**
+		Compute one block (the raw counter-based function).
+
+		@param c Counter.
+		@param k Key.
+		@param[out] out Outputs.
+	*/
+	static void
+	block(
+		std::uint32_t const (&c)[4],
+		std::uint32_t const (&k)[2],
+		std::uint32_t (&out)[4]
+	) noexcept {
+		std::uint32_t x[4]{c[0], c[1], c[2], c[3]};
+		std::uint32_t k0 = k[0], k1 = k[1];
+		for (unsigned r = 0; r < 10; ++r) {
+			detail::random::philox4x32_round(x, k0, k1);
+			k0 += 0x9E3779B9u;
+			k1 += 0xBB67AE85u;
+		}
+		out[0] = x[0];
+		out[1] = x[1];
+		out[2] = x[2];
+		out[3] = x[3];
+	}
+
+	/**
+		Constructor with seed and stream.
+
+		@param seed Key.
+		@param stream High 64 bits of the counter.
+	*/
+	explicit
+	philox4x32(
+		std::uint64_t const seed = 0u,
+		std::uint64_t const stream = 0u
+	) noexcept
+		: key{
+			static_cast<std::uint32_t>(seed),
+			static_cast<std::uint32_t>(seed >> 32)
+		}
+		, counter{
+			0u, 0u,
+			static_cast<std::uint32_t>(stream),
+			static_cast<std::uint32_t>(stream >> 32)
+		}
+		, buffer()
+		, index(4u)
+	{}
+
+	/** Get the next output. */
+	result_type
+	operator()() noexcept {
+		if (index == 4u) {
+			block(counter, key, buffer);
+			detail::random::philox_add(counter, 1u);
+			index = 0u;
+		}
+		return buffer[index++];
+	}
+
+	/**
+		Fill an array with outputs.
+
+		@note This produces the same sequence as repeated calls to
+		operator()().
+
+		@param count Number of outputs.
+		@param[out] out Outputs (@a count values).
+	*/
+	void
+	generate(
+		std::size_t const count,
+		result_type* out
+	) noexcept {
+		std::size_t n = count;
+		for (; n > 0 && index < 4u; --n) {
+			*out++ = buffer[index++];
+		}
+		// Full blocks, split where the low half of the counter wraps
+		while (n >= 4u) {
+			std::uint64_t const base = detail::random::philox_low(counter);
+			std::uint64_t blocks = n / 4u;
+			if (base + blocks < base) {
+				blocks = 0u - base;
+			}
+			std::uint32_t const c2 = counter[2], c3 = counter[3];
+			for (std::uint64_t i = 0; i < blocks; ++i) {
+				std::uint64_t const b = base + i;
+				std::uint32_t const c[4]{
+					static_cast<std::uint32_t>(b),
+					static_cast<std::uint32_t>(b >> 32),
+					c2, c3
+				};
+				std::uint32_t x[4];
+				block(c, key, x);
+				out[4 * i + 0] = x[0];
+				out[4 * i + 1] = x[1];
+				out[4 * i + 2] = x[2];
+				out[4 * i + 3] = x[3];
+			}
+			detail::random::philox_add(counter, blocks);
+			out += 4u * blocks;
+			n -= static_cast<std::size_t>(4u * blocks);
+		}
+		for (; n > 0; --n) {
+			*out++ = (*this)();
+		}
+	}
+
+	/**
+		Move to an absolute position in the current stream.
+
+		@param n Output index; the next output is output @a n.
+	*/
+	void
+	seek(
+		std::uint64_t const n
+	) noexcept {
+		counter[0] = static_cast<std::uint32_t>(n >> 2);
+		counter[1] = static_cast<std::uint32_t>(n >> 34);
+		index = 4u;
+		unsigned const skip = static_cast<unsigned>(n & 3u);
+		if (skip != 0u) {
+			(*this)();
+			index = skip;
+		}
+	}
+
+	/**
+		Skip outputs.
+
+		@param n Number of outputs to skip.
+	*/
+	void
+	discard(
+		std::uint64_t const n
+	) noexcept {
+		// Position of the next output in the current stream
+		std::uint64_t const position
+			= (detail::random::philox_low(counter) << 2) - (4u - index)
+		;
+		seek(position + n);
+	}
+};
+
+/** @} */ // end of doc-group random
+
+} // namespace random
+} // namespace am
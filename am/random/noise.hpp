@@ -0,0 +1,944 @@
+/**
+@copyright MIT license; see @ref index or the accompanying LICENSE file.
+
+@file
+@brief Gradient noise over vectors, arrays and grids.
+
+@note The gradient sets and the simplex construction follow Ken
+Perlin's "Improving Noise" (2002) and Stefan Gustavson's "Simplex
+noise demystified" (2005); the simplex kernel radius and falloff
+follow KdotJPG's OpenSimplex2.
+*/
+
+#pragma once
+
+#include "../config.hpp"
+#include "../detail/linear/type_traits.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace am {
+namespace detail {
+namespace random {
+
+/** @cond INTERNAL */
+
+// Lattice points are hashed directly instead of through a permutation
+// table: each coordinate is multiplied by its own odd constant, the
+// products and the seed are XORed together and the result is
+// finalized. Every step is a plain integer operation, so the noise
+// kernels vectorize across points.
+constexpr std::uint32_t const
+lattice_prime[4]{
+	0x8da6b343u, 0xd8163841u, 0xcb1ab31fu, 0x165667b1u
+};
+
+inline std::uint32_t
+lattice_finalize(
+	std::uint32_t h
+) noexcept {
+	h ^= h >> 16;
+	h *= 0x7feb352du;
+	h ^= h >> 15;
+	h *= 0x846ca68bu;
+	h ^= h >> 16;
+	return h;
+}
+
+// Floor to integer without std::floor (valid below 2^31)
+template<
+	class T
+>
+inline std::int32_t
+lattice_floor(
+	T const x
+) noexcept {
+	std::int32_t const i = static_cast<std::int32_t>(x);
+	return i - static_cast<std::int32_t>(x < static_cast<T>(i));
+}
+
+inline std::int32_t
+lattice_sign(
+	std::uint32_t const bit
+) noexcept {
+	return 1 - 2 * static_cast<std::int32_t>(bit & 1u);
+}
+
+// Kernels work on blocks of B points in SoA form; every statement is
+// a loop over the points, so each vectorizes on its own. The single
+// point forms use B = 1.
+
+// Points per block for the array and grid forms; large enough that the
+// point loops are vectorized as loops rather than fully unrolled
+constexpr std::size_t const noise_block = 32u;
+
+// 8 directions: (+-1, +-2) and (+-2, +-1)
+template<
+	std::size_t B,
+	class T
+>
+inline void
+lattice_gradient(
+	std::uint32_t const (&h)[B],
+	T (&g)[2][B]
+) noexcept {
+	for (std::size_t l = 0; l < B; ++l) {
+		std::int32_t const swap = static_cast<std::int32_t>((h[l] >> 2) & 1u);
+		g[0][l] = static_cast<T>(lattice_sign(h[l]) * (1 + swap));
+		g[1][l] = static_cast<T>(lattice_sign(h[l] >> 1) * (2 - swap));
+	}
+}
+
+// The 12 cube edge midpoints (+-1, +-1, 0) (4 of them twice) chosen
+// as in improved Perlin noise, but as a vector
+template<
+	std::size_t B,
+	class T
+>
+inline void
+lattice_gradient(
+	std::uint32_t const (&h)[B],
+	T (&g)[3][B]
+) noexcept {
+	for (std::size_t l = 0; l < B; ++l) {
+		std::uint32_t const b = h[l] & 15u;
+		std::int32_t const su = lattice_sign(b);
+		std::int32_t const sv = lattice_sign(b >> 1);
+		std::int32_t const u_x = b < 8u;
+		std::int32_t const v_y = b < 4u;
+		std::int32_t const v_x = (b == 12u) | (b == 14u);
+		std::int32_t const v_z = 1 - v_y - v_x;
+		g[0][l] = static_cast<T>(su * u_x + sv * v_x);
+		g[1][l] = static_cast<T>(su * (1 - u_x) + sv * v_y);
+		g[2][l] = static_cast<T>(sv * v_z);
+	}
+}
+
+// The 32 directions with one zero and three +-1 components
+template<
+	std::size_t B,
+	class T
+>
+inline void
+lattice_gradient(
+	std::uint32_t const (&h)[B],
+	T (&g)[4][B]
+) noexcept {
+	for (std::uint32_t a = 0; a < 4u; ++a) {
+		for (std::size_t l = 0; l < B; ++l) {
+			std::uint32_t const zero = (h[l] >> 3) & 3u;
+			std::uint32_t const k = a - (a > zero);
+			g[a][l] = static_cast<T>(
+				static_cast<std::int32_t>(a != zero) * lattice_sign(h[l] >> k)
+			);
+		}
+	}
+}
+
+// Scale to roughly [-1, 1] (measured maxima, less a margin)
+template<
+	std::size_t N
+>
+struct noise_scale;
+
+template<>
+struct noise_scale<2> {
+	static constexpr double const perlin = 0.63;
+	static constexpr double const simplex = 43.0;
+};
+
+template<>
+struct noise_scale<3> {
+	static constexpr double const perlin = 0.95;
+	static constexpr double const simplex = 73.0;
+};
+
+template<>
+struct noise_scale<4> {
+	static constexpr double const perlin = 0.87;
+	static constexpr double const simplex = 60.0;
+};
+
+template<
+	std::size_t N,
+	bool Gradient,
+	std::size_t B,
+	class T
+>
+inline void
+perlin_block(
+	T const (&p)[N][B],
+	std::uint32_t const seed,
+	T (&value)[B],
+	T (&grad)[N][B]
+) noexcept {
+	// Fade: 6t^5 - 15t^4 + 10t^3 and its derivative
+	std::uint32_t h0[N][B];
+	T f[N][B];
+	T u[N][B];
+	T du[N][B];
+	for (std::size_t a = 0; a < N; ++a) {
+		for (std::size_t l = 0; l < B; ++l) {
+			std::int32_t const i = lattice_floor(p[a][l]);
+			T const x = p[a][l] - static_cast<T>(i);
+			f[a][l] = x;
+			u[a][l] = x * x * x * (x * (x * T(6) - T(15)) + T(10));
+			du[a][l] = T(30) * x * x * (x - T(1)) * (x - T(1));
+			h0[a][l] = static_cast<std::uint32_t>(i) * lattice_prime[a];
+			grad[a][l] = T(0);
+		}
+	}
+	for (std::size_t l = 0; l < B; ++l) {
+		value[l] = T(0);
+	}
+
+	// Sum over the corners of the fade-weighted gradient ramps
+	for (std::size_t c = 0; c < (std::size_t(1) << N); ++c) {
+		std::uint32_t h[B];
+		for (std::size_t l = 0; l < B; ++l) {
+			h[l] = seed;
+		}
+		for (std::size_t a = 0; a < N; ++a) {
+			std::uint32_t const hi = ((c >> a) & 1u) * lattice_prime[a];
+			for (std::size_t l = 0; l < B; ++l) {
+				h[l] ^= h0[a][l] + hi;
+			}
+		}
+		for (std::size_t l = 0; l < B; ++l) {
+			h[l] = lattice_finalize(h[l]);
+		}
+		T g[N][B];
+		lattice_gradient(h, g);
+
+		T w[N][B];
+		T dot[B];
+		T weight[B];
+		for (std::size_t l = 0; l < B; ++l) {
+			dot[l] = T(0);
+			weight[l] = T(1);
+		}
+		for (std::size_t a = 0; a < N; ++a) {
+			bool const hi = (c >> a) & 1u;
+			T const offset = hi ? T(1) : T(0);
+			for (std::size_t l = 0; l < B; ++l) {
+				w[a][l] = hi ? u[a][l] : T(1) - u[a][l];
+				dot[l] += g[a][l] * (f[a][l] - offset);
+				weight[l] *= w[a][l];
+			}
+		}
+		for (std::size_t l = 0; l < B; ++l) {
+			value[l] += weight[l] * dot[l];
+		}
+		if (Gradient) {
+			for (std::size_t k = 0; k < N; ++k) {
+				T const sign = (c >> k) & 1u ? T(1) : T(-1);
+				T dweight[B];
+				for (std::size_t l = 0; l < B; ++l) {
+					dweight[l] = sign * du[k][l];
+				}
+				for (std::size_t a = 0; a < N; ++a) {
+					if (a != k) {
+						for (std::size_t l = 0; l < B; ++l) {
+							dweight[l] *= w[a][l];
+						}
+					}
+				}
+				for (std::size_t l = 0; l < B; ++l) {
+					grad[k][l] += weight[l] * g[k][l] + dweight[l] * dot[l];
+				}
+			}
+		}
+	}
+
+	T const scale = static_cast<T>(noise_scale<N>::perlin);
+	for (std::size_t l = 0; l < B; ++l) {
+		value[l] *= scale;
+	}
+	for (std::size_t a = 0; a < N; ++a) {
+		for (std::size_t l = 0; l < B; ++l) {
+			grad[a][l] *= scale;
+		}
+	}
+}
+
+// Skew F = (sqrt(N + 1) - 1) / N and unskew G = (1 - 1 / sqrt(N + 1)) / N
+template<
+	std::size_t N
+>
+struct simplex_skew;
+
+template<>
+struct simplex_skew<2> {
+	static constexpr double const F = 0.36602540378443864676;
+	static constexpr double const G = 0.21132486540518711775;
+};
+
+template<>
+struct simplex_skew<3> {
+	static constexpr double const F = 1.0 / 3.0;
+	static constexpr double const G = 1.0 / 6.0;
+};
+
+template<>
+struct simplex_skew<4> {
+	static constexpr double const F = 0.30901699437494742410;
+	static constexpr double const G = 0.13819660112501051518;
+};
+
+template<
+	std::size_t N,
+	bool Gradient,
+	std::size_t B,
+	class T
+>
+inline void
+simplex_block(
+	T const (&p)[N][B],
+	std::uint32_t const seed,
+	T (&value)[B],
+	T (&grad)[N][B]
+) noexcept {
+	T const F = static_cast<T>(simplex_skew<N>::F);
+	T const G = static_cast<T>(simplex_skew<N>::G);
+
+	// Find the containing simplex in the skewed lattice
+	T s[B];
+	T t[B];
+	for (std::size_t l = 0; l < B; ++l) {
+		s[l] = T(0);
+		t[l] = T(0);
+		value[l] = T(0);
+	}
+	for (std::size_t a = 0; a < N; ++a) {
+		for (std::size_t l = 0; l < B; ++l) {
+			s[l] += p[a][l];
+		}
+	}
+	std::int32_t i0[N][B];
+	for (std::size_t a = 0; a < N; ++a) {
+		for (std::size_t l = 0; l < B; ++l) {
+			i0[a][l] = lattice_floor(p[a][l] + s[l] * F);
+			t[l] += static_cast<T>(i0[a][l]);
+		}
+	}
+	T d0[N][B];
+	for (std::size_t a = 0; a < N; ++a) {
+		for (std::size_t l = 0; l < B; ++l) {
+			d0[a][l] = p[a][l] - (static_cast<T>(i0[a][l]) - t[l] * G);
+			grad[a][l] = T(0);
+		}
+	}
+
+	// Vertex k steps once along each of the k axes with the largest
+	// offsets; ties go to the lower axis
+	std::uint32_t rank[N][B];
+	for (std::size_t a = 0; a < N; ++a) {
+		for (std::size_t l = 0; l < B; ++l) {
+			rank[a][l] = 0u;
+		}
+		for (std::size_t b = 0; b < N; ++b) {
+			for (std::size_t l = 0; l < B; ++l) {
+				rank[a][l] += static_cast<std::uint32_t>(
+					(d0[b][l] > d0[a][l]) | ((b < a) & (d0[b][l] == d0[a][l]))
+				);
+			}
+		}
+	}
+
+	// Radially symmetric (0.5 - r^2)^4 kernel around each vertex; the
+	// radius keeps the kernels inside the simplices sharing the vertex
+	for (std::size_t k = 0; k <= N; ++k) {
+		T const kG = static_cast<T>(k) * G;
+		std::uint32_t h[B];
+		T d[N][B];
+		T r2[B];
+		for (std::size_t l = 0; l < B; ++l) {
+			h[l] = seed;
+			r2[l] = T(0);
+		}
+		for (std::size_t a = 0; a < N; ++a) {
+			for (std::size_t l = 0; l < B; ++l) {
+				std::int32_t const step = rank[a][l] < k;
+				h[l] ^= static_cast<std::uint32_t>(i0[a][l] + step) * lattice_prime[a];
+				d[a][l] = d0[a][l] - static_cast<T>(step) + kG;
+				r2[l] += d[a][l] * d[a][l];
+			}
+		}
+		for (std::size_t l = 0; l < B; ++l) {
+			h[l] = lattice_finalize(h[l]);
+		}
+		T g[N][B];
+		lattice_gradient(h, g);
+		T dot[B];
+		for (std::size_t l = 0; l < B; ++l) {
+			dot[l] = T(0);
+		}
+		for (std::size_t a = 0; a < N; ++a) {
+			for (std::size_t l = 0; l < B; ++l) {
+				dot[l] += g[a][l] * d[a][l];
+			}
+		}
+		T r_4[B];
+		T r_3[B];
+		for (std::size_t l = 0; l < B; ++l) {
+			T const r = T(0.5) - r2[l] > T(0) ? T(0.5) - r2[l] : T(0);
+			T const r_2 = r * r;
+			r_4[l] = r_2 * r_2;
+			r_3[l] = T(8) * r_2 * r * dot[l];
+			value[l] += r_4[l] * dot[l];
+		}
+		if (Gradient) {
+			for (std::size_t a = 0; a < N; ++a) {
+				for (std::size_t l = 0; l < B; ++l) {
+					grad[a][l] += r_4[l] * g[a][l] - r_3[l] * d[a][l];
+				}
+			}
+		}
+	}
+
+	T const scale = static_cast<T>(noise_scale<N>::simplex);
+	for (std::size_t l = 0; l < B; ++l) {
+		value[l] *= scale;
+	}
+	for (std::size_t a = 0; a < N; ++a) {
+		for (std::size_t l = 0; l < B; ++l) {
+			grad[a][l] *= scale;
+		}
+	}
+}
+
+template<
+	class V
+>
+struct noise_point {
+	using value_type = detail::linear::value_type<V>;
+	static constexpr std::size_t const size = V::size();
+
+	AM_STATIC_ASSERT(
+		detail::linear::is_vector<V>::value,
+		"V must be a vector type"
+	);
+	AM_STATIC_ASSERT(
+		std::is_floating_point<value_type>::value,
+		"V must have floating-point components"
+	);
+	AM_STATIC_ASSERT(
+		2u <= size && size <= 4u,
+		"V must have 2, 3 or 4 components"
+	);
+};
+
+struct op_perlin {
+	template<std::size_t N, bool Gradient, std::size_t B, class T>
+	static void
+	eval(
+		T const (&p)[N][B],
+		std::uint32_t const seed,
+		T (&value)[B],
+		T (&grad)[N][B]
+	) noexcept {
+		perlin_block<N, Gradient>(p, seed, value, grad);
+	}
+};
+
+struct op_simplex {
+	template<std::size_t N, bool Gradient, std::size_t B, class T>
+	static void
+	eval(
+		T const (&p)[N][B],
+		std::uint32_t const seed,
+		T (&value)[B],
+		T (&grad)[N][B]
+	) noexcept {
+		simplex_block<N, Gradient>(p, seed, value, grad);
+	}
+};
+
+template<
+	class Op,
+	bool Gradient,
+	class V
+>
+inline detail::linear::value_type<V>
+noise_one(
+	V const& point,
+	std::uint32_t const seed,
+	V* const gradient
+) noexcept {
+	using T = typename noise_point<V>::value_type;
+	constexpr std::size_t const N = noise_point<V>::size;
+	T p[N][1];
+	T g[N][1];
+	T value[1];
+	for (std::size_t a = 0; a < N; ++a) {
+		p[a][0] = point[a];
+	}
+	Op::template eval<N, Gradient>(p, seed, value, g);
+	if (Gradient) {
+		for (std::size_t a = 0; a < N; ++a) {
+			(*gradient)[a] = g[a][0];
+		}
+	}
+	return value[0];
+}
+
+// Points are processed a block at a time; a short final block is
+// padded
+template<
+	class Op,
+	bool Gradient,
+	class V
+>
+inline void
+noise_array(
+	std::size_t const count,
+	V const* const points,
+	detail::linear::value_type<V>* const out,
+	V* const gradient,
+	std::uint32_t const seed
+) noexcept {
+	using T = typename noise_point<V>::value_type;
+	constexpr std::size_t const N = noise_point<V>::size;
+	constexpr std::size_t const B = noise_block;
+	for (std::size_t i = 0; i < count; i += B) {
+		std::size_t const n = count - i < B ? count - i : B;
+		T p[N][B];
+		T g[N][B];
+		T value[B];
+		for (std::size_t a = 0; a < N; ++a) {
+			for (std::size_t l = 0; l < B; ++l) {
+				p[a][l] = l < n ? points[i + l][a] : T(0);
+			}
+		}
+		Op::template eval<N, Gradient>(p, seed, value, g);
+		for (std::size_t l = 0; l < n; ++l) {
+			out[i + l] = value[l];
+		}
+		if (Gradient) {
+			for (std::size_t l = 0; l < n; ++l) {
+				for (std::size_t a = 0; a < N; ++a) {
+					gradient[i + l][a] = g[a][l];
+				}
+			}
+		}
+	}
+}
+
+// Rows run along x; the other coordinates are fixed per row
+template<
+	class Op,
+	bool Gradient,
+	class S,
+	class V
+>
+inline void
+noise_grid(
+	S const& size,
+	V const& origin,
+	V const& step,
+	detail::linear::value_type<V>* out,
+	V* gradient,
+	std::uint32_t const seed
+) noexcept {
+	using T = typename noise_point<V>::value_type;
+	constexpr std::size_t const N = noise_point<V>::size;
+	constexpr std::size_t const B = noise_block;
+	AM_STATIC_ASSERT(
+		detail::linear::is_vector<S>::value
+		&& S::size() == N
+		&& std::is_integral<detail::linear::value_type<S>>::value,
+		"S must be an integral vector with as many components as V"
+	);
+	std::size_t rows = 1u;
+	for (std::size_t a = 1; a < N; ++a) {
+		rows *= static_cast<std::size_t>(size[a]);
+	}
+	std::size_t const width = static_cast<std::size_t>(size[0]);
+	for (std::size_t r = 0; r < rows; ++r) {
+		T p[N][B];
+		std::size_t index = r;
+		for (std::size_t a = 1; a < N; ++a) {
+			std::size_t const extent = static_cast<std::size_t>(size[a]);
+			T const x = origin[a] + step[a] * static_cast<T>(index % extent);
+			for (std::size_t l = 0; l < B; ++l) {
+				p[a][l] = x;
+			}
+			index /= extent;
+		}
+		for (std::size_t i = 0; i < width; i += B) {
+			std::size_t const n = width - i < B ? width - i : B;
+			T g[N][B];
+			T value[B];
+			for (std::size_t l = 0; l < B; ++l) {
+				p[0][l] = origin[0] + step[0] * static_cast<T>(
+					static_cast<std::int32_t>(i + l)
+				);
+			}
+			Op::template eval<N, Gradient>(p, seed, value, g);
+			for (std::size_t l = 0; l < n; ++l) {
+				out[i + l] = value[l];
+			}
+			if (Gradient) {
+				for (std::size_t l = 0; l < n; ++l) {
+					for (std::size_t a = 0; a < N; ++a) {
+						gradient[i + l][a] = g[a][l];
+					}
+				}
+			}
+		}
+		out += width;
+		if (Gradient) {
+			gradient += width;
+		}
+	}
+}
+
+/** @endcond */ // INTERNAL
+
+} // namespace random
+} // namespace detail
+
+namespace random {
+
+/**
+	@addtogroup random
+	@{
+*/
+
+/** @name Noise */ /// @{
+
+/**
+	Perlin noise.
+
+	Improved Perlin noise (quintic fade) on the integer lattice.
+	Lattice points are hashed with @a seed, so there is no
+	permutation table and the noise does not repeat.
+
+	@note Coordinates must be less than <code>2^31</code> in
+	magnitude.
+
+	@tparam V Vector type (2, 3 or 4 floating-point components);
+	inferred from @a point.
+	@returns A value in about <code>[-1, 1]</code>; @c 0 at every
+	lattice point.
+	@param point Position.
+	@param seed Seed.
+*/
+template<
+	class V
+>
+inline detail::linear::value_type<V>
+perlin(
+	V const& point,
+	std::uint32_t const seed = 0u
+) noexcept {
+	return detail::random::noise_one<detail::random::op_perlin, false>(
+		point, seed, static_cast<V*>(nullptr)
+	);
+}
+
+/**
+	Perlin noise with gradient.
+
+	@tparam V Vector type; inferred from @a point.
+	@returns The value, as from perlin(V const&, std::uint32_t).
+	@param point Position.
+	@param[out] gradient Analytic gradient at @a point.
+	@param seed Seed.
+*/
+template<
+	class V
+>
+inline detail::linear::value_type<V>
+perlin(
+	V const& point,
+	V& gradient,
+	std::uint32_t const seed = 0u
+) noexcept {
+	return detail::random::noise_one<detail::random::op_perlin, true>(
+		point, seed, &gradient
+	);
+}
+
+/**
+	Simplex noise.
+
+	Gradient noise on the simplex lattice, summing a
+	<code>(0.5 - r^2)^4</code> kernel from each corner of the
+	containing simplex: @c N + 1 corners instead of Perlin's
+	<code>2^N</code>, and no axis-aligned artifacts. The lattice and
+	hashing are as for perlin().
+
+	@tparam V Vector type (2, 3 or 4 floating-point components);
+	inferred from @a point.
+	@returns A value in about <code>[-1, 1]</code>.
+	@param point Position.
+	@param seed Seed.
+*/
+template<
+	class V
+>
+inline detail::linear::value_type<V>
+simplex(
+	V const& point,
+	std::uint32_t const seed = 0u
+) noexcept {
+	return detail::random::noise_one<detail::random::op_simplex, false>(
+		point, seed, static_cast<V*>(nullptr)
+	);
+}
+
+/**
+	Simplex noise with gradient.
+
+	@tparam V Vector type; inferred from @a point.
+	@returns The value, as from simplex(V const&, std::uint32_t).
+	@param point Position.
+	@param[out] gradient Analytic gradient at @a point.
+	@param seed Seed.
+*/
+template<
+	class V
+>
+inline detail::linear::value_type<V>
+simplex(
+	V const& point,
+	V& gradient,
+	std::uint32_t const seed = 0u
+) noexcept {
+	return detail::random::noise_one<detail::random::op_simplex, true>(
+		point, seed, &gradient
+	);
+}
+
+/**
+	Perlin noise over an array of points.
+
+	@tparam V Vector type; inferred from @a points.
+	@param count Number of points.
+	@param points Positions (@a count values).
+	@param[out] out Values (@a count values).
+	@param seed Seed.
+*/
+template<
+	class V
+>
+inline void
+perlin(
+	std::size_t const count,
+	V const* const points,
+	detail::linear::value_type<V>* const out,
+	std::uint32_t const seed = 0u
+) noexcept {
+	detail::random::noise_array<detail::random::op_perlin, false>(
+		count, points, out, static_cast<V*>(nullptr), seed
+	);
+}
+
+/**
+	Perlin noise with gradients over an array of points.
+
+	@tparam V Vector type; inferred from @a points.
+	@param count Number of points.
+	@param points Positions (@a count values).
+	@param[out] out Values (@a count values).
+	@param[out] gradient Gradients (@a count values).
+	@param seed Seed.
+*/
+template<
+	class V
+>
+inline void
+perlin(
+	std::size_t const count,
+	V const* const points,
+	detail::linear::value_type<V>* const out,
+	V* const gradient,
+	std::uint32_t const seed = 0u
+) noexcept {
+	detail::random::noise_array<detail::random::op_perlin, true>(
+		count, points, out, gradient, seed
+	);
+}
+
+/**
+	Simplex noise over an array of points.
+
+	@tparam V Vector type; inferred from @a points.
+	@param count Number of points.
+	@param points Positions (@a count values).
+	@param[out] out Values (@a count values).
+	@param seed Seed.
+*/
+template<
+	class V
+>
+inline void
+simplex(
+	std::size_t const count,
+	V const* const points,
+	detail::linear::value_type<V>* const out,
+	std::uint32_t const seed = 0u
+) noexcept {
+	detail::random::noise_array<detail::random::op_simplex, false>(
+		count, points, out, static_cast<V*>(nullptr), seed
+	);
+}
+
+/**
+	Simplex noise with gradients over an array of points.
+
+	@tparam V Vector type; inferred from @a points.
+	@param count Number of points.
+	@param points Positions (@a count values).
+	@param[out] out Values (@a count values).
+	@param[out] gradient Gradients (@a count values).
+	@param seed Seed.
+*/
+template<
+	class V
+>
+inline void
+simplex(
+	std::size_t const count,
+	V const* const points,
+	detail::linear::value_type<V>* const out,
+	V* const gradient,
+	std::uint32_t const seed = 0u
+) noexcept {
+	detail::random::noise_array<detail::random::op_simplex, true>(
+		count, points, out, gradient, seed
+	);
+}
+
+/**
+	Perlin noise over a regular grid.
+
+	Point <code>(i, j, ...)</code> is at
+	<code>origin + step * (i, j, ...)</code> and its value is stored
+	at <code>i + size.x * (j + size.y * ...)</code> (x fastest).
+
+	@tparam S Integral vector type; inferred from @a size.
+	@tparam V Vector type; inferred from @a origin.
+	@param size Number of points along each axis.
+	@param origin Position of the first point.
+	@param step Spacing along each axis.
+	@param[out] out Values (product of @a size values).
+	@param seed Seed.
+*/
+template<
+	class S,
+	class V
+>
+inline void
+perlin_grid(
+	S const& size,
+	V const& origin,
+	V const& step,
+	detail::linear::value_type<V>* const out,
+	std::uint32_t const seed = 0u
+) noexcept {
+	detail::random::noise_grid<detail::random::op_perlin, false>(
+		size, origin, step, out, static_cast<V*>(nullptr), seed
+	);
+}
+
+/**
+	Perlin noise with gradients over a regular grid.
+
+	@tparam S Integral vector type; inferred from @a size.
+	@tparam V Vector type; inferred from @a origin.
+	@param size Number of points along each axis.
+	@param origin Position of the first point.
+	@param step Spacing along each axis.
+	@param[out] out Values (product of @a size values).
+	@param[out] gradient Gradients (product of @a size values).
+	@param seed Seed.
+*/
+template<
+	class S,
+	class V
+>
+inline void
+perlin_grid(
+	S const& size,
+	V const& origin,
+	V const& step,
+	detail::linear::value_type<V>* const out,
+	V* const gradient,
+	std::uint32_t const seed = 0u
+) noexcept {
+	detail::random::noise_grid<detail::random::op_perlin, true>(
+		size, origin, step, out, gradient, seed
+	);
+}
+
+/**
+	Simplex noise over a regular grid.
+
+	@note See perlin_grid(S const&, V const&, V const&, detail::linear::value_type<V>*, std::uint32_t)
+	for the layout.
+
+	@tparam S Integral vector type; inferred from @a size.
+	@tparam V Vector type; inferred from @a origin.
+	@param size Number of points along each axis.
+	@param origin Position of the first point.
+	@param step Spacing along each axis.
+	@param[out] out Values (product of @a size values).
+	@param seed Seed.
+*/
+template<
+	class S,
+	class V
+>
+inline void
+simplex_grid(
+	S const& size,
+	V const& origin,
+	V const& step,
+	detail::linear::value_type<V>* const out,
+	std::uint32_t const seed = 0u
+) noexcept {
+	detail::random::noise_grid<detail::random::op_simplex, false>(
+		size, origin, step, out, static_cast<V*>(nullptr), seed
+	);
+}
+
+/**
+	Simplex noise with gradients over a regular grid.
+
+	@tparam S Integral vector type; inferred from @a size.
+	@tparam V Vector type; inferred from @a origin.
+	@param size Number of points along each axis.
+	@param origin Position of the first point.
+	@param step Spacing along each axis.
+	@param[out] out Values (product of @a size values).
+	@param[out] gradient Gradients (product of @a size values).
+	@param seed Seed.
+*/
+template<
+	class S,
+	class V
+>
+inline void
+simplex_grid(
+	S const& size,
+	V const& origin,
+	V const& step,
+	detail::linear::value_type<V>* const out,
+	V* const gradient,
+	std::uint32_t const seed = 0u
+) noexcept {
+	detail::random::noise_grid<detail::random::op_simplex, true>(
+		size, origin, step, out, gradient, seed
+	);
+}
+
+/// @}
+
+/** @} */ // end of doc-group random
+
+} // namespace random
+} // namespace am
@@ -45,4 +45,6 @@ precore.make_solution(
 precore.import("general")
 precore.import("vec")
 precore.import("mat")
+precore.import("geometry")
 precore.import("hash")
+precore.import("random")
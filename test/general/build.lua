@@ -2,4 +2,6 @@
 make_tests(
 	"general", {
 	["headers"] = {nil, nil},
+	["memory"] = {nil, nil},
+	["trivial"] = {nil, nil},
 })
@@ -3,9 +3,36 @@
 
 #include <am/config.hpp>
 #include <am/arithmetic_types.hpp>
+#include <am/memory.hpp>
 #include <am/linear/vector.hpp>
 #include <am/linear/matrix.hpp>
+#include <am/linear/eigen.hpp>
+#include <am/linear/decompose.hpp>
+#include <am/linear/factorization.hpp>
+#include <am/linear/transcendental.hpp>
+#include <am/linear/spline.hpp>
+#include <am/linear/strided_span.hpp>
+#include <am/geometry/aabb.hpp>
+#include <am/geometry/sphere.hpp>
+#include <am/geometry/frustum.hpp>
+#include <am/geometry/intersection.hpp>
+#include <am/geometry/predicates.hpp>
+#include <am/geometry/morton.hpp>
 #include <am/hash/fnv.hpp>
+#include <am/hash/bloom.hpp>
+#include <am/hash/crc32c.hpp>
+#include <am/hash/cuckoo_filter.hpp>
+#include <am/hash/flat_map.hpp>
+#include <am/hash/fuse_filter.hpp>
+#include <am/hash/hasher.hpp>
+#include <am/hash/hyperloglog.hpp>
+#include <am/hash/linear.hpp>
+#include <am/hash/murmur.hpp>
+#include <am/hash/siphash.hpp>
+#include <am/hash/xxhash.hpp>
+#include <am/random/engine.hpp>
+#include <am/random/distribution.hpp>
+#include <am/random/noise.hpp>
 
 signed main() {
 	am::linear:: vec1 const a1{1.0};
@@ -0,0 +1,96 @@
+
+#ifndef AM_CONFIG_ALIGN_SIMD
+	#define AM_CONFIG_ALIGN_SIMD
+#endif
+
+#include <am/config.hpp>
+#include <am/memory.hpp>
+#include <am/linear/vector.hpp>
+#include <am/linear/matrix.hpp>
+
+#include "./common.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <new>
+
+using am::linear::vec3;
+using am::linear::vec4;
+using am::linear::mat3x4;
+using am::linear::mat4x4;
+
+static bool
+is_aligned(
+	void const* const p,
+	std::size_t const alignment
+) {
+	return 0 == (reinterpret_cast<std::uintptr_t>(p) & (alignment - 1));
+}
+
+void
+test_types() {
+	static_assert(16 == alignof(vec4), "");
+	static_assert(16 == sizeof(vec4), "");
+	static_assert(32 == alignof(am::detail::linear::tvec4<double>), "");
+	static_assert(16 == alignof(mat4x4) && 64 == sizeof(mat4x4), "");
+	static_assert(16 == alignof(mat3x4), "");
+	static_assert(4 == alignof(vec3), "");
+}
+
+void
+test_allocator() {
+	for (unsigned n = 1; n < 40; n += 3) {
+		am::aligned_vector<mat4x4> matrices(n);
+		fassert(is_aligned(matrices.data(), am::cache_line_size));
+		matrices.back() = mat4x4{2.0f};
+		fassert(matrices.back() == mat4x4{2.0f});
+
+		am::aligned_vector<float, 256> floats(n * 7, 1.0f);
+		fassert(is_aligned(floats.data(), 256));
+	}
+
+	// Rebinding (node-based containers)
+	std::list<vec4, am::aligned_allocator<vec4>> nodes;
+	for (unsigned i = 0; i < 8; ++i) {
+		nodes.emplace_back(static_cast<float>(i));
+		fassert(is_aligned(&nodes.back(), alignof(vec4)));
+	}
+	fassert(am::aligned_allocator<int>{} == am::aligned_allocator<float>{});
+
+	// Sizes that would wrap once the alignment padding is added
+	am::aligned_allocator<char, 64> bytes;
+	std::size_t const sizes[]{
+		std::numeric_limits<std::size_t>::max() - 64u,
+		std::numeric_limits<std::size_t>::max() - 63u - sizeof(void*) + 1u
+	};
+	for (std::size_t const n : sizes) {
+		bool thrown = false;
+		try {
+			bytes.deallocate(bytes.allocate(n), n);
+		} catch (std::bad_alloc const&) {
+			thrown = true;
+		}
+		fassert(thrown);
+	}
+}
+
+void
+test_array() {
+	am::aligned_array<vec4, 5> a;
+	am::aligned_array<float, 3, 128> b{{1.0f, 2.0f, 3.0f}};
+	fassert(is_aligned(&a, am::cache_line_size) && is_aligned(&b, 128));
+	fassert(5 == a.size() && 3 == b.size());
+	float sum = 0.0f;
+	for (float const f : b) {
+		sum += f;
+	}
+	fassert(6.0f == sum && 2.0f == b[1]);
+}
+
+signed main() {
+	test_types();
+	test_allocator();
+	test_array();
+	return 0;
+}
@@ -0,0 +1,149 @@
+
+#ifndef AM_CONFIG_TRIVIAL_DEFAULT_CONSTRUCT
+	#define AM_CONFIG_TRIVIAL_DEFAULT_CONSTRUCT
+#endif
+
+#include <am/config.hpp>
+#include <am/linear/vector.hpp>
+#include <am/linear/matrix.hpp>
+#include <am/memory.hpp>
+
+#include "./common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+using am::linear::vec2;
+using am::linear::vec3;
+using am::linear::vec4;
+using am::linear::mat2x3;
+using am::linear::mat3x3;
+using am::linear::mat4x4;
+
+#define TEST_TRIVIAL(type_)												\
+	static_assert(std::is_trivially_default_constructible<type_>::value, #type_);	\
+	static_assert(std::is_trivially_copyable<type_>::value, #type_)
+
+TEST_TRIVIAL(am::linear::vec1);
+TEST_TRIVIAL(vec2);
+TEST_TRIVIAL(vec3);
+TEST_TRIVIAL(vec4);
+TEST_TRIVIAL(am::linear::ivec3);
+TEST_TRIVIAL(am::linear::mat2x2);
+TEST_TRIVIAL(mat2x3);
+TEST_TRIVIAL(am::linear::mat2x4);
+TEST_TRIVIAL(am::linear::mat3x2);
+TEST_TRIVIAL(mat3x3);
+TEST_TRIVIAL(am::linear::mat3x4);
+TEST_TRIVIAL(am::linear::mat4x2);
+TEST_TRIVIAL(am::linear::mat4x3);
+TEST_TRIVIAL(mat4x4);
+
+void
+test_factories() {
+	fassert(vec3::zero() == (vec3{0.0f, 0.0f, 0.0f}));
+	fassert(vec4::zero() == vec4{0.0f});
+	fassert(mat4x4::identity() == mat4x4{1.0f});
+	fassert(mat4x4::zero() == mat4x4{0.0f});
+	fassert(mat3x3::identity() * (vec3{1.0f, 2.0f, 3.0f}) == (vec3{1.0f, 2.0f, 3.0f}));
+	fassert(mat2x3::identity() == (mat2x3{
+		1.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f
+	}));
+
+	// Value-initialization zeroes
+	fassert(mat4x4{} == mat4x4::zero());
+	fassert(vec2{} == vec2::zero());
+}
+
+// Fills new storage with a byte pattern, to see which elements
+// the container writes
+template<
+	class T
+>
+struct pattern_allocator
+	: public std::allocator<T>
+{
+	template<
+		class U
+	>
+	struct rebind {
+		using other = pattern_allocator<U>;
+	};
+
+	pattern_allocator() = default;
+
+	template<
+		class U
+	>
+	pattern_allocator(
+		pattern_allocator<U> const&
+	) noexcept {}
+
+	T*
+	allocate(
+		std::size_t const n
+	) {
+		T* const p = std::allocator<T>::allocate(n);
+		std::memset(static_cast<void*>(p), 0x7f, n * sizeof(T));
+		return p;
+	}
+};
+
+static bool
+has_pattern(
+	mat4x4 const& m
+) {
+	unsigned char bytes[sizeof(mat4x4)];
+	std::memcpy(bytes, &m, sizeof(mat4x4));
+	for (unsigned char const b : bytes) {
+		if (0x7f != b) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void
+test_bulk() {
+	// Standard containers value-initialize: every element is zeroed
+	std::vector<mat4x4, pattern_allocator<mat4x4>> zeroed(64);
+	fassert(zeroed[0] == mat4x4::zero() && zeroed[63] == mat4x4::zero());
+
+	// Default-initialization skips the write pass, for construction
+	// and resize() alike
+	using allocator_type = am::default_init_allocator<
+		mat4x4, pattern_allocator<mat4x4>
+	>;
+	std::vector<mat4x4, allocator_type> matrices(64);
+	fassert(has_pattern(matrices[0]) && has_pattern(matrices[63]));
+	for (std::size_t i = 0; i < matrices.size(); ++i) {
+		matrices[i] = mat4x4{static_cast<float>(i)};
+	}
+	matrices.resize(128);
+	fassert(matrices[63] == mat4x4{63.0f});
+	fassert(has_pattern(matrices[64]) && has_pattern(matrices[127]));
+
+	// Construction with a value is forwarded
+	matrices.push_back(mat4x4::identity());
+	matrices.resize(160, mat4x4{2.0f});
+	fassert(matrices[128] == mat4x4::identity());
+	fassert(matrices[159] == mat4x4{2.0f});
+
+	// Aligned and default-initialized
+	std::vector<
+		vec4,
+		am::default_init_allocator<vec4, am::aligned_allocator<vec4>>
+	> aligned(17);
+	fassert(0 == (reinterpret_cast<std::uintptr_t>(aligned.data()) & (am::cache_line_size - 1)));
+}
+
+signed main() {
+	test_factories();
+	test_bulk();
+	return 0;
+}
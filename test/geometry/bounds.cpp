@@ -0,0 +1,170 @@
+
+#include <am/config.hpp>
+#include <am/linear/vector.hpp>
+#include <am/linear/matrix.hpp>
+#include <am/geometry/aabb.hpp>
+#include <am/linear/strided_span.hpp>
+#include <am/geometry/sphere.hpp>
+
+#include "./common.hpp"
+
+#include <cstddef>
+#include <vector>
+
+using am::linear::vec3;
+using am::linear::ivec3;
+using am::linear::mat4x4;
+
+void
+test_component_ops() {
+	vec3 const a{1.0f, -2.0f, 3.0f}, b{-1.0f, 2.0f, 0.0f};
+	fassert(am::linear::min(a, b) == (vec3{-1.0f, -2.0f, 0.0f}));
+	fassert(am::linear::max(a, b) == (vec3{1.0f, 2.0f, 3.0f}));
+	fassert(am::linear::min(a, 0.0f) == (vec3{0.0f, -2.0f, 0.0f}));
+	fassert(am::linear::max(a, 0.0f) == (vec3{1.0f, 0.0f, 3.0f}));
+	fassert(am::linear::clamp(a, -1.0f, 1.0f) == (vec3{1.0f, -1.0f, 1.0f}));
+	fassert(am::linear::clamp(a, b, vec3{2.0f}) == (vec3{1.0f, 2.0f, 2.0f}));
+	fassert(am::linear::abs(a) == (vec3{1.0f, 2.0f, 3.0f}));
+	fassert(am::linear::abs(ivec3{-4, 0, 4}) == (ivec3{4, 0, 4}));
+	fassert(
+		am::linear::abs(am::linear::uvec2{4u, 5u}) == (am::linear::uvec2{4u, 5u})
+	);
+	fassert(am::linear::max(am::linear::vec1{2.0f}, 3.0f).x == 3.0f);
+	fassert(
+		am::linear::min(am::linear::vec4{2.0f}, am::linear::vec4{1.0f, 2.0f, 3.0f, 4.0f})
+		== (am::linear::vec4{1.0f, 2.0f, 2.0f, 2.0f})
+	);
+}
+
+void
+test_aabb() {
+	std::vector<vec3> points;
+	for (signed i = 0; i < 103; ++i) {
+		float const f = static_cast<float>(i);
+		points.emplace_back(std::sin(f) * 5.0f, f * 0.25f - 3.0f, std::cos(f * 3.0f));
+	}
+	points[17] = vec3{-7.0f, 0.0f, 0.0f};
+	points[102] = vec3{0.0f, 0.0f, 9.0f};
+
+	auto const box = am::geometry::aabb_of(points.size(), points.data());
+	fassert(box.min.x == -7.0f);
+	fassert(box.max.z == 9.0f);
+	fassert(box.min.y == -3.0f);
+	for (auto const& p : points) {
+		fassert(am::linear::min(p, box.min) == box.min);
+		fassert(am::linear::max(p, box.max) == box.max);
+	}
+
+	// Partial results merge to the whole
+	auto const a = am::geometry::aabb_of(50, points.data());
+	auto const b = am::geometry::aabb_of(points.size() - 50, points.data() + 50);
+	auto const merged = am::geometry::aabb_merge(a, b);
+	fassert(merged.min == box.min && merged.max == box.max);
+
+	auto const empty = am::geometry::aabb_of<vec3>(0, nullptr);
+	fassert(empty.min.x > empty.max.x);
+
+	// Transform (Arvo) matches transforming all corners
+	mat4x4 m{
+		0.0f, 1.0f, 0.0f, 0.0f,
+		-2.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 0.5f, 0.0f,
+		10.0f, 20.0f, 30.0f, 1.0f
+	};
+	am::geometry::aabb<vec3> const unit{vec3{-1.0f, 0.0f, 2.0f}, vec3{1.0f, 3.0f, 4.0f}};
+	auto const t = am::geometry::aabb_transform(unit, m);
+	auto expected = am::geometry::aabb_empty<vec3>();
+	for (unsigned c = 0; c < 8; ++c) {
+		vec3 const corner{
+			(c & 1) ? unit.max.x : unit.min.x,
+			(c & 2) ? unit.max.y : unit.min.y,
+			(c & 4) ? unit.max.z : unit.min.z
+		};
+		vec3 const p{m * am::linear::vec4{corner, 1.0f}};
+		expected.min = am::linear::min(expected.min, p);
+		expected.max = am::linear::max(expected.max, p);
+	}
+	fassert(vec_near(t.min, expected.min));
+	fassert(vec_near(t.max, expected.max));
+}
+
+void
+test_sphere() {
+	std::vector<vec3> points;
+	for (signed i = 0; i < 1000; ++i) {
+		float const f = static_cast<float>(i);
+		points.emplace_back(std::sin(f * 0.7f) * 3.0f, std::cos(f * 1.3f), std::sin(f * 0.1f) * 2.0f);
+	}
+	auto const s = am::geometry::bounding_sphere(points.size(), points.data());
+	for (auto const& p : points) {
+		fassert(am::linear::distance(p, s.center) <= s.radius * 1.0001f);
+	}
+	// Loose bound against the radius of the enclosing box
+	fassert(s.radius < 3.7f);
+
+	vec3 const one{1.0f, 2.0f, 3.0f};
+	auto const single = am::geometry::bounding_sphere(1, &one);
+	fassert(single.center == one && single.radius == 0.0f);
+}
+
+// Interleaved vertex buffer with a 32-byte stride
+struct Vertex {
+	float position[3];
+	float normal[3];
+	float uv[2];
+};
+
+void
+test_views() {
+	std::vector<Vertex> vertices(37);
+	std::vector<vec3> positions;
+	for (std::size_t i = 0; i < vertices.size(); ++i) {
+		float const f = static_cast<float>(i);
+		Vertex& v = vertices[i];
+		v.position[0] = std::sin(f * 0.9f) * 4.0f;
+		v.position[1] = std::cos(f * 0.4f);
+		v.position[2] = f * 0.25f - 2.0f;
+		v.normal[0] = v.normal[1] = v.normal[2] = -100.0f;
+		v.uv[0] = v.uv[1] = 100.0f;
+		positions.emplace_back(v.position[0], v.position[1], v.position[2]);
+	}
+
+	am::linear::vec_view<vec3> const strided{
+		vertices.data(), vertices.size(), sizeof(Vertex)
+	};
+	fassert(!strided.is_contiguous() && strided.size() == vertices.size());
+	fassert(strided[5] == positions[5]);
+	fassert(strided.subspan(3, 4)[1] == positions[4]);
+
+	am::linear::vec_view<vec3> const packed{positions.data(), positions.size()};
+	fassert(packed.is_contiguous());
+
+	auto const a = am::geometry::aabb_of(positions.size(), positions.data());
+	auto const b = am::geometry::aabb_of(strided);
+	auto const c = am::geometry::aabb_of(packed);
+	fassert(a.min == b.min && a.max == b.max);
+	fassert(a.min == c.min && a.max == c.max);
+
+	auto const s = am::geometry::bounding_sphere(positions.size(), positions.data());
+	auto const t = am::geometry::bounding_sphere(strided);
+	fassert(s.center == t.center && s.radius == t.radius);
+	fassert(am::geometry::aabb_of(am::linear::vec_view<vec3>{}).min.x > 0.0f);
+
+	// Writes go through to the buffer
+	am::linear::strided_span<vec3> const normals{
+		&vertices[0].normal, vertices.size(), sizeof(Vertex)
+	};
+	normals.set(2, vec3{0.0f, 1.0f, 0.0f});
+	fassert(vertices[2].normal[1] == 1.0f && vertices[2].uv[0] == 100.0f);
+	fassert(vertices[1].normal[1] == -100.0f);
+	am::linear::vec_view<vec3> const normals_view{normals};
+	fassert(normals_view[2] == (vec3{0.0f, 1.0f, 0.0f}));
+}
+
+signed main() {
+	test_component_ops();
+	test_aabb();
+	test_sphere();
+	test_views();
+	return 0;
+}
@@ -0,0 +1,9 @@
+
+make_tests(
+	"geometry", {
+	["bounds"] = {nil, nil},
+	["frustum"] = {nil, nil},
+	["intersection"] = {nil, nil},
+	["morton"] = {nil, nil},
+	["predicates"] = {nil, nil},
+})
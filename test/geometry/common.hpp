@@ -0,0 +1,23 @@
+
+#pragma once
+
+#include "../general/common.hpp"
+
+#include <am/linear/vector.hpp>
+
+#include <cmath>
+
+template<class Cons>
+inline bool
+vec_near(
+	Cons const& a,
+	Cons const& b,
+	typename Cons::value_type const eps = 1e-4f
+) {
+	for (std::size_t i = 0; i < Cons::size(); ++i) {
+		if (std::abs(a[i] - b[i]) > eps) {
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,161 @@
+
+#include <am/config.hpp>
+#include <am/linear/vector.hpp>
+#include <am/linear/matrix.hpp>
+#include <am/geometry/frustum.hpp>
+
+#include "./common.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using am::linear::vec3;
+using am::linear::mat4x4;
+
+// OpenGL-style perspective projection
+static mat4x4
+perspective(
+	float const fovy,
+	float const aspect,
+	float const znear,
+	float const zfar
+) {
+	float const f = 1.0f / std::tan(fovy * 0.5f);
+	return mat4x4{
+		f / aspect, 0.0f, 0.0f, 0.0f,
+		0.0f, f, 0.0f, 0.0f,
+		0.0f, 0.0f, (zfar + znear) / (znear - zfar), -1.0f,
+		0.0f, 0.0f, (2.0f * zfar * znear) / (znear - zfar), 0.0f
+	};
+}
+
+static bool
+bit(
+	std::vector<std::uint64_t> const& mask,
+	std::size_t const i
+) {
+	return (mask[i >> 6] >> (i & 63)) & 1u;
+}
+
+void
+test_planes() {
+	using am::geometry::frustum_planes;
+	auto const f = frustum_planes(perspective(1.5707964f, 1.0f, 1.0f, 100.0f));
+	// Camera looks down -Z; near plane at z = -1, far at z = -100
+	fassert(vec_near(f.planes[am::geometry::FP_NEAR], am::linear::vec4{0.0f, 0.0f, -1.0f, -1.0f}));
+	fassert(vec_near(f.planes[am::geometry::FP_FAR], am::linear::vec4{0.0f, 0.0f, 1.0f, 100.0f}, 1e-3f));
+	float const h = std::sqrt(0.5f);
+	fassert(vec_near(f.planes[am::geometry::FP_LEFT], am::linear::vec4{h, 0.0f, -h, 0.0f}));
+	fassert(vec_near(f.planes[am::geometry::FP_TOP], am::linear::vec4{0.0f, -h, -h, 0.0f}));
+
+	// Zero-to-one depth only changes the near plane
+	mat4x4 p = perspective(1.0f, 1.5f, 0.5f, 50.0f);
+	mat4x4 const remap{
+		1.0f, 0.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 0.5f, 0.0f,
+		0.0f, 0.0f, 0.5f, 1.0f
+	};
+	auto const g = frustum_planes(p);
+	auto const d = frustum_planes(remap * p, am::geometry::ClipDepth::zero_to_one);
+	for (unsigned k = 0; k < am::geometry::FP_COUNT; ++k) {
+		fassert(vec_near(g.planes[k], d.planes[k], 1e-3f));
+	}
+}
+
+void
+test_cull() {
+	using am::geometry::sphere;
+	using am::geometry::aabb;
+	auto const f = am::geometry::frustum_planes(
+		perspective(1.2f, 1.0f, 0.1f, 50.0f)
+	);
+
+	std::size_t const count = 1000;
+	std::vector<sphere<vec3>> spheres;
+	std::vector<aabb<vec3>> boxes;
+	std::vector<float> x, y, z, r, ex, ey, ez;
+	for (std::size_t i = 0; i < count; ++i) {
+		float const t = static_cast<float>(i);
+		vec3 const c{
+			std::sin(t * 0.37f) * 40.0f,
+			std::cos(t * 0.11f) * 40.0f,
+			std::sin(t * 0.07f) * 60.0f
+		};
+		float const radius = 0.5f + std::abs(std::sin(t)) * 3.0f;
+		spheres.push_back(sphere<vec3>{c, radius});
+		boxes.push_back(aabb<vec3>{c - radius, c + radius});
+		x.push_back(c.x); y.push_back(c.y); z.push_back(c.z); r.push_back(radius);
+		ex.push_back(radius); ey.push_back(radius); ez.push_back(radius);
+	}
+
+	std::size_t const words = (count + 63) / 64;
+	std::vector<std::uint64_t> m0(words), m1(words), m2(words), m3(words);
+	am::geometry::frustum_cull_spheres(f, count, x.data(), y.data(), z.data(), r.data(), m0.data());
+	am::geometry::frustum_cull_spheres(f, count, spheres.data(), m1.data());
+	am::geometry::frustum_cull_aabbs(
+		f, count, x.data(), y.data(), z.data(), ex.data(), ey.data(), ez.data(), m2.data()
+	);
+	am::geometry::frustum_cull_aabbs(f, count, boxes.data(), m3.data());
+
+	std::size_t visible = 0;
+	for (std::size_t i = 0; i < count; ++i) {
+		bool const s = am::geometry::frustum_intersects(f, spheres[i]);
+		bool const b = am::geometry::frustum_intersects(f, boxes[i]);
+		fassert(bit(m0, i) == s);
+		fassert(bit(m1, i) == s);
+		fassert(bit(m2, i) == b);
+		fassert(bit(m3, i) == b);
+		// A box enclosing the sphere is at least as visible
+		fassert(!s || b);
+		visible += s;
+	}
+	// Not degenerate either way
+	fassert(0 < visible && count > visible);
+	// Bits past the end are clear
+	fassert(0 == (m0[words - 1] >> (count & 63)));
+
+	// Views: contiguous, and interleaved in a record
+	struct Object {
+		sphere<vec3> bound_sphere;
+		aabb<vec3> bound_box;
+		unsigned id;
+	};
+	std::vector<Object> objects;
+	for (std::size_t i = 0; i < count; ++i) {
+		objects.push_back(Object{spheres[i], boxes[i], static_cast<unsigned>(i)});
+	}
+	std::vector<std::uint64_t> v0(words), v1(words), v2(words), v3(words);
+	am::geometry::frustum_cull_spheres(
+		f, am::linear::strided_span<sphere<vec3> const>{spheres.data(), count}, v0.data()
+	);
+	am::geometry::frustum_cull_spheres(
+		f, am::linear::strided_span<sphere<vec3> const>{
+			reinterpret_cast<unsigned char const*>(objects.data()) + offsetof(Object, bound_sphere),
+			count, sizeof(Object)
+		}, v1.data()
+	);
+	am::geometry::frustum_cull_aabbs(
+		f, am::linear::strided_span<aabb<vec3> const>{boxes.data(), count}, v2.data()
+	);
+	am::geometry::frustum_cull_aabbs(
+		f, am::linear::strided_span<aabb<vec3> const>{
+			reinterpret_cast<unsigned char const*>(objects.data()) + offsetof(Object, bound_box),
+			count, sizeof(Object)
+		}, v3.data()
+	);
+	fassert(v0 == m1 && v1 == m1);
+	fassert(v2 == m3 && v3 == m3);
+
+	// Obvious cases
+	fassert(am::geometry::frustum_intersects(f, sphere<vec3>{vec3{0.0f, 0.0f, -10.0f}, 1.0f}));
+	fassert(!am::geometry::frustum_intersects(f, sphere<vec3>{vec3{0.0f, 0.0f, 10.0f}, 1.0f}));
+	fassert(!am::geometry::frustum_intersects(f, sphere<vec3>{vec3{0.0f, 0.0f, -60.0f}, 1.0f}));
+}
+
+signed main() {
+	test_planes();
+	test_cull();
+	return 0;
+}
@@ -0,0 +1,141 @@
+
+#include <am/config.hpp>
+#include <am/linear/vector.hpp>
+#include <am/geometry/intersection.hpp>
+
+#include "./common.hpp"
+
+#include <limits>
+
+using am::linear::vec3;
+using ray = am::geometry::ray<float>;
+using aabb = am::geometry::aabb<vec3>;
+
+static float const INF = std::numeric_limits<float>::infinity();
+
+static ray
+make_ray(
+	unsigned const i
+) {
+	float const f = static_cast<float>(i);
+	return ray{
+		vec3{std::sin(f * 1.3f) * 0.2f, std::cos(f * 0.7f) * 0.2f, 5.0f},
+		am::linear::normalize(vec3{
+			std::sin(f * 0.37f) * 0.4f, std::cos(f * 0.91f) * 0.4f, -1.0f
+		})
+	};
+}
+
+void
+test_single() {
+	vec3 const v0{-1.0f, -1.0f, 0.0f}, v1{1.0f, -1.0f, 0.0f}, v2{0.0f, 1.0f, 0.0f};
+	float t = INF, u = -1.0f, v = -1.0f;
+	ray const down{vec3{0.0f, 0.0f, 2.0f}, vec3{0.0f, 0.0f, -1.0f}};
+	fassert(am::geometry::intersect_triangle(down, v0, v1, v2, t, u, v));
+	fassert(std::abs(t - 2.0f) < 1e-6f);
+	fassert(std::abs(u - 0.25f) < 1e-6f && std::abs(v - 0.5f) < 1e-6f);
+	// Farther than the current hit
+	t = 1.0f;
+	fassert(!am::geometry::intersect_triangle(down, v0, v1, v2, t, u, v));
+	fassert(1.0f == t);
+	// Pointing away, parallel, and outside
+	t = INF;
+	ray const up{vec3{0.0f, 0.0f, 2.0f}, vec3{0.0f, 0.0f, 1.0f}};
+	fassert(!am::geometry::intersect_triangle(up, v0, v1, v2, t, u, v));
+	ray const side{vec3{0.0f, 0.0f, 0.0f}, vec3{1.0f, 0.0f, 0.0f}};
+	fassert(!am::geometry::intersect_triangle(side, v0, v1, v2, t, u, v));
+	ray const miss{vec3{2.0f, 2.0f, 2.0f}, vec3{0.0f, 0.0f, -1.0f}};
+	fassert(!am::geometry::intersect_triangle(miss, v0, v1, v2, t, u, v));
+
+	aabb const box{vec3{-1.0f}, vec3{1.0f}};
+	t = INF;
+	fassert(am::geometry::intersect_aabb(down, am::geometry::inverse_direction(down), box, t));
+	fassert(std::abs(t - 1.0f) < 1e-6f);
+	t = INF;
+	fassert(!am::geometry::intersect_aabb(up, am::geometry::inverse_direction(up), box, t));
+	// Axis-parallel ray outside a slab
+	t = INF;
+	fassert(!am::geometry::intersect_aabb(miss, am::geometry::inverse_direction(miss), box, t));
+	// Origin inside
+	t = INF;
+	fassert(am::geometry::intersect_aabb(side, am::geometry::inverse_direction(side), box, t));
+	fassert(0.0f == t);
+}
+
+template<unsigned N>
+void
+test_packets() {
+	vec3 const v0{-1.0f, -1.0f, 0.0f}, v1{1.0f, -1.0f, 0.5f}, v2{0.0f, 1.0f, 0.0f};
+	aabb const box{vec3{-0.5f, -0.5f, -1.0f}, vec3{0.5f, 0.5f, 1.0f}};
+
+	for (unsigned base = 0; base < 64; base += N) {
+		am::geometry::ray_packet<float, N> p;
+		float inv_x[N], inv_y[N], inv_z[N];
+		for (unsigned i = 0; i < N; ++i) {
+			ray const r = make_ray(base + i);
+			vec3 const inv = am::geometry::inverse_direction(r);
+			p.ox[i] = r.origin.x; p.oy[i] = r.origin.y; p.oz[i] = r.origin.z;
+			p.dx[i] = r.direction.x; p.dy[i] = r.direction.y; p.dz[i] = r.direction.z;
+			inv_x[i] = inv.x; inv_y[i] = inv.y; inv_z[i] = inv.z;
+		}
+
+		float t[N], u[N], v[N], tb[N];
+		for (unsigned i = 0; i < N; ++i) {
+			t[i] = tb[i] = INF;
+			u[i] = v[i] = 0.0f;
+		}
+		unsigned const tri_mask = am::geometry::intersect_triangle(p, v0, v1, v2, t, u, v);
+		unsigned const box_mask = am::geometry::intersect_aabb(p, inv_x, inv_y, inv_z, box, tb);
+		for (unsigned i = 0; i < N; ++i) {
+			ray const r = make_ray(base + i);
+			float st = INF, su = 0.0f, sv = 0.0f;
+			bool const hit = am::geometry::intersect_triangle(r, v0, v1, v2, st, su, sv);
+			fassert(hit == bool(tri_mask & (1u << i)));
+			if (hit) {
+				fassert(std::abs(st - t[i]) < 1e-5f);
+				fassert(std::abs(su - u[i]) < 1e-5f && std::abs(sv - v[i]) < 1e-5f);
+			}
+			float sb = INF;
+			bool const bhit = am::geometry::intersect_aabb(
+				r, am::geometry::inverse_direction(r), box, sb
+			);
+			fassert(bhit == bool(box_mask & (1u << i)));
+			if (bhit) {
+				fassert(std::abs(sb - tb[i]) < 1e-5f);
+			}
+		}
+	}
+
+	// One ray against a packet of primitives
+	am::geometry::triangle_packet<float, N> tris;
+	am::geometry::aabb_packet<float, N> boxes;
+	for (unsigned i = 0; i < N; ++i) {
+		vec3 const off{0.0f, 0.0f, -static_cast<float>(i)};
+		tris.set(i, v0 + off, v1 + off, v2 + off);
+		boxes.set(i, aabb{box.min + off, box.max + off});
+	}
+	ray const r{vec3{0.1f, 0.1f, 3.0f}, vec3{0.0f, 0.0f, -1.0f}};
+	float t = INF, u = 0.0f, v = 0.0f;
+	unsigned const mask = am::geometry::intersect_triangle(r, tris, t, u, v);
+	fassert(mask & 1u);
+	float st = INF, su = 0.0f, sv = 0.0f;
+	am::geometry::intersect_triangle(r, v0, v1, v2, st, su, sv);
+	fassert(std::abs(t - st) < 1e-6f);
+
+	float enter[N];
+	unsigned const bmask = am::geometry::intersect_aabb(
+		r, am::geometry::inverse_direction(r), boxes, INF, enter
+	);
+	fassert(((1u << N) - 1u) == bmask);
+	fassert(std::abs(enter[0] - 2.0f) < 1e-6f);
+	fassert(0 == am::geometry::intersect_aabb(
+		r, am::geometry::inverse_direction(r), boxes, 1.0f, enter
+	));
+}
+
+signed main() {
+	test_single();
+	test_packets<4>();
+	test_packets<8>();
+	return 0;
+}
@@ -0,0 +1,187 @@
+
+#include <am/config.hpp>
+#include <am/linear/vector.hpp>
+#include <am/geometry/morton.hpp>
+
+#include "./common.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using am::linear::uvec2;
+using am::linear::uvec3;
+using u64vec2 = am::detail::linear::tvec2<std::uint64_t>;
+
+namespace geometry = am::geometry;
+namespace detail = am::detail::geometry;
+
+static std::uint64_t
+lcg(
+	std::uint64_t& s
+) {
+	s = s * 6364136223846793005ULL + 1442695040888963407ULL;
+	return s >> 16;
+}
+
+// Bit-by-bit reference
+template<class Code, class V>
+static Code
+morton_reference(
+	V const& v,
+	unsigned const bits
+) {
+	Code code = 0u;
+	for (unsigned b = 0; b < bits; ++b) {
+		for (std::size_t a = 0; a < V::size(); ++a) {
+			code |= static_cast<Code>((static_cast<Code>(v[a]) >> b) & 1u) << (b * V::size() + a);
+		}
+	}
+	return code;
+}
+
+template<class Code, class V>
+static void
+check_morton(
+	unsigned const bits
+) {
+	using T = typename V::value_type;
+	std::uint64_t s = 1;
+	T const mask = static_cast<T>((std::uint64_t(1) << bits) - 1u);
+	std::vector<V> points(1000), decoded(1000);
+	std::vector<Code> codes(1000), hcodes(1000);
+	for (auto& p : points) {
+		for (std::size_t a = 0; a < V::size(); ++a) {
+			p[a] = static_cast<T>(lcg(s));
+		}
+		Code const code = geometry::morton_encode<Code>(p);
+		fassert(code == morton_reference<Code>(p, bits));
+		V const q = geometry::morton_decode<V>(code);
+		V h = geometry::hilbert_decode<V>(geometry::hilbert_encode<Code>(p));
+		for (std::size_t a = 0; a < V::size(); ++a) {
+			fassert(q[a] == (p[a] & mask));
+			fassert(h[a] == (p[a] & mask));
+		}
+	}
+	fassert(geometry::morton_encode<Code>(V{mask}) == ~Code(0) >> (sizeof(Code) * 8 - bits * V::size()));
+
+	geometry::morton_encode(points.size(), points.data(), codes.data());
+	geometry::hilbert_encode(points.size(), points.data(), hcodes.data());
+	for (std::size_t i = 0; i < points.size(); ++i) {
+		fassert(codes[i] == geometry::morton_encode<Code>(points[i]));
+		fassert(hcodes[i] == geometry::hilbert_encode<Code>(points[i]));
+	}
+	geometry::morton_decode(codes.size(), codes.data(), decoded.data());
+	for (std::size_t i = 0; i < points.size(); ++i) {
+		fassert(decoded[i] == geometry::morton_decode<V>(codes[i]));
+	}
+	geometry::hilbert_decode(hcodes.size(), hcodes.data(), decoded.data());
+	for (std::size_t i = 0; i < points.size(); ++i) {
+		fassert(decoded[i] == geometry::hilbert_decode<V>(hcodes[i]));
+	}
+}
+
+// The shift-and-mask forms against the default forms (pdep/pext when
+// BMI2 is available)
+template<class Code, class V>
+static void
+check_portable() {
+	using T = typename V::value_type;
+	constexpr std::size_t const B = detail::hilbert_block;
+	std::uint64_t s = 7;
+	V points[B], decoded[B], portable[B];
+	Code codes[B], hcodes[B], portable_codes[B];
+	for (unsigned r = 0; r < 100; ++r) {
+		for (auto& p : points) {
+			for (std::size_t a = 0; a < V::size(); ++a) {
+				p[a] = static_cast<T>(lcg(s));
+			}
+		}
+		for (std::size_t i = 0; i < B; ++i) {
+			codes[i] = detail::morton_encode_impl<Code, false>(points[i]);
+			fassert((codes[i] == detail::morton_encode_impl<Code, true>(points[i])));
+			// Unmasked codes exercise the high bits as well
+			Code const raw = static_cast<Code>(lcg(s) ^ (lcg(s) << 32));
+			detail::morton_decode_impl<false>(raw, decoded[i]);
+			detail::morton_decode_impl<true>(raw, portable[i]);
+			fassert(decoded[i] == portable[i]);
+		}
+		detail::hilbert_encode_block<Code, false, B>(points, B, hcodes);
+		detail::hilbert_encode_block<Code, true, B>(points, B, portable_codes);
+		for (std::size_t i = 0; i < B; ++i) {
+			fassert(hcodes[i] == portable_codes[i]);
+		}
+		detail::hilbert_decode_block<false, B>(codes, B, decoded);
+		detail::hilbert_decode_block<true, B>(codes, B, portable);
+		for (std::size_t i = 0; i < B; ++i) {
+			fassert(decoded[i] == portable[i]);
+		}
+	}
+}
+
+// Consecutive Hilbert codes are neighboring cells
+template<class Code, class V>
+static void
+check_hilbert_walk(
+	Code const first,
+	Code const count
+) {
+	V prev = geometry::hilbert_decode<V>(first);
+	fassert(geometry::hilbert_encode<Code>(prev) == first);
+	for (Code c = first + 1u; c != first + count; ++c) {
+		V const p = geometry::hilbert_decode<V>(c);
+		fassert(geometry::hilbert_encode<Code>(p) == c);
+		std::uint64_t distance = 0;
+		for (std::size_t a = 0; a < V::size(); ++a) {
+			distance += p[a] > prev[a] ? p[a] - prev[a] : prev[a] - p[a];
+		}
+		fassert(distance == 1u);
+		prev = p;
+	}
+}
+
+void
+test_morton() {
+	fassert(geometry::morton_encode<std::uint32_t>(uvec2{1u, 0u}) == 1u);
+	fassert(geometry::morton_encode<std::uint32_t>(uvec2{0u, 1u}) == 2u);
+	fassert(geometry::morton_encode<std::uint32_t>(uvec2{3u, 5u}) == 0x27u);
+	fassert(geometry::morton_encode<std::uint64_t>(uvec3{0u, 0u, 1u}) == 4u);
+	fassert(geometry::morton_encode<std::uint64_t>(uvec3{1u, 2u, 4u}) == 0x111u);
+	fassert(geometry::morton_decode<uvec3>(std::uint32_t(0x111u)) == (uvec3{1u, 2u, 4u}));
+
+	check_morton<std::uint32_t, uvec2>(16);
+	check_morton<std::uint64_t, uvec2>(32);
+	check_morton<std::uint32_t, uvec3>(10);
+	check_morton<std::uint64_t, uvec3>(21);
+	check_morton<std::uint64_t, u64vec2>(32);
+
+	check_portable<std::uint32_t, uvec2>();
+	check_portable<std::uint64_t, uvec2>();
+	check_portable<std::uint32_t, uvec3>();
+	check_portable<std::uint64_t, uvec3>();
+	check_portable<std::uint64_t, u64vec2>();
+}
+
+void
+test_hilbert() {
+	// The first cells of the 2D curve
+	uvec2 const walk[]{
+		uvec2{0u, 0u}, uvec2{1u, 0u}, uvec2{1u, 1u}, uvec2{0u, 1u}
+	};
+	for (std::uint32_t c = 0; c < 4u; ++c) {
+		uvec2 const p = geometry::hilbert_decode<uvec2>(c);
+		fassert(p == walk[c] || p == (uvec2{walk[c].y, walk[c].x}));
+	}
+
+	check_hilbert_walk<std::uint32_t, uvec2>(0u, 70000u);
+	check_hilbert_walk<std::uint32_t, uvec3>(0u, 70000u);
+	check_hilbert_walk<std::uint64_t, uvec2>(0x0123456789abcdefULL, 70000u);
+	check_hilbert_walk<std::uint64_t, uvec3>(0x0123456789abcdeULL, 70000u);
+	check_hilbert_walk<std::uint32_t, uvec3>(0x3fff0000u, 0xffffu);
+}
+
+signed main() {
+	test_morton();
+	test_hilbert();
+	return 0;
+}
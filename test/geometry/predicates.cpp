@@ -0,0 +1,134 @@
+
+#include <am/config.hpp>
+#include <am/linear/vector.hpp>
+#include <am/geometry/predicates.hpp>
+
+#include "./common.hpp"
+
+#include <cmath>
+#include <limits>
+
+using dvec2 = am::detail::linear::tvec2<double>;
+using dvec3 = am::detail::linear::tvec3<double>;
+
+static int
+sign(
+	double const x
+) {
+	return (x > 0.0) - (x < 0.0);
+}
+
+static double
+step(
+	double x,
+	int n
+) {
+	for (; n > 0; --n) {
+		x = std::nextafter(x, 1e300);
+	}
+	for (; n < 0; ++n) {
+		x = std::nextafter(x, -1e300);
+	}
+	return x;
+}
+
+static double
+plain_orient2d(
+	dvec2 const& a,
+	dvec2 const& b,
+	dvec2 const& c
+) {
+	return (a.x - c.x) * (b.y - c.y) - (a.y - c.y) * (b.x - c.x);
+}
+
+void
+test_orient2d() {
+	dvec2 const a{0.0, 0.0}, b{1.0, 0.0}, c{0.0, 1.0};
+	fassert(am::geometry::orient2d(a, b, c) > 0.0);
+	fassert(am::geometry::orient2d(a, c, b) < 0.0);
+	fassert(am::geometry::orient2d(a, b, dvec2{2.0, 0.0}) == 0.0);
+
+	// Points a few ulps off the line y = x; the exact sign is
+	// sign(j - i), which the plain determinant gets wrong for many
+	unsigned naive_wrong = 0;
+	dvec2 const q{12.0, 12.0}, r{24.0, 24.0};
+	for (int i = 0; i < 64; ++i) {
+	for (int j = 0; j < 64; ++j) {
+		dvec2 const p{step(0.5, i), step(0.5, j)};
+		fassert(sign(am::geometry::orient2d(p, q, r)) == sign(j - i));
+		naive_wrong += sign(plain_orient2d(p, q, r)) != sign(j - i);
+	}}
+	fassert(0 < naive_wrong);
+
+	// The exact path agrees with well-conditioned inputs
+	for (unsigned i = 0; i < 256; ++i) {
+		double const f = static_cast<double>(i);
+		dvec2 const u{std::sin(f), std::cos(f * 1.7)};
+		dvec2 const v{std::sin(f * 2.3), std::cos(f * 0.3)};
+		dvec2 const w{std::sin(f * 0.7), std::cos(f * 3.1)};
+		double const det = plain_orient2d(u, v, w);
+		if (std::abs(det) > 1e-6) {
+			fassert(sign(am::detail::geometry::orient2d_exact(
+				u.x, u.y, v.x, v.y, w.x, w.y
+			)) == sign(det));
+		}
+	}
+}
+
+void
+test_orient3d() {
+	dvec3 const a{0.0, 0.0, 0.0}, b{1.0, 0.0, 0.0}, c{0.0, 1.0, 0.0};
+	fassert(am::geometry::orient3d(a, b, c, dvec3{0.0, 0.0, -1.0}) > 0.0);
+	fassert(am::geometry::orient3d(a, b, c, dvec3{0.0, 0.0, 1.0}) < 0.0);
+	fassert(am::geometry::orient3d(a, b, c, dvec3{3.0, -7.0, 0.0}) == 0.0);
+
+	// Points a few ulps off the plane x = y
+	dvec3 const p{12.0, 12.0, 0.0}, q{24.0, 24.0, 0.0}, r{0.0, 0.0, 1.0};
+	int const side = sign(am::geometry::orient3d(p, q, r, dvec3{0.0, 1.0, 0.0}));
+	fassert(0 != side);
+	for (int i = 0; i < 32; ++i) {
+	for (int j = 0; j < 32; ++j) {
+		dvec3 const d{step(0.5, i), step(0.5, j), 0.25};
+		fassert(sign(am::geometry::orient3d(p, q, r, d)) == side * sign(j - i));
+	}}
+}
+
+void
+test_incircle() {
+	dvec2 const a{1.0, 0.0}, b{0.0, 1.0}, c{-1.0, 0.0};
+	fassert(am::geometry::incircle(a, b, c, dvec2{0.0, 0.0}) > 0.0);
+	fassert(am::geometry::incircle(a, b, c, dvec2{2.0, 0.0}) < 0.0);
+	fassert(am::geometry::incircle(c, b, a, dvec2{0.0, 0.0}) < 0.0);
+
+	// Circle of radius 5 far from the origin, with (3, 4) on it
+	double const o = 1048576.0;
+	dvec2 const e{o + 5.0, o}, f{o, o + 5.0}, g{o - 5.0, o};
+	fassert(am::geometry::incircle(e, f, g, dvec2{o + 3.0, o + 4.0}) == 0.0);
+	fassert(am::geometry::incircle(e, f, g, dvec2{o - 3.0, o - 4.0}) == 0.0);
+	for (int k = 1; k < 8; ++k) {
+		fassert(am::geometry::incircle(e, f, g, dvec2{o + 3.0, step(o + 4.0, k)}) < 0.0);
+		fassert(am::geometry::incircle(e, f, g, dvec2{o + 3.0, step(o + 4.0, -k)}) > 0.0);
+		fassert(am::geometry::incircle(e, f, g, dvec2{step(o - 3.0, -k), o - 4.0}) < 0.0);
+	}
+}
+
+void
+test_float() {
+	using fvec2 = am::detail::linear::tvec2<float>;
+	fvec2 const q{12.0f, 12.0f}, r{24.0f, 24.0f};
+	for (int i = 0; i < 16; ++i) {
+	for (int j = 0; j < 16; ++j) {
+		float x = 0.5f, y = 0.5f;
+		for (int k = 0; k < i; ++k) { x = std::nextafter(x, 1.0f); }
+		for (int k = 0; k < j; ++k) { y = std::nextafter(y, 1.0f); }
+		fassert(sign(am::geometry::orient2d(fvec2{x, y}, q, r)) == sign(j - i));
+	}}
+}
+
+signed main() {
+	test_orient2d();
+	test_orient3d();
+	test_incircle();
+	test_float();
+	return 0;
+}
@@ -0,0 +1,95 @@
+
+#include <am/config.hpp>
+#include <am/hash/bloom.hpp>
+#include <am/hash/murmur.hpp>
+
+#include "./common.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using am::hash::bloom_filter;
+using am::hash::blocked_bloom_filter;
+using am::hash::register_bloom_filter;
+using murmur3 = am::hash::hasher<am::hash::murmur3>;
+
+// No false negatives, batch and single forms agree, and the false
+// positive rate is near what the parameters give
+template<
+	class Filter
+>
+static void
+test_filter(
+	std::size_t const bits_per_key,
+	double const max_fpp
+) {
+	std::size_t const n = 100000u;
+	auto const keys = make_keys(n, 1u);
+	auto const others = make_keys(n, 2u);
+
+	Filter single{n * bits_per_key, am::hash::bloom_optimal_hashes(n * bits_per_key, n)};
+	Filter batch{single.bit_count(), single.hash_count()};
+	for (auto const key : keys) {
+		single.insert(key);
+	}
+	batch.insert(n, keys.data());
+	for (std::size_t i = 0; i < single.bit_count() / 64u; ++i) {
+		fassert(single.data()[i] == batch.data()[i]);
+	}
+
+	TEST_FILTER_MEMBERSHIP(single, keys, others, max_fpp);
+
+	// Keys reach every part of the filter
+	std::size_t const words = single.bit_count() / 64u;
+	std::size_t used = 0u;
+	for (std::size_t i = 0; i < words; i += 8u) {
+		used += (0u != single.data()[i]) ? 1u : 0u;
+	}
+	fassert(used * 10u > (words / 8u) * 9u);
+
+	single.clear();
+	fassert(!single.contains(keys[0]));
+}
+
+signed main() {
+	// 10 bits per key: ~0.8% for the standard filter
+	test_filter<bloom_filter<>>(10u, 0.01);
+	test_filter<blocked_bloom_filter<>>(10u, 0.014);
+	test_filter<register_bloom_filter<>>(10u, 0.032);
+	test_filter<register_bloom_filter<>>(16u, 0.016);
+
+	// 32-bit hash
+	test_filter<bloom_filter<murmur3>>(10u, 0.01);
+	test_filter<blocked_bloom_filter<murmur3>>(10u, 0.014);
+	test_filter<register_bloom_filter<murmur3>>(10u, 0.032);
+
+	// Optimal parameters
+	fassert(am::hash::bloom_optimal_bits(1000u, 0.01) == 9586u);
+	fassert(am::hash::bloom_optimal_hashes(9586u, 1000u) == 7u);
+	fassert(am::hash::bloom_optimal_hashes(1u, 1000u) == 1u);
+	// Out-of-range rates
+	fassert(am::hash::bloom_optimal_bits(1000u, 1.0) == 0u);
+	fassert(am::hash::bloom_optimal_bits(1000u, 2.0) == 0u);
+	fassert(am::hash::bloom_optimal_bits(1000u, std::nan("")) == 0u);
+	fassert(am::hash::bloom_optimal_bits(1000u, 0.0) == am::hash::bloom_optimal_bits(1000u, -1.0));
+	fassert(am::hash::bloom_optimal_bits(1000u, 0.0) > 1000000u);
+	fassert(am::hash::bloom_optimal_bits(~std::size_t(0), 0.0) == ~std::size_t(0));
+
+	// Strings (and heterogeneous queries)
+	{
+		blocked_bloom_filter<> filter{1024u, 5u};
+		std::string const words[]{"alpha", "beta", "gamma"};
+		filter.insert(3u, words);
+		fassert(filter.contains("alpha"));
+		fassert(filter.contains(std::string{"beta"}));
+		fassert(filter.bit_count() == 1024u);
+	}
+
+	// Rounding
+	fassert(bloom_filter<>(1u, 1u).bit_count() == 64u);
+	fassert(blocked_bloom_filter<>(513u, 1u).bit_count() == 1024u);
+	fassert(blocked_bloom_filter<>(0u, 1u).bit_count() == 512u);
+	return 0;
+}
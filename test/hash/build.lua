@@ -4,4 +4,13 @@ make_tests(
 	["validate"] = {nil, nil},
 	["util"] = {nil, nil},
 	["combiner"] = {nil, nil},
+	["linear"] = {nil, nil},
+	["xxhash"] = {nil, nil},
+	["crc32c"] = {nil, nil},
+	["siphash"] = {nil, nil},
+	["flat_map"] = {nil, nil},
+	["bloom"] = {nil, nil},
+	["cuckoo_filter"] = {nil, nil},
+	["fuse_filter"] = {nil, nil},
+	["hyperloglog"] = {nil, nil},
 })
@@ -3,8 +3,12 @@
 
 #include "../general/common.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <memory>
 #include <string>
+#include <vector>
 
 #define TEST_HASH_FUNC_CSTR(func, impl, input, result) {\
 	auto const x = am::hash::func<impl>(input, std::strlen(input));\
@@ -84,3 +88,43 @@ void TEST_HASH_SEEDED_SET_CE(
 		fassert(it->value == constexpr_hash_func(it->input, size, seed));
 	}
 }
+
+// xorshift keys; different seeds give (in practice) disjoint sets
+inline std::vector<std::uint64_t>
+make_keys(
+	std::size_t const count,
+	std::uint64_t x
+) {
+	std::vector<std::uint64_t> keys(count);
+	for (auto& key : keys) {
+		x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+		key = x;
+	}
+	return keys;
+}
+
+// No false negatives, the batch and single forms of contains() agree,
+// and the false positive rate over others is below max_fpp
+template<
+	class Filter
+>
+void TEST_FILTER_MEMBERSHIP(
+	Filter const& filter,
+	std::vector<std::uint64_t> const& keys,
+	std::vector<std::uint64_t> const& others,
+	double const max_fpp
+) {
+	std::size_t const n = keys.size() < others.size() ? others.size() : keys.size();
+	std::unique_ptr<bool[]> out{new bool[n]};
+	for (auto const key : keys) {
+		fassert(filter.contains(key));
+	}
+	fassert(keys.size() == filter.contains(keys.size(), keys.data(), out.get()));
+
+	std::size_t const positives = filter.contains(others.size(), others.data(), out.get());
+	for (std::size_t i = 0; i < others.size(); ++i) {
+		fassert(out[i] == filter.contains(others[i]));
+	}
+	double const fpp = static_cast<double>(positives) / static_cast<double>(others.size());
+	fassert(fpp < max_fpp);
+}
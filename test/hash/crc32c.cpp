@@ -0,0 +1,110 @@
+
+#include <am/config.hpp>
+#include <am/hash/crc32c.hpp>
+
+#include "./common.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using am::hash::crc32c;
+
+// Bit-at-a-time reference
+static std::uint32_t
+crc32c_bitwise(
+	char const* const data,
+	std::size_t const size
+) {
+	std::uint32_t crc = ~0u;
+	for (std::size_t i = 0; i < size; ++i) {
+		crc ^= static_cast<std::uint8_t>(data[i]);
+		for (unsigned k = 0; k < 8u; ++k) {
+			crc = (crc >> 1) ^ (0x82f63b78u & (0u - (crc & 1u)));
+		}
+	}
+	return ~crc;
+}
+
+static std::vector<char>
+make_data(
+	unsigned const size
+) {
+	std::vector<char> data(size);
+	std::uint32_t x = 0x12345678u;
+	for (unsigned i = 0; i < size; ++i) {
+		x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+		data[i] = static_cast<char>(x);
+	}
+	return data;
+}
+
+signed main() {
+	// Check values
+	fassert(am::hash::calc<crc32c>("123456789", 9u) == 0xe3069283u);
+	fassert(am::hash::calc<crc32c>("", 0u) == 0u);
+	fassert(am::hash::calc_string<crc32c>(std::string(32, '\0')) == 0x8a9136aau);
+	fassert(am::hash::calc_string<crc32c>(std::string(32, '\xff')) == 0x62a8ab43u);
+
+	std::vector<char> const data = make_data(100000u);
+
+	// All paths (tail, 8-byte, short and long interleaved blocks), at
+	// unaligned offsets
+	{
+		unsigned const sizes[]{
+			0u, 1u, 7u, 8u, 9u, 63u, 767u, 768u, 769u, 1600u, 2304u,
+			24575u, 24576u, 24577u, 50000u, 99990u
+		};
+		for (unsigned const size : sizes) {
+			for (unsigned offset = 0; offset < 8u; ++offset) {
+				char const* const p = data.data() + offset;
+				fassert(
+					am::hash::calc<crc32c>(p, size) == crc32c_bitwise(p, size)
+				);
+			}
+		}
+	}
+
+	// Streaming
+	{
+		am::hash::generic_combiner<crc32c> combiner{};
+		unsigned const size = 99000u;
+		unsigned chunk = 1u;
+		for (unsigned i = 0; i < size;) {
+			unsigned const n = chunk < size - i ? chunk : size - i;
+			combiner.add(data.data() + i, n);
+			i += n;
+			chunk = (chunk * 7u) % 4099u + 1u;
+		}
+		fassert(combiner.size() == size);
+		fassert(combiner.value() == crc32c_bitwise(data.data(), size));
+	}
+
+	// Combine
+	{
+		unsigned const size = 30000u;
+		std::uint32_t const whole = am::hash::calc<crc32c>(data.data(), size);
+		unsigned const splits[]{0u, 1u, 5u, 8u, 777u, 12345u, 29999u, 30000u};
+		for (unsigned const split : splits) {
+			std::uint32_t const a = am::hash::calc<crc32c>(data.data(), split);
+			std::uint32_t const b = am::hash::calc<crc32c>(
+				data.data() + split, size - split
+			);
+			fassert(am::hash::crc32c_combine(a, b, size - split) == whole);
+		}
+
+		// Parallel-style: four chunks joined left to right
+		unsigned const quarter = size / 4u;
+		std::uint32_t crc = 0u;
+		for (unsigned i = 0; i < 4u; ++i) {
+			crc = am::hash::crc32c_combine(
+				crc,
+				am::hash::calc<crc32c>(data.data() + i * quarter, quarter),
+				quarter
+			);
+		}
+		fassert(crc == am::hash::calc<crc32c>(data.data(), 4u * quarter));
+	}
+	return 0;
+}
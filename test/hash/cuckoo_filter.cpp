@@ -0,0 +1,105 @@
+
+#include <am/config.hpp>
+#include <am/hash/fnv.hpp>
+#include <am/hash/cuckoo_filter.hpp>
+
+#include "./common.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using am::hash::cuckoo_filter;
+using am::hash::hasher;
+
+// No false negatives, batch and single forms agree, the false positive
+// rate is near what the fingerprint gives, and removed keys are gone
+template<
+	class Filter
+>
+static void
+test_filter(
+	double const max_fpp
+) {
+	std::size_t const n = 100000u;
+	auto const keys = make_keys(n, 1u);
+	auto const others = make_keys(n, 2u);
+
+	// Filled to 95%
+	Filter filter{n};
+	fassert(filter.capacity() >= n);
+	std::size_t const fill = filter.capacity() * 95u / 100u;
+	auto const more = make_keys(fill - n, 3u);
+	fassert(n == filter.insert(n, keys.data()));
+	fassert(more.size() == filter.insert(more.size(), more.data()));
+	fassert(filter.size() == fill && !filter.full());
+	fassert(filter.load_factor() > 0.94f);
+
+	TEST_FILTER_MEMBERSHIP(filter, keys, others, max_fpp);
+
+	// Remove half
+	for (std::size_t i = 0; i < n; i += 2u) {
+		fassert(filter.erase(keys[i]));
+	}
+	fassert(filter.size() == fill - n / 2u);
+	for (std::size_t i = 1; i < n; i += 2u) {
+		fassert(filter.contains(keys[i]));
+	}
+	std::size_t still = 0u;
+	for (std::size_t i = 0; i < n; i += 2u) {
+		still += filter.contains(keys[i]) ? 1u : 0u;
+	}
+	fassert(static_cast<double>(still) / static_cast<double>(n / 2u) < max_fpp);
+
+	filter.clear();
+	fassert(filter.size() == 0u && !filter.contains(keys[1]));
+}
+
+// Inserts past capacity fail without losing keys, and removing one
+// makes room again
+static void
+test_full() {
+	cuckoo_filter<std::uint16_t> filter{64u};
+	std::size_t const capacity = filter.capacity();
+	auto const keys = make_keys(2u * capacity, 4u);
+	std::size_t const inserted = filter.insert(keys.size(), keys.data());
+	fassert(filter.full());
+	fassert(inserted == filter.size() && inserted < keys.size());
+	fassert(inserted >= capacity * 3u / 4u);
+	for (std::size_t i = 0; i < inserted; ++i) {
+		fassert(filter.contains(keys[i]));
+	}
+	fassert(!filter.insert(keys[inserted]));
+
+	fassert(filter.erase(keys[0]));
+	fassert(!filter.full() && filter.size() == inserted - 1u);
+	for (std::size_t i = 1; i < inserted; ++i) {
+		fassert(filter.contains(keys[i]));
+	}
+}
+
+static void
+test_duplicates() {
+	cuckoo_filter<std::uint8_t, hasher<am::hash::fnv1a<am::hash::HL64>>> filter{1000u};
+	std::string const word{"alpha"};
+	for (unsigned i = 0; i < 8u; ++i) {
+		fassert(filter.insert(word));
+	}
+	fassert(filter.size() == 8u && !filter.full());
+	for (unsigned i = 0; i < 8u; ++i) {
+		fassert(filter.contains("alpha"));
+		fassert(filter.erase("alpha"));
+	}
+	fassert(!filter.contains("alpha"));
+	fassert(!filter.erase("alpha"));
+	fassert(filter.size() == 0u);
+}
+
+signed main() {
+	// Fingerprint bits f at load a: about 8a/2^f
+	test_filter<cuckoo_filter<std::uint8_t>>(0.04);
+	test_filter<cuckoo_filter<std::uint16_t>>(0.0005);
+	test_full();
+	test_duplicates();
+	return 0;
+}
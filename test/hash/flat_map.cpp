@@ -0,0 +1,302 @@
+
+#include <am/config.hpp>
+#include <am/hash/fnv.hpp>
+#include <am/hash/siphash.hpp>
+#include <am/hash/xxhash.hpp>
+#include <am/hash/flat_map.hpp>
+
+#include "./common.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+using am::hash::flat_map;
+using am::hash::flat_set;
+using am::hash::hasher;
+
+static std::uint64_t
+next_random(
+	std::uint64_t& x
+) {
+	x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+	return x;
+}
+
+// Counts live instances to check construction and destruction pair up
+struct counted {
+	static int live;
+
+	int value;
+
+	counted(int const value = 0) : value(value) { ++live; }
+	counted(counted const& other) : value(other.value) { ++live; }
+	counted(counted&& other) noexcept : value(other.value) { ++live; }
+	~counted() { --live; }
+
+	counted& operator=(counted const&) = default;
+	counted& operator=(counted&&) = default;
+};
+
+int counted::live = 0;
+
+// Counts copies to check that growing moves keys
+struct copy_counted {
+	static int copies;
+
+	std::uint64_t value;
+
+	copy_counted(std::uint64_t const value) : value(value) {}
+	copy_counted(copy_counted const& other) : value(other.value) { ++copies; }
+	copy_counted(copy_counted&& other) noexcept : value(other.value) {}
+
+	friend bool
+	operator==(
+		copy_counted const& x,
+		copy_counted const& y
+	) {
+		return x.value == y.value;
+	}
+};
+
+int copy_counted::copies = 0;
+
+struct copy_counted_hash {
+	std::size_t
+	operator()(
+		copy_counted const& key
+	) const noexcept {
+		return static_cast<std::size_t>(key.value * 0x9e3779b97f4a7c15ULL);
+	}
+};
+
+// Random inserts, erases and lookups against std::unordered_map; the
+// small key range churns tombstones
+template<
+	class Map
+>
+static void
+test_differential(
+	std::uint64_t const range
+) {
+	Map map;
+	std::unordered_map<std::uint64_t, std::uint64_t> ref;
+	std::uint64_t x = 0x9e3779b97f4a7c15ULL;
+	for (unsigned i = 0; i < 200000u; ++i) {
+		std::uint64_t const r = next_random(x);
+		std::uint64_t const key = (r >> 8) % range;
+		switch (r & 3u) {
+		case 0:
+		case 1: {
+			auto const res = map.insert({key, i});
+			auto const ref_res = ref.insert({key, i});
+			fassert(res.second == ref_res.second);
+			fassert(res.first->first == key);
+			fassert(res.first->second == ref_res.first->second);
+		}	break;
+
+		case 2:
+			fassert(map.erase(key) == ref.erase(key));
+			break;
+
+		case 3: {
+			auto const it = map.find(key);
+			auto const ref_it = ref.find(key);
+			fassert((it == map.end()) == (ref_it == ref.end()));
+			fassert(it == map.end() || it->second == ref_it->second);
+		}	break;
+		}
+		fassert(map.size() == ref.size());
+	}
+
+	// Iteration visits each value once
+	std::size_t count = 0u;
+	for (auto const& value : map) {
+		auto const ref_it = ref.find(value.first);
+		fassert(ref_it != ref.end() && ref_it->second == value.second);
+		++count;
+	}
+	fassert(count == ref.size());
+
+	// Tombstones do not build up
+	fassert(map.capacity() < 8u * range);
+}
+
+static void
+test_strings() {
+	flat_map<std::string, int> map{
+		{"alpha", 1},
+		{"beta", 2},
+		{"gamma", 3},
+	};
+	fassert(map.size() == 3u);
+
+	// Heterogeneous lookup
+	fassert(map.find("beta")->second == 2);
+	fassert(map.find(std::string{"gamma"})->second == 3);
+	fassert(map.contains("alpha"));
+	fassert(!map.contains("delta"));
+	fassert(map.count("alpha") == 1u);
+	fassert(map.at("alpha") == 1);
+
+	bool thrown = false;
+	try {
+		map.at("delta");
+	} catch (std::out_of_range const&) {
+		thrown = true;
+	}
+	fassert(thrown);
+
+	map["delta"] = 4;
+	fassert(map.at("delta") == 4);
+	fassert(!map.try_emplace("delta", 5).second);
+	fassert(!map.insert_or_assign("delta", 5).second);
+	fassert(map.at("delta") == 5);
+	fassert(map.erase("delta") == 1u);
+	fassert(map.erase("delta") == 0u);
+
+	// Precomputed hash from a combiner fed the key in pieces
+	using impl = am::hash::xxh3<am::hash::HL64>;
+	am::hash::generic_combiner<impl> combiner{0u};
+	combiner.add("gam", 3u);
+	combiner.add("ma", 2u);
+	fassert(combiner.value() == map.hash_function()("gamma"));
+	fassert(map.find("gamma", combiner.value())->second == 3);
+	fassert(map.contains("gamma", combiner.value()));
+
+	// Many keys
+	for (int i = 0; i < 10000; ++i) {
+		map.emplace(std::to_string(i), i);
+	}
+	fassert(map.size() == 10003u);
+	for (int i = 0; i < 10000; ++i) {
+		fassert(map.at(std::to_string(i)) == i);
+	}
+}
+
+static void
+test_semantics() {
+	using map_type = flat_map<std::uint64_t, counted>;
+	{
+		map_type map;
+		fassert(map.empty() && map.capacity() == 0u);
+		fassert(map.begin() == map.end());
+		fassert(!map.contains(1u));
+		fassert(map.erase(1u) == 0u);
+
+		for (std::uint64_t i = 0; i < 1000u; ++i) {
+			map.try_emplace(i, static_cast<int>(i));
+		}
+		fassert(counted::live == 1000);
+
+		// Copy and move
+		map_type copy{map};
+		fassert(copy.size() == 1000u && counted::live == 2000);
+		map_type moved{std::move(copy)};
+		fassert(moved.size() == 1000u && copy.empty());
+		fassert(counted::live == 2000);
+		for (std::uint64_t i = 0; i < 1000u; ++i) {
+			fassert(moved.at(i).value == static_cast<int>(i));
+		}
+		copy = moved;
+		fassert(copy.size() == 1000u && counted::live == 3000);
+		copy = map_type{};
+		fassert(copy.empty() && counted::live == 2000);
+
+		// Erase while iterating
+		for (auto it = moved.begin(); it != moved.end();) {
+			bool const even = 0 == (it->second.value & 1);
+			if (even) {
+				it = moved.erase(it);
+			} else {
+				++it;
+			}
+		}
+		fassert(moved.size() == 500u && counted::live == 1500);
+		for (std::uint64_t i = 0; i < 1000u; ++i) {
+			bool const odd = 1u == (i & 1u);
+			fassert(moved.contains(i) == odd);
+		}
+
+		// Lookups with another integer type
+		fassert(moved.contains(1u));
+		fassert(moved.find(static_cast<std::uint16_t>(3))->second.value == 3);
+
+		// Clear keeps the allocation
+		std::size_t const capacity = moved.capacity();
+		moved.clear();
+		fassert(moved.empty() && moved.capacity() == capacity);
+		fassert(moved.begin() == moved.end());
+		fassert(counted::live == 1000);
+
+		// Reserve
+		map_type reserved{5000u};
+		std::size_t const reserved_capacity = reserved.capacity();
+		for (std::uint64_t i = 0; i < 5000u; ++i) {
+			reserved[i].value = 1;
+		}
+		fassert(reserved.capacity() == reserved_capacity);
+		fassert(reserved.load_factor() <= 0.875f);
+	}
+	fassert(counted::live == 0);
+}
+
+static void
+test_key_moves() {
+	flat_map<copy_counted, std::string, copy_counted_hash, std::equal_to<copy_counted>> map;
+	for (std::uint64_t i = 0; i < 5000u; ++i) {
+		map.try_emplace(copy_counted{i}, std::to_string(i));
+	}
+	fassert(map.size() == 5000u && map.capacity() > 5000u);
+	fassert(copy_counted::copies == 0);
+	for (std::uint64_t i = 0; i < 5000u; ++i) {
+		fassert(map.at(copy_counted{i}) == std::to_string(i));
+	}
+
+	flat_set<copy_counted, copy_counted_hash, std::equal_to<copy_counted>> set;
+	for (std::uint64_t i = 0; i < 5000u; ++i) {
+		set.emplace(copy_counted{i});
+	}
+	fassert(copy_counted::copies == 0);
+}
+
+static void
+test_sets() {
+	// Seeded (the seed changes the layout, not the contents)
+	using sip = hasher<am::hash::siphash13>;
+	flat_set<std::uint64_t, sip> a{0u, sip{am::hash::siphash_key{1u, 2u}}};
+	flat_set<std::uint64_t, sip> b{0u, sip{am::hash::siphash_key{3u, 4u}}};
+	for (std::uint64_t i = 0; i < 1000u; ++i) {
+		a.insert(i * 7u);
+		b.insert(i * 7u);
+	}
+	fassert(!a.insert(7u).second);
+	for (std::uint64_t const key : a) {
+		fassert(b.contains(key));
+	}
+
+	// 32-bit hash
+	flat_set<std::string, hasher<am::hash::fnv1a<am::hash::HL32>>> c{"x", "y"};
+	fassert(c.contains("x") && c.contains("y") && !c.contains("z"));
+
+	// Standard hash functor (no heterogeneous lookup)
+	flat_set<int, std::hash<int>, std::equal_to<int>> d{1, 2, 3};
+	fassert(d.size() == 3u && d.contains(2) && !d.contains(4));
+	d.erase(d.find(2));
+	fassert(d.size() == 2u && !d.contains(2));
+}
+
+signed main() {
+	test_differential<flat_map<std::uint64_t, std::uint64_t>>(64u);
+	test_differential<flat_map<std::uint64_t, std::uint64_t>>(5000u);
+	test_differential<flat_map<
+		std::uint64_t, std::uint64_t, hasher<am::hash::fnv1a<am::hash::HL64>>
+	>>(5000u);
+	test_strings();
+	test_semantics();
+	test_key_moves();
+	test_sets();
+	return 0;
+}
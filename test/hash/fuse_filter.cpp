@@ -0,0 +1,87 @@
+
+#include <am/config.hpp>
+#include <am/hash/fnv.hpp>
+#include <am/hash/fuse_filter.hpp>
+
+#include "./common.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using am::hash::binary_fuse_filter;
+using am::hash::hasher;
+
+// No false negatives, batch and single forms agree, and the false
+// positive rate and size are near what the fingerprint gives
+template<
+	class Filter
+>
+static void
+test_filter(
+	std::size_t const n,
+	double const max_fpp,
+	double const max_bits_per_key
+) {
+	auto const keys = make_keys(n, 1u);
+	auto const others = make_keys(100000u, 2u);
+
+	Filter filter;
+	fassert(filter.build(n, keys.data()));
+	fassert(filter.size() == n);
+	TEST_FILTER_MEMBERSHIP(filter, keys, others, max_fpp);
+
+	double const bits_per_key
+		= 8.0 * sizeof(typename Filter::fingerprint_type) * filter.fingerprint_count()
+		/ static_cast<double>(n)
+	;
+	fassert(bits_per_key < max_bits_per_key);
+
+	filter.clear();
+	fassert(filter.size() == 0u && !filter.contains(keys[0]));
+}
+
+static void
+test_edges() {
+	binary_fuse_filter<> filter;
+	std::uint64_t const key = 42u;
+	fassert(!filter.contains(key));
+	fassert(filter.build(0u, &key));
+	fassert(filter.size() == 0u);
+
+	for (std::size_t n = 1u; n < 100u; ++n) {
+		auto const keys = make_keys(n, 3u);
+		fassert(filter.build(n, keys.data()));
+		fassert(filter.size() == n);
+		for (auto const k : keys) {
+			fassert(filter.contains(k));
+		}
+	}
+
+	// Duplicates are dropped
+	auto keys = make_keys(10000u, 4u);
+	keys.insert(keys.end(), keys.begin(), keys.begin() + 5000);
+	keys.push_back(keys[0]);
+	fassert(filter.build(keys.size(), keys.data()));
+	fassert(filter.size() == 10000u);
+	for (auto const k : keys) {
+		fassert(filter.contains(k));
+	}
+
+	// Strings
+	binary_fuse_filter<std::uint16_t, hasher<am::hash::fnv1a<am::hash::HL64>>> words;
+	std::string const set[]{"alpha", "beta", "gamma"};
+	fassert(words.build(3u, set));
+	fassert(words.contains("alpha"));
+	fassert(words.contains(std::string{"gamma"}));
+	fassert(!words.contains("delta"));
+}
+
+signed main() {
+	// 1/256 and 1/65536
+	test_filter<binary_fuse_filter<std::uint8_t>>(1000000u, 0.005, 9.2);
+	test_filter<binary_fuse_filter<std::uint16_t>>(1000000u, 0.0001, 18.4);
+	test_filter<binary_fuse_filter<std::uint8_t>>(1000u, 0.005, 16.0);
+	test_edges();
+	return 0;
+}
@@ -0,0 +1,157 @@
+
+#include <am/config.hpp>
+#include <am/hash/murmur.hpp>
+#include <am/hash/hyperloglog.hpp>
+
+#include "./common.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using am::hash::hyperloglog;
+using am::hash::hasher;
+
+static double
+relative_error(
+	double const estimate,
+	std::size_t const actual
+) {
+	return std::abs(estimate - static_cast<double>(actual)) / static_cast<double>(actual);
+}
+
+// Within a few standard errors over the whole range, and close to
+// exact while sparse
+template<
+	class Sketch
+>
+static void
+test_accuracy(
+	unsigned const precision
+) {
+	auto const keys = make_keys(2000000u, 1u);
+	double const error = 1.04 / std::sqrt(static_cast<double>(1u << precision));
+	Sketch sketch{precision};
+	fassert(sketch.sparse() && 0.0 == sketch.estimate());
+
+	std::size_t n = 0u;
+	for (std::size_t const next : {1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 2000000u}) {
+		sketch.insert(next - n, keys.data() + n);
+		n = next;
+		double const e = relative_error(sketch.estimate(), n);
+		if (sketch.sparse()) {
+			fassert(e < 0.01);
+		} else {
+			fassert(e < 4.0 * error);
+		}
+	}
+	fassert(!sketch.sparse());
+
+	// Duplicates do not count
+	double const before = sketch.estimate();
+	sketch.insert(1000u, keys.data());
+	fassert(before == sketch.estimate());
+
+	sketch.clear();
+	fassert(sketch.sparse() && 0.0 == sketch.estimate());
+}
+
+// A merge is the sketch of the union, whatever the representations
+static void
+test_merge() {
+	auto const keys = make_keys(200000u, 2u);
+	for (std::size_t const n : {100u, 2000u, 200000u}) {
+		hyperloglog<> all{12u};
+		hyperloglog<> low{12u};
+		hyperloglog<> high{12u};
+		hyperloglog<> tiny{12u};
+		all.insert(n, keys.data());
+		low.insert(n * 2u / 3u, keys.data());
+		high.insert(n - n / 3u, keys.data() + n / 3u);
+		tiny.insert(n / 10u, keys.data() + n / 2u);
+
+		hyperloglog<> merged{low};
+		merged.merge(high);
+		merged.merge(tiny);
+		merged.merge(merged);
+		fassert(merged.serialize() == all.serialize());
+
+		hyperloglog<> reversed{tiny};
+		reversed.merge(high);
+		reversed.merge(low);
+		fassert(reversed.serialize() == all.serialize());
+		fassert(reversed.estimate() == all.estimate());
+	}
+
+	// Precisions must match
+	hyperloglog<> a{12u};
+	hyperloglog<> b{13u};
+	bool thrown = false;
+	try {
+		a.merge(b);
+	} catch (std::invalid_argument const&) {
+		thrown = true;
+	}
+	fassert(thrown);
+}
+
+static void
+test_serialize() {
+	auto const keys = make_keys(100000u, 3u);
+	for (std::size_t const n : {0u, 1u, 500u, 100000u}) {
+		hyperloglog<> sketch{12u};
+		sketch.insert(n, keys.data());
+		auto const data = sketch.serialize();
+		fassert(data.size() <= 3u + 4096u);
+
+		hyperloglog<> copy{4u};
+		fassert(copy.deserialize(data.data(), data.size()));
+		fassert(copy.precision() == 12u);
+		fassert(copy.sparse() == sketch.sparse());
+		fassert(copy.estimate() == sketch.estimate());
+		fassert(copy.serialize() == data);
+
+		// Truncated or corrupt
+		fassert(!copy.deserialize(data.data(), data.size() - 1u));
+		auto bad = data;
+		bad[1] = 30u;
+		fassert(!copy.deserialize(bad.data(), bad.size()));
+		bad = data;
+		bad.push_back(0u);
+		fassert(!copy.deserialize(bad.data(), bad.size()));
+		fassert(copy.serialize() == data);
+	}
+
+	// Sparse entries are delta-coded: under four bytes each
+	hyperloglog<> sparse{14u};
+	sparse.insert(1000u, keys.data());
+	fassert(sparse.sparse() && sparse.serialize().size() < 3500u);
+}
+
+static void
+test_keys() {
+	hyperloglog<hasher<am::hash::murmur2<am::hash::HL64>>> sketch{};
+	fassert(sketch.precision() == 14u && sketch.register_count() == 16384u);
+	std::string const words[]{"alpha", "beta", "gamma", "beta"};
+	sketch.insert(4u, words);
+	sketch.insert("alpha");
+	fassert(std::round(sketch.estimate()) == 3.0);
+
+	// Clamped precision
+	fassert(hyperloglog<>{1u}.precision() == 4u);
+	fassert(hyperloglog<>{30u}.precision() == 18u);
+}
+
+signed main() {
+	test_accuracy<hyperloglog<>>(14u);
+	test_accuracy<hyperloglog<>>(10u);
+	test_accuracy<hyperloglog<>>(18u);
+	// 32-bit hash
+	test_accuracy<hyperloglog<hasher<am::hash::murmur3>>>(14u);
+	test_merge();
+	test_serialize();
+	test_keys();
+	return 0;
+}
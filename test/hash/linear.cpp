@@ -0,0 +1,139 @@
+
+#include <am/config.hpp>
+#include <am/linear/vector.hpp>
+#include <am/linear/matrix.hpp>
+#include <am/hash/fnv.hpp>
+#include <am/hash/murmur.hpp>
+#include <am/hash/linear.hpp>
+
+#include "./common.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using am::linear::vec2;
+using am::linear::vec3;
+using am::linear::ivec3;
+using am::linear::mat3;
+using am::linear::mat2x4;
+
+using fnv64 = am::hash::fnv1a<am::hash::HL64>;
+using murmur64 = am::hash::murmur2<am::hash::HL64>;
+
+template<class V>
+static void
+test_canonical() {
+	using T = typename V::value_type;
+	V a{T(0)};
+	V b{T(0)};
+	b[1] = -T(0);
+	fassert(a == b);
+	fassert(am::hash::linear_hash(a) == am::hash::linear_hash(b));
+	fassert(std::hash<V>{}(a) == std::hash<V>{}(b));
+	fassert(am::hash::calc<fnv64>(a) == am::hash::calc<fnv64>(b));
+	fassert(
+		am::hash::calc<murmur64>(a, 7u) == am::hash::calc<murmur64>(b, 7u)
+	);
+
+	// NaNs with different payloads and signs hash together
+	V n1{T(1)};
+	V n2{T(1)};
+	n1[0] = std::numeric_limits<T>::quiet_NaN();
+	n2[0] = -std::numeric_limits<T>::quiet_NaN();
+	fassert(am::hash::linear_hash(n1) == am::hash::linear_hash(n2));
+	fassert(am::hash::calc<fnv64>(n1) == am::hash::calc<fnv64>(n2));
+	fassert(am::hash::linear_hash(n1) != am::hash::linear_hash(V{T(1)}));
+}
+
+signed main() {
+	// -0, NaN
+	test_canonical<vec2>();
+	test_canonical<vec3>();
+	test_canonical<am::detail::linear::tvec4<double> >();
+
+	// Implementation overloads hash the component bytes
+	{
+		vec3 const v{1.5f, -2.0f, 3.25f};
+		fassert(
+			am::hash::calc<fnv64>(v) ==
+			am::hash::calc<fnv64>(
+				reinterpret_cast<char const*>(&v), sizeof(v)
+			)
+		);
+		fassert(
+			am::hash::calc<murmur64>(v, 42u) ==
+			am::hash::calc<murmur64>(
+				reinterpret_cast<char const*>(&v), sizeof(v), 42u
+			)
+		);
+
+		mat2x4 m{};
+		for (unsigned c = 0; c < mat2x4::size(); ++c) {
+			for (unsigned r = 0; r < mat2x4::col_type::size(); ++r) {
+				m[c][r] = float(c * 4 + r) - 3.5f;
+			}
+		}
+		fassert(
+			am::hash::calc<fnv64>(m) ==
+			am::hash::calc<fnv64>(
+				reinterpret_cast<char const*>(&m), sizeof(m)
+			)
+		);
+
+		// Component order matters; seed matters
+		mat2x4 t = m;
+		std::swap(t[0][1], t[1][0]);
+		fassert(am::hash::linear_hash(m) != am::hash::linear_hash(t));
+		fassert(am::hash::linear_hash(m) != am::hash::linear_hash(m, 1u));
+	}
+
+	// Containers
+	{
+		std::unordered_map<ivec3, unsigned> map;
+		for (signed z = -8; z < 8; ++z)
+		for (signed y = -8; y < 8; ++y)
+		for (signed x = -8; x < 8; ++x) {
+			map[ivec3{x, y, z}] = static_cast<unsigned>(map.size());
+		}
+		fassert(map.size() == 16u * 16u * 16u);
+		fassert(map.at(ivec3{0, 0, 0}) == 8u * 256u + 8u * 16u + 8u);
+
+		std::unordered_set<vec3> set;
+		set.insert(vec3{0.0f, 1.0f, 2.0f});
+		fassert(set.count(vec3{-0.0f, 1.0f, 2.0f}) == 1u);
+
+		std::unordered_set<mat3> mset;
+		mset.insert(mat3{1.0f});
+		mset.insert(mat3{2.0f});
+		mset.insert(mat3{1.0f});
+		fassert(mset.size() == 2u);
+	}
+
+	// Distribution: no full 64-bit collisions and few bucket collisions
+	// over a lattice
+	{
+		unsigned const buckets = 1u << 16;
+		std::vector<unsigned char> used(buckets, 0u);
+		std::unordered_set<std::uint64_t> full;
+		unsigned collisions = 0;
+		unsigned count = 0;
+		for (signed z = 0; z < 32; ++z)
+		for (signed y = 0; y < 32; ++y)
+		for (signed x = 0; x < 32; ++x) {
+			std::uint64_t const h = am::hash::linear_hash(ivec3{x, y, z});
+			full.insert(h);
+			collisions += used[h & (buckets - 1u)];
+			used[h & (buckets - 1u)] = 1u;
+			++count;
+		}
+		fassert(full.size() == count);
+		// expected n - m * (1 - (1 - 1/m)^n) ~= 6982 for n = 32768
+		fassert(collisions < 7400u);
+	}
+	return 0;
+}
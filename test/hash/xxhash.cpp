@@ -0,0 +1,254 @@
+
+#include <am/config.hpp>
+#include <am/hash/xxhash.hpp>
+
+#include "./common.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using am::hash::HashLength;
+
+using xxh3_64 = am::hash::xxh3<HashLength::HL64>;
+using xxh3_128 = am::hash::xxh3<HashLength::HL128>;
+
+// Reference values from xxHash 0.8.3 over make_data()
+struct xxh_vector {
+	unsigned size;
+	std::uint64_t xxh64;
+	std::uint64_t xxh3_64;
+	std::uint64_t xxh3_128_lo;
+	std::uint64_t xxh3_128_hi;
+};
+
+static std::uint64_t const seed_b = 0x9e3779b97f4a7c15u;
+
+static xxh_vector const vectors_seed_0[]{
+	{    0u, 0xef46db3751d8e999u, 0x2d06800538d394c2u, 0x6001c324468d497fu, 0x99aa06d3014798d8u},
+	{    1u, 0xa96c7f0ce858bbb7u, 0x4c5cca45d0f4811fu, 0x4c5cca45d0f4811fu, 0x495b62073ef70ca4u},
+	{    2u, 0xc22c6a70ad56bba6u, 0x29c60963cbfa4e6eu, 0x29c60963cbfa4e6eu, 0xf1b5eec902a1eb5eu},
+	{    3u, 0xbed43740ee6332bbu, 0x6e3e2670e61106acu, 0x6e3e2670e61106acu, 0x390cdc5b4a895dd7u},
+	{    4u, 0xfa212ae44b3bb23du, 0x5c4c63133443d03fu, 0x3d668af6f2a44d77u, 0xaa6e2f274640a3f4u},
+	{    5u, 0xd339dcc9ac8e6776u, 0x49f5eb3111280b63u, 0x62853c5f1a6eda6eu, 0xd9da89da8d7e169au},
+	{    8u, 0x994b676b71ce94ddu, 0xf9fd4dd0b04d78f5u, 0x61ddbe7f31a6100du, 0x6a86a3bda6af4e3du},
+	{    9u, 0x572b84c18b983af8u, 0x7c20df9712c26edfu, 0x8c7b67fd458a936bu, 0x664c7ca18afd6255u},
+	{   15u, 0x09e6451ed2ff8b1du, 0xb345a7b2698ba575u, 0xd2738c0bad6cbf9au, 0x6ef18f28edd02b19u},
+	{   16u, 0x94ad0095e72b24d5u, 0x86abf6baccea0858u, 0xe2ce54a7c19c730du, 0x7f9a218b0425449au},
+	{   17u, 0x1464f2eff23b5fe1u, 0xb58bf5dc5022d071u, 0x8d96ef110fcdebb4u, 0x66fc23f6439dbd77u},
+	{   31u, 0x6711d55e306b5d8fu, 0x48442fcd5518b086u, 0xcee425163875b69bu, 0xd8201bc2fedefe5cu},
+	{   32u, 0x07f7b8e3bc5d6e25u, 0xe3712ed84c04a66eu, 0xfd357cf6cb2dda18u, 0x49a11ee743d6d342u},
+	{   33u, 0x09f85eeb4e1cbe9fu, 0xa4dee99b093e1f73u, 0xf8994653f4bfe6dau, 0x7228d9284a8116f6u},
+	{   63u, 0xb7c9968c066cb6a5u, 0x30ca01f63dcc223bu, 0x9ede94f828604a13u, 0x943c9c8db76d0623u},
+	{   64u, 0x50d4159a0411632eu, 0x1291d2d4042330ddu, 0xba7e015a54f14be1u, 0xe0faf20e0e0fe0ddu},
+	{   65u, 0xd277176bff863efcu, 0x97c6bf83217e5ec9u, 0x85326f4078a61329u, 0x9397df27b7a98713u},
+	{   96u, 0x18c8f362eb735341u, 0x81296929fc063365u, 0x8b8720f565dcf40cu, 0xfb78ac185ef55443u},
+	{   97u, 0x7683defa1456dab5u, 0xf145a45b658ab9ddu, 0xbb385623e598c6d4u, 0x9cfc8c7d6e7815c8u},
+	{  128u, 0x0430e433b792e757u, 0x10d17f72c0ccba41u, 0xff361dec1385710au, 0xaec730751478556cu},
+	{  129u, 0x1f9708e5a00618fau, 0x1648bdc3db49d1a2u, 0x4545b3a09738e31au, 0x98cd36ccbb557926u},
+	{  200u, 0x3b8cc7eaa63f107eu, 0xc0fbc0f4e181c826u, 0xa4773493fbbe3543u, 0x26d28d07860728f6u},
+	{  240u, 0xca0b65cc61295ca7u, 0xb6cfaf343fab81e6u, 0x3f2c53e72293711fu, 0x5293e17bf553903du},
+	{  241u, 0x0ffefe0dfc875cf4u, 0x956cae592c67279eu, 0x956cae592c67279eu, 0xb53840fe3fedf161u},
+	{  255u, 0x15a6db05d4e83df4u, 0x64a6073025eb7929u, 0x64a6073025eb7929u, 0x08c3b91c3870117bu},
+	{  256u, 0xa2dbe913965256fcu, 0xb15e550733c5dfacu, 0xb15e550733c5dfacu, 0xd0d2829a226d0edbu},
+	{  257u, 0x6fd17cd37fe9dbe9u, 0x67ce5a3104c5c55cu, 0x67ce5a3104c5c55cu, 0x007726a366fdc07au},
+	{  511u, 0xd06277369b0f7abdu, 0x5f7a0da3417107f7u, 0x5f7a0da3417107f7u, 0x53b2db617f7050d5u},
+	{  512u, 0x0bd8d2e440d85b0bu, 0xf3daee1367be4526u, 0xf3daee1367be4526u, 0x522aaff18d36548au},
+	{ 1023u, 0xd19e36e06768d8f0u, 0xdf6d4cdaf9acd422u, 0xdf6d4cdaf9acd422u, 0x1be93a53c17dcc54u},
+	{ 1024u, 0xdf964ad9cddc4440u, 0x9fb9947417c15b80u, 0x9fb9947417c15b80u, 0xefaa73720eec0a33u},
+	{ 1025u, 0x40a17fc9fca94d75u, 0xfe1b47100b1d79d8u, 0xfe1b47100b1d79d8u, 0xd42732dbb96b6c2bu},
+	{ 2048u, 0x48b8060f13ceb867u, 0x650cf45cdde6160au, 0x650cf45cdde6160au, 0xdc5c874eec8efb6fu},
+	{ 3000u, 0x251d1b67e167b3c1u, 0xd447a759fd0193b7u, 0xd447a759fd0193b7u, 0xadcef52cba93e53eu},
+	{20000u, 0x1266293d274331cdu, 0x267fdb25f0b94b2du, 0x267fdb25f0b94b2du, 0xd4b4a5167fb40fd1u},
+};
+
+static xxh_vector const vectors_seed_b[]{
+	{    0u, 0xc4349fc93c010000u, 0x602b0e2cd6662c8bu, 0x4ca5176998171787u, 0xd142977a2cca554bu},
+	{    1u, 0x585882422a6165e7u, 0x2f3acd3805f81de3u, 0x2f3acd3805f81de3u, 0x00a711eb5a736b26u},
+	{    2u, 0x44c43596a6307bb0u, 0x28a7b77c08c091ebu, 0x28a7b77c08c091ebu, 0x729f8aae8729063cu},
+	{    3u, 0x45fa1406538fa168u, 0xbc74611d87f659e0u, 0xbc74611d87f659e0u, 0x3f5fd00ff400ba58u},
+	{    4u, 0xa65107f22943365au, 0x6c3753177c607de4u, 0xc63af37da30d5d08u, 0x7e5d191bd8d354e6u},
+	{    5u, 0xf51eda3a20de9b88u, 0xc527066b4c496b85u, 0x2cc1691173e89377u, 0x6be318dc7b2fb79cu},
+	{    8u, 0xce592d5f53e192ecu, 0xbc72d0531396303fu, 0x8a88691d5cecb7b6u, 0x9b51bcd70be038f6u},
+	{    9u, 0x5495aa796de8ab73u, 0x93c5aa006102daf5u, 0xa1e691e73aaf9ca5u, 0xc0dd1f12f479931bu},
+	{   15u, 0x47a857d1f90c35e1u, 0x082933f851ba6e46u, 0xb3d5c583a94771deu, 0x9ab345e6bcac3acbu},
+	{   16u, 0x3f8fea7c86a04013u, 0x69d001b16ecf450au, 0x1097f793402c818au, 0xd5f6fdbf62cdc681u},
+	{   17u, 0xe5044d205f3d2f74u, 0xb7c99d19be27eb69u, 0x553306f0d043114cu, 0xfdb93ea9bd7c5a87u},
+	{   31u, 0x24c4e99ab0404b5eu, 0x4d0ca634ab4ca4f4u, 0x71f599128523ec7cu, 0xb5c71d9d392be41cu},
+	{   32u, 0x046e99bbda1a814bu, 0xe5fb38c81d49c6f5u, 0x8113676252dbe0c7u, 0x731432cbcc022e37u},
+	{   33u, 0xd7fe2bfee6e4cdedu, 0x5a46a370c35146acu, 0x8baa0fec23cfddf3u, 0xa5369adeeda33584u},
+	{   63u, 0xbd457f9ea47180c8u, 0x92944c1b6245dd77u, 0x29b4461d3350d20fu, 0xa525f95a97125fc3u},
+	{   64u, 0xa768f350a8e4fcf6u, 0x543fa55d8db03991u, 0x60ce1b9d00ac1042u, 0x6c800fcd18b46b32u},
+	{   65u, 0xfe99ab21e40d4b0cu, 0xf3efe40559a76a28u, 0xafdec891bf7066bdu, 0x6d799965351e22d8u},
+	{   96u, 0x01a18accd4cb50afu, 0x260f288635623ee8u, 0x79cd945d75928ca3u, 0x4b06b5d340f2cb02u},
+	{   97u, 0x90c8f5ae688cef2au, 0x58817b2a6ec0ed2eu, 0x2ea3921926f4cf9du, 0x0be14f6d3382fc98u},
+	{  128u, 0xa17ef243ce1ff792u, 0x49b81c6e0abb9305u, 0x18528564127001a4u, 0x98b7168a26969c36u},
+	{  129u, 0xb5d711b6226e05b6u, 0x5e3831b221810b00u, 0x54e9357c883cec48u, 0x03159dbf8591c495u},
+	{  200u, 0xcd5273f408a4cfbcu, 0x83264818fb531769u, 0xba852c1a37ad8096u, 0xfac3060dae982a81u},
+	{  240u, 0x85e504429b241d4fu, 0x76a73ec26433f82cu, 0xfcac543705c8c541u, 0xde30c63ee85a3579u},
+	{  241u, 0x537b9610b2f8022du, 0x2be236ba3bacf75cu, 0x2be236ba3bacf75cu, 0x7be6397a1dfd48ccu},
+	{  255u, 0xf91cb247d93dfe82u, 0x407522ce8ddf4b58u, 0x407522ce8ddf4b58u, 0xa1648aee50eac98bu},
+	{  256u, 0x0fdd97b3e0f22d80u, 0x92999d62f0815eefu, 0x92999d62f0815eefu, 0x32f10ace78688c34u},
+	{  257u, 0x12aec49d6ae6f794u, 0xabe1fabe4e15920bu, 0xabe1fabe4e15920bu, 0x3b67526cb5ab6112u},
+	{  511u, 0xe0731de64d79c90eu, 0x0c6595c6272c0c58u, 0x0c6595c6272c0c58u, 0x21d1f7df2977acf4u},
+	{  512u, 0x31a46e65a990a14bu, 0x2079de80034b2b58u, 0x2079de80034b2b58u, 0x7206eedeb32f793eu},
+	{ 1023u, 0x5a822b726c8332efu, 0x6ead689a3ab564a8u, 0x6ead689a3ab564a8u, 0x5053f1286b53747au},
+	{ 1024u, 0x21dd42f5cc15ab0eu, 0x6fcbb2c4c7c9ceb3u, 0x6fcbb2c4c7c9ceb3u, 0x2927ea86a057d175u},
+	{ 1025u, 0x437c8c83f6df77e8u, 0xb25de0d05cf6da28u, 0xb25de0d05cf6da28u, 0x588909266b1f5e1cu},
+	{ 2048u, 0xee4d54c2d1dc8008u, 0xc4710df89f78a974u, 0xc4710df89f78a974u, 0x5971fa6cb6453bb5u},
+	{ 3000u, 0xda8bfd12ad2ed2b5u, 0x30a5e620771fe0a5u, 0x30a5e620771fe0a5u, 0xd4953292bebc1ec5u},
+	{20000u, 0xae7c081b4516bdb4u, 0x827bb15942cda572u, 0x827bb15942cda572u, 0x79249f36932b5f41u},
+};
+
+// Folds over every size in [0, 2200)
+struct xxh_fold {
+	std::uint64_t xxh64;
+	std::uint64_t xxh3_64;
+	std::uint64_t xxh3_128_lo;
+	std::uint64_t xxh3_128_hi;
+};
+
+static xxh_fold const fold_seed_0{
+	0xc989a533ea5f1be5u, 0xe4f0b5514cd17d83u, 0x3ab5f562af222872u, 0x5769e3565aab3481u
+};
+
+static xxh_fold const fold_seed_b{
+	0xfd0dafaf1931c9a9u, 0x3875bfb014412ca2u, 0x5924c82835eda263u, 0x67dcf853d453eb25u
+};
+
+static std::vector<char>
+make_data(
+	unsigned const size
+) {
+	std::vector<char> data(size);
+	for (unsigned i = 0; i < size; ++i) {
+		data[i] = static_cast<char>(((i * 131u + 7u) ^ (i >> 8)) & 0xffu);
+	}
+	return data;
+}
+
+static std::uint64_t
+lo64(
+	xxh3_128::hash_type const& h
+) {
+	std::uint64_t x;
+	std::memcpy(&x, h.data + 0, 8u);
+	return x;
+}
+
+static std::uint64_t
+hi64(
+	xxh3_128::hash_type const& h
+) {
+	std::uint64_t x;
+	std::memcpy(&x, h.data + 8, 8u);
+	return x;
+}
+
+static std::uint64_t
+rotl(
+	std::uint64_t const x
+) {
+	return (x << 5) | (x >> 59);
+}
+
+template<class Impl>
+static typename Impl::hash_type
+calc_streamed(
+	char const* const data,
+	unsigned const size,
+	std::uint64_t const seed,
+	unsigned const step
+) {
+	am::hash::generic_combiner<Impl> combiner{seed};
+	unsigned chunk = 1u;
+	for (unsigned i = 0; i < size;) {
+		unsigned const n = chunk < size - i ? chunk : size - i;
+		combiner.add(data + i, n);
+		i += n;
+		chunk = (chunk * step) % 601u + 1u;
+	}
+	fassert(combiner.size() == size);
+	return combiner.value();
+}
+
+static void
+test_vectors(
+	xxh_vector const (&vectors)[35],
+	xxh_fold const& fold,
+	std::uint64_t const seed,
+	std::vector<char> const& data
+) {
+	for (auto const& v : vectors) {
+		char const* const p = data.data();
+		fassert(am::hash::calc<am::hash::xxh64>(p, v.size, seed) == v.xxh64);
+		fassert(am::hash::calc<xxh3_64>(p, v.size, seed) == v.xxh3_64);
+		auto const h128 = am::hash::calc<xxh3_128>(p, v.size, seed);
+		fassert(lo64(h128) == v.xxh3_128_lo);
+		fassert(hi64(h128) == v.xxh3_128_hi);
+	}
+
+	xxh_fold f{0u, 0u, 0u, 0u};
+	for (unsigned size = 0; size < 2200u; ++size) {
+		char const* const p = data.data();
+		f.xxh64 = rotl(f.xxh64) ^ am::hash::calc<am::hash::xxh64>(p, size, seed);
+		f.xxh3_64 = rotl(f.xxh3_64) ^ am::hash::calc<xxh3_64>(p, size, seed);
+		auto const h128 = am::hash::calc<xxh3_128>(p, size, seed);
+		f.xxh3_128_lo = rotl(f.xxh3_128_lo) ^ lo64(h128);
+		f.xxh3_128_hi = rotl(f.xxh3_128_hi) ^ hi64(h128);
+
+		// Streaming in uneven chunks gives the same value
+		unsigned const step = 3u + size % 7u;
+		fassert(
+			calc_streamed<am::hash::xxh64>(p, size, seed, step)
+			== am::hash::calc<am::hash::xxh64>(p, size, seed)
+		);
+		fassert(
+			calc_streamed<xxh3_64>(p, size, seed, step)
+			== am::hash::calc<xxh3_64>(p, size, seed)
+		);
+		auto const s128 = calc_streamed<xxh3_128>(p, size, seed, step);
+		fassert(lo64(s128) == lo64(h128) && hi64(s128) == hi64(h128));
+	}
+	fassert(f.xxh64 == fold.xxh64);
+	fassert(f.xxh3_64 == fold.xxh3_64);
+	fassert(f.xxh3_128_lo == fold.xxh3_128_lo);
+	fassert(f.xxh3_128_hi == fold.xxh3_128_hi);
+}
+
+signed main() {
+	std::vector<char> const data = make_data(20000u);
+	test_vectors(vectors_seed_0, fold_seed_0, 0u, data);
+	test_vectors(vectors_seed_b, fold_seed_b, seed_b, data);
+
+	// Large streamed input, one byte then large chunks
+	{
+		std::vector<char> const big = make_data(1u << 20);
+		unsigned const size = static_cast<unsigned>(big.size());
+		am::hash::generic_combiner<xxh3_64> c3{7u};
+		am::hash::generic_combiner<am::hash::xxh64> c64{7u};
+		c3.add(big.data(), 1u);
+		c64.add(big.data(), 1u);
+		for (unsigned i = 1u; i < size; i += 65537u) {
+			unsigned const n = 65537u < size - i ? 65537u : size - i;
+			c3.add(big.data() + i, n);
+			c64.add(big.data() + i, n);
+		}
+		fassert(c3.value() == am::hash::calc<xxh3_64>(big.data(), size, 7u));
+		fassert(c64.value() == am::hash::calc<am::hash::xxh64>(big.data(), size, 7u));
+
+		// value() does not mutate the state
+		c3.add(big.data(), 10u);
+		fassert(c3.value() == c3.value());
+	}
+
+	// Strings
+	{
+		std::string const str{"xxHash"};
+		fassert(
+			am::hash::calc_string<xxh3_64>(str, 0u)
+			== am::hash::calc<xxh3_64>(str.data(), str.size(), 0u)
+		);
+	}
+	return 0;
+}
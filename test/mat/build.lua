@@ -2,4 +2,7 @@
 make_tests(
 	"mat", {
 	["operators"] = {nil, nil},
+	["eigen"] = {nil, nil},
+	["decompose"] = {nil, nil},
+	["factorization"] = {nil, nil},
 })
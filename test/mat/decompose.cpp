@@ -0,0 +1,175 @@
+
+#include <am/config.hpp>
+#include <am/linear/matrix.hpp>
+#include <am/linear/decompose.hpp>
+
+#include "./common.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using am::linear::vec3;
+using am::linear::mat3x3;
+using am::linear::mat4x4;
+
+static std::uint32_t g_state = 0x2545F491u;
+
+static float
+random_unit() {
+	g_state = g_state * 1664525u + 1013904223u;
+	return static_cast<float>(g_state >> 8) / 8388608.0f - 1.0f;
+}
+
+static vec3
+random_vec3() {
+	float const x = random_unit();
+	float const y = random_unit();
+	return vec3{x, y, random_unit()};
+}
+
+// Rotation from an axis and angle
+static mat3x3
+rotation(
+	vec3 axis,
+	float const angle
+) {
+	axis = am::linear::normalize(axis);
+	float const c = std::cos(angle), s = std::sin(angle), k = 1.0f - c;
+	return mat3x3{
+		c + axis.x * axis.x * k, axis.y * axis.x * k + axis.z * s, axis.z * axis.x * k - axis.y * s,
+		axis.x * axis.y * k - axis.z * s, c + axis.y * axis.y * k, axis.z * axis.y * k + axis.x * s,
+		axis.x * axis.z * k + axis.y * s, axis.y * axis.z * k - axis.x * s, c + axis.z * axis.z * k
+	};
+}
+
+template<class M>
+static float
+max_error(
+	M const& a,
+	M const& b
+) {
+	float e = 0.0f;
+	for (unsigned c = 0; c < M::col_type::size(); ++c) {
+		for (unsigned r = 0; r < M::row_type::size(); ++r) {
+			e = std::max(e, std::abs(a.data[c][r] - b.data[c][r]));
+		}
+	}
+	return e;
+}
+
+static bool
+is_rotation(
+	mat3x3 const& m
+) {
+	return
+		max_error(am::linear::transpose(m) * m, mat3x3{1.0f}) < 1e-5f &&
+		std::abs(am::linear::determinant(m) - 1.0f) < 1e-5f
+	;
+}
+
+static void
+check_polar(
+	mat3x3 const& m
+) {
+	mat3x3 r, p;
+	am::linear::polar_decompose(m, r, p);
+	fassert(is_rotation(r));
+	fassert(max_error(p, am::linear::transpose(p)) < 1e-5f);
+	fassert(max_error(r * p, m) < 1e-5f);
+}
+
+void
+test_polar() {
+	check_polar(mat3x3{1.0f});
+	check_polar(mat3x3{2.0f});
+	check_polar(mat3x3{-1.0f});
+	check_polar(rotation(vec3{1.0f, 2.0f, 3.0f}, 1.0f));
+	// Singular
+	check_polar(mat3x3{0.0f});
+	check_polar(mat3x3{
+		1.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f,
+		0.0f, 0.0f, 0.0f
+	});
+	check_polar(mat3x3{
+		1.0f, 2.0f, 3.0f,
+		2.0f, 4.0f, 6.0f,
+		1.0f, 0.0f, 1.0f
+	});
+
+	// Rotation times stretch recovers both
+	for (unsigned i = 0; i < 500; ++i) {
+		mat3x3 const q = rotation(random_vec3(), 3.0f * random_unit());
+		mat3x3 const s = am::linear::transpose(q) * mat3x3{
+			1.5f, 0.0f, 0.0f,
+			0.0f, 0.5f, 0.0f,
+			0.0f, 0.0f, 2.0f
+		} * q;
+		mat3x3 const r0 = rotation(random_vec3(), 3.0f * random_unit());
+		mat3x3 r, p;
+		am::linear::polar_decompose(r0 * s, r, p);
+		fassert(max_error(r, r0) < 1e-5f && max_error(p, s) < 1e-5f);
+
+		mat3x3 m;
+		for (unsigned c = 0; c < 3; ++c) {
+			m.data[c] = random_vec3();
+		}
+		check_polar(m);
+	}
+}
+
+void
+test_trs() {
+	vec3 const t0{1.0f, -2.0f, 3.0f};
+	vec3 const s0{2.0f, 0.5f, 3.0f};
+	mat3x3 const r0 = rotation(vec3{0.3f, -1.0f, 0.2f}, 0.7f);
+	mat4x4 const m = am::linear::compose(t0, r0, s0);
+
+	vec3 t, s;
+	mat3x3 r;
+	am::linear::decompose(m, t, r, s);
+	fassert(t == t0);
+	fassert(am::linear::distance(s, s0) < 1e-5f);
+	fassert(max_error(r, r0) < 1e-5f);
+
+	// Mirrored transforms come out with negative scale
+	mat4x4 const mirror = am::linear::compose(t0, r0, vec3{-1.0f, 1.0f, 1.0f});
+	am::linear::decompose(mirror, t, r, s);
+	fassert(is_rotation(r) && s.x < 0.0f && s.y < 0.0f && s.z < 0.0f);
+	fassert(max_error(am::linear::compose(t, r, s), mirror) < 1e-5f);
+}
+
+void
+test_batch() {
+	std::size_t const count = 29;
+	std::vector<mat4x4> m(count);
+	std::vector<mat3x3> r(count);
+	std::vector<vec3> t(count), s(count);
+	for (std::size_t i = 0; i < count; ++i) {
+		m[i] = am::linear::compose(
+			random_vec3(),
+			rotation(random_vec3(), 3.0f * random_unit()),
+			random_vec3() + vec3{2.0f}
+		);
+	}
+	// A singular one among them
+	m[9] = am::linear::compose(vec3{1.0f}, mat3x3{1.0f}, vec3{1.0f, 0.0f, 1.0f});
+	am::linear::decompose(count, m.data(), t.data(), r.data(), s.data());
+	for (std::size_t i = 0; i < count; ++i) {
+		vec3 st, ss;
+		mat3x3 sr;
+		am::linear::decompose(m[i], st, sr, ss);
+		fassert(st == t[i]);
+		fassert(max_error(sr, r[i]) < 1e-6f && am::linear::distance(ss, s[i]) < 1e-6f);
+		fassert(max_error(am::linear::compose(t[i], r[i], s[i]), m[i]) < 1e-5f);
+	}
+}
+
+signed main() {
+	test_polar();
+	test_trs();
+	test_batch();
+	return 0;
+}
@@ -0,0 +1,195 @@
+
+#include <am/config.hpp>
+#include <am/linear/matrix.hpp>
+#include <am/linear/eigen.hpp>
+
+#include "./common.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using am::linear::vec3;
+using am::linear::mat3x3;
+using dmat3x3 = am::detail::linear::tmat3x3<double>;
+using dvec3 = am::detail::linear::tvec3<double>;
+
+static std::uint32_t g_state = 0x9E3779B9u;
+
+static double
+random_unit() {
+	g_state = g_state * 1664525u + 1013904223u;
+	return static_cast<double>(g_state >> 8) / 8388608.0 - 1.0;
+}
+
+template<class T>
+static am::detail::linear::tmat3x3<T>
+random_matrix() {
+	am::detail::linear::tmat3x3<T> m;
+	for (unsigned c = 0; c < 3; ++c) {
+		for (unsigned r = 0; r < 3; ++r) {
+			m.data[c][r] = static_cast<T>(random_unit());
+		}
+	}
+	return m;
+}
+
+template<class T>
+static am::detail::linear::tmat3x3<T>
+diagonal(
+	am::detail::linear::tvec3<T> const& d
+) {
+	am::detail::linear::tmat3x3<T> m{T(0)};
+	m.data[0].x = d.x;
+	m.data[1].y = d.y;
+	m.data[2].z = d.z;
+	return m;
+}
+
+template<class T>
+static T
+max_error(
+	am::detail::linear::tmat3x3<T> const& a,
+	am::detail::linear::tmat3x3<T> const& b
+) {
+	T e{0};
+	for (unsigned c = 0; c < 3; ++c) {
+		for (unsigned r = 0; r < 3; ++r) {
+			e = std::max(e, std::abs(a.data[c][r] - b.data[c][r]));
+		}
+	}
+	return e;
+}
+
+template<class T>
+static bool
+is_rotation(
+	am::detail::linear::tmat3x3<T> const& m,
+	T const tolerance
+) {
+	return
+		max_error(am::linear::transpose(m) * m, am::detail::linear::tmat3x3<T>{T(1)}) < tolerance &&
+		std::abs(am::linear::determinant(m) - T(1)) < tolerance
+	;
+}
+
+template<class T>
+static void
+check_eigen(
+	am::detail::linear::tmat3x3<T> const& a,
+	T const tolerance
+) {
+	am::detail::linear::tvec3<T> values;
+	am::detail::linear::tmat3x3<T> vectors;
+	am::linear::eigen_symmetric(a, values, vectors);
+	fassert(values.x >= values.y && values.y >= values.z);
+	fassert(is_rotation(vectors, tolerance));
+	fassert(max_error(vectors * diagonal(values) * am::linear::transpose(vectors), a) < tolerance);
+}
+
+template<class T>
+static void
+check_svd(
+	am::detail::linear::tmat3x3<T> const& a,
+	T const tolerance
+) {
+	am::detail::linear::tmat3x3<T> u, v;
+	am::detail::linear::tvec3<T> sigma;
+	am::linear::svd(a, u, sigma, v);
+	fassert(sigma.x >= sigma.y && sigma.y >= std::abs(sigma.z));
+	fassert(is_rotation(u, tolerance) && is_rotation(v, tolerance));
+	fassert(max_error(u * diagonal(sigma) * am::linear::transpose(v), a) < tolerance);
+}
+
+void
+test_eigen() {
+	// Known spectrum
+	mat3x3 const a{
+		2.0f, 1.0f, 0.0f,
+		1.0f, 2.0f, 0.0f,
+		0.0f, 0.0f, 5.0f
+	};
+	vec3 values;
+	mat3x3 vectors;
+	am::linear::eigen_symmetric(a, values, vectors);
+	fassert(std::abs(values.x - 5.0f) < 1e-6f);
+	fassert(std::abs(values.y - 3.0f) < 1e-6f);
+	fassert(std::abs(values.z - 1.0f) < 1e-6f);
+	fassert(std::abs(std::abs(vectors.data[0].z) - 1.0f) < 1e-6f);
+
+	// Degenerate: repeated, zero, diagonal
+	check_eigen(mat3x3{1.0f}, 1e-6f);
+	check_eigen(mat3x3{0.0f}, 1e-6f);
+	check_eigen(diagonal(vec3{1.0f, 3.0f, 2.0f}), 1e-6f);
+	check_eigen(mat3x3{
+		1.0f, 1.0f, 1.0f,
+		1.0f, 1.0f, 1.0f,
+		1.0f, 1.0f, 1.0f
+	}, 1e-5f);
+
+	// Random symmetric
+	for (unsigned i = 0; i < 1000; ++i) {
+		mat3x3 const m = random_matrix<float>();
+		check_eigen(m + am::linear::transpose(m), 1e-5f);
+		dmat3x3 const d = random_matrix<double>();
+		check_eigen(d + am::linear::transpose(d), 1e-13);
+	}
+}
+
+void
+test_svd() {
+	check_svd(mat3x3{1.0f}, 1e-6f);
+	check_svd(mat3x3{0.0f}, 1e-6f);
+	check_svd(mat3x3{-1.0f}, 1e-6f);
+	// Rank 1 and 2
+	check_svd(mat3x3{
+		1.0f, 2.0f, 3.0f,
+		2.0f, 4.0f, 6.0f,
+		3.0f, 6.0f, 9.0f
+	}, 1e-5f);
+	check_svd(mat3x3{
+		1.0f, 0.0f, 0.0f,
+		0.0f, 1.0f, 0.0f,
+		1.0f, 1.0f, 0.0f
+	}, 1e-5f);
+
+	for (unsigned i = 0; i < 1000; ++i) {
+		check_svd(random_matrix<float>(), 1e-5f);
+		check_svd(random_matrix<double>(), 1e-12);
+	}
+}
+
+void
+test_batch() {
+	std::size_t const count = 37;
+	std::vector<mat3x3> m(count), u(count), v(count), w(count);
+	std::vector<vec3> sigma(count), values(count);
+	for (auto& x : m) {
+		x = random_matrix<float>();
+	}
+	am::linear::svd(count, m.data(), u.data(), sigma.data(), v.data());
+	for (std::size_t i = 0; i < count; ++i) {
+		mat3x3 su, sv;
+		vec3 ss;
+		am::linear::svd(m[i], su, ss, sv);
+		fassert(max_error(su, u[i]) < 1e-6f && max_error(sv, v[i]) < 1e-6f);
+		fassert(am::linear::distance(ss, sigma[i]) < 1e-6f);
+		m[i] = m[i] + am::linear::transpose(m[i]);
+	}
+	am::linear::eigen_symmetric(count, m.data(), values.data(), w.data());
+	for (std::size_t i = 0; i < count; ++i) {
+		mat3x3 sw;
+		vec3 sx;
+		am::linear::eigen_symmetric(m[i], sx, sw);
+		fassert(max_error(sw, w[i]) < 1e-6f);
+		fassert(am::linear::distance(sx, values[i]) < 1e-6f);
+	}
+}
+
+signed main() {
+	test_eigen();
+	test_svd();
+	test_batch();
+	return 0;
+}
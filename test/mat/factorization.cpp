@@ -0,0 +1,187 @@
+
+#include <am/config.hpp>
+#include <am/linear/matrix.hpp>
+#include <am/linear/factorization.hpp>
+
+#include "./common.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using am::linear::vec2;
+using am::linear::vec3;
+using am::linear::vec4;
+using am::linear::mat2x2;
+using am::linear::mat3x3;
+using am::linear::mat4x4;
+using dmat4x4 = am::detail::linear::tmat4x4<double>;
+
+static std::uint32_t g_state = 0x6A09E667u;
+
+static float
+random_unit() {
+	g_state = g_state * 1664525u + 1013904223u;
+	return static_cast<float>(g_state >> 8) / 8388608.0f - 1.0f;
+}
+
+template<class Cons>
+static Cons
+random_matrix() {
+	Cons m;
+	for (std::size_t c = 0; c < Cons::col_type::size(); ++c) {
+		for (std::size_t r = 0; r < Cons::col_type::size(); ++r) {
+			m.data[c][r] = static_cast<typename Cons::value_type>(random_unit());
+		}
+	}
+	return m;
+}
+
+template<class Cons>
+static typename Cons::col_type
+random_vector() {
+	typename Cons::col_type v;
+	for (std::size_t i = 0; i < v.size(); ++i) {
+		v[i] = static_cast<typename Cons::value_type>(random_unit());
+	}
+	return v;
+}
+
+// Well-conditioned SPD matrix
+template<class Cons>
+static Cons
+random_spd() {
+	Cons const m = random_matrix<Cons>();
+	return am::linear::transpose(m) * m + Cons{typename Cons::value_type(1)};
+}
+
+template<class Vec>
+static typename Vec::value_type
+max_error(
+	Vec const& a,
+	Vec const& b
+) {
+	typename Vec::value_type e{0};
+	for (std::size_t i = 0; i < a.size(); ++i) {
+		e = std::max(e, std::abs(a[i] - b[i]));
+	}
+	return e;
+}
+
+template<class Cons>
+static void
+check_solvers(
+	typename Cons::value_type const tolerance
+) {
+	using Vec = typename Cons::col_type;
+	for (unsigned i = 0; i < 200; ++i) {
+		Cons const a = random_spd<Cons>();
+		Vec const b = random_vector<Cons>();
+
+		Cons l = a;
+		fassert(am::linear::cholesky(l));
+		fassert(max_error(a * am::linear::cholesky_solve(l, b), b) < tolerance);
+		for (std::size_t c = 1; c < b.size(); ++c) {
+			fassert(l.data[c][0] == 0);
+		}
+		Cons const llt = l * am::linear::transpose(l);
+		for (std::size_t c = 0; c < b.size(); ++c) {
+			fassert(max_error(llt.data[c], a.data[c]) < tolerance);
+		}
+
+		Cons ld = a;
+		fassert(am::linear::ldlt(ld));
+		fassert(max_error(a * am::linear::ldlt_solve(ld, b), b) < tolerance);
+
+		Cons const g = random_matrix<Cons>() + Cons{typename Cons::value_type(2)};
+		Cons qr = g;
+		Vec tau;
+		fassert(am::linear::qr(qr, tau));
+		fassert(max_error(g * am::linear::qr_solve(qr, tau, b), b) < tolerance);
+	}
+}
+
+void
+test_solvers() {
+	check_solvers<mat2x2>(1e-5f);
+	check_solvers<mat3x3>(1e-5f);
+	check_solvers<mat4x4>(1e-5f);
+	check_solvers<dmat4x4>(1e-12);
+
+	// Known factor
+	mat3x3 l{
+		4.0f, 2.0f, 2.0f,
+		2.0f, 5.0f, 3.0f,
+		2.0f, 3.0f, 6.0f
+	};
+	fassert(am::linear::cholesky(l));
+	fassert(l == (mat3x3{
+		2.0f, 1.0f, 1.0f,
+		0.0f, 2.0f, 1.0f,
+		0.0f, 0.0f, 2.0f
+	}));
+
+	// Indefinite: Cholesky fails, LDLT and QR succeed
+	mat2x2 const indefinite{
+		1.0f, 2.0f,
+		2.0f, 1.0f
+	};
+	vec2 const b{3.0f, 3.0f};
+	mat2x2 m = indefinite;
+	fassert(!am::linear::cholesky(m));
+	m = indefinite;
+	fassert(am::linear::ldlt(m));
+	fassert(max_error(am::linear::ldlt_solve(m, b), vec2{1.0f}) < 1e-6f);
+
+	// Permutation: zero leading pivot is fine for QR
+	mat3x3 p{
+		0.0f, 1.0f, 0.0f,
+		1.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 1.0f
+	};
+	vec3 tau;
+	fassert(am::linear::qr(p, tau));
+	fassert(max_error(am::linear::qr_solve(p, tau, vec3{1.0f, 2.0f, 3.0f}), vec3{2.0f, 1.0f, 3.0f}) < 1e-6f);
+
+	// Singular
+	mat3x3 s{0.0f};
+	fassert(!am::linear::qr(s, tau));
+	s = mat3x3{0.0f};
+	fassert(!am::linear::ldlt(s));
+}
+
+void
+test_batch() {
+	std::size_t const count = 21;
+	std::vector<mat4x4> a(count);
+	std::vector<vec4> b(count), x(count);
+	for (std::size_t i = 0; i < count; ++i) {
+		a[i] = random_spd<mat4x4>();
+		b[i] = random_vector<mat4x4>();
+	}
+	fassert(am::linear::cholesky_solve(count, a.data(), b.data(), x.data()));
+	for (std::size_t i = 0; i < count; ++i) {
+		mat4x4 l = a[i];
+		am::linear::cholesky(l);
+		fassert(max_error(x[i], am::linear::cholesky_solve(l, b[i])) < 1e-6f);
+	}
+	fassert(am::linear::ldlt_solve(count, a.data(), b.data(), x.data()));
+	for (std::size_t i = 0; i < count; ++i) {
+		fassert(max_error(a[i] * x[i], b[i]) < 1e-5f);
+	}
+	fassert(am::linear::qr_solve(count, a.data(), b.data(), x.data()));
+	for (std::size_t i = 0; i < count; ++i) {
+		fassert(max_error(a[i] * x[i], b[i]) < 1e-5f);
+	}
+
+	a[5] = mat4x4{-1.0f};
+	fassert(!am::linear::cholesky_solve(count, a.data(), b.data(), x.data()));
+	fassert(max_error(a[4] * x[4], b[4]) < 1e-5f);
+}
+
+signed main() {
+	test_solvers();
+	test_batch();
+	return 0;
+}
@@ -0,0 +1,7 @@
+
+make_tests(
+	"random", {
+	["engine"] = {nil, nil},
+	["distribution"] = {nil, nil},
+	["noise"] = {nil, nil},
+})
@@ -0,0 +1,201 @@
+
+#include <am/config.hpp>
+#include <am/linear/vector.hpp>
+#include <am/random/engine.hpp>
+#include <am/random/distribution.hpp>
+
+#include "./common.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using am::linear::vec2;
+using am::linear::vec3;
+using am::random::xoshiro256pp;
+using am::random::xoshiro256pp_lanes;
+using am::random::pcg32;
+using am::random::philox4x32;
+
+template<class T>
+static void
+check_moments(
+	std::vector<T> const& x,
+	double const mean,
+	double const variance
+) {
+	double m = 0.0, v = 0.0;
+	for (auto const a : x) {
+		m += a;
+	}
+	m /= x.size();
+	for (auto const a : x) {
+		v += (a - m) * (a - m);
+	}
+	v /= x.size();
+	// Five standard errors
+	double const n = static_cast<double>(x.size());
+	fassert(std::abs(m - mean) < 5.0 * std::sqrt(variance / n));
+	fassert(std::abs(v - variance) < 5.0 * variance * std::sqrt(2.0 / n));
+}
+
+template<class T, class Engine>
+static void
+check_scalar(
+	Engine rng
+) {
+	std::size_t const count = 100000;
+	std::vector<T> x(count);
+	for (auto& a : x) {
+		a = am::random::uniform<T>(rng);
+		fassert(T(0) <= a && a < T(1));
+	}
+	check_moments(x, 0.5, 1.0 / 12.0);
+
+	am::random::uniform(rng, count, x.data());
+	for (auto const a : x) {
+		fassert(T(0) <= a && a < T(1));
+	}
+	check_moments(x, 0.5, 1.0 / 12.0);
+
+	for (auto& a : x) {
+		a = am::random::uniform(rng, T(-3), T(5));
+		fassert(T(-3) <= a && a < T(5));
+	}
+	check_moments(x, 1.0, 64.0 / 12.0);
+
+	for (auto& a : x) {
+		a = am::random::normal<T>(rng);
+		fassert(std::isfinite(a));
+	}
+	check_moments(x, 0.0, 1.0);
+
+	// Odd count exercises the unpaired tail
+	x.resize(count - 1);
+	am::random::normal(rng, x.size(), x.data());
+	for (auto const a : x) {
+		fassert(std::isfinite(a));
+	}
+	check_moments(x, 0.0, 1.0);
+}
+
+template<class T, class Engine>
+static void
+check_geometric(
+	Engine rng
+) {
+	using tvec2 = am::detail::linear::tvec2<T>;
+	using tvec3 = am::detail::linear::tvec3<T>;
+	std::size_t const count = 50000;
+	std::vector<tvec3> s(count);
+	std::vector<tvec2> d(count);
+	am::random::on_sphere(rng, count, s.data());
+	am::random::in_disk(rng, count, d.data());
+
+	tvec3 sm{T(0)};
+	tvec2 dm{T(0)};
+	T r2{0};
+	for (std::size_t i = 0; i < count; ++i) {
+		fassert(std::abs(am::linear::length(s[i]) - T(1)) < T(1e-5));
+		fassert(am::linear::dot(d[i], d[i]) < T(1));
+		tvec3 const ps = am::random::on_sphere<T>(rng);
+		tvec2 const pd = am::random::in_disk<T>(rng);
+		fassert(std::abs(am::linear::length(ps) - T(1)) < T(1e-5));
+		fassert(am::linear::dot(pd, pd) < T(1));
+		sm += s[i] + ps;
+		dm += d[i] + pd;
+		r2 += am::linear::dot(d[i], d[i]);
+	}
+	sm /= T(2 * count);
+	dm /= T(2 * count);
+	fassert(am::linear::length(sm) < T(0.02));
+	fassert(am::linear::length(dm) < T(0.02));
+	// E[r^2] = 1/2 for a uniform disk
+	fassert(std::abs(r2 / T(count) - T(0.5)) < T(0.01));
+}
+
+void
+test_distributions() {
+	check_scalar<float>(xoshiro256pp{1});
+	check_scalar<double>(xoshiro256pp_lanes<>{2});
+	check_scalar<float>(pcg32{3});
+	check_scalar<double>(philox4x32{4});
+	check_geometric<float>(xoshiro256pp_lanes<>{5});
+	check_geometric<double>(pcg32{6});
+}
+
+void
+test_vectors() {
+	xoshiro256pp rng{7};
+	vec3 m{0.0f};
+	vec3 v{0.0f};
+	unsigned const count = 50000;
+	for (unsigned i = 0; i < count; ++i) {
+		vec3 const u = am::random::uniform<vec3>(rng);
+		fassert(u.x >= 0.0f && u.y >= 0.0f && u.z >= 0.0f);
+		fassert(u.x < 1.0f && u.y < 1.0f && u.z < 1.0f);
+		vec2 const b = am::random::uniform(rng, vec2{-1.0f, 2.0f}, vec2{1.0f, 4.0f});
+		fassert(b.x >= -1.0f && b.x < 1.0f && b.y >= 2.0f && b.y < 4.0f);
+		vec3 const n = am::random::normal(rng, vec3{1.0f, 2.0f, 3.0f}, vec3{2.0f});
+		m += n;
+		v += (n - vec3{1.0f, 2.0f, 3.0f}) * (n - vec3{1.0f, 2.0f, 3.0f});
+	}
+	m /= static_cast<float>(count);
+	v /= static_cast<float>(count);
+	fassert(am::linear::distance(m, vec3{1.0f, 2.0f, 3.0f}) < 0.05f);
+	fassert(am::linear::distance(v, vec3{4.0f}) < 0.2f);
+
+	// Same engine state gives the same values
+	xoshiro256pp a{8}, b{8};
+	fassert(am::random::normal<vec3>(a) == am::random::normal<vec3>(b));
+	fassert(am::random::uniform<double>(a) == am::random::uniform<double>(b));
+}
+
+template<class Engine>
+static void
+check_standard(
+	Engine rng
+) {
+	std::size_t const count = 100000;
+	std::vector<float> xf(count);
+	std::vector<double> xd(count);
+	for (std::size_t i = 0; i < count; ++i) {
+		xf[i] = am::random::uniform<float>(rng);
+		xd[i] = am::random::uniform<double>(rng);
+		fassert(0.0f <= xf[i] && xf[i] < 1.0f);
+		fassert(0.0 <= xd[i] && xd[i] < 1.0);
+	}
+	check_moments(xf, 0.5, 1.0 / 12.0);
+	check_moments(xd, 0.5, 1.0 / 12.0);
+	for (auto& a : xf) {
+		a = am::random::normal<float>(rng);
+	}
+	check_moments(xf, 0.0, 1.0);
+}
+
+void
+test_standard_engines() {
+	// result_type is 64 bits wide on LP64, but outputs are 32 bits
+	check_standard(std::mt19937{9});
+	check_standard(std::mt19937_64{10});
+
+	// One 32-bit output in the high bits for float, two for double
+	std::mt19937 rng{11};
+	std::mt19937 ref = rng;
+	std::uint64_t const w0 = ref();
+	fassert(am::random::uniform<float>(rng) == static_cast<float>(w0 >> 8) * 5.9604644775390625e-8f);
+	std::uint64_t const w1 = ref();
+	std::uint64_t const w2 = ref();
+	fassert(
+		am::random::uniform<double>(rng) ==
+		static_cast<double>(((w1 << 32) | w2) >> 11) * 1.1102230246251565404e-16
+	);
+}
+
+signed main() {
+	test_distributions();
+	test_vectors();
+	test_standard_engines();
+	return 0;
+}
@@ -0,0 +1,158 @@
+
+#include <am/config.hpp>
+#include <am/random/engine.hpp>
+
+#include "./common.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using am::random::splitmix64;
+using am::random::xoshiro256pp;
+using am::random::xoshiro256pp_lanes;
+using am::random::pcg32;
+using am::random::philox4x32;
+
+template<class Engine>
+static void
+check_generate(
+	Engine a
+) {
+	Engine b = a;
+	std::vector<typename Engine::result_type> x(103);
+	// Uneven pieces exercise the buffered paths
+	a();
+	a.generate(5, x.data());
+	a.generate(61, x.data() + 5);
+	a.generate(37, x.data() + 66);
+	b();
+	for (auto const v : x) {
+		fassert(v == b());
+	}
+	fassert(a() == b());
+}
+
+void
+test_known_answers() {
+	splitmix64 sm{1};
+	fassert(sm() == 0x910a2dec89025cc1ULL);
+	fassert(sm() == 0xbeeb8da1658eec67ULL);
+
+	xoshiro256pp x{1};
+	fassert(x() == 0xcfc5d07f6f03c29bULL);
+	fassert(x() == 0xbf424132963fe08dULL);
+	fassert(x() == 0x19a37d5757aaf520ULL);
+
+	// pcg32-demo reference output
+	pcg32 p{42u, 54u};
+	std::uint32_t const pcg_expected[]{
+		0xa15c02b7u, 0x7b47f409u, 0xba1d3330u,
+		0x83d2f293u, 0xbfa4784bu, 0xcbed606eu
+	};
+	for (auto const v : pcg_expected) {
+		fassert(p() == v);
+	}
+
+	// Random123 known-answer tests
+	std::uint32_t out[4];
+	philox4x32::block({0u, 0u, 0u, 0u}, {0u, 0u}, out);
+	fassert(out[0] == 0x6627e8d5u && out[1] == 0xe169c58du);
+	fassert(out[2] == 0xbc57ac4cu && out[3] == 0x9b00dbd8u);
+	philox4x32::block(
+		{0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu},
+		{0xffffffffu, 0xffffffffu}, out
+	);
+	fassert(out[0] == 0x408f276du && out[1] == 0x41c83b0eu);
+	fassert(out[2] == 0xa20bc7c6u && out[3] == 0x6d5451fdu);
+	philox4x32::block(
+		{0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u},
+		{0xa4093822u, 0x299f31d0u}, out
+	);
+	fassert(out[0] == 0xd16cfe09u && out[1] == 0x94fdccebu);
+	fassert(out[2] == 0x5001e420u && out[3] == 0x24126ea1u);
+
+	// Engine output is the blocks in order
+	philox4x32 ph{0u};
+	fassert(ph() == 0x6627e8d5u);
+	fassert(ph() == 0xe169c58du);
+}
+
+void
+test_generate() {
+	check_generate(splitmix64{7});
+	check_generate(xoshiro256pp{7});
+	check_generate(xoshiro256pp_lanes<>{7});
+	check_generate(xoshiro256pp_lanes<3>{7});
+	check_generate(pcg32{7, 3});
+	check_generate(philox4x32{7, 3});
+
+	// Across a wrap of the low counter words
+	philox4x32 ph{7, 3};
+	ph.seek((std::uint64_t(1) << 62) * 4u - 10u);
+	check_generate(ph);
+}
+
+void
+test_jump() {
+	xoshiro256pp x{1};
+	x.jump();
+	fassert(x() == 0xdafd92f1adffc5b9ULL);
+	xoshiro256pp y{1};
+	y.long_jump();
+	fassert(y() == 0xc6e0f3d2b09d8eecULL);
+
+	// Lane l is the base engine jumped l times
+	xoshiro256pp_lanes<4> lanes{9};
+	xoshiro256pp base{9};
+	xoshiro256pp streams[4];
+	for (auto& s : streams) {
+		s = base;
+		base.jump();
+	}
+	for (unsigned i = 0; i < 10; ++i) {
+		for (auto& s : streams) {
+			fassert(lanes() == s());
+		}
+	}
+	lanes.long_jump();
+	for (auto& s : streams) {
+		s.long_jump();
+	}
+	for (auto& s : streams) {
+		fassert(lanes() == s());
+	}
+
+	// PCG advance matches stepping, and wraps backward
+	pcg32 p{5, 6}, q{5, 6};
+	p.advance(1000);
+	for (unsigned i = 0; i < 1000; ++i) {
+		q();
+	}
+	fassert(p() == q());
+	p.advance(~std::uint64_t(0));
+	pcg32 r{5, 6};
+	r.discard(1000);
+	fassert(p() == r());
+	fassert(pcg32(5, 6)() != pcg32(5, 7)());
+
+	// Philox seek and discard are random access
+	philox4x32 a{11, 2}, b{11, 2};
+	for (unsigned i = 0; i < 1001; ++i) {
+		b();
+	}
+	a.seek(1001);
+	fassert(a() == b());
+	a.discard(6);
+	for (unsigned i = 0; i < 6; ++i) {
+		b();
+	}
+	fassert(a() == b());
+	fassert(philox4x32(11, 2)() != philox4x32(11, 3)());
+}
+
+signed main() {
+	test_known_answers();
+	test_generate();
+	test_jump();
+	return 0;
+}
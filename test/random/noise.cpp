@@ -0,0 +1,181 @@
+
+#include <am/config.hpp>
+#include <am/linear/vector.hpp>
+#include <am/random/engine.hpp>
+#include <am/random/distribution.hpp>
+#include <am/random/noise.hpp>
+
+#include "./common.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using am::linear::vec2;
+using am::linear::vec3;
+using am::linear::uvec2;
+using am::linear::uvec3;
+using am::random::xoshiro256pp;
+
+namespace detail = am::detail::linear;
+
+struct perlin_op {
+	template<class V>
+	static detail::value_type<V>
+	value(V const& p, std::uint32_t const seed) {
+		return am::random::perlin(p, seed);
+	}
+
+	template<class V>
+	static detail::value_type<V>
+	value(V const& p, V& g, std::uint32_t const seed) {
+		return am::random::perlin(p, g, seed);
+	}
+};
+
+struct simplex_op {
+	template<class V>
+	static detail::value_type<V>
+	value(V const& p, std::uint32_t const seed) {
+		return am::random::simplex(p, seed);
+	}
+
+	template<class V>
+	static detail::value_type<V>
+	value(V const& p, V& g, std::uint32_t const seed) {
+		return am::random::simplex(p, g, seed);
+	}
+};
+
+template<class Op, class V>
+static void
+check_noise() {
+	using T = detail::value_type<V>;
+	xoshiro256pp rng{1};
+	unsigned const count = 20000;
+	double mean = 0.0, variance = 0.0;
+	for (unsigned i = 0; i < count; ++i) {
+		V const p = am::random::uniform(rng, V{T(-300)}, V{T(300)});
+		T const v = Op::value(p, 0u);
+		fassert(std::abs(v) <= T(1));
+		fassert(v == Op::value(p, 0u));
+		mean += v;
+		variance += v * v;
+
+		// Value and gradient forms agree (up to contraction); the
+		// gradient matches central differences
+		V g;
+		T const eps = sizeof(T) == 4 ? T(1e-6) : T(1e-14);
+		fassert(std::abs(Op::value(p, g, 0u) - v) < eps);
+		T const h = sizeof(T) == 4 ? T(1e-2) : T(1e-5);
+		for (std::size_t a = 0; a < V::size(); ++a) {
+			V lo = p, hi = p;
+			lo[a] -= h;
+			hi[a] += h;
+			T const fd = (Op::value(hi, 0u) - Op::value(lo, 0u)) / (T(2) * h);
+			fassert(std::abs(fd - g[a]) < (sizeof(T) == 4 ? T(0.05) : T(1e-5)));
+		}
+	}
+	mean /= count;
+	variance /= count;
+	fassert(std::abs(mean) < 0.02);
+	fassert(variance > 0.01);
+
+	// Seeds give unrelated fields
+	unsigned same = 0;
+	for (unsigned i = 0; i < 100; ++i) {
+		V const p = am::random::uniform(rng, V{T(-300)}, V{T(300)});
+		same += Op::value(p, 1u) == Op::value(p, 2u);
+	}
+	fassert(same < 5);
+}
+
+template<class V>
+static void
+check_lattice() {
+	using T = detail::value_type<V>;
+	V p{T(0)};
+	for (int i = -4; i <= 4; ++i) {
+		p[0] = static_cast<T>(i);
+		p[V::size() - 1] = static_cast<T>(3 - i);
+		fassert(am::random::perlin(p) == T(0));
+		fassert(am::random::perlin(p, 7u) == T(0));
+	}
+}
+
+void
+test_single() {
+	check_noise<perlin_op, detail::tvec2<double>>();
+	check_noise<perlin_op, detail::tvec3<double>>();
+	check_noise<perlin_op, detail::tvec4<double>>();
+	check_noise<simplex_op, detail::tvec2<double>>();
+	check_noise<simplex_op, detail::tvec3<double>>();
+	check_noise<simplex_op, detail::tvec4<double>>();
+	check_noise<perlin_op, vec3>();
+	check_noise<simplex_op, vec2>();
+	check_lattice<vec2>();
+	check_lattice<detail::tvec3<double>>();
+	check_lattice<detail::tvec4<float>>();
+}
+
+void
+test_forms() {
+	xoshiro256pp rng{2};
+	std::size_t const count = 77;
+	std::vector<vec3> p(count), g(count), ga(count);
+	std::vector<float> v(count), va(count);
+	for (auto& x : p) {
+		x = am::random::uniform(rng, vec3{-20.0f}, vec3{20.0f});
+	}
+	am::random::perlin(count, p.data(), v.data(), 3u);
+	am::random::perlin(count, p.data(), va.data(), ga.data(), 3u);
+	for (std::size_t i = 0; i < count; ++i) {
+		vec3 gi;
+		float const vi = am::random::perlin(p[i], gi, 3u);
+		fassert(std::abs(v[i] - vi) < 1e-5f && std::abs(va[i] - vi) < 1e-5f);
+		fassert(am::linear::distance(ga[i], gi) < 1e-4f);
+	}
+	am::random::simplex(count, p.data(), v.data(), 3u);
+	am::random::simplex(count, p.data(), va.data(), ga.data(), 3u);
+	for (std::size_t i = 0; i < count; ++i) {
+		vec3 gi;
+		float const vi = am::random::simplex(p[i], gi, 3u);
+		fassert(std::abs(v[i] - vi) < 1e-5f && std::abs(va[i] - vi) < 1e-5f);
+		fassert(am::linear::distance(ga[i], gi) < 1e-4f);
+	}
+
+	// Grids are x-fastest
+	uvec3 const size{37u, 5u, 3u};
+	vec3 const origin{-4.0f, 1.5f, 10.0f};
+	vec3 const step{0.3f, 0.7f, 1.1f};
+	std::size_t const n = size.x * size.y * size.z;
+	std::vector<float> grid(n), grid_g(n);
+	std::vector<vec3> grad(n);
+	am::random::perlin_grid(size, origin, step, grid.data(), 5u);
+	am::random::simplex_grid(size, origin, step, grid_g.data(), grad.data(), 5u);
+	for (unsigned k = 0; k < size.z; ++k)
+	for (unsigned j = 0; j < size.y; ++j)
+	for (unsigned i = 0; i < size.x; ++i) {
+		std::size_t const index = i + size.x * (j + size.y * k);
+		vec3 const q = origin + step * vec3{
+			static_cast<float>(i), static_cast<float>(j), static_cast<float>(k)
+		};
+		vec3 gq;
+		fassert(std::abs(grid[index] - am::random::perlin(q, 5u)) < 1e-5f);
+		fassert(std::abs(grid_g[index] - am::random::simplex(q, gq, 5u)) < 1e-5f);
+		fassert(am::linear::distance(grad[index], gq) < 1e-4f);
+	}
+
+	std::vector<float> row(10);
+	am::random::simplex_grid(uvec2{10u, 1u}, vec2{0.25f}, vec2{0.5f, 0.0f}, row.data());
+	for (unsigned i = 0; i < 10; ++i) {
+		vec2 const q{0.25f + 0.5f * static_cast<float>(i), 0.25f};
+		fassert(std::abs(row[i] - am::random::simplex(q)) < 1e-5f);
+	}
+}
+
+signed main() {
+	test_single();
+	test_forms();
+	return 0;
+}
@@ -2,4 +2,7 @@
 make_tests(
 	"vec", {
 	["operators"] = {nil, nil},
+	["interpolation"] = {nil, nil},
+	["mask"] = {nil, nil},
+	["transcendental"] = {nil, nil},
 })
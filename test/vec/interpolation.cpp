@@ -0,0 +1,240 @@
+
+#include <am/config.hpp>
+#include <am/linear/vector.hpp>
+#include <am/linear/interpolation.hpp>
+#include <am/linear/spline.hpp>
+
+#include "./common.hpp"
+
+#include <cmath>
+
+using am::linear::vec2;
+
+static bool
+near(
+	vec2 const& a,
+	vec2 const& b,
+	float const eps = 1e-4f
+) {
+	return std::abs(a.x - b.x) <= eps && std::abs(a.y - b.y) <= eps;
+}
+
+void
+test_bezier() {
+	vec2 const
+		v0{0.0f, 0.0f},
+		v1{1.0f, 2.0f},
+		v2{3.0f, 2.0f},
+		v3{4.0f, 0.0f}
+	;
+
+	// Quadratic
+	fassert(near(am::linear::bezier_quadratic(v0, v1, v2, 0.0f), v0));
+	fassert(near(am::linear::bezier_quadratic(v0, v1, v2, 1.0f), v2));
+	fassert(near(
+		am::linear::bezier_quadratic(v0, v1, v2, 0.5f),
+		vec2{1.25f, 1.5f}
+	));
+
+	// Subdivision
+	vec2 l3[3], r3[3];
+	am::linear::bezier_quadratic_split(v0, v1, v2, 0.25f, l3, r3);
+	fassert(near(l3[2], am::linear::bezier_quadratic(v0, v1, v2, 0.25f)));
+	fassert(near(
+		am::linear::bezier_quadratic(l3[0], l3[1], l3[2], 0.5f),
+		am::linear::bezier_quadratic(v0, v1, v2, 0.125f)
+	));
+	fassert(near(
+		am::linear::bezier_quadratic(r3[0], r3[1], r3[2], 0.5f),
+		am::linear::bezier_quadratic(v0, v1, v2, 0.625f)
+	));
+
+	vec2 l4[4], r4[4];
+	am::linear::bezier_cubic_split(v0, v1, v2, v3, 0.5f, l4, r4);
+	fassert(near(l4[3], am::linear::bezier_cubic(v0, v1, v2, v3, 0.5f)));
+	fassert(near(
+		am::linear::bezier_cubic(l4[0], l4[1], l4[2], l4[3], 0.5f),
+		am::linear::bezier_cubic(v0, v1, v2, v3, 0.25f)
+	));
+	fassert(near(
+		am::linear::bezier_cubic(r4[0], r4[1], r4[2], r4[3], 0.5f),
+		am::linear::bezier_cubic(v0, v1, v2, v3, 0.75f)
+	));
+
+	// Tessellation
+	enum : std::size_t { N = 64 };
+	vec2 points[N + 1];
+	am::linear::bezier_quadratic_tessellate(v0, v1, v2, N, points);
+	for (std::size_t k = 0; k <= N; ++k) {
+		float const t = static_cast<float>(k) / N;
+		fassert(near(points[k], am::linear::bezier_quadratic(v0, v1, v2, t)));
+	}
+	am::linear::bezier_cubic_tessellate(v0, v1, v2, v3, N, points);
+	for (std::size_t k = 0; k <= N; ++k) {
+		float const t = static_cast<float>(k) / N;
+		fassert(near(points[k], am::linear::bezier_cubic(v0, v1, v2, v3, t)));
+	}
+	fassert(points[N] == v3);
+
+	vec2 const
+		c0[2]{v0, v3},
+		c1[2]{v1, v2},
+		c2[2]{v2, v1},
+		c3[2]{v3, v0}
+	;
+	vec2 batch[(N + 1) * 2];
+	am::linear::bezier_cubic_tessellate_n(2, c0, c1, c2, c3, N, batch);
+	for (std::size_t k = 0; k <= N; ++k) {
+		float const t = static_cast<float>(k) / N;
+		for (std::size_t i = 0; i < 2; ++i) {
+			fassert(near(
+				batch[k * 2 + i],
+				am::linear::bezier_cubic(c0[i], c1[i], c2[i], c3[i], t)
+			));
+		}
+	}
+
+	// Views: contiguous, and control points interleaved per curve
+	using view = am::linear::vec_view<vec2>;
+	vec2 batch_view[(N + 1) * 2];
+	am::linear::bezier_cubic_tessellate_n(
+		view{c0, 2}, view{c1, 2}, view{c2, 2}, view{c3, 2}, N, batch_view
+	);
+	for (std::size_t k = 0; k < (N + 1) * 2; ++k) {
+		fassert(near(batch_view[k], batch[k]));
+	}
+	vec2 const curves[2][4]{
+		{v0, v1, v2, v3},
+		{v3, v2, v1, v0}
+	};
+	std::size_t const stride = sizeof(curves[0]);
+	am::linear::bezier_cubic_tessellate_n(
+		view{&curves[0][0], 2, stride}, view{&curves[0][1], 2, stride},
+		view{&curves[0][2], 2, stride}, view{&curves[0][3], 2, stride},
+		N, batch_view
+	);
+	for (std::size_t k = 0; k < (N + 1) * 2; ++k) {
+		fassert(near(batch_view[k], batch[k]));
+	}
+}
+
+void
+test_spline() {
+	using basis = am::linear::cubic_basis<float>;
+	vec2 const p[6]{
+		vec2{0.0f, 0.0f},
+		vec2{1.0f, 1.0f},
+		vec2{2.0f, 0.0f},
+		vec2{3.0f, 1.0f},
+		vec2{4.0f, 0.0f},
+		vec2{5.0f, 1.0f}
+	};
+
+	// Bézier basis agrees with bezier_cubic
+	for (float t = 0.0f; t <= 1.0f; t += 0.125f) {
+		fassert(near(
+			am::linear::spline_cubic(basis::bezier(), p[0], p[1], p[2], p[3], t),
+			am::linear::bezier_cubic(p[0], p[1], p[2], p[3], t)
+		));
+	}
+
+	// Hermite end points and tangents
+	vec2 const m0{1.0f, 0.0f}, m1{0.0f, 1.0f};
+	fassert(near(am::linear::hermite(p[0], m0, p[2], m1, 0.0f), p[0]));
+	fassert(near(am::linear::hermite(p[0], m0, p[2], m1, 1.0f), p[2]));
+
+	// Catmull-Rom interpolates the inner control points
+	fassert(near(am::linear::catmull_rom(p[0], p[1], p[2], p[3], 0.0f), p[1]));
+	fassert(near(am::linear::catmull_rom(p[0], p[1], p[2], p[3], 1.0f), p[2]));
+	fassert(near(
+		am::linear::catmull_rom_centripetal(p[0], p[1], p[2], p[3], 0.0f), p[1]
+	));
+	fassert(near(
+		am::linear::catmull_rom_centripetal(p[0], p[1], p[2], p[3], 1.0f), p[2]
+	));
+	// alpha = 0 is the uniform curve
+	fassert(near(
+		am::linear::catmull_rom_centripetal(p[0], p[1], p[3], p[5], 0.3f, 0.0f),
+		am::linear::catmull_rom(p[0], p[1], p[3], p[5], 0.3f)
+	));
+
+	// B-spline is C0 across segments
+	fassert(near(
+		am::linear::bspline_cubic(p[0], p[1], p[2], p[3], 1.0f),
+		am::linear::bspline_cubic(p[1], p[2], p[3], p[4], 0.0f)
+	));
+	fassert(near(
+		am::linear::bspline_cubic(p[0], p[1], p[2], p[3], 0.0f),
+		vec2{1.0f, 4.0f / 6.0f}
+	));
+
+	// Batch sampling
+	enum : std::size_t { STEPS = 8 };
+	vec2 out[3 * STEPS + 1];
+	std::size_t const written = am::linear::spline_cubic_sample(
+		basis::catmull_rom(), 6, p, STEPS, out
+	);
+	fassert(3 * STEPS + 1 == written);
+	for (std::size_t s = 0; s < 3; ++s) {
+		for (std::size_t k = 0; k < STEPS; ++k) {
+			fassert(near(
+				out[s * STEPS + k],
+				am::linear::catmull_rom(
+					p[s], p[s + 1], p[s + 2], p[s + 3],
+					static_cast<float>(k) / STEPS
+				)
+			));
+		}
+	}
+	fassert(near(out[3 * STEPS], p[4]));
+
+	// Views: contiguous, and interleaved with other attributes
+	struct Knot {
+		vec2 position;
+		float weight;
+	};
+	Knot knots[6];
+	for (std::size_t i = 0; i < 6; ++i) {
+		knots[i] = Knot{p[i], 1.0f};
+	}
+	vec2 out_view[3 * STEPS + 1];
+	fassert(written == am::linear::spline_cubic_sample(
+		basis::catmull_rom(), am::linear::vec_view<vec2>{p, 6}, STEPS, out_view
+	));
+	for (std::size_t k = 0; k < written; ++k) {
+		fassert(near(out_view[k], out[k]));
+	}
+	fassert(written == am::linear::spline_cubic_sample(
+		basis::catmull_rom(),
+		am::linear::vec_view<vec2>{&knots[0].position, 6, sizeof(Knot)},
+		STEPS, out_view
+	));
+	for (std::size_t k = 0; k < written; ++k) {
+		fassert(near(out_view[k], out[k]));
+	}
+	fassert(0 == am::linear::spline_cubic_sample(
+		basis::catmull_rom(), 3, p, STEPS, out
+	));
+
+	// Arc-length table over a straight line
+	am::linear::arc_length_table<float> table;
+	table.build_from(
+		[](float const u) { return vec2{2.0f * u * u, 0.0f}; },
+		0.0f, 1.0f, 257
+	);
+	fassert(std::abs(table.length() - 2.0f) < 1e-4f);
+	fassert(std::abs(table.parameter(0.5f) - 0.5f) < 1e-3f);
+	fassert(std::abs(table.parameter(-1.0f)) < 1e-6f);
+	fassert(std::abs(table.parameter(4.0f) - 1.0f) < 1e-6f);
+	float params[5];
+	table.uniform_parameters(4, params);
+	for (std::size_t k = 0; k <= 4; ++k) {
+		fassert(std::abs(params[k] - table.parameter(0.5f * k)) < 1e-5f);
+	}
+}
+
+signed main() {
+	test_bezier();
+	test_spline();
+	return 0;
+}
@@ -0,0 +1,75 @@
+
+#include <am/config.hpp>
+#include <am/linear/vector.hpp>
+
+#include "./common.hpp"
+
+#include <limits>
+
+using am::linear::vec2;
+using am::linear::vec3;
+using am::linear::vec4;
+using am::linear::ivec4;
+using am::linear::bvec1;
+using am::linear::bvec2;
+using am::linear::bvec3;
+using am::linear::bvec4;
+
+void
+test_compare() {
+	vec3 const a{1.0f, 2.0f, 3.0f};
+	vec3 const b{3.0f, 2.0f, 1.0f};
+	fassert(am::linear::less(a, b) == (bvec3{true, false, false}));
+	fassert(am::linear::less_equal(a, b) == (bvec3{true, true, false}));
+	fassert(am::linear::greater(a, b) == (bvec3{false, false, true}));
+	fassert(am::linear::greater_equal(a, b) == (bvec3{false, true, true}));
+	fassert(am::linear::equal(a, b) == (bvec3{false, true, false}));
+	fassert(am::linear::not_equal(a, b) == (bvec3{true, false, true}));
+
+	ivec4 const i{-1, 0, 1, 2};
+	fassert(am::linear::less(i, ivec4{0}) == (bvec4{true, false, false, false}));
+	fassert(am::linear::equal(am::linear::vec1{1.0f}, am::linear::vec1{1.0f}) == bvec1{true});
+
+	// NaN compares unequal to everything
+	float const nan = std::numeric_limits<float>::quiet_NaN();
+	vec2 const n{nan, 0.0f};
+	fassert(am::linear::not_equal(n, n) == (bvec2{true, false}));
+	fassert(!am::linear::any(am::linear::less(n, vec2{nan, 0.0f})));
+}
+
+void
+test_any_all() {
+	fassert(!am::linear::any(bvec4{false}));
+	fassert(am::linear::any(bvec4{false, false, true, false}));
+	fassert(!am::linear::all(bvec4{true, true, false, true}));
+	fassert(am::linear::all(bvec4{true}));
+	fassert(am::linear::all(bvec1{true}) && !am::linear::any(bvec1{false}));
+	fassert(am::linear::any(bvec2{true, false}) && !am::linear::all(bvec2{true, false}));
+}
+
+void
+test_select() {
+	vec4 const a{1.0f, 2.0f, 3.0f, 4.0f};
+	vec4 const b{-1.0f, -2.0f, -3.0f, -4.0f};
+	fassert(am::linear::select(bvec4{true}, a, b) == a);
+	fassert(am::linear::select(bvec4{false}, a, b) == b);
+	fassert(
+		am::linear::select(bvec4{true, false, false, true}, a, b)
+		== (vec4{1.0f, -2.0f, -3.0f, 4.0f})
+	);
+
+	// Branch-free absolute value
+	vec3 const v{-1.0f, 0.5f, -0.25f};
+	vec3 const zero{0.0f};
+	fassert(
+		am::linear::select(am::linear::less(v, zero), -v, v)
+		== am::linear::abs(v)
+	);
+}
+
+signed main() {
+	test_compare();
+	test_any_all();
+	test_select();
+	return 0;
+}
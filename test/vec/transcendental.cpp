@@ -0,0 +1,256 @@
+
+#include <am/config.hpp>
+#include <am/linear/vector.hpp>
+#include <am/linear/transcendental.hpp>
+
+#include "./common.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using am::linear::vec2;
+using am::linear::vec4;
+using dvec3 = am::detail::linear::tvec3<double>;
+
+// Distance from the reference in units of the result's ulp
+template<class T>
+static double
+ulp_error(
+	T const value,
+	long double const reference
+) {
+	if (reference == 0.0L) {
+		return value == T(0) ? 0.0 : 1e9;
+	}
+	int e;
+	std::frexp(static_cast<T>(reference), &e);
+	int const exponent = std::max(e, std::numeric_limits<T>::min_exponent);
+	long double const ulp = std::ldexp(1.0L, exponent - std::numeric_limits<T>::digits);
+	return static_cast<double>(std::abs(static_cast<long double>(value) - reference) / ulp);
+}
+
+template<class T>
+static T
+sweep(
+	T const lo,
+	T const hi,
+	unsigned const i,
+	unsigned const n
+) {
+	return lo + (hi - lo) * static_cast<T>(i) / static_cast<T>(n);
+}
+
+template<class T>
+static void
+check_ulp(
+	double const sincos_ulp,
+	double const exp_ulp,
+	double const log_ulp,
+	double const atan2_ulp,
+	double const pow_ulp
+) {
+	namespace detail = am::detail::linear;
+	unsigned const n = 100000;
+	double e_sin = 0, e_exp = 0, e_log = 0, e_atan2 = 0, e_pow = 0;
+	for (unsigned i = 0; i <= n; ++i) {
+		T const x = sweep(T(-8192), T(8192), i, n) + T(0.1234);
+		T s, c;
+		detail::kernel_sincos(x, s, c);
+		e_sin = std::max(e_sin, ulp_error(s, std::sin(static_cast<long double>(x))));
+		e_sin = std::max(e_sin, ulp_error(c, std::cos(static_cast<long double>(x))));
+
+		T const ex = sweep(T(-80), T(80), i, n);
+		e_exp = std::max(e_exp, ulp_error(detail::kernel_exp(ex), std::exp(static_cast<long double>(ex))));
+
+		T const lx = static_cast<T>(std::pow(10.0, sweep(-30.0, 30.0, i, n)));
+		e_log = std::max(e_log, ulp_error(detail::kernel_log(lx), std::log(static_cast<long double>(lx))));
+
+		T const ay = sweep(T(-100), T(100), i, n);
+		T const ax = sweep(T(7), T(-3), i, n);
+		e_atan2 = std::max(e_atan2, ulp_error(
+			detail::kernel_atan2(ay, ax),
+			std::atan2(static_cast<long double>(ay), static_cast<long double>(ax))
+		));
+
+		T const px = sweep(T(0.01), T(100), i, n);
+		T const py = sweep(T(-6), T(6), i, n);
+		e_pow = std::max(e_pow, ulp_error(
+			detail::kernel_pow(px, py),
+			std::pow(static_cast<long double>(px), static_cast<long double>(py))
+		));
+	}
+	fassert(e_sin <= sincos_ulp);
+	fassert(e_exp <= exp_ulp);
+	fassert(e_log <= log_ulp);
+	fassert(e_atan2 <= atan2_ulp);
+	fassert(e_pow <= pow_ulp);
+}
+
+template<class T>
+static void
+check_fast() {
+	namespace detail = am::detail::linear;
+	unsigned const n = 100000;
+	for (unsigned i = 0; i <= n; ++i) {
+		T const x = sweep(T(-8192), T(8192), i, n) + T(0.1234);
+		T s, c;
+		detail::kernel_fast_sincos(x, s, c);
+		fassert(std::abs(s - std::sin(static_cast<long double>(x))) < 4e-6L);
+		fassert(std::abs(c - std::cos(static_cast<long double>(x))) < 4e-6L);
+
+		T const ex = sweep(T(-80), T(80), i, n);
+		long double const er = std::exp(static_cast<long double>(ex));
+		fassert(std::abs(detail::kernel_fast_exp(ex) - er) < 8e-6L * er);
+
+		T const lx = static_cast<T>(std::pow(10.0, sweep(-30.0, 30.0, i, n)));
+		fassert(std::abs(detail::kernel_fast_log(lx) - std::log(static_cast<long double>(lx))) < 1e-5L);
+
+		T const ay = sweep(T(-100), T(100), i, n);
+		T const ax = sweep(T(7), T(-3), i, n);
+		fassert(std::abs(
+			detail::kernel_fast_atan2(ay, ax)
+			- std::atan2(static_cast<long double>(ay), static_cast<long double>(ax))
+		) < 1.2e-5L);
+	}
+}
+
+void
+test_accuracy() {
+	check_ulp<float>(2.5, 1.1, 1.0, 3.5, 0.5);
+	check_ulp<double>(2.0, 2.0, 1.0, 2.0, 40.0);
+	check_fast<float>();
+	check_fast<double>();
+}
+
+void
+test_special() {
+	float const inf = std::numeric_limits<float>::infinity();
+	float const nan = std::numeric_limits<float>::quiet_NaN();
+
+	vec4 const s = am::linear::sin(vec4{0.0f, -0.0f, inf, nan});
+	fassert(s.x == 0.0f && !std::signbit(s.x));
+	fassert(s.y == 0.0f && std::signbit(s.y));
+	fassert(std::isnan(s.z) && std::isnan(s.w));
+	fassert(std::isnan(am::linear::cos(vec2{inf}).x));
+
+	vec4 const e = am::linear::exp(vec4{-inf, inf, 0.0f, -200.0f});
+	fassert(e == (vec4{0.0f, inf, 1.0f, 0.0f}));
+	fassert(std::isnan(am::linear::exp(vec2{nan}).x));
+
+	vec4 const l = am::linear::log(vec4{0.0f, inf, 1.0f, -1.0f});
+	fassert(l.x == -inf && l.y == inf && l.z == 0.0f && std::isnan(l.w));
+	fassert(std::abs(am::linear::log(vec2{1e-40f}).x - std::log(1e-40f)) < 1e-5f);
+
+	vec4 const a = am::linear::atan2(vec4{0.0f, 0.0f, -0.0f, 1.0f}, vec4{1.0f, -1.0f, -1.0f, 0.0f});
+	fassert(a.x == 0.0f);
+	fassert(a.y == std::atan2(0.0f, -1.0f));
+	fassert(a.z == std::atan2(-0.0f, -1.0f));
+	fassert(a.w == std::atan2(1.0f, 0.0f));
+	fassert(am::linear::atan2(vec2{inf}, vec2{inf}).x == std::atan2(inf, inf));
+
+	vec4 const p = am::linear::pow(vec4{-2.0f, -2.0f, 0.0f, 1.0f}, vec4{3.0f, 0.5f, -1.0f, nan});
+	fassert(p.x == -8.0f && std::isnan(p.y) && p.z == inf && p.w == 1.0f);
+	fassert(am::linear::pow(vec2{nan}, 0.0f) == vec2{1.0f});
+	fassert(am::linear::pow(vec2{-1.0f}, inf) == vec2{1.0f});
+	fassert(am::linear::pow(dvec3{2.0}, 10.0) == dvec3{1024.0});
+	// -inf to non-integer, odd and even powers
+	vec4 const pi = am::linear::pow(vec4{-inf}, vec4{0.5f, -0.5f, 3.0f, -3.0f});
+	fassert(pi.x == inf && pi.y == 0.0f && !std::signbit(pi.y));
+	fassert(pi.z == -inf && pi.w == 0.0f && std::signbit(pi.w));
+	vec2 const pe = am::linear::pow(vec2{-inf}, vec2{2.0f, -2.0f});
+	fassert(pe.x == inf && pe.y == 0.0f && !std::signbit(pe.y));
+	double const dinf = std::numeric_limits<double>::infinity();
+	dvec3 const pd = am::linear::pow(dvec3{-dinf}, dvec3{0.5, -0.5, -3.0});
+	fassert(pd.x == dinf && pd.y == 0.0 && !std::signbit(pd.y));
+	fassert(pd.z == 0.0 && std::signbit(pd.z));
+}
+
+void
+test_forms() {
+	std::size_t const count = 37;
+	std::vector<float> x(count), y(count), out(count), s(count), c(count);
+	for (std::size_t i = 0; i < count; ++i) {
+		x[i] = 0.37f * static_cast<float>(i) - 5.0f;
+		y[i] = 0.11f * static_cast<float>(i) + 0.25f;
+	}
+	am::linear::sincos(count, x.data(), s.data(), c.data());
+	am::linear::sin(count, x.data(), out.data());
+	fassert(out == s);
+	am::linear::cos(count, x.data(), out.data());
+	fassert(out == c);
+	for (std::size_t i = 0; i + 4 <= count; i += 4) {
+		vec4 const v{x[i], x[i + 1], x[i + 2], x[i + 3]};
+		vec4 const w{y[i], y[i + 1], y[i + 2], y[i + 3]};
+		vec4 vs, vc;
+		am::linear::sincos(v, vs, vc);
+		fassert(vs == am::linear::sin(v) && vc == am::linear::cos(v));
+		fassert(vs == (vec4{s[i], s[i + 1], s[i + 2], s[i + 3]}));
+
+		am::linear::fast::sincos(v, vs, vc);
+		fassert(vs == am::linear::fast::sin(v) && vc == am::linear::fast::cos(v));
+		fassert(am::linear::distance(vs, am::linear::sin(v)) < 1e-5f);
+		fassert(am::linear::distance(am::linear::fast::exp(w), am::linear::exp(w)) < 1e-4f);
+		fassert(am::linear::distance(am::linear::fast::log(w), am::linear::log(w)) < 1e-4f);
+		fassert(am::linear::distance(am::linear::fast::pow(w, v) / am::linear::pow(w, v), vec4{1.0f}) < 1e-4f);
+		fassert(am::linear::distance(am::linear::fast::atan2(v, w), am::linear::atan2(v, w)) < 1e-4f);
+	}
+
+	am::linear::exp(count, x.data(), out.data());
+	fassert(out[3] == am::linear::exp(vec2{x[3]}).x);
+	am::linear::log(count, y.data(), out.data());
+	fassert(out[4] == am::linear::log(vec2{y[4]}).x);
+	am::linear::pow(count, y.data(), x.data(), out.data());
+	fassert(out[5] == am::linear::pow(vec2{y[5]}, x[5]).x);
+	am::linear::atan2(count, x.data(), y.data(), out.data());
+	fassert(out[6] == am::linear::atan2(vec2{x[6]}, vec2{y[6]}).x);
+	// In place
+	out = x;
+	am::linear::fast::exp(count, out.data(), out.data());
+	fassert(out[7] == am::linear::fast::exp(vec2{x[7]}).x);
+
+	// Views: contiguous, and interleaved (x and y in one vec2)
+	using view = am::linear::vec_view<float>;
+	using span = am::linear::strided_span<float>;
+	std::vector<vec2> xy(count), res(count);
+	for (std::size_t i = 0; i < count; ++i) {
+		xy[i] = vec2{x[i], y[i]};
+	}
+	view const xs{&xy[0].x, count, sizeof(vec2)};
+	view const ys{&xy[0].y, count, sizeof(vec2)};
+	span const res_x{&res[0].x, count, sizeof(vec2)};
+	std::vector<float> ref(count);
+	am::linear::sin(view{x.data(), count}, span{out.data(), count});
+	fassert(out == s);
+	am::linear::cos(xs, res_x);
+	for (std::size_t i = 0; i < count; ++i) {
+		fassert(res[i].x == c[i]);
+	}
+	am::linear::log(ys, span{out.data(), count});
+	am::linear::log(count, y.data(), ref.data());
+	fassert(out == ref);
+	am::linear::pow(ys, xs, res_x);
+	am::linear::pow(count, y.data(), x.data(), ref.data());
+	for (std::size_t i = 0; i < count; ++i) {
+		fassert(res[i].x == ref[i]);
+	}
+	am::linear::fast::atan2(xs, ys, span{out.data(), count});
+	am::linear::fast::atan2(count, x.data(), y.data(), ref.data());
+	fassert(out == ref);
+	am::linear::fast::exp(
+		view{x.data(), count}, span{&res[0].y, count, sizeof(vec2)}
+	);
+	am::linear::fast::exp(count, x.data(), ref.data());
+	for (std::size_t i = 0; i < count; ++i) {
+		fassert(res[i].y == ref[i]);
+	}
+}
+
+signed main() {
+	test_accuracy();
+	test_special();
+	test_forms();
+	return 0;
+}